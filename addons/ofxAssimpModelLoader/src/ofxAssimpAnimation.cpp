@@ -23,6 +23,10 @@ ofxAssimpAnimation::ofxAssimpAnimation(shared_ptr<const aiScene> scene, aiAnimat
     if(animation != NULL) {
         durationInSeconds = animation->mDuration;
         durationInMilliSeconds = durationInSeconds * 1000;
+
+        for(unsigned int i=0; i<animation->mNumChannels; i++) {
+            channelNodes.push_back(scene->mRootNode->FindNode(animation->mChannels[i]->mNodeName));
+        }
     }
 }
 
@@ -65,79 +69,152 @@ void ofxAssimpAnimation::update() {
 
 void ofxAssimpAnimation::updateAnimationNodes() {
 	for(unsigned int i=0; i<animation->mNumChannels; i++) {
-        const aiNodeAnim * channel = animation->mChannels[i];
-        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
+        aiVector3D presentPosition;
+        aiQuaternion presentRotation;
+        aiVector3D presentScaling;
+        if(samples) {
+            sampleChannel(i, progressInSeconds, presentPosition, presentRotation, presentScaling);
+        } else {
+            evaluateChannel(animation->mChannels[i], progressInSeconds, presentPosition, presentRotation, presentScaling);
+        }
         
-        aiVector3D presentPosition(0, 0, 0);
-        if(channel->mNumPositionKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumPositionKeys - 1) {
-                if(progressInSeconds < channel->mPositionKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
-            const aiVectorKey & key = channel->mPositionKeys[frame];
-            const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
+        aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
+        mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
+        mat.a2 *= presentScaling.y; mat.b2 *= presentScaling.y; mat.c2 *= presentScaling.y;
+        mat.a3 *= presentScaling.z; mat.b3 *= presentScaling.z; mat.c3 *= presentScaling.z;
+        mat.a4 = presentPosition.x; mat.b4 = presentPosition.y; mat.c4 = presentPosition.z;
+        
+        if(nodeTransforms) {
+            if(channelNodeIndices[i] >= 0) {
+                (*nodeTransforms)[channelNodeIndices[i]] = mat;
             }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
-            } else {
-                presentPosition = key.mValue;
+        } else if(channelNodes[i]) {
+            channelNodes[i]->mTransformation = mat;
+        }
+    }
+}
+
+void ofxAssimpAnimation::evaluateChannel(const aiNodeAnim * channel, double time, aiVector3D & presentPosition, aiQuaternion & presentRotation, aiVector3D & presentScaling) {
+    presentPosition = aiVector3D(0, 0, 0);
+    if(channel->mNumPositionKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumPositionKeys - 1) {
+            if(time < channel->mPositionKeys[frame+1].mTime) {
+                break;
             }
+            frame++;
         }
         
-        aiQuaternion presentRotation(1, 0, 0, 0);
-        if(channel->mNumRotationKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumRotationKeys - 1) {
-                if(progressInSeconds < channel->mRotationKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
-            const aiQuatKey& key = channel->mRotationKeys[frame];
-            const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
-            } else {
-                presentRotation = key.mValue;
+        unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
+        const aiVectorKey & key = channel->mPositionKeys[frame];
+        const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += getDurationInSeconds();
+        }
+        if(diffTime > 0) {
+            float factor = float((time - key.mTime) / diffTime);
+            presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
+        } else {
+            presentPosition = key.mValue;
+        }
+    }
+    
+    presentRotation = aiQuaternion(1, 0, 0, 0);
+    if(channel->mNumRotationKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumRotationKeys - 1) {
+            if(time < channel->mRotationKeys[frame+1].mTime) {
+                break;
             }
+            frame++;
         }
         
-        aiVector3D presentScaling(1, 1, 1);
-        if(channel->mNumScalingKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumScalingKeys - 1){
-                if(progressInSeconds < channel->mScalingKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
+        unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
+        const aiQuatKey& key = channel->mRotationKeys[frame];
+        const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += getDurationInSeconds();
+        }
+        if(diffTime > 0) {
+            float factor = float((time - key.mTime) / diffTime);
+            aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
+        } else {
+            presentRotation = key.mValue;
+        }
+    }
+    
+    presentScaling = aiVector3D(1, 1, 1);
+    if(channel->mNumScalingKeys > 0) {
+        unsigned int frame = 0;
+        while(frame < channel->mNumScalingKeys - 1){
+            if(time < channel->mScalingKeys[frame+1].mTime) {
+                break;
             }
-            
-            presentScaling = channel->mScalingKeys[frame].mValue;
+            frame++;
         }
         
-        aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
-        mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
-        mat.a2 *= presentScaling.y; mat.b2 *= presentScaling.y; mat.c2 *= presentScaling.y;
-        mat.a3 *= presentScaling.z; mat.b3 *= presentScaling.z; mat.c3 *= presentScaling.z;
-        mat.a4 = presentPosition.x; mat.b4 = presentPosition.y; mat.c4 = presentPosition.z;
-        
-        targetNode->mTransformation = mat;
+        presentScaling = channel->mScalingKeys[frame].mValue;
+    }
+}
+
+void ofxAssimpAnimation::sampleChannel(size_t channel, double time, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling) {
+    // the samples around the time, found without searching
+    double sample = std::max(time / samples->interval, 0.0);
+    size_t first = std::min<size_t>(sample, samples->numSamples - 2);
+    float factor = ofClamp(sample - first, 0, 1);
+    size_t index = channel * samples->numSamples + first;
+    
+    position = samples->positions[index] + (samples->positions[index + 1] - samples->positions[index]) * factor;
+    aiQuaternion::Interpolate(rotation, samples->rotations[index], samples->rotations[index + 1], factor);
+    scaling = samples->scalings[index] + (samples->scalings[index + 1] - samples->scalings[index]) * factor;
+}
+
+void ofxAssimpAnimation::bake(float samplesPerSecond) {
+    samples.reset();
+    if(animation == NULL || samplesPerSecond <= 0) {
+        return;
+    }
+    
+    auto baked = make_shared<Samples>();
+    double tps = animation->mTicksPerSecond ? animation->mTicksPerSecond : 25.f;
+    double duration = getDurationInSeconds();
+    baked->samplesPerSecond = samplesPerSecond;
+    baked->interval = tps / samplesPerSecond;
+    // at least two samples to interpolate between, the last one at the end
+    baked->numSamples = std::max<size_t>(ceil(duration / baked->interval), 1) + 1;
+    
+    size_t size = animation->mNumChannels * baked->numSamples;
+    baked->positions.resize(size);
+    baked->rotations.resize(size);
+    baked->scalings.resize(size);
+    for(unsigned int i=0; i<animation->mNumChannels; i++) {
+        for(size_t j=0; j<baked->numSamples; j++) {
+            size_t index = i * baked->numSamples + j;
+            double time = std::min(j * baked->interval, duration);
+            evaluateChannel(animation->mChannels[i], time, baked->positions[index], baked->rotations[index], baked->scalings[index]);
+        }
+    }
+    samples = baked;
+}
+
+bool ofxAssimpAnimation::isBaked() {
+    return samples != nullptr;
+}
+
+float ofxAssimpAnimation::getSampleRate() {
+    return samples ? samples->samplesPerSecond : 0;
+}
+
+void ofxAssimpAnimation::setNodeTransforms(shared_ptr<vector<aiMatrix4x4>> transforms, const vector<const aiNode*> & nodes) {
+    nodeTransforms = transforms;
+    channelNodeIndices.assign(channelNodes.size(), -1);
+    for(size_t i=0; i<channelNodes.size(); i++) {
+        auto it = find(nodes.begin(), nodes.end(), channelNodes[i]);
+        if(it != nodes.end()) {
+            channelNodeIndices[i] = it - nodes.begin();
+        }
     }
 }
 
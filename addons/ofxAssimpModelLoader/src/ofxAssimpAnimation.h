@@ -42,13 +42,53 @@ public:
     void setPosition(float position);
     void setLoopState(ofLoopType state);
     void setSpeed(float speed);
+
+    /// \brief Sample the animation at a fixed rate so updating it doesn't
+    /// need to search the keyframes.
+    ///
+    /// Every update interpolates between the two samples around the current
+    /// position, which costs the same for any number of keyframes. Higher
+    /// rates follow the keyframes more closely but use more memory. Copies
+    /// of the animation share the samples.
+    /// \param samplesPerSecond Samples per second of animation, 0 removes
+    /// the samples and goes back to evaluating the keyframes.
+    void bake(float samplesPerSecond);
+    bool isBaked();
+    float getSampleRate();
     
 protected:
+    friend class ofxAssimpModelLoader;
+
+    struct Samples {
+        float samplesPerSecond;
+        // interval between samples in ticks of the animation
+        double interval;
+        size_t numSamples;
+        // numSamples values for every channel, one channel after the other
+        vector<aiVector3D> positions;
+        vector<aiQuaternion> rotations;
+        vector<aiVector3D> scalings;
+    };
     
     void updateAnimationNodes();
+
+    // evaluates the keyframes of a channel at a time in ticks
+    void evaluateChannel(const aiNodeAnim * channel, double time, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling);
+    // interpolates the samples of a channel at a time in ticks
+    void sampleChannel(size_t channel, double time, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling);
+
+    // makes the animation write the transformations of the nodes to a list
+    // owned by a model instead of the nodes of the scene, so models
+    // sharing the scene can be in different poses
+    void setNodeTransforms(shared_ptr<vector<aiMatrix4x4>> transforms, const vector<const aiNode*> & nodes);
     
     shared_ptr<const aiScene> scene;
     aiAnimation * animation;
+    shared_ptr<const Samples> samples;
+    // the node animated by every channel, found once
+    vector<aiNode*> channelNodes;
+    shared_ptr<vector<aiMatrix4x4>> nodeTransforms;
+    vector<int> channelNodeIndices;
     float animationCurrTime;
     float animationPrevTime;
     bool bPlay;
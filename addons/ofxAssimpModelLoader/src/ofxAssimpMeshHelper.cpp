@@ -12,6 +12,9 @@ ofxAssimpMeshHelper::ofxAssimpMeshHelper() {
     twoSided = false;
     hasChanged = false;
     validCache = false;
+    numInfluences = 0;
+    dirtyBegin = 0;
+    dirtyEnd = 0;
 }
 
 bool ofxAssimpMeshHelper::hasTexture() {
@@ -39,6 +39,24 @@ public:
     vector<aiVector3D> animatedPos;
     vector<aiVector3D> animatedNorm;
 
+    // skinning data, built when loading a model with animations.
+    // the node of every bone as an index in the list of nodes of the model,
+    // -1 if the bone has no node
+    vector<int> boneNodes;
+    // the 3x4 matrix of every bone in the last update, row major
+    vector<float> boneMatrices;
+    // range of vertices influenced by every bone
+    vector<unsigned int> boneVerticesBegin;
+    vector<unsigned int> boneVerticesEnd;
+    // the bones and weights of every vertex, in numInfluences columns of
+    // one value per vertex, unused influences have weight 0
+    unsigned int numInfluences;
+    vector<unsigned int> influenceBones;
+    vector<float> influenceWeights;
+    // vertices skinned since the last upload
+    unsigned int dirtyBegin;
+    unsigned int dirtyEnd;
+
     ofMesh cachedMesh;
     bool validCache;
     
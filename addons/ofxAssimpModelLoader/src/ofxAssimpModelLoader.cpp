@@ -7,6 +7,8 @@
 #include <assimp/config.h>
 
 ofxAssimpModelLoader::ofxAssimpModelLoader(){
+	bSceneSharing = false;
+	animationSampleRate = 0;
 	clear();
 }
 
@@ -16,29 +18,10 @@ ofxAssimpModelLoader::~ofxAssimpModelLoader(){
 
 //------------------------------------------
 bool ofxAssimpModelLoader::loadModel(string modelName, bool optimize){
-    
-    file.open(modelName, ofFile::ReadOnly, true); // Since it may be a binary file we should read it in binary -Ed
-    if(!file.exists()) {
-        ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): model does not exist: \"" << modelName << "\"";
+    loadingModel = std::shared_future<shared_ptr<ofxAssimpModelLoader>>();
+    if(!importScene(modelName, optimize)){
         return false;
     }
-
-    ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): loading \"" << file.getFileName()
-		<< "\" from \"" << file.getEnclosingDirectory() << "\"";
-    
-    if(scene.get() != nullptr){
-        clear();
-		// we reset the shared_ptr explicitly here, to force the old 
-		// aiScene to be deleted **before** a new aiScene is created.
-		scene.reset();
-    }
-    
-    // sets various properties & flags to a default preference
-    unsigned int flags = initImportProperties(optimize);
-    
-    // loads scene from file
-    scene = shared_ptr<const aiScene>(aiImportFileExWithProperties(file.getAbsolutePath().c_str(), flags, NULL, store.get()), aiReleaseImport);
-    
     bool bOk = processScene();
     return bOk;
 }
@@ -48,6 +31,7 @@ bool ofxAssimpModelLoader::loadModel(ofBuffer & buffer, bool optimize, const cha
     
     ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): loading from memory buffer \"." << extension << "\"";
     
+    loadingModel = std::shared_future<shared_ptr<ofxAssimpModelLoader>>();
     if(scene.get() != nullptr){
         clear();
 		// we reset the shared_ptr explicitly here, to force the old 
@@ -65,6 +49,88 @@ bool ofxAssimpModelLoader::loadModel(ofBuffer & buffer, bool optimize, const cha
     return bOk;
 }
 
+//------------------------------------------
+void ofxAssimpModelLoader::loadModelAsync(string modelName, bool optimize){
+    if(scene.get() != nullptr){
+        clear();
+        scene.reset();
+    }
+
+    // everything that doesn't need GL is loaded by another model in a task
+    // and copied to this one when it's done
+    auto loader = make_shared<ofxAssimpModelLoader>();
+    loader->bSceneSharing = bSceneSharing;
+    loader->animationSampleRate = animationSampleRate;
+    loadingModel = ofGetTaskPool().async([loader, modelName, optimize]() -> shared_ptr<ofxAssimpModelLoader>{
+        if(loader->importScene(modelName, optimize) && loader->loadMeshes()){
+            return loader;
+        }
+        return nullptr;
+    }).share();
+}
+
+bool ofxAssimpModelLoader::isLoading(){
+    return loadingModel.valid();
+}
+
+bool ofxAssimpModelLoader::waitForLoading(){
+    if(loadingModel.valid()){
+        loadingModel.wait();
+        updateLoading();
+    }
+    return scene != nullptr;
+}
+
+bool ofxAssimpModelLoader::updateLoading(){
+    if(!loadingModel.valid()){
+        return false;
+    }
+    if(loadingModel.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+        return true;
+    }
+
+    shared_ptr<ofxAssimpModelLoader> loader;
+    try{
+        loader = loadingModel.get();
+    }catch(std::exception & e){
+        ofLogError("ofxAssimpModelLoader") << "loadModelAsync(): " << e.what();
+    }
+    loadingModel = std::shared_future<shared_ptr<ofxAssimpModelLoader>>();
+    if(!loader){
+        return false;
+    }
+
+    file = loader->file;
+    store = loader->store;
+    scene = loader->scene;
+    modelMeshes = loader->modelMeshes;
+    animations = loader->animations;
+    texturePixels = loader->texturePixels;
+    nodes = loader->nodes;
+    nodeParents = loader->nodeParents;
+    nodeLocalTransforms = loader->nodeLocalTransforms;
+    nodeTransforms = loader->nodeTransforms;
+    finishLoading();
+    return false;
+}
+
+//------------------------------------------
+void ofxAssimpModelLoader::setSceneSharing(bool shared){
+    bSceneSharing = shared;
+}
+
+bool ofxAssimpModelLoader::isSceneSharing(){
+    return bSceneSharing;
+}
+
+void ofxAssimpModelLoader::setAnimationSampleRate(float samplesPerSecond){
+    animationSampleRate = std::max(samplesPerSecond, 0.f);
+}
+
+float ofxAssimpModelLoader::getAnimationSampleRate(){
+    return animationSampleRate;
+}
+
 unsigned int ofxAssimpModelLoader::initImportProperties(bool optimize) {    
     store.reset(aiCreatePropertyStore(), aiReleasePropertyStore);
     
@@ -81,29 +147,84 @@ unsigned int ofxAssimpModelLoader::initImportProperties(bool optimize) {
     return flags;
 }
 
-bool ofxAssimpModelLoader::processScene() {
+// scenes loaded by models sharing them, by file and import flags
+static std::mutex sharedScenesMutex;
+static map<string, weak_ptr<const aiScene>> sharedScenes;
+
+bool ofxAssimpModelLoader::importScene(string modelName, bool optimize){
     
-    normalizeFactor = ofGetWidth() / 2.0;
+    file.open(modelName, ofFile::ReadOnly, true); // Since it may be a binary file we should read it in binary -Ed
+    if(!file.exists()) {
+        ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): model does not exist: \"" << modelName << "\"";
+        return false;
+    }
+
+    ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): loading \"" << file.getFileName()
+		<< "\" from \"" << file.getEnclosingDirectory() << "\"";
     
-    if(scene){
-        loadGLResources();
-        update();
-        calculateDimensions();
-        
-        if(getAnimationCount())
-            ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): scene has " << getAnimationCount() << "animations";
-        else {
-            ofLogVerbose("ofxAssimpModelLoader") << "loadMode(): no animations";
-        }       
-        
+    if(scene.get() != nullptr){
+        clear();
+		// we reset the shared_ptr explicitly here, to force the old 
+		// aiScene to be deleted **before** a new aiScene is created.
+		scene.reset();
+    }
+    
+    // sets various properties & flags to a default preference
+    unsigned int flags = initImportProperties(optimize);
+
+    string sharedName = file.getAbsolutePath() + ":" + ofToString(flags);
+    if(bSceneSharing){
+        std::unique_lock<std::mutex> lock(sharedScenesMutex);
+        auto it = sharedScenes.find(sharedName);
+        if(it != sharedScenes.end()){
+            scene = it->second.lock();
+        }
+        if(scene){
+            ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): sharing the scene of \"" << file.getFileName() << "\"";
+            return true;
+        }
+    }
+    
+    // loads scene from file
+    scene = shared_ptr<const aiScene>(aiImportFileExWithProperties(file.getAbsolutePath().c_str(), flags, NULL, store.get()), aiReleaseImport);
+
+    if(bSceneSharing && scene){
+        std::unique_lock<std::mutex> lock(sharedScenesMutex);
+        for(auto it = sharedScenes.begin(); it != sharedScenes.end();){
+            if(it->second.expired()){
+                it = sharedScenes.erase(it);
+            }else{
+                ++it;
+            }
+        }
+        sharedScenes[sharedName] = scene;
+    }
+    return true;
+}
+
+bool ofxAssimpModelLoader::processScene() {
+    if(loadMeshes()){
+        finishLoading();
         return true;
     }else{
-        ofLogError("ofxAssimpModelLoader") << "loadModel(): " + (string) aiGetErrorString();
         clear();
         return false;
     }
+}
+
+void ofxAssimpModelLoader::finishLoading() {
     
-    return false;
+    normalizeFactor = ofGetWidth() / 2.0;
+    
+    loadGLResources();
+    update();
+    calculateDimensions();
+    
+    if(getAnimationCount())
+        ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): scene has " << getAnimationCount() << "animations";
+    else {
+        ofLogVerbose("ofxAssimpModelLoader") << "loadMode(): no animations";
+    }       
 }
 
 
@@ -173,24 +294,31 @@ void ofxAssimpModelLoader::optimizeScene(){
 }
 
 //-------------------------------------------
-void ofxAssimpModelLoader::loadGLResources(){
+bool ofxAssimpModelLoader::loadMeshes(){
+    if(!scene){
+        ofLogError("ofxAssimpModelLoader") << "loadModel(): " + (string) aiGetErrorString();
+        return false;
+    }
 
-	ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): starting";
+	ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): starting";
 
     // create new mesh helpers for each mesh, will populate their data later.
     modelMeshes.resize(scene->mNumMeshes,ofxAssimpMeshHelper());
 
-    // create OpenGL buffers and populate them based on each meshes pertinant info.
+    int numOfAnimations = scene->mNumAnimations;
+    for (int i = 0; i<numOfAnimations; i++) {
+        aiAnimation * animation = scene->mAnimations[i];
+        animations.push_back(ofxAssimpAnimation(scene, animation));
+        animations.back().bake(animationSampleRate);
+    }
+
     for (unsigned int i = 0; i < scene->mNumMeshes; ++i){
-        ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): loading mesh " << i;
+        ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): loading mesh " << i;
         // current mesh we are introspecting
         aiMesh* mesh = scene->mMeshes[i];
 
         // the current meshHelper we will be populating data into.
         ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
-        //ofxAssimpMeshHelper meshHelper;
-		
-        //meshHelper.texture = NULL;
 
         // Handle material info
         aiMaterial* mtl = scene->mMaterials[mesh->mMaterialIndex];
@@ -234,50 +362,40 @@ void ofxAssimpModelLoader::loadGLResources(){
         else
             meshHelper.twoSided = false;
 
-        // Load Textures
+        // Load Textures, only the images here, loadGLResources() uploads them
         int texIndex = 0;
         aiString texPath;
 
         // TODO: handle other aiTextureTypes
         if(AI_SUCCESS == mtl->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)){
-            ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): loading image from \"" << texPath.data << "\"";
+            ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): loading image from \"" << texPath.data << "\"";
             string modelFolder = file.getEnclosingDirectory();
             string relTexPath = ofFilePath::getEnclosingDirectory(texPath.data,false);
             string texFile = ofFilePath::getFileName(texPath.data);
             string realPath = ofFilePath::join(ofFilePath::join(modelFolder, relTexPath), texFile);
             
             if(ofFile::doesFileExist(realPath) == false) {
-                ofLogError("ofxAssimpModelLoader") << "loadGLResource(): texture doesn't exist: \""
+                ofLogError("ofxAssimpModelLoader") << "loadMeshes(): texture doesn't exist: \""
 					<< file.getFileName() + "\" in \"" << realPath << "\"";
             }
             
-            ofxAssimpTexture assimpTexture;
-            bool bTextureAlreadyExists = false;
-            for(size_t j = 0; j < textures.size(); j++) {
-                assimpTexture = textures[j];
-                if(assimpTexture.getTexturePath() == realPath) {
-                    bTextureAlreadyExists = true;
-                    break;
-                }
-            }
-            if(bTextureAlreadyExists) {
-                meshHelper.assimpTexture = assimpTexture;
-                ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): texture already loaded: \""
+            if(texturePixels.count(realPath)) {
+                ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): texture already loaded: \""
 					<< file.getFileName() + "\" from \"" << realPath << "\"";
             } else {
-                ofTexture texture;
-                bool bTextureLoadedOk = ofLoadImage(texture, realPath);
+                ofPixels pixels;
+                bool bTextureLoadedOk = ofLoadImage(pixels, realPath);
                 if(bTextureLoadedOk) {
-                    textures.push_back(ofxAssimpTexture(texture, realPath));
-                    assimpTexture = textures.back();
-                    meshHelper.assimpTexture = assimpTexture;
-                    ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): texture loaded, dimensions: "
-						<< texture.getWidth() << "x" << texture.getHeight();
+                    ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): texture loaded, dimensions: "
+						<< pixels.getWidth() << "x" << pixels.getHeight();
                 } else {
-                    ofLogError("ofxAssimpModelLoader") << "loadGLResource(): couldn't load texture: \""
+                    ofLogError("ofxAssimpModelLoader") << "loadMeshes(): couldn't load texture: \""
 						<< file.getFileName() + "\" from \"" << realPath << "\"";
                 }
+                // kept even if empty so it's not loaded again for other meshes
+                texturePixels[realPath] = pixels;
             }
+            meshHelper.assimpTexture = ofxAssimpTexture(ofTexture(), realPath);
         }
 
         meshHelper.mesh = mesh;
@@ -286,12 +404,6 @@ void ofxAssimpModelLoader::loadGLResources(){
         meshHelper.validCache = true;
         meshHelper.hasChanged = false;
 
-		int numOfAnimations = scene->mNumAnimations;
-		for (int i = 0; i<numOfAnimations; i++) {
-			aiAnimation * animation = scene->mAnimations[i];
-			animations.push_back(ofxAssimpAnimation(scene, animation));
-		}
-
         if(hasAnimations()){
 			meshHelper.animatedPos.resize(mesh->mNumVertices);
 			if(mesh->HasNormals()){
@@ -299,6 +411,49 @@ void ofxAssimpModelLoader::loadGLResources(){
 			}
         }
 
+        meshHelper.indices.resize(mesh->mNumFaces * 3);
+        int j=0;
+        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
+			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
+				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
+			}
+		}
+    }
+
+    if(hasAnimations()){
+        initNodes();
+        initSkinning();
+    }
+
+    ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): finished";
+    return true;
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::loadGLResources(){
+
+	ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): starting";
+
+    // create OpenGL buffers and populate them based on each meshes pertinant info.
+    for (unsigned int i = 0; i < modelMeshes.size(); ++i){
+        ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): loading mesh " << i;
+        ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+        aiMesh* mesh = meshHelper.mesh;
+
+        string texturePath = meshHelper.assimpTexture.getTexturePath();
+        if(!texturePath.empty() && !meshHelper.assimpTexture.hasTexture()) {
+            auto texture = find_if(textures.begin(), textures.end(), [&](ofxAssimpTexture & assimpTexture){
+                return assimpTexture.getTexturePath() == texturePath;
+            });
+            if(texture != textures.end()) {
+                meshHelper.assimpTexture = *texture;
+            } else if(texturePixels[texturePath].isAllocated()) {
+                ofTexture texture;
+                texture.loadData(texturePixels[texturePath]);
+                textures.push_back(ofxAssimpTexture(texture, texturePath));
+                meshHelper.assimpTexture = textures.back();
+            }
+        }
 
         int usage;
         if(getAnimationCount()){
@@ -327,20 +482,9 @@ void ofxAssimpModelLoader::loadGLResources(){
 			meshHelper.vbo.setTexCoordData(&meshHelper.cachedMesh.getTexCoords()[0].x, mesh->mNumVertices,GL_STATIC_DRAW,sizeof(ofVec2f));
         }
 
-        meshHelper.indices.resize(mesh->mNumFaces * 3);
-        int j=0;
-        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
-			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
-				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
-			}
-		}
-
         meshHelper.vbo.setIndexData(&meshHelper.indices[0],meshHelper.indices.size(),GL_STATIC_DRAW);
-
-        //modelMeshes.push_back(meshHelper);
     }
-    
-
+    texturePixels.clear();
 
     ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): finished";
 }
@@ -369,18 +513,25 @@ void ofxAssimpModelLoader::clear(){
     currentAnimation = -1;
 
     textures.clear();
+    texturePixels.clear();
+    nodes.clear();
+    nodeParents.clear();
+    nodeLocalTransforms.reset();
+    nodeTransforms.clear();
 
     updateModelMatrix();
 }
 
 //------------------------------------------- update.
 void ofxAssimpModelLoader::update() {
+	if(updateLoading()) return;
 	if(!scene) return;
     updateAnimations();
-    updateMeshes(scene->mRootNode, ofMatrix4x4());
     if(hasAnimations() == false) {
+        updateMeshes(scene->mRootNode, ofMatrix4x4());
         return;
     }
+    updateNodes();
     updateBones();
     updateGLResources();
 }
@@ -412,81 +563,231 @@ void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix)
     }
 }
 
+void ofxAssimpModelLoader::updateModels(const vector<ofxAssimpModelLoader*> & models) {
+    // models still loading have no scene yet and are skipped
+    for(auto model: models) {
+        if(model) {
+            model->updateLoading();
+        }
+    }
+    // every model only modifies its own nodes and meshes
+    ofParallelFor(0, models.size(), [&](size_t i){
+        ofxAssimpModelLoader * model = models[i];
+        if(!model || !model->scene) return;
+        model->updateAnimations();
+        if(!model->hasAnimations()) {
+            model->updateMeshes(model->scene->mRootNode, ofMatrix4x4());
+            return;
+        }
+        model->updateNodes();
+        model->updateBones();
+    });
+    for(auto model: models) {
+        if(model && model->scene && model->hasAnimations()) {
+            model->updateGLResources();
+        }
+    }
+}
+
+void ofxAssimpModelLoader::initNodes() {
+    nodes.clear();
+    nodeParents.clear();
+    vector<pair<const aiNode*, int>> pending{{scene->mRootNode, -1}};
+    while(!pending.empty()) {
+        const aiNode * node = pending.back().first;
+        int parent = pending.back().second;
+        pending.pop_back();
+        int index = nodes.size();
+        nodes.push_back(node);
+        nodeParents.push_back(parent);
+        for(unsigned int i = 0; i < node->mNumChildren; i++) {
+            pending.emplace_back(node->mChildren[i], index);
+        }
+    }
+
+    // the animations never modify the scene, which can be shared
+    nodeLocalTransforms = make_shared<vector<aiMatrix4x4>>(nodes.size());
+    for(size_t i = 0; i < nodes.size(); ++i) {
+        (*nodeLocalTransforms)[i] = nodes[i]->mTransformation;
+    }
+    nodeTransforms.resize(nodes.size());
+    for(auto & animation: animations) {
+        animation.setNodeTransforms(nodeLocalTransforms, nodes);
+    }
+}
+
+void ofxAssimpModelLoader::initSkinning() {
+    for(auto & meshHelper: modelMeshes) {
+        const aiMesh * mesh = meshHelper.mesh;
+        size_t numVertices = mesh->mNumVertices;
+
+        meshHelper.boneNodes.assign(mesh->mNumBones, -1);
+        meshHelper.boneVerticesBegin.assign(mesh->mNumBones, numVertices);
+        meshHelper.boneVerticesEnd.assign(mesh->mNumBones, 0);
+        vector<unsigned int> vertexInfluences(numVertices, 0);
+        for(unsigned int a = 0; a < mesh->mNumBones; ++a) {
+            const aiBone * bone = mesh->mBones[a];
+            const aiNode * node = scene->mRootNode->FindNode(bone->mName);
+            auto it = find(nodes.begin(), nodes.end(), node);
+            if(it != nodes.end()) {
+                meshHelper.boneNodes[a] = it - nodes.begin();
+            }
+            for(unsigned int b = 0; b < bone->mNumWeights; ++b) {
+                unsigned int vertexId = bone->mWeights[b].mVertexId;
+                vertexInfluences[vertexId]++;
+                meshHelper.boneVerticesBegin[a] = std::min(meshHelper.boneVerticesBegin[a], vertexId);
+                meshHelper.boneVerticesEnd[a] = std::max(meshHelper.boneVerticesEnd[a], vertexId + 1);
+            }
+        }
+
+        meshHelper.numInfluences = 0;
+        for(auto influences: vertexInfluences) {
+            meshHelper.numInfluences = std::max(meshHelper.numInfluences, influences);
+        }
+        meshHelper.influenceBones.assign(meshHelper.numInfluences * numVertices, 0);
+        meshHelper.influenceWeights.assign(meshHelper.numInfluences * numVertices, 0.f);
+        vertexInfluences.assign(numVertices, 0);
+        for(unsigned int a = 0; a < mesh->mNumBones; ++a) {
+            const aiBone * bone = mesh->mBones[a];
+            for(unsigned int b = 0; b < bone->mNumWeights; ++b) {
+                const aiVertexWeight & weight = bone->mWeights[b];
+                size_t column = vertexInfluences[weight.mVertexId]++;
+                meshHelper.influenceBones[column * numVertices + weight.mVertexId] = a;
+                meshHelper.influenceWeights[column * numVertices + weight.mVertexId] = weight.mWeight;
+            }
+        }
+
+        // NaN never compares equal so every bone is skinned the first time
+        meshHelper.boneMatrices.assign(mesh->mNumBones * 12, std::numeric_limits<float>::quiet_NaN());
+        meshHelper.dirtyBegin = 0;
+        meshHelper.dirtyEnd = 0;
+    }
+}
+
+static void skinVertices(ofxAssimpMeshHelper & meshHelper, size_t begin, size_t end) {
+    const aiMesh * mesh = meshHelper.mesh;
+    const size_t numVertices = mesh->mNumVertices;
+    const unsigned int numInfluences = meshHelper.numInfluences;
+    const unsigned int * bones = meshHelper.influenceBones.data();
+    const float * weights = meshHelper.influenceWeights.data();
+    const float * matrices = meshHelper.boneMatrices.data();
+    const bool hasNormals = mesh->HasNormals();
+
+    for(size_t v = begin; v < end; v++) {
+        // blend the matrices of the bones so every vertex is transformed once,
+        // the fixed size loop over the 12 values is vectorized by the compiler
+        float m[12] = {0};
+        for(unsigned int k = 0; k < numInfluences; k++) {
+            const float weight = weights[k * numVertices + v];
+            const float * bone = matrices + 12 * bones[k * numVertices + v];
+            for(int j = 0; j < 12; j++) {
+                m[j] += weight * bone[j];
+            }
+        }
+
+        const aiVector3D & p = mesh->mVertices[v];
+        meshHelper.animatedPos[v].Set(
+            m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3],
+            m[4] * p.x + m[5] * p.y + m[6] * p.z + m[7],
+            m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11]);
+
+        if(hasNormals) {
+            // only the rotation and scale of the bones
+            const aiVector3D & n = mesh->mNormals[v];
+            meshHelper.animatedNorm[v].Set(
+                m[0] * n.x + m[1] * n.y + m[2] * n.z,
+                m[4] * n.x + m[5] * n.y + m[6] * n.z,
+                m[8] * n.x + m[9] * n.y + m[10] * n.z);
+        }
+    }
+}
+
+void ofxAssimpModelLoader::updateNodes() {
+    // transformation of every node relative to the root, parents come
+    // before their children so one pass is enough
+    const vector<aiMatrix4x4> & localTransforms = *nodeLocalTransforms;
+    for(size_t i = 0; i < nodes.size(); ++i) {
+        if(nodeParents[i] < 0) {
+            nodeTransforms[i] = localTransforms[i];
+        } else {
+            nodeTransforms[i] = nodeTransforms[nodeParents[i]] * localTransforms[i];
+        }
+
+        aiMatrix4x4 m = nodeTransforms[i];
+        m.Transpose();
+        for(unsigned int j = 0; j < nodes[i]->mNumMeshes; j++) {
+            modelMeshes[nodes[i]->mMeshes[j]].matrix.set(m.a1, m.a2, m.a3, m.a4,
+                                                         m.b1, m.b2, m.b3, m.b4,
+                                                         m.c1, m.c2, m.c3, m.c4,
+                                                         m.d1, m.d2, m.d3, m.d4);
+        }
+    }
+}
+
 void ofxAssimpModelLoader::updateBones() {
     if (!hasAnimations()){
         return;
     }
-    // update mesh position for the animation
-	for(size_t i = 0; i < modelMeshes.size(); ++i) {
-		// current mesh we are introspecting
-		const aiMesh* mesh = modelMeshes[i].mesh;
-        
-		// calculate bone matrices
-		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
-		for(unsigned int a = 0; a < mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-            
-			// find the corresponding node by again looking recursively through the node hierarchy for the same name
-			aiNode* node = scene->mRootNode->FindNode(bone->mName);
-            
-			// start with the mesh-to-bone matrix
-			boneMatrices[a] = bone->mOffsetMatrix;
-			// and now append all node transformations down the parent chain until we're back at mesh coordinates again
-			const aiNode* tempNode = node;
-			while(tempNode) {
-				// check your matrix multiplication order here!!!
-				boneMatrices[a] = tempNode->mTransformation * boneMatrices[a];
-				// boneMatrices[a] = boneMatrices[a] * tempNode->mTransformation;
-				tempNode = tempNode->mParent;
-			}
-			modelMeshes[i].hasChanged = true;
-			modelMeshes[i].validCache = false;
-		}
-        
-		modelMeshes[i].animatedPos.assign(modelMeshes[i].animatedPos.size(), aiVector3D(0.0f));
-		if(mesh->HasNormals()){
-			modelMeshes[i].animatedNorm.assign(modelMeshes[i].animatedNorm.size(), aiVector3D(0.0f));
-		}
-		// loop through all vertex weights of all bones
-		for(unsigned int a = 0; a < mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-			const aiMatrix4x4& posTrafo = boneMatrices[a];
-            
-			for(unsigned int b = 0; b < bone->mNumWeights; ++b) {
-				const aiVertexWeight& weight = bone->mWeights[b];
-                
-				size_t vertexId = weight.mVertexId;
-				const aiVector3D& srcPos = mesh->mVertices[vertexId];
-                
-				modelMeshes[i].animatedPos[vertexId] += weight.mWeight * (posTrafo * srcPos);
-			}
-			if(mesh->HasNormals()){
-				// 3x3 matrix, contains the bone matrix without the translation, only with rotation and possibly scaling
-				aiMatrix3x3 normTrafo = aiMatrix3x3( posTrafo);
-				for(unsigned int b = 0; b < bone->mNumWeights; ++b) {
-					const aiVertexWeight& weight = bone->mWeights[b];
-					size_t vertexId = weight.mVertexId;
-                    
-					const aiVector3D& srcNorm = mesh->mNormals[vertexId];
-					modelMeshes[i].animatedNorm[vertexId] += weight.mWeight * (normTrafo * srcNorm);
-				}
-			}
-		}
-	}
+
+    ofParallelFor(0, modelMeshes.size(), [&](size_t i){
+        ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+        const aiMesh * mesh = meshHelper.mesh;
+
+        // the bone matrices go from the mesh to the bone and then through all
+        // the nodes down the parent chain back to mesh coordinates. only the
+        // vertices influenced by a bone that moved need skinning again
+        size_t begin = mesh->mNumVertices;
+        size_t end = 0;
+        for(unsigned int a = 0; a < mesh->mNumBones; ++a) {
+            aiMatrix4x4 boneMatrix = mesh->mBones[a]->mOffsetMatrix;
+            if(meshHelper.boneNodes[a] >= 0) {
+                boneMatrix = nodeTransforms[meshHelper.boneNodes[a]] * boneMatrix;
+            }
+            float * matrix = &meshHelper.boneMatrices[a * 12];
+            const float * rows = &boneMatrix.a1;
+            bool changed = !std::equal(rows, rows + 12, matrix);
+            if(changed) {
+                std::copy(rows, rows + 12, matrix);
+                begin = std::min<size_t>(begin, meshHelper.boneVerticesBegin[a]);
+                end = std::max<size_t>(end, meshHelper.boneVerticesEnd[a]);
+            }
+        }
+        if(begin >= end) {
+            return;
+        }
+
+        ofParallelForRange(begin, end, [&](size_t first, size_t last){
+            skinVertices(meshHelper, first, last);
+        }, 4096);
+
+        if(meshHelper.dirtyBegin < meshHelper.dirtyEnd) {
+            begin = std::min<size_t>(begin, meshHelper.dirtyBegin);
+            end = std::max<size_t>(end, meshHelper.dirtyEnd);
+        }
+        meshHelper.dirtyBegin = begin;
+        meshHelper.dirtyEnd = end;
+        meshHelper.hasChanged = true;
+        meshHelper.validCache = false;
+    });
 }
 
 void ofxAssimpModelLoader::updateGLResources(){
-    // now upload the result position and normal along with the other vertex attributes into a dynamic vertex buffer, VBO or whatever
+    // upload only the vertices that changed since the last upload
     for (unsigned int i = 0; i < modelMeshes.size(); ++i){
-    	if(modelMeshes[i].hasChanged){
-			const aiMesh* mesh = modelMeshes[i].mesh;
-			if(hasAnimations()){
-				modelMeshes[i].vbo.updateVertexData(&modelMeshes[i].animatedPos[0].x,mesh->mNumVertices);
+        ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+    	if(meshHelper.hasChanged){
+			const aiMesh* mesh = meshHelper.mesh;
+			if(hasAnimations() && meshHelper.dirtyBegin < meshHelper.dirtyEnd){
+				GLintptr offset = meshHelper.dirtyBegin * sizeof(aiVector3D);
+				GLsizeiptr bytes = (meshHelper.dirtyEnd - meshHelper.dirtyBegin) * sizeof(aiVector3D);
+				meshHelper.vbo.getVertexBuffer().updateData(offset, bytes, &meshHelper.animatedPos[meshHelper.dirtyBegin].x);
 				if(mesh->HasNormals()){
-					modelMeshes[i].vbo.updateNormalData(&modelMeshes[i].animatedNorm[0].x,mesh->mNumVertices);
+					meshHelper.vbo.getNormalBuffer().updateData(offset, bytes, &meshHelper.animatedNorm[meshHelper.dirtyBegin].x);
 				}
 			}
-			modelMeshes[i].hasChanged = false;
+			meshHelper.dirtyBegin = 0;
+			meshHelper.dirtyEnd = 0;
+			meshHelper.hasChanged = false;
     	}
     }
 }
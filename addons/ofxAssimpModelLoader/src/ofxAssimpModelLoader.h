@@ -30,11 +30,57 @@ class ofxAssimpModelLoader{
 
         bool loadModel(string modelName, bool optimize=false);
         bool loadModel(ofBuffer & buffer, bool optimize=false, const char * extension="");
+
+        /// \brief Load a model without blocking the calling thread.
+        ///
+        /// Reading the file, building the meshes, loading the images of the
+        /// textures and sampling the animations happen in a thread of
+        /// ofGetTaskPool(). Once that is done, the next call to update()
+        /// creates the GL resources, so it has to be called from the thread
+        /// with the GL context. Until then the model is empty and
+        /// isLoading() returns true. Errors are logged and leave the model
+        /// empty.
+        void loadModelAsync(string modelName, bool optimize=false);
+
+        /// \returns true after loadModelAsync() until the model is ready.
+        bool isLoading();
+
+        /// \brief Wait until the model loaded with loadModelAsync() is ready,
+        /// creating its GL resources.
+        /// \returns true if the model loaded correctly.
+        bool waitForLoading();
+
+        /// \brief Share the scene of a file with other models that loaded
+        /// the same file with the same options and sharing enabled.
+        ///
+        /// The file is only read and processed once while any of those
+        /// models keep it, which saves time and memory when drawing many
+        /// copies of a model. Every model still has its own meshes, so
+        /// they can be animated independently. Disabled by default, it
+        /// applies to the next load. optimizeScene() changes the scene of
+        /// all the models that share it.
+        void setSceneSharing(bool shared);
+        bool isSceneSharing();
+
+        /// \brief Sample the animations of the next models loaded at a
+        /// fixed rate, see ofxAssimpAnimation::bake().
+        ///
+        /// 0, the default, evaluates the keyframes on every update.
+        void setAnimationSampleRate(float samplesPerSecond);
+        float getAnimationSampleRate();
         void createEmptyModel();
         void createLightsFromAiModel();
         void optimizeScene();
 
         void update();
+
+        /// \brief Update several models at the same time.
+        ///
+        /// The animations and skinning of all the models are calculated in
+        /// parallel using all the cores and then uploaded to the GPU from
+        /// the calling thread, which is much faster than calling update()
+        /// on each of them for crowds of animated characters.
+        static void updateModels(const vector<ofxAssimpModelLoader*> & models);
     
         bool hasAnimations();
         unsigned int getAnimationCount();
@@ -115,13 +161,30 @@ class ofxAssimpModelLoader{
     protected:
         void updateAnimations();
         void updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix);
+        void updateNodes();
         void updateBones();
         void updateModelMatrix();
+
+        // lists the nodes and makes the animations move this model's copy
+        // of their transformations
+        void initNodes();
+        // finds the nodes of the bones and sorts the weights by vertex
+        void initSkinning();
     
         // ai scene setup
         unsigned int initImportProperties(bool optimize);
+        bool importScene(string modelName, bool optimize);
         bool processScene();
 
+        // meshes, materials, images and animations, which don't need GL so
+        // they can be loaded in another thread
+        bool loadMeshes();
+        // finishes a model after loadMeshes() in the thread with GL
+        void finishLoading();
+        // finishes an asynchronous load if it's ready, returns true while
+        // it's still loading
+        bool updateLoading();
+
         // Initial VBO creation, etc
         void loadGLResources();
     
@@ -148,6 +211,18 @@ class ofxAssimpModelLoader{
         vector<ofxAssimpTexture> textures;
         vector<ofxAssimpMeshHelper> modelMeshes;
         vector<ofxAssimpAnimation> animations;
+
+        // images of the textures loaded with the meshes, until they are
+        // uploaded by loadGLResources()
+        map<string, ofPixels> texturePixels;
+
+        // all the nodes of the scene, parents before their children, with the
+        // index of their parent, their transformation relative to the parent
+        // as moved by the animations and relative to the root
+        vector<const aiNode*> nodes;
+        vector<int> nodeParents;
+        shared_ptr<vector<aiMatrix4x4>> nodeLocalTransforms;
+        vector<aiMatrix4x4> nodeTransforms;
         int currentAnimation; // DEPRECATED - to be removed with deprecated animation functions.
 
         bool bUsingTextures;
@@ -155,6 +230,11 @@ class ofxAssimpModelLoader{
         bool bUsingColors;
         bool bUsingMaterials;
         float normalizeFactor;
+        bool bSceneSharing;
+        float animationSampleRate;
+
+        // the model being loaded by loadModelAsync()
+        std::shared_future<shared_ptr<ofxAssimpModelLoader>> loadingModel;
 
         // the main Asset Import scene that does the magic.
         shared_ptr<const aiScene> scene;
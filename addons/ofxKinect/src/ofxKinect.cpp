@@ -202,6 +202,7 @@ bool ofxKinect::open(int deviceIndex) {
 	if(!kinectContext.open(*this, deviceIDFromIndex)) {
 		return false;
 	}
+	calibration.setup(kinectDevice->registration);
 
 	if(serial == "0000000000000000") {
         bHasMotorControl = false;
@@ -244,6 +245,7 @@ bool ofxKinect::open(string serial) {
 	if(!kinectContext.open(*this, serial)) {
 		return false;
 	}
+	calibration.setup(kinectDevice->registration);
 	
 	if(serial == "0000000000000000") {
         bHasMotorControl = false;
@@ -460,6 +462,23 @@ float ofxKinect::getZeroPlaneDistance()  const{
 	return kinectDevice->registration.zero_plane_info.reference_distance;
 }
 
+//------------------------------------
+const ofxKinectCalibration & ofxKinect::getCalibration() const{
+	return calibration;
+}
+
+//------------------------------------
+void ofxKinect::getPointCloud(vector<glm::vec3> & points, int step, bool skipInvalid) const{
+	calibration.getPointCloud(depthPixelsRaw, points, step, skipInvalid);
+}
+
+//------------------------------------
+void ofxKinect::getPointCloud(ofMesh & mesh, int step) const{
+	// the infrared image comes from the depth sensor so it's always aligned
+	bool mapToVideo = !bUseRegistration && !bIsVideoInfrared;
+	calibration.getPointCloud(depthPixelsRaw, videoPixels, mesh, step, mapToVideo);
+}
+
 //------------------------------------
 ofColor ofxKinect::getColorAt(int x, int y)  const{
 	int index = (y * width + x) * videoBytesPerPixel;
@@ -779,25 +798,12 @@ void ofxKinect::setReconnectWaitTime(float waitTime) {
 
 //---------------------------------------------------------------------------
 void ofxKinect::updateDepthLookupTable() {
-	unsigned char nearColor = bNearWhite ? 255 : 0;
-	unsigned char farColor = bNearWhite ? 0 : 255;
-	unsigned int maxDepthLevels = 10001;
-	depthLookupTable.resize(maxDepthLevels);
-	depthLookupTable[0] = 0;
-	for(unsigned int i = 1; i < maxDepthLevels; i++) {
-		depthLookupTable[i] = ofMap(i, nearClipping, farClipping, nearColor, farColor, true);
-	}
+	ofxKinectCalibration::updateDepthLookupTable(depthLookupTable, nearClipping, farClipping, bNearWhite);
 }
 
 //----------------------------------------------------------
 void ofxKinect::updateDepthPixels() {
-	int n = width * height;
-	for(int i = 0; i < n; i++) {
-		distancePixels[i] = depthPixelsRaw[i];
-	}
-	for(int i = 0; i < n; i++) {
-		depthPixels[i] = depthLookupTable[depthPixelsRaw[i]];
-	}
+	ofxKinectCalibration::updateDepthPixels(depthPixelsRaw, depthLookupTable, distancePixels, depthPixels);
 }
 
 //---------------------------------------------------------------------------
@@ -44,6 +44,7 @@
 
 
 #include "ofxBase3DVideo.h"
+#include "ofxKinectCalibration.h"
 
 class ofxKinectContext;
 
@@ -148,6 +149,28 @@ public:
 	/// get the focal length of the IR sensor in mm
 	float getZeroPlaneDistance() const;
 
+	/// get the parameters and registration tables of the device, read when
+	/// it's opened
+	const ofxKinectCalibration & getCalibration() const;
+
+/// \section Point Cloud
+
+	/// fill points with the world coordinates of the current depth image in mm
+	///
+	/// step takes one every step pixels in both directions to downsample the
+	/// cloud, skipInvalid leaves out the pixels without depth
+	///
+	/// much faster than calling getWorldCoordinateAt() for every pixel, see
+	/// ofxKinectCalibration::getPointCloud()
+	void getPointCloud(vector<glm::vec3> & points, int step=1, bool skipInvalid=true) const;
+
+	/// fill a mesh of points with the world coordinates of the current depth
+	/// image and their colors from the video image
+	///
+	/// the colors are mapped with the registration tables of the device
+	/// unless setRegistration() already aligned the depth image
+	void getPointCloud(ofMesh & mesh, int step=1) const;
+
 /// \section RGB Data
 
 	/// get the RGB value for a depth point
@@ -350,6 +373,8 @@ protected:
 	ofShortPixels depthPixelsRaw;
 	ofFloatPixels distancePixels;
 
+	ofxKinectCalibration calibration;
+
 	ofPoint rawAccel;
 	ofPoint mksAccel;
 
@@ -0,0 +1,276 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectCalibration.h"
+
+#include "libfreenect_registration.h"
+
+// "fixed-point" precision of the registration table x values, from libfreenect
+#define OFX_KINECT_REG_X_SCALE 256
+
+// rows converted by each task, a 640 pixel row is too little work on its own
+#define OFX_KINECT_ROWS_GRAIN 16
+
+const int ofxKinectCalibration::width;
+const int ofxKinectCalibration::height;
+const int ofxKinectCalibration::maxDepth;
+
+//--------------------------------------------------------------------
+ofxKinectCalibration::ofxKinectCalibration() {
+	registrationOffset = 0;
+	// zero plane info reported by a model 1414
+	setup(0.1042, 120, 7.5, 2.3);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::setup(const freenect_registration & registration) {
+	const freenect_zero_plane_info & info = registration.zero_plane_info;
+	setup(info.reference_pixel_size, info.reference_distance, info.dcmos_emitter_dist, info.dcmos_rcmos_dist);
+
+	if(registration.registration_table == NULL || registration.depth_to_rgb_shift == NULL) {
+		return;
+	}
+	int n = width * height;
+	registrationX.resize(n);
+	registrationY.resize(n);
+	for(int i = 0; i < n; i++) {
+		registrationX[i] = registration.registration_table[i][0];
+		registrationY[i] = registration.registration_table[i][1];
+	}
+	depthToVideoShift.assign(registration.depth_to_rgb_shift, registration.depth_to_rgb_shift + maxDepth);
+	// same offset libfreenect applies to the registered depth image
+	registrationOffset = height * registration.reg_pad_info.start_lines;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::setup(float zeroPlanePixelSize, float zeroPlaneDistance,
+	float sensorEmitterDistance, float sensorCameraDistance) {
+	this->zeroPlanePixelSize = zeroPlanePixelSize;
+	this->zeroPlaneDistance = zeroPlaneDistance;
+	this->sensorEmitterDistance = sensorEmitterDistance;
+	this->sensorCameraDistance = sensorCameraDistance;
+	registrationX.clear();
+	registrationY.clear();
+	depthToVideoShift.clear();
+	registrationOffset = 0;
+	updateRays();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectCalibration::hasRegistration() const {
+	return !depthToVideoShift.empty();
+}
+
+//--------------------------------------------------------------------
+float ofxKinectCalibration::getSensorEmitterDistance() const {
+	return sensorEmitterDistance;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectCalibration::getSensorCameraDistance() const {
+	return sensorCameraDistance;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectCalibration::getZeroPlanePixelSize() const {
+	return zeroPlanePixelSize;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectCalibration::getZeroPlaneDistance() const {
+	return zeroPlaneDistance;
+}
+
+//--------------------------------------------------------------------
+glm::vec3 ofxKinectCalibration::getWorldCoordinateAt(int x, int y, float z) const {
+	int i = y * width + x;
+	return glm::vec3(raysX[i] * z, raysY[i] * z, z);
+}
+
+//--------------------------------------------------------------------
+int ofxKinectCalibration::getVideoIndexAt(int x, int y, unsigned short z) const {
+	int i = y * width + x;
+	if(!hasRegistration()) {
+		return i;
+	}
+	if(z == 0 || z >= maxDepth) {
+		return -1;
+	}
+	int videoX = (registrationX[i] + depthToVideoShift[z]) / OFX_KINECT_REG_X_SCALE;
+	if(videoX < 0 || videoX >= width) {
+		return -1;
+	}
+	int videoIndex = registrationY[i] * width + videoX - registrationOffset;
+	if(videoIndex < 0 || videoIndex >= width * height) {
+		return -1;
+	}
+	return videoIndex;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::getPointCloud(const ofShortPixels & depth, vector<glm::vec3> & points, int step, bool skipInvalid) const {
+	if(depth.getWidth() != width || depth.getHeight() != height || depth.getNumChannels() != 1) {
+		ofLogError("ofxKinectCalibration") << "getPointCloud(): depth image has to be " << width << "x" << height << " with 1 channel";
+		points.clear();
+		return;
+	}
+	step = max(step, 1);
+	size_t cols = (width + step - 1) / step;
+	size_t rows = (height + step - 1) / step;
+	points.resize(cols * rows);
+
+	const unsigned short * depthData = depth.getData();
+	ofParallelForRange(0, rows, [&](size_t firstRow, size_t lastRow) {
+		for(size_t row = firstRow; row < lastRow; row++) {
+			size_t offset = row * step * width;
+			const unsigned short * depthRow = depthData + offset;
+			const float * rayXRow = raysX.data() + offset;
+			const float * rayYRow = raysY.data() + offset;
+			glm::vec3 * pointsRow = points.data() + row * cols;
+			// no branches so the compiler can vectorize it
+			for(size_t col = 0; col < cols; col++) {
+				float z = depthRow[col * step];
+				pointsRow[col].x = rayXRow[col * step] * z;
+				pointsRow[col].y = rayYRow[col * step] * z;
+				pointsRow[col].z = z;
+			}
+		}
+	}, OFX_KINECT_ROWS_GRAIN);
+
+	if(skipInvalid) {
+		points.erase(std::remove_if(points.begin(), points.end(), [](const glm::vec3 & p) {
+			return p.z == 0;
+		}), points.end());
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::getPointCloud(const ofShortPixels & depth, const ofPixels & video, ofMesh & mesh, int step, bool mapToVideo) const {
+	mesh.clear();
+	mesh.setMode(OF_PRIMITIVE_POINTS);
+	vector<glm::vec3> points;
+	getPointCloud(depth, points, step, false);
+	if(points.empty()) {
+		return;
+	}
+	bool bColors = video.getWidth() == width && video.getHeight() >= height;
+	if(!bColors && video.isAllocated()) {
+		ofLogWarning("ofxKinectCalibration") << "getPointCloud(): video image has to be " << width << "x" << height << ", ignoring colors";
+	}
+	step = max(step, 1);
+	size_t cols = (width + step - 1) / step;
+	size_t rows = (height + step - 1) / step;
+
+	// video pixel of every point, -1 to leave it out
+	vector<int> videoIndices(points.size());
+	const unsigned short * depthData = depth.getData();
+	ofParallelForRange(0, rows, [&](size_t firstRow, size_t lastRow) {
+		for(size_t row = firstRow; row < lastRow; row++) {
+			int y = row * step;
+			for(size_t col = 0; col < cols; col++) {
+				int x = col * step;
+				unsigned short z = depthData[y * width + x];
+				int & index = videoIndices[row * cols + col];
+				if(z == 0) {
+					index = -1;
+				} else if(!bColors) {
+					index = 0;
+				} else {
+					index = mapToVideo ? getVideoIndexAt(x, y, z) : y * width + x;
+				}
+			}
+		}
+	}, OFX_KINECT_ROWS_GRAIN);
+
+	auto & vertices = mesh.getVertices();
+	auto & colors = mesh.getColors();
+	vertices.reserve(points.size());
+	if(bColors) {
+		colors.reserve(points.size());
+	}
+	const unsigned char * videoData = video.getData();
+	size_t channels = video.getNumChannels();
+	for(size_t i = 0; i < points.size(); i++) {
+		int index = videoIndices[i];
+		if(index < 0) {
+			continue;
+		}
+		vertices.push_back(points[i]);
+		if(bColors) {
+			const unsigned char * pixel = videoData + index * channels;
+			colors.push_back(ofColor(pixel[0], pixel[(channels - 1) / 2], pixel[channels - 1]));
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::updateDepthLookupTable(vector<unsigned char> & lookup,
+	float nearClip, float farClip, bool bNearWhite) {
+	unsigned char nearColor = bNearWhite ? 255 : 0;
+	unsigned char farColor = bNearWhite ? 0 : 255;
+	lookup.resize(maxDepth + 1);
+	lookup[0] = 0;
+	for(int i = 1; i <= maxDepth; i++) {
+		lookup[i] = ofMap(i, nearClip, farClip, nearColor, farColor, true);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::updateDepthPixels(const ofShortPixels & raw, const vector<unsigned char> & lookup,
+	ofFloatPixels & distance, ofPixels & gray) {
+	if(lookup.empty() || distance.size() != raw.size() || gray.size() != raw.size()) {
+		ofLogError("ofxKinectCalibration") << "updateDepthPixels(): images with different sizes or no lookup table";
+		return;
+	}
+	const unsigned short * rawData = raw.getData();
+	float * distanceData = distance.getData();
+	unsigned char * grayData = gray.getData();
+	const unsigned char * lookupData = lookup.data();
+	size_t maxLookup = lookup.size() - 1;
+	// blocks of rows in parallel, with the float conversion in a loop of its
+	// own so the compiler can vectorize it
+	ofParallelForRange(0, raw.size(), [&](size_t begin, size_t end) {
+		for(size_t i = begin; i < end; i++) {
+			distanceData[i] = rawData[i];
+		}
+		for(size_t i = begin; i < end; i++) {
+			grayData[i] = lookupData[std::min<size_t>(rawData[i], maxLookup)];
+		}
+	}, raw.getWidth() * OFX_KINECT_ROWS_GRAIN);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectCalibration::updateRays() {
+	// the zero plane pixel size is for the 1280x1024 sensor and the 640x480
+	// image is that cropped to 1280x960 and scaled by .5, see
+	// freenect_camera_to_world()
+	float factor = 2 * zeroPlanePixelSize / zeroPlaneDistance;
+	raysX.resize(width * height);
+	raysY.resize(width * height);
+	for(int y = 0; y < height; y++) {
+		for(int x = 0; x < width; x++) {
+			raysX[y * width + x] = (x - width / 2) * factor;
+			raysY[y * width + x] = (y - height / 2) * factor;
+		}
+	}
+}
@@ -0,0 +1,140 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+struct freenect_registration;
+
+/// \class ofxKinectCalibration
+///
+/// the intrinsic parameters of a kinect with the tables to convert whole
+/// depth frames into point clouds and find the color of each depth point
+///
+/// the conversion uses a precomputed ray for every depth pixel, so a point
+/// is only a couple of multiplications, and is done in parallel for blocks of
+/// rows with ofGetTaskPool()
+///
+class ofxKinectCalibration {
+
+public:
+
+	/// starts with the usual parameters of a kinect, without registration
+	ofxKinectCalibration();
+
+	/// copy the parameters and registration tables of a device
+	void setup(const freenect_registration & registration);
+
+	/// set the parameters without registration tables
+	///
+	/// the color of a depth point is then the one at the same position
+	/// in the video image
+	void setup(float zeroPlanePixelSize, float zeroPlaneDistance,
+		float sensorEmitterDistance, float sensorCameraDistance);
+
+	/// are there tables to map depth points to the video image?
+	bool hasRegistration() const;
+
+/// \section Intrinsic IR Sensor Parameters
+
+	float getSensorEmitterDistance() const; ///< in cm
+	float getSensorCameraDistance() const;  ///< in cm
+	float getZeroPlanePixelSize() const;    ///< in mm
+	float getZeroPlaneDistance() const;     ///< in mm
+
+/// \section Conversion
+
+	/// calculates the coordinate in the world for a depth point in mm
+	///
+	/// center of image is (0.0), same as ofxKinect::getWorldCoordinateAt()
+	glm::vec3 getWorldCoordinateAt(int x, int y, float z) const;
+
+	/// get the index of the pixel in the video image that sees a depth point
+	/// at distance z in mm, -1 if it falls outside of the image
+	int getVideoIndexAt(int x, int y, unsigned short z) const;
+
+	/// fill points with the world coordinates of the depth image in mm
+	///
+	/// step takes one every step pixels in both directions to downsample the
+	/// cloud, skipInvalid leaves out the pixels without depth, otherwise the
+	/// points keep the layout of the image, row by row
+	void getPointCloud(const ofShortPixels & depth, std::vector<glm::vec3> & points,
+		int step=1, bool skipInvalid=true) const;
+
+	/// fill a mesh of points with the world coordinates of the depth image
+	/// and their color in the video image, leaving out pixels without depth
+	///
+	/// set mapToVideo to false when the depth image is already registered
+	/// to the video image, see ofxKinect::setRegistration()
+	void getPointCloud(const ofShortPixels & depth, const ofPixels & video, ofMesh & mesh,
+		int step=1, bool mapToVideo=true) const;
+
+/// \section Depth Images
+
+	/// fill lookup with the gray level of every depth up to maxDepth in mm,
+	/// the depths outside of nearClip - farClip are clamped and 0 is black
+	///
+	/// see ofxKinect::setDepthClipping() and
+	/// ofxKinect::enableDepthNearValueWhite()
+	static void updateDepthLookupTable(std::vector<unsigned char> & lookup,
+		float nearClip, float farClip, bool bNearWhite);
+
+	/// convert raw depth in mm to distance and gray pixels with a lookup
+	/// table from updateDepthLookupTable(), in parallel for blocks of rows
+	///
+	/// the three images have to be allocated with the same size
+	static void updateDepthPixels(const ofShortPixels & raw, const std::vector<unsigned char> & lookup,
+		ofFloatPixels & distance, ofPixels & gray);
+
+	/// kinect image size
+	const static int width = 640;
+	const static int height = 480;
+
+	/// the depth values of the registration table go up to 10m
+	const static int maxDepth = 10000;
+
+protected:
+
+	friend class ofxKinectRecorder;
+	friend class ofxKinectPlayer;
+
+	void updateRays();
+
+	float sensorEmitterDistance;
+	float sensorCameraDistance;
+	float zeroPlanePixelSize;
+	float zeroPlaneDistance;
+
+	/// world x and y per mm of depth for every pixel
+	std::vector<float> raysX;
+	std::vector<float> raysY;
+
+	/// libfreenect's depth -> rgb mapping: the position of every pixel in
+	/// the video image in 1/256th pixels for x plus a horizontal shift that
+	/// depends on the depth, empty if there's no registration
+	std::vector<int32_t> registrationX;
+	std::vector<int32_t> registrationY;
+	std::vector<int32_t> depthToVideoShift;
+	int registrationOffset;
+};
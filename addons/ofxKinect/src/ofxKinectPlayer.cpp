@@ -0,0 +1,363 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectPlayer.h"
+#include "ofxKinectRecorder.h"
+
+//--------------------------------------------------------------------
+template<typename T>
+static bool readValue(ofFile & file, T & value) {
+	file.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return file.good();
+}
+
+//--------------------------------------------------------------------
+template<typename T>
+static bool readValues(ofFile & file, vector<T> & values, size_t size) {
+	values.resize(size);
+	file.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+	return file.good();
+}
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::ofxKinectPlayer() {
+	framesStart = 0;
+	frameSize = 0;
+	numFrames = 0;
+	currentFrame = -1;
+	timestamp = 0;
+	bMapToVideo = true;
+	videoChannels = 0;
+	bUseTexture = true;
+	bNearWhite = true;
+	bLoop = true;
+	bIsFrameNew = false;
+	setDepthClipping();
+}
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::~ofxKinectPlayer() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::load(const string & path, bool texture) {
+	close();
+	if(!file.open(path, ofFile::ReadOnly, true)) {
+		ofLogError("ofxKinectPlayer") << "load(): couldn't open \"" << path << "\"";
+		return false;
+	}
+
+	string magic(strlen(ofxKinectRecorder::magic), '\0');
+	file.read(&magic[0], magic.size());
+	int32_t version, width, height, channels, mapToVideo, hasRegistration;
+	float pixelSize, distance, emitterDistance, cameraDistance;
+	bool bValid = file.good() && magic == ofxKinectRecorder::magic
+		&& readValue(file, version) && version == ofxKinectRecorder::version
+		&& readValue(file, width) && width == ofxKinectCalibration::width
+		&& readValue(file, height) && height == ofxKinectCalibration::height
+		&& readValue(file, channels) && (channels == 0 || channels == 1 || channels == 3)
+		&& readValue(file, mapToVideo)
+		&& readValue(file, pixelSize) && readValue(file, distance)
+		&& readValue(file, emitterDistance) && readValue(file, cameraDistance)
+		&& readValue(file, hasRegistration);
+	if(bValid) {
+		calibration.setup(pixelSize, distance, emitterDistance, cameraDistance);
+		if(hasRegistration) {
+			size_t n = width * height;
+			bValid = readValue(file, calibration.registrationOffset)
+				&& readValues(file, calibration.registrationX, n)
+				&& readValues(file, calibration.registrationY, n)
+				&& readValues(file, calibration.depthToVideoShift, ofxKinectCalibration::maxDepth);
+		}
+	}
+	if(!bValid) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << path << "\" is not an ofxKinectRecorder recording";
+		close();
+		return false;
+	}
+
+	videoChannels = channels;
+	bMapToVideo = mapToVideo;
+	framesStart = file.tellg();
+	frameSize = sizeof(uint64_t) + width * height * (sizeof(unsigned short) + videoChannels);
+	numFrames = (file.getSize() - framesStart) / frameSize;
+	currentFrame = -1;
+	timestamp = 0;
+	bIsFrameNew = false;
+
+	depthPixelsRaw.allocate(width, height, 1);
+	depthPixels.allocate(width, height, 1);
+	distancePixels.allocate(width, height, 1);
+	depthPixelsRaw.set(0);
+	depthPixels.set(0);
+	distancePixels.set(0);
+	// without video the point clouds have no colors instead of black ones
+	if(videoChannels > 0) {
+		videoPixels.allocate(width, height, videoChannels);
+		videoPixels.set(0);
+	} else {
+		videoPixels.clear();
+	}
+
+	bUseTexture = texture;
+	if(bUseTexture) {
+		depthTex.allocate(depthPixels);
+		if(videoPixels.isAllocated()) {
+			videoTex.allocate(videoPixels);
+		} else {
+			videoTex.clear();
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::close() {
+	if(file.is_open()) {
+		file.close();
+	}
+	numFrames = 0;
+	currentFrame = -1;
+	bIsFrameNew = false;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isInitialized() const {
+	return file.is_open();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::update() {
+	bIsFrameNew = false;
+	if(!isInitialized() || numFrames == 0) {
+		return;
+	}
+	int frame = currentFrame + 1;
+	if(frame >= numFrames) {
+		if(!bLoop) {
+			return;
+		}
+		frame = 0;
+	}
+	setFrame(frame);
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isFrameNew() const {
+	return bIsFrameNew;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::setPixelFormat(ofPixelFormat pixelFormat) {
+	return pixelFormat == getPixelFormat();
+}
+
+//--------------------------------------------------------------------
+ofPixelFormat ofxKinectPlayer::getPixelFormat() const {
+	return videoChannels == 1 ? OF_PIXELS_GRAY : OF_PIXELS_RGB;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setLoop(bool bLoop) {
+	this->bLoop = bLoop;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isLoop() const {
+	return bLoop;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectPlayer::getNumFrames() const {
+	return numFrames;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectPlayer::getCurrentFrame() const {
+	return currentFrame;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::setFrame(int frame) {
+	if(!isInitialized()) {
+		ofLogError("ofxKinectPlayer") << "setFrame(): no recording loaded";
+		return false;
+	}
+	if(frame < 0 || frame >= numFrames) {
+		ofLogError("ofxKinectPlayer") << "setFrame(): frame " << frame << " out of range 0-" << numFrames - 1;
+		return false;
+	}
+	file.clear();
+	file.seekg(framesStart + std::streamoff(frame) * frameSize);
+	if(!readFrame()) {
+		ofLogError("ofxKinectPlayer") << "setFrame(): couldn't read frame " << frame;
+		return false;
+	}
+	currentFrame = frame;
+	bIsFrameNew = true;
+
+	updateDepthPixels();
+	if(bUseTexture) {
+		depthTex.loadData(depthPixels);
+		if(videoPixels.isAllocated()) {
+			videoTex.loadData(videoPixels);
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+uint64_t ofxKinectPlayer::getTimestamp() const {
+	return timestamp;
+}
+
+//--------------------------------------------------------------------
+const ofxKinectCalibration & ofxKinectPlayer::getCalibration() const {
+	return calibration;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::getPointCloud(vector<glm::vec3> & points, int step, bool skipInvalid) const {
+	calibration.getPointCloud(depthPixelsRaw, points, step, skipInvalid);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::getPointCloud(ofMesh & mesh, int step) const {
+	calibration.getPointCloud(depthPixelsRaw, videoPixels, mesh, step, bMapToVideo);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setDepthClipping(float nearClip, float farClip) {
+	nearClipping = nearClip;
+	farClipping = farClip;
+	updateDepthLookupTable();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::enableDepthNearValueWhite(bool bEnabled) {
+	bNearWhite = bEnabled;
+	updateDepthLookupTable();
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getPixels() {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getPixels() const {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getDepthPixels() {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getDepthPixels() const {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+ofShortPixels & ofxKinectPlayer::getRawDepthPixels() {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+const ofShortPixels & ofxKinectPlayer::getRawDepthPixels() const {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+ofFloatPixels & ofxKinectPlayer::getDistancePixels() {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+const ofFloatPixels & ofxKinectPlayer::getDistancePixels() const {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getTexture() {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getTexture() const {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getDepthTexture() {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getDepthTexture() const {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::draw(float x, float y, float w, float h) const {
+	if(bUseTexture && videoTex.isAllocated()) {
+		videoTex.draw(x, y, w, h);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::drawDepth(float x, float y, float w, float h) const {
+	if(bUseTexture) {
+		depthTex.draw(x, y, w, h);
+	}
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::readFrame() {
+	size_t n = depthPixelsRaw.getWidth() * depthPixelsRaw.getHeight();
+	if(!readValue(file, timestamp)) {
+		return false;
+	}
+	file.read(reinterpret_cast<char*>(depthPixelsRaw.getData()), n * sizeof(unsigned short));
+	if(videoChannels > 0) {
+		file.read(reinterpret_cast<char*>(videoPixels.getData()), n * videoChannels);
+	}
+	return file.good();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::updateDepthPixels() {
+	ofxKinectCalibration::updateDepthPixels(depthPixelsRaw, depthLookupTable, distancePixels, depthPixels);
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::updateDepthLookupTable() {
+	ofxKinectCalibration::updateDepthLookupTable(depthLookupTable, nearClipping, farClipping, bNearWhite);
+	if(isInitialized()) {
+		updateDepthPixels();
+	}
+}
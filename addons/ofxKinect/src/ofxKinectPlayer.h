@@ -0,0 +1,150 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+#include "ofxBase3DVideo.h"
+#include "ofxKinectCalibration.h"
+
+/// \class ofxKinectPlayer
+///
+/// plays back the raw depth and video frames recorded with
+/// ofxKinectRecorder, with the same images and point clouds as ofxKinect,
+/// to test or benchmark an app without a kinect
+///
+/// every call to update() loads the next frame, so a recording always
+/// gives the same frames in the same order, see getTimestamp() to pace it
+///
+class ofxKinectPlayer : public ofxBase3DVideo {
+
+public:
+
+	ofxKinectPlayer();
+	virtual ~ofxKinectPlayer();
+
+/// \section Main
+
+	/// open a recording and load its first frame
+	///
+	/// set texture to false if you don't need to use the internal textures
+	bool load(const string & path, bool texture=true);
+
+	/// close the recording
+	void close();
+
+	/// is a recording open?
+	bool isInitialized() const;
+
+	/// load the next frame, starting again after the last one if looping
+	void update();
+
+	/// is the current frame new?
+	bool isFrameNew() const;
+
+	bool setPixelFormat(ofPixelFormat pixelFormat);
+	ofPixelFormat getPixelFormat() const;
+
+/// \section Playback
+
+	/// start again after the last frame, enabled by default
+	void setLoop(bool bLoop);
+	bool isLoop() const;
+
+	int getNumFrames() const;
+	int getCurrentFrame() const;
+
+	/// load a frame now
+	bool setFrame(int frame);
+
+	/// milliseconds since the start of the recording of the current frame
+	uint64_t getTimestamp() const;
+
+/// \section Depth Data
+
+	/// the calibration of the kinect that was recorded
+	const ofxKinectCalibration & getCalibration() const;
+
+	/// see ofxKinect::getPointCloud()
+	void getPointCloud(vector<glm::vec3> & points, int step=1, bool skipInvalid=true) const;
+	void getPointCloud(ofMesh & mesh, int step=1) const;
+
+	/// see ofxKinect::setDepthClipping(), default is 50cm - 4m
+	void setDepthClipping(float nearClip=500, float farClip=4000);
+	void enableDepthNearValueWhite(bool bEnabled=true);
+
+/// \section Pixel Data
+
+	/// the video pixels, not allocated if the recording only has depth
+	ofPixels & getPixels();
+	const ofPixels & getPixels() const;
+
+	ofPixels & getDepthPixels();
+	const ofPixels & getDepthPixels() const;
+	ofShortPixels & getRawDepthPixels();
+	const ofShortPixels & getRawDepthPixels() const;
+	ofFloatPixels & getDistancePixels();
+	const ofFloatPixels & getDistancePixels() const;
+
+	ofTexture & getTexture();
+	const ofTexture & getTexture() const;
+	ofTexture & getDepthTexture();
+	const ofTexture & getDepthTexture() const;
+
+/// \section Draw
+
+	void draw(float x, float y, float w, float h) const;
+	void drawDepth(float x, float y, float w, float h) const;
+
+private:
+
+	bool readFrame();
+	void updateDepthPixels();
+	void updateDepthLookupTable();
+
+	ofFile file;
+	std::streamoff framesStart;
+	size_t frameSize;
+	int numFrames;
+	int currentFrame;
+	uint64_t timestamp;
+
+	ofxKinectCalibration calibration;
+	bool bMapToVideo;
+	int videoChannels;
+
+	ofPixels videoPixels;
+	ofPixels depthPixels;
+	ofShortPixels depthPixelsRaw;
+	ofFloatPixels distancePixels;
+
+	bool bUseTexture;
+	ofTexture depthTex;
+	ofTexture videoTex;
+
+	vector<unsigned char> depthLookupTable;
+	float nearClipping, farClipping;
+	bool bNearWhite;
+	bool bLoop;
+	bool bIsFrameNew;
+};
@@ -0,0 +1,138 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectRecorder.h"
+
+const char * ofxKinectRecorder::magic = "OFXKINECT";
+const int ofxKinectRecorder::version;
+
+//--------------------------------------------------------------------
+template<typename T>
+static void writeValue(ofFile & file, T value) {
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//--------------------------------------------------------------------
+template<typename T>
+static void writeValues(ofFile & file, const vector<T> & values) {
+	file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::ofxKinectRecorder() {
+	videoChannels = 0;
+	numFrames = 0;
+	startTime = 0;
+}
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::~ofxKinectRecorder() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::open(const string & path, const ofxKinectCalibration & calibration, int videoChannels, bool mapToVideo) {
+	close();
+	if(videoChannels != 0 && videoChannels != 1 && videoChannels != 3) {
+		ofLogError("ofxKinectRecorder") << "open(): video has to have 0, 1 or 3 channels, not " << videoChannels;
+		return false;
+	}
+	if(!file.open(path, ofFile::WriteOnly, true)) {
+		ofLogError("ofxKinectRecorder") << "open(): couldn't open \"" << path << "\"";
+		return false;
+	}
+	this->videoChannels = videoChannels;
+	numFrames = 0;
+	startTime = ofGetElapsedTimeMillis();
+
+	file.write(magic, strlen(magic));
+	writeValue<int32_t>(file, version);
+	writeValue<int32_t>(file, ofxKinectCalibration::width);
+	writeValue<int32_t>(file, ofxKinectCalibration::height);
+	writeValue<int32_t>(file, videoChannels);
+	writeValue<int32_t>(file, mapToVideo);
+	writeValue<float>(file, calibration.zeroPlanePixelSize);
+	writeValue<float>(file, calibration.zeroPlaneDistance);
+	writeValue<float>(file, calibration.sensorEmitterDistance);
+	writeValue<float>(file, calibration.sensorCameraDistance);
+	writeValue<int32_t>(file, calibration.hasRegistration());
+	if(calibration.hasRegistration()) {
+		writeValue<int32_t>(file, calibration.registrationOffset);
+		writeValues(file, calibration.registrationX);
+		writeValues(file, calibration.registrationY);
+		writeValues(file, calibration.depthToVideoShift);
+	}
+	if(!file.good()) {
+		ofLogError("ofxKinectRecorder") << "open(): couldn't write \"" << path << "\"";
+		close();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::close() {
+	if(file.is_open()) {
+		file.close();
+	}
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::isOpen() const {
+	return file.is_open();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::addFrame(const ofShortPixels & depth, const ofPixels & video) {
+	if(!isOpen()) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): not recording, call open() first";
+		return false;
+	}
+	size_t width = ofxKinectCalibration::width;
+	size_t height = ofxKinectCalibration::height;
+	if(depth.getWidth() != width || depth.getHeight() != height || depth.getNumChannels() != 1) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): depth has to be " << width << "x" << height << " with 1 channel";
+		return false;
+	}
+	// the infrared image is 488 lines high until ofxKinect crops it
+	if(videoChannels > 0 && (video.getWidth() != width || video.getHeight() < height || int(video.getNumChannels()) != videoChannels)) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): video has to be " << width << "x" << height << " with " << videoChannels << " channels";
+		return false;
+	}
+	writeValue<uint64_t>(file, ofGetElapsedTimeMillis() - startTime);
+	file.write(reinterpret_cast<const char*>(depth.getData()), width * height * sizeof(unsigned short));
+	if(videoChannels > 0) {
+		file.write(reinterpret_cast<const char*>(video.getData()), width * height * videoChannels);
+	}
+	if(!file.good()) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): couldn't write frame " << numFrames;
+		return false;
+	}
+	numFrames++;
+	return true;
+}
+
+//--------------------------------------------------------------------
+int ofxKinectRecorder::getNumFrames() const {
+	return numFrames;
+}
@@ -0,0 +1,85 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+#include "ofxKinectCalibration.h"
+
+/// \class ofxKinectRecorder
+///
+/// records raw depth and video frames to a file that ofxKinectPlayer can
+/// play back, to test or benchmark an app without a kinect
+///
+/// the file starts with the calibration and then has every frame
+/// uncompressed, a millisecond timestamp followed by the 16 bit depth in mm
+/// and the video pixels, in the byte order of the machine that recorded it
+///
+/// usage:
+///
+///     recorder.open("take.kinect", kinect.getCalibration(), kinect.getPixels().getNumChannels());
+///     ...
+///     kinect.update();
+///     if(kinect.isFrameNew()) {
+///         recorder.addFrame(kinect.getRawDepthPixels(), kinect.getPixels());
+///     }
+///
+class ofxKinectRecorder {
+
+public:
+
+	ofxKinectRecorder();
+	~ofxKinectRecorder();
+
+	/// start a new recording, overwriting the file
+	///
+	/// videoChannels is 3 for rgb, 1 for infrared or 0 to record only depth
+	///
+	/// set mapToVideo to false if the depth frames are already registered to
+	/// the video or the video is infrared, so the player doesn't map the
+	/// colors again, see ofxKinectCalibration::getPointCloud()
+	bool open(const string & path, const ofxKinectCalibration & calibration,
+		int videoChannels=3, bool mapToVideo=true);
+
+	/// finish the recording
+	void close();
+
+	bool isOpen() const;
+
+	/// append a frame, the video is ignored if recording only depth
+	bool addFrame(const ofShortPixels & depth, const ofPixels & video);
+
+	/// number of frames added since open()
+	int getNumFrames() const;
+
+	/// identifies the file format
+	static const char * magic;
+	static const int version = 1;
+
+private:
+
+	ofFile file;
+	int videoChannels;
+	int numFrames;
+	uint64_t startTime;
+};
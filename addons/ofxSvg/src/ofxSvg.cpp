@@ -1,5 +1,7 @@
 #include "ofxSvg.h"
 #include "ofConstants.h"
+#include "ofGraphics.h"
+#include "ofTaskPool.h"
 
 using namespace std;
 
@@ -18,11 +20,18 @@ void ofxSVG::load(string path){
 		return;
 	}
 
-	ofBuffer buffer = ofBufferFromFile(path);
-	size_t size = buffer.size();
+	// read straight into a buffer with a terminating zero that can be passed
+	// to the parser as is, instead of copying the text again
+	ofFile file(path, ofFile::ReadOnly, true);
+	size_t size = file.exists() ? file.getSize() : 0;
+	ofBuffer buffer;
+	buffer.allocate(size + 1);
+	file.read(buffer.getData(), size);
+	size = file.gcount();
+	buffer.getData()[size] = 0;
 
 	struct svgtiny_diagram * diagram = svgtiny_create();
-	svgtiny_code code = svgtiny_parse(diagram, buffer.getText().c_str(), size, path.c_str(), 0, 0);
+	svgtiny_code code = svgtiny_parse(diagram, buffer.getData(), size, path.c_str(), 0, 0);
 
 	if(code != svgtiny_OK){
 		string msg;
@@ -61,6 +70,25 @@ void ofxSVG::draw(){
 	}
 }
 
+void ofxSVG::setMergeOnLoad(bool merge){
+	bMergeOnLoad = merge;
+}
+
+bool ofxSVG::isMergeOnLoad() const{
+	return bMergeOnLoad;
+}
+
+void ofxSVG::drawMerged(){
+	ofPushStyle();
+	for(auto & merged: mergedMeshes){
+		if(merged.strokeWidth > 0){
+			ofSetLineWidth(merged.strokeWidth);
+		}
+		merged.mesh.draw();
+	}
+	ofPopStyle();
+}
+
 
 void ofxSVG::setupDiagram(struct svgtiny_diagram * diagram){
 
@@ -68,15 +96,91 @@ void ofxSVG::setupDiagram(struct svgtiny_diagram * diagram){
 	height = diagram->height;
 
 	paths.clear();
+	mergedMeshes.clear();
 
+	std::vector<int> shapes;
 	for(int i = 0; i < (int)diagram->shape_count; i++){
 		if(diagram->shape[i].path){
-			paths.push_back(ofPath());
-			setupShape(&diagram->shape[i],paths.back());
+			shapes.push_back(i);
 		}else if(diagram->shape[i].text){
 			ofLogWarning("ofxSVG") << "setupDiagram(): text: not implemented yet";
 		}
 	}
+
+	// every shape only modifies its own path
+	paths.resize(shapes.size());
+	ofParallelFor(0, shapes.size(), [&](size_t i){
+		setupShape(&diagram->shape[shapes[i]], paths[i]);
+	}, 64);
+
+	if(bMergeOnLoad){
+		mergePaths();
+	}
+}
+
+void ofxSVG::mergePaths(){
+	// tessellating is the slow part, every path uses the tessellator of its
+	// thread
+	ofParallelFor(0, paths.size(), [&](size_t i){
+		if(paths[i].isFilled()){
+			paths[i].getTessellation();
+		}
+		if(paths[i].hasOutline()){
+			paths[i].getOutline();
+		}
+	}, 16);
+
+	// a new mesh is started when the indices of the current one are full
+	auto getMesh = [&](float strokeWidth, size_t numVertices) -> ofMesh &{
+		for(auto it = mergedMeshes.rbegin(); it != mergedMeshes.rend(); ++it){
+			if(it->strokeWidth == strokeWidth){
+				if(it->mesh.getNumVertices() + numVertices <= std::numeric_limits<ofIndexType>::max()){
+					return it->mesh;
+				}
+				break;
+			}
+		}
+		mergedMeshes.emplace_back();
+		mergedMeshes.back().strokeWidth = strokeWidth;
+		mergedMeshes.back().mesh.setMode(strokeWidth > 0 ? OF_PRIMITIVE_LINES : OF_PRIMITIVE_TRIANGLES);
+		return mergedMeshes.back().mesh;
+	};
+
+	for(auto & path: paths){
+		if(!path.isFilled()){
+			continue;
+		}
+		const ofMesh & tessellation = path.getTessellation();
+		ofMesh & mesh = getMesh(0, tessellation.getNumVertices());
+		ofIndexType offset = mesh.getNumVertices();
+		mesh.addVertices(tessellation.getVertices());
+		mesh.getColors().resize(mesh.getNumVertices(), path.getFillColor());
+		for(auto index: tessellation.getIndices()){
+			mesh.addIndex(offset + index);
+		}
+	}
+
+	// the outlines after all the fills so every stroke width is a mesh
+	for(auto & path: paths){
+		if(!path.hasOutline()){
+			continue;
+		}
+		for(auto & outline: path.getOutline()){
+			size_t numVertices = outline.size();
+			if(numVertices < 2){
+				continue;
+			}
+			ofMesh & mesh = getMesh(path.getStrokeWidth(), numVertices);
+			ofIndexType offset = mesh.getNumVertices();
+			mesh.addVertices(outline.getVertices());
+			mesh.getColors().resize(mesh.getNumVertices(), path.getStrokeColor());
+			size_t numLines = outline.isClosed() ? numVertices : numVertices - 1;
+			for(size_t i = 0; i < numLines; i++){
+				mesh.addIndex(offset + i);
+				mesh.addIndex(offset + (i + 1) % numVertices);
+			}
+		}
+	}
 }
 
 void ofxSVG::setupShape(struct svgtiny_shape * shape, ofPath & path){
@@ -3,6 +3,7 @@
 //#include "ofMain.h"
 #include "ofPath.h"
 #include "ofTypes.h"
+#include "ofVboMesh.h"
 
 class ofxSVG {
 	public: ~ofxSVG();
@@ -17,6 +18,25 @@ class ofxSVG {
 		void load(std::string path);
 		void draw();
 
+		/// \brief Tessellate all the shapes while loading and merge them
+		/// into a few meshes to draw static svgs faster, disabled by default.
+		///
+		/// The shapes are tessellated in parallel with ofGetTaskPool(). The
+		/// fills of all of them go into one mesh with their colors in the
+		/// vertices and the outlines into one mesh of lines for every stroke
+		/// width, so drawMerged() needs a few draw calls instead of several
+		/// per shape. It applies to the next load().
+		void setMergeOnLoad(bool merge);
+		bool isMergeOnLoad() const;
+
+		/// \brief Draw the meshes merged while loading.
+		///
+		/// All the fills are drawn before all the outlines, so it only looks
+		/// different from draw() where the fill of a shape covers the outline
+		/// of a previous one. Changes to the paths after loading are not
+		/// drawn.
+		void drawMerged();
+
 		int getNumPath(){
 			return paths.size();
 		}
@@ -32,7 +52,16 @@ class ofxSVG {
 
 		std::vector <ofPath> paths;
 
+		struct MergedMesh{
+			ofVboMesh mesh;
+			// 0 for fills
+			float strokeWidth;
+		};
+		bool bMergeOnLoad = false;
+		std::vector <MergedMesh> mergedMeshes;
+
 		void setupDiagram(struct svgtiny_diagram * diagram);
 		void setupShape(struct svgtiny_shape * shape, ofPath & path);
+		void mergePaths();
 
 };
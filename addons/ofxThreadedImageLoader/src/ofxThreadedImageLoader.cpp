@@ -1,7 +1,16 @@
 #include "ofxThreadedImageLoader.h"
 #include <sstream>
+#include <cstring>
+// images being copied to the pixel buffers at the same time when
+// streaming, as many as the buffers of the upload
+static const int streamingBuffers = 3;
+
 ofxThreadedImageLoader::ofxThreadedImageLoader(){
 	nextID = 0;
+#ifndef TARGET_OPENGLES
+	streaming = false;
+	buffersInUse = 0;
+#endif
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
     
@@ -12,6 +21,10 @@ ofxThreadedImageLoader::ofxThreadedImageLoader(){
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
 	images_to_load_from_disk.close();
 	images_to_update.close();
+#ifndef TARGET_OPENGLES
+	images_to_copy.close();
+	images_to_upload.close();
+#endif
 	waitForThread(true);
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
@@ -49,6 +62,21 @@ void ofxThreadedImageLoader::threadedFunction() {
 	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
 	ofImageLoaderEntry entry;
 	while( images_to_load_from_disk.receive(entry) ) {
+#ifndef TARGET_OPENGLES
+		// the main thread mapped pixel buffers for images already loaded,
+		// they're copied before loading anything else so the buffers don't
+		// wait behind the disk
+		ofImageLoaderEntry mapped;
+		while(images_to_copy.tryReceive(mapped)) {
+			const ofPixels & pixels = mapped.image->getPixels();
+			memcpy(mapped.mapped, pixels.getData(), pixels.getTotalBytes());
+			images_to_upload.send(mapped);
+		}
+#endif
+		// an empty entry only wakes up the thread to copy
+		if(!entry.image) {
+			continue;
+		}
 		if(entry.image->load(entry.filename) )  {
 			images_to_update.send(entry);
 		}else{
@@ -88,11 +116,60 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 // Check the update queue and update the texture
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
 	ofImageLoaderEntry entry;
+#ifndef TARGET_OPENGLES
+	bool uploaded = false;
+	while(images_to_upload.tryReceive(entry)){
+		entry.image->setUseTexture(true);
+		upload.end(entry.buffer, entry.image->getTexture());
+		buffersInUse--;
+		uploaded = true;
+	}
+	if(streaming){
+		// map a buffer for every loaded image and send it back to the
+		// loader thread to copy the pixels, they're uploaded once it's done
+		while(buffersInUse < streamingBuffers && images_to_update.tryReceive(entry)){
+			ofPixels mapped;
+			const ofPixels & pixels = entry.image->getPixels();
+			entry.buffer = upload.begin(mapped, pixels.getWidth(), pixels.getHeight(), pixels.getPixelFormat());
+			if(entry.buffer < 0){
+				entry.image->setUseTexture(true);
+				entry.image->update();
+				continue;
+			}
+			entry.mapped = mapped.getData();
+			buffersInUse++;
+			images_to_copy.send(entry);
+			images_to_load_from_disk.send(ofImageLoaderEntry());
+		}
+		return;
+	}
+	if(uploaded && buffersInUse == 0){
+		// streaming was disabled while the loader thread was copying
+		upload.clear();
+	}
+#endif
+    // Load 1 image per update so we don't block the gl thread for too long
 	if (images_to_update.tryReceive(entry)) {
 		entry.image->setUseTexture(true);
 		entry.image->update();
 	}
 }
 
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setUseTextureStreaming(bool useStreaming){
+#ifndef TARGET_OPENGLES
+	streaming = useStreaming;
+	if(buffersInUse > 0){
+		// the loader thread is still writing to the buffers, update()
+		// keeps or clears them once it's done
+		return;
+	}
+	if(streaming){
+		upload.setup(streamingBuffers);
+	}else{
+		upload.clear();
+	}
+#endif
+}
+
@@ -5,6 +5,7 @@
 #include "ofURLFileLoader.h"
 #include "ofTypes.h" 
 #include "ofThreadChannel.h"
+#include "ofPixelsUpload.h"
 
 
 using namespace std;
@@ -17,6 +18,13 @@ public:
 	void loadFromDisk(ofImage& image, string file);
 	void loadFromURL(ofImage& image, string url);
 
+	/// Upload the loaded images through a ring of pixel buffers, so
+	/// several images can be sent to the GPU every frame without waiting
+	/// for the copies. The loader thread writes the pixels to the mapped
+	/// buffers and update() only starts the transfers. Does nothing with
+	/// OpenGL ES.
+	void setUseTextureStreaming(bool useStreaming);
+
 
 
 private:
@@ -28,15 +36,22 @@ private:
     struct ofImageLoaderEntry {
         ofImageLoaderEntry() {
             image = NULL;
+            buffer = -1;
+            mapped = NULL;
         }
         
         ofImageLoaderEntry(ofImage & pImage) {
             image = &pImage;
+            buffer = -1;
+            mapped = NULL;
         }
         ofImage* image;
         string filename;
         string url;
         string name;
+        // pixel buffer mapped for the image when streaming
+        int buffer;
+        unsigned char* mapped;
     };
 
 
@@ -48,6 +63,13 @@ private:
 	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
 	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
 	ofThreadChannel<ofImageLoaderEntry> images_to_update;
+#ifndef TARGET_OPENGLES
+	ofThreadChannel<ofImageLoaderEntry> images_to_copy; // mapped, copied before any other load
+	ofThreadChannel<ofImageLoaderEntry> images_to_upload; // copied to their pixel buffers
+	bool                streaming;
+	int                 buffersInUse;
+	ofPixelsUpload      upload;
+#endif
 };
 
 
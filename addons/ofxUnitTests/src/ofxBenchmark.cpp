@@ -0,0 +1,29 @@
+#include "ofxBenchmark.h"
+#include <atomic>
+
+namespace{
+	std::atomic<uint64_t> allocations(0);
+	std::atomic<uint64_t> allocatedBytes(0);
+}
+
+//--------------------------------------------------------------
+void ofxBenchmarkCountAllocation(std::size_t size){
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+bool ofxBenchmarkIsCountingAllocations(){
+	// any application allocates something before running the benchmarks
+	return allocations.load(std::memory_order_relaxed) > 0;
+}
+
+//--------------------------------------------------------------
+uint64_t ofxBenchmarkGetAllocations(){
+	return allocations.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+uint64_t ofxBenchmarkGetAllocatedBytes(){
+	return allocatedBytes.load(std::memory_order_relaxed);
+}
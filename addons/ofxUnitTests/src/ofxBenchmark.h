@@ -0,0 +1,310 @@
+#pragma once
+
+// before ofxUnitTests.h, whose test macro breaks the json library
+#include "ofJson.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+/// \returns The number of allocations with operator new made by any thread
+/// since the application started, always 0 unless the application includes
+/// ofxBenchmarkAllocations.h.
+uint64_t ofxBenchmarkGetAllocations();
+
+/// \returns The number of bytes allocated with operator new by any thread
+/// since the application started, without subtracting the freed ones.
+uint64_t ofxBenchmarkGetAllocatedBytes();
+
+/// \returns true if the application includes ofxBenchmarkAllocations.h.
+bool ofxBenchmarkIsCountingAllocations();
+
+/// \brief Used by the allocation functions in ofxBenchmarkAllocations.h.
+void ofxBenchmarkCountAllocation(std::size_t size);
+
+/// \brief Make the compiler believe value is used so the code that computes
+/// it isn't optimized away.
+template<typename T>
+inline void ofxBenchmarkKeep(const T & value){
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const void * volatile sink;
+	sink = &value;
+#endif
+}
+
+struct ofxBenchmarkOptions{
+	/// \brief Repetitions run and discarded before measuring, to fill the
+	/// caches and let the processor speed up.
+	std::size_t warmup = 2;
+
+	/// \brief Measured repetitions, the statistics are calculated over them.
+	std::size_t repetitions = 10;
+
+	/// \brief Calls to the function in every repetition, 0 calculates them
+	/// so every repetition lasts at least minTime.
+	std::size_t iterations = 0;
+
+	/// \brief Minimum duration of a repetition in seconds when the
+	/// iterations are calculated.
+	double minTime = 0.01;
+};
+
+/// \brief Statistics of a benchmark, times are in nanoseconds per call.
+struct ofxBenchmarkResult{
+	std::string name;
+	std::size_t repetitions = 0;
+	std::size_t iterations = 0;
+	double min = 0;
+	double median = 0;
+	double mean = 0;
+	double stddev = 0;
+	double max = 0;
+	/// \brief Allocations per call.
+	double allocations = 0;
+	/// \brief Bytes allocated per call.
+	double allocatedBytes = 0;
+};
+
+/// \brief Base class for applications that measure the performance of some
+/// code and check it didn't get slower.
+///
+/// Implement runBenchmarks() calling benchmark() for every piece of code to
+/// measure:
+///
+/// ~~~~{.cpp}
+/// class ofApp: public ofxBenchmarkApp{
+/// 	void runBenchmarks(){
+/// 		ofPixels pixels;
+/// 		pixels.allocate(1920, 1080, OF_PIXELS_RGB);
+/// 		benchmark("pixels mirror", [&]{
+/// 			pixels.mirror(true, false);
+/// 		});
+/// 	}
+/// };
+/// ~~~~
+///
+/// Every benchmark runs some warm up repetitions and then measures the time
+/// and the allocations of several more, each calling the function as many
+/// times as needed to last a minimum time. The results are logged and saved
+/// as JSON, by default to benchmark_results.json in the data folder.
+///
+/// Allocations are only counted if one source file of the application,
+/// usually main.cpp, includes ofxBenchmarkAllocations.h, which replaces the
+/// global operator new.
+///
+/// If there's a baseline, by default benchmark_baseline.json in the data
+/// folder, every benchmark is compared with it and a warning is logged when
+/// its median time is slower than the baseline by more than the tolerance
+/// or when it allocates more. Timings are noisy so by default that's only a
+/// report, with OFX_BENCHMARK_FAIL_ON_REGRESSION=1 regressions also fail as
+/// tests so the application exits with an error like the unit tests. A
+/// baseline is a results file from a previous run in the same computer.
+///
+/// Benchmarks should be built in release mode, the CI scripts don't run
+/// them.
+///
+/// These environment variables change the defaults:
+/// - OFX_BENCHMARK_OUTPUT: path of the results.
+/// - OFX_BENCHMARK_BASELINE: path of the baseline.
+/// - OFX_BENCHMARK_SAVE_BASELINE: if 1 the results are also saved as the
+///   new baseline instead of comparing with it.
+/// - OFX_BENCHMARK_TOLERANCE: allowed slowdown, 0.2 allows 20% slower.
+/// - OFX_BENCHMARK_FAIL_ON_REGRESSION: if 1 regressions fail as tests.
+/// - OFX_BENCHMARK_FILTER: only run benchmarks with this in their name.
+class ofxBenchmarkApp: public ofxUnitTestsApp{
+protected:
+	virtual void runBenchmarks() = 0;
+
+	/// \brief Measure the time it takes to call function.
+	///
+	/// Setup that shouldn't be measured has to be done before calling this.
+	/// Use ofxBenchmarkKeep() with results that are not used otherwise.
+	template<typename Function>
+	ofxBenchmarkResult benchmark(const std::string & name, Function function, const ofxBenchmarkOptions & options = ofxBenchmarkOptions()){
+		ofxBenchmarkResult result;
+		result.name = name;
+		if(!filter.empty() && name.find(filter) == std::string::npos){
+			return result;
+		}
+
+		result.iterations = options.iterations;
+		if(result.iterations == 0){
+			result.iterations = calibrate(function, options.minTime);
+		}
+		for(std::size_t i = 0; i < options.warmup; i++){
+			timeIterations(function, result.iterations);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(std::max<std::size_t>(options.repetitions, 1));
+		auto allocations = ofxBenchmarkGetAllocations();
+		auto allocatedBytes = ofxBenchmarkGetAllocatedBytes();
+		for(std::size_t i = 0; i < samples.capacity(); i++){
+			samples.push_back(timeIterations(function, result.iterations) / result.iterations);
+		}
+		auto calls = double(samples.size() * result.iterations);
+		result.allocations = (ofxBenchmarkGetAllocations() - allocations) / calls;
+		result.allocatedBytes = (ofxBenchmarkGetAllocatedBytes() - allocatedBytes) / calls;
+
+		result.repetitions = samples.size();
+		std::sort(samples.begin(), samples.end());
+		result.min = samples.front();
+		result.max = samples.back();
+		auto middle = samples.size() / 2;
+		result.median = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+		for(auto sample: samples){
+			result.mean += sample;
+		}
+		result.mean /= samples.size();
+		for(auto sample: samples){
+			result.stddev += (sample - result.mean) * (sample - result.mean);
+		}
+		result.stddev = sqrt(result.stddev / samples.size());
+
+		ofLogNotice() << name << ": " << formatTime(result.median)
+					  << " (min " << formatTime(result.min)
+					  << ", max " << formatTime(result.max)
+					  << ", stddev " << formatTime(result.stddev)
+					  << ", " << ofToString(result.allocations, 1) << " allocations)";
+		results.push_back(result);
+		return result;
+	}
+
+private:
+	void run(){
+		auto output = ofGetEnv("OFX_BENCHMARK_OUTPUT");
+		if(output.empty()){
+			output = ofToDataPath("benchmark_results.json");
+		}
+		auto baselinePath = ofGetEnv("OFX_BENCHMARK_BASELINE");
+		if(baselinePath.empty()){
+			baselinePath = ofToDataPath("benchmark_baseline.json");
+		}
+		auto tolerance = ofGetEnv("OFX_BENCHMARK_TOLERANCE");
+		if(!tolerance.empty()){
+			maxSlowdown = ofToDouble(tolerance);
+		}
+		filter = ofGetEnv("OFX_BENCHMARK_FILTER");
+		failOnRegression = ofGetEnv("OFX_BENCHMARK_FAIL_ON_REGRESSION") == "1";
+		if(!ofxBenchmarkIsCountingAllocations()){
+			ofLogNotice() << "allocations are not counted, include ofxBenchmarkAllocations.h in main.cpp to count them";
+		}
+
+		runBenchmarks();
+
+		auto json = toJson();
+		ofSavePrettyJson(output, json);
+		ofLogNotice() << "results saved to " << output;
+
+		if(ofGetEnv("OFX_BENCHMARK_SAVE_BASELINE") == "1"){
+			ofSavePrettyJson(baselinePath, json);
+			ofLogNotice() << "baseline saved to " << baselinePath;
+		}else if(ofFile::doesFileExist(baselinePath)){
+			compare(ofLoadJson(baselinePath));
+		}else{
+			ofLogNotice() << "no baseline in " << baselinePath << ", set OFX_BENCHMARK_SAVE_BASELINE=1 to save one";
+		}
+	}
+
+	template<typename Function>
+	double timeIterations(Function & function, std::size_t iterations){
+		auto start = std::chrono::steady_clock::now();
+		for(std::size_t i = 0; i < iterations; i++){
+			function();
+		}
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	template<typename Function>
+	std::size_t calibrate(Function & function, double minTime){
+		const double minNanos = minTime * 1e9;
+		std::size_t iterations = 1;
+		while(iterations < (1u << 30)){
+			auto nanos = timeIterations(function, iterations);
+			if(nanos >= minNanos){
+				break;
+			}
+			// aim a bit over the minimum but never grow more than 10x at once
+			auto estimate = nanos > 0 ? minNanos / nanos * iterations * 1.2 : iterations * 10.0;
+			iterations = std::max(iterations + 1, std::min<std::size_t>(estimate, iterations * 10));
+		}
+		return iterations;
+	}
+
+	std::string formatTime(double nanos) const{
+		if(nanos < 1e3){
+			return ofToString(nanos, 1) + "ns";
+		}else if(nanos < 1e6){
+			return ofToString(nanos / 1e3, 2) + "us";
+		}else if(nanos < 1e9){
+			return ofToString(nanos / 1e6, 2) + "ms";
+		}else{
+			return ofToString(nanos / 1e9, 2) + "s";
+		}
+	}
+
+	ofJson toJson() const{
+		ofJson benchmarks = ofJson::array();
+		for(auto & result: results){
+			benchmarks.push_back({
+				{"name", result.name},
+				{"repetitions", result.repetitions},
+				{"iterations", result.iterations},
+				{"min", result.min},
+				{"median", result.median},
+				{"mean", result.mean},
+				{"stddev", result.stddev},
+				{"max", result.max},
+				{"allocations", result.allocations},
+				{"allocatedBytes", result.allocatedBytes},
+			});
+		}
+		return {
+			{"timestamp", ofGetTimestampString("%Y-%m-%dT%H:%M:%S")},
+			{"unit", "ns"},
+			{"benchmarks", benchmarks},
+		};
+	}
+
+	void compare(const ofJson & baseline){
+		if(!baseline.count("benchmarks")){
+			ofLogError() << "the baseline has no benchmarks";
+			test(false, "baseline");
+			return;
+		}
+		for(auto & result: results){
+			auto previous = std::find_if(baseline["benchmarks"].begin(), baseline["benchmarks"].end(), [&](const ofJson & benchmark){
+				return benchmark.value("name", "") == result.name;
+			});
+			if(previous == baseline["benchmarks"].end()){
+				ofLogNotice() << result.name << " is not in the baseline";
+				continue;
+			}
+			double previousMedian = previous->value("median", 0.0);
+			double previousAllocations = previous->value("allocations", 0.0);
+			double change = previousMedian > 0 ? result.median / previousMedian - 1 : 0;
+			ofLogNotice() << result.name << ": " << ofToString(change * 100, 1) << "% compared to the baseline";
+			if(change >= maxSlowdown){
+				ofLogWarning() << result.name << " is slower than the baseline by more than " << ofToString(maxSlowdown * 100, 1) << "%";
+			}
+			// allocations are deterministic, up to rounding of the average
+			bool moreAllocations = ofxBenchmarkIsCountingAllocations() && result.allocations >= previousAllocations + 0.01;
+			if(moreAllocations){
+				ofLogWarning() << result.name << " allocates more than the baseline: " << result.allocations << " vs " << previousAllocations;
+			}
+			if(failOnRegression){
+				test_lt(change, maxSlowdown, result.name + " time");
+				test(!moreAllocations, result.name + " allocations");
+			}
+		}
+	}
+
+	std::vector<ofxBenchmarkResult> results;
+	std::string filter;
+	double maxSlowdown = 0.2;
+	bool failOnRegression = false;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+// Replaces the global allocation functions to count every allocation in the
+// application, including the ones in the core and in other libraries that
+// use operator new. Include it in exactly one source file of a benchmark
+// application, usually main.cpp. Applications that don't include it report
+// no allocations.
+
+#include "ofxBenchmark.h"
+#include <cstdlib>
+#include <new>
+#ifdef TARGET_WIN32
+#include <malloc.h>
+#endif
+
+namespace{
+	void * ofxBenchmarkAllocate(std::size_t size){
+		ofxBenchmarkCountAllocation(size);
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void * ofxBenchmarkAllocateOrThrow(std::size_t size){
+		while(true){
+			void * memory = ofxBenchmarkAllocate(size);
+			if(memory){
+				return memory;
+			}
+			auto handler = std::get_new_handler();
+			if(!handler){
+				throw std::bad_alloc();
+			}
+			handler();
+		}
+	}
+
+#ifdef __cpp_aligned_new
+	void * ofxBenchmarkAllocateAligned(std::size_t size, std::align_val_t alignment){
+		ofxBenchmarkCountAllocation(size);
+		if(size == 0){
+			size = 1;
+		}
+	#ifdef TARGET_WIN32
+		return _aligned_malloc(size, static_cast<std::size_t>(alignment));
+	#else
+		void * memory = nullptr;
+		auto align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+		return posix_memalign(&memory, align, size) == 0 ? memory : nullptr;
+	#endif
+	}
+
+	void * ofxBenchmarkAllocateAlignedOrThrow(std::size_t size, std::align_val_t alignment){
+		while(true){
+			void * memory = ofxBenchmarkAllocateAligned(size, alignment);
+			if(memory){
+				return memory;
+			}
+			auto handler = std::get_new_handler();
+			if(!handler){
+				throw std::bad_alloc();
+			}
+			handler();
+		}
+	}
+
+	void ofxBenchmarkFreeAligned(void * memory){
+	#ifdef TARGET_WIN32
+		_aligned_free(memory);
+	#else
+		std::free(memory);
+	#endif
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void * operator new(std::size_t size){
+	return ofxBenchmarkAllocateOrThrow(size);
+}
+
+void * operator new[](std::size_t size){
+	return ofxBenchmarkAllocateOrThrow(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept{
+	return ofxBenchmarkAllocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept{
+	return ofxBenchmarkAllocate(size);
+}
+
+void operator delete(void * memory) noexcept{
+	std::free(memory);
+}
+
+void operator delete[](void * memory) noexcept{
+	std::free(memory);
+}
+
+void operator delete(void * memory, const std::nothrow_t &) noexcept{
+	std::free(memory);
+}
+
+void operator delete[](void * memory, const std::nothrow_t &) noexcept{
+	std::free(memory);
+}
+
+void operator delete(void * memory, std::size_t) noexcept{
+	std::free(memory);
+}
+
+void operator delete[](void * memory, std::size_t) noexcept{
+	std::free(memory);
+}
+
+#ifdef __cpp_aligned_new
+//--------------------------------------------------------------
+void * operator new(std::size_t size, std::align_val_t alignment){
+	return ofxBenchmarkAllocateAlignedOrThrow(size, alignment);
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment){
+	return ofxBenchmarkAllocateAlignedOrThrow(size, alignment);
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept{
+	return ofxBenchmarkAllocateAligned(size, alignment);
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept{
+	return ofxBenchmarkAllocateAligned(size, alignment);
+}
+
+void operator delete(void * memory, std::align_val_t) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+
+void operator delete[](void * memory, std::align_val_t) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+
+void operator delete(void * memory, std::align_val_t, const std::nothrow_t &) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+
+void operator delete[](void * memory, std::align_val_t, const std::nothrow_t &) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+
+void operator delete(void * memory, std::size_t, std::align_val_t) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+
+void operator delete[](void * memory, std::size_t, std::align_val_t) noexcept{
+	ofxBenchmarkFreeAligned(memory);
+}
+#endif
@@ -8,11 +8,70 @@
 
 #include "of3dPrimitives.h"
 #include "ofGraphics.h"
+#include <mutex>
+#include <tuple>
 
 using namespace std;
 
+namespace{
+	enum ofCachedPrimitiveType{
+		OF_CACHED_PRIMITIVE_PLANE,
+		OF_CACHED_PRIMITIVE_SPHERE,
+		OF_CACHED_PRIMITIVE_ICO_SPHERE,
+		OF_CACHED_PRIMITIVE_CYLINDER,
+		OF_CACHED_PRIMITIVE_CONE,
+		OF_CACHED_PRIMITIVE_BOX,
+	};
+
+	// process wide cache of the meshes generated by the primitives, keyed by
+	// type, parameters and vbo usage. It only holds weak references so the
+	// meshes are released once the last primitive using them is gone.
+	struct ofPrimitiveMeshCache{
+		typedef std::tuple<int, std::vector<float>, bool> Key;
+		std::mutex mutex;
+		std::map<Key, std::weak_ptr<ofMesh>> meshes;
+		std::size_t sweepThreshold = 64;
+
+		shared_ptr<ofMesh> get(int primitiveType, const std::vector<float> & params, bool useVbo, const std::function<ofMesh()> & generate){
+			Key key(primitiveType, params, useVbo);
+			std::unique_lock<std::mutex> lock(mutex);
+			auto & cached = meshes[key];
+			auto mesh = cached.lock();
+			if(!mesh){
+				if(useVbo){
+					mesh = std::make_shared<ofVboMesh>(generate());
+				}else{
+					mesh = std::make_shared<ofMesh>(generate());
+				}
+				cached = mesh;
+
+				// animating a parameter creates a new key per frame,
+				// drop the expired ones once in a while
+				if(meshes.size() >= sweepThreshold){
+					for(auto it = meshes.begin(); it != meshes.end();){
+						if(it->second.expired()){
+							it = meshes.erase(it);
+						}else{
+							++it;
+						}
+					}
+					sweepThreshold = std::max<std::size_t>(64, meshes.size() * 2);
+				}
+			}
+			return mesh;
+		}
+	};
+
+	ofPrimitiveMeshCache & getPrimitiveMeshCache(){
+		static ofPrimitiveMeshCache * cache = new ofPrimitiveMeshCache;
+		return *cache;
+	}
+}
+
 of3dPrimitive::of3dPrimitive()
 :usingVbo(true)
+,meshShared(false)
+,meshExposed(false)
 ,mesh(new ofVboMesh)
 {
     setScale(1.0, 1.0, 1.0);
@@ -27,17 +86,25 @@ of3dPrimitive::~of3dPrimitive() {
 of3dPrimitive::of3dPrimitive(const of3dPrimitive & mom):ofNode(mom){
     texCoords = mom.texCoords;
     usingVbo = mom.usingVbo;
-	if(usingVbo){
-		mesh = std::make_shared<ofVboMesh>();
+    meshShared = mom.meshShared;
+    meshExposed = false;
+	if(meshShared){
+		mesh = mom.mesh;
 	}else{
-		mesh = std::make_shared<ofMesh>();
+		if(usingVbo){
+			mesh = std::make_shared<ofVboMesh>();
+		}else{
+			mesh = std::make_shared<ofMesh>();
+		}
+		*mesh = *mom.mesh;
 	}
-	*mesh = *mom.mesh;
 }
 
 //----------------------------------------------------------
 of3dPrimitive::of3dPrimitive(const ofMesh & mesh)
 :usingVbo(true)
+,meshShared(false)
+,meshExposed(false)
 ,mesh(new ofVboMesh(mesh)){
 
 }
@@ -47,8 +114,25 @@ of3dPrimitive & of3dPrimitive::operator=(const of3dPrimitive & mom){
 	if(&mom!=this){
 		(*(ofNode*)this)=mom;
 		texCoords = mom.texCoords;
-		setUseVbo(mom.usingVbo);
-		*mesh = *mom.mesh;
+		if(mom.meshShared && !meshExposed){
+			usingVbo = mom.usingVbo;
+			meshShared = true;
+			mesh = mom.mesh;
+		}else{
+			if(meshShared){
+				// never write into a shared mesh
+				if(mom.usingVbo){
+					mesh = std::make_shared<ofVboMesh>();
+				}else{
+					mesh = std::make_shared<ofMesh>();
+				}
+				usingVbo = mom.usingVbo;
+				meshShared = false;
+			}else{
+				setUseVbo(mom.usingVbo);
+			}
+			*mesh = *mom.mesh;
+		}
 	}
     return *this;
 }
@@ -56,11 +140,15 @@ of3dPrimitive & of3dPrimitive::operator=(const of3dPrimitive & mom){
 // GETTERS //
 //----------------------------------------------------------
 ofMesh* of3dPrimitive::getMeshPtr() {
+    unshareMesh();
+    meshExposed = true;
     return mesh.get();
 }
 
 //----------------------------------------------------------
 ofMesh& of3dPrimitive::getMesh() {
+    unshareMesh();
+    meshExposed = true;
     return *mesh;
 }
 
@@ -114,27 +202,45 @@ bool of3dPrimitive::hasNormalsEnabled() const {
 
 //----------------------------------------------------------
 void of3dPrimitive::enableNormals() {
-    getMesh().enableNormals();
+    if(!mesh->usingNormals()){
+        unshareMesh();
+        mesh->enableNormals();
+    }
 }
 //----------------------------------------------------------
 void of3dPrimitive::enableTextures() {
-    getMesh().enableTextures();
+    if(!mesh->usingTextures()){
+        unshareMesh();
+        mesh->enableTextures();
+    }
 }
 //----------------------------------------------------------
 void of3dPrimitive::enableColors() {
-    getMesh().enableColors();
+    if(!mesh->usingColors()){
+        unshareMesh();
+        mesh->enableColors();
+    }
 }
 //----------------------------------------------------------
 void of3dPrimitive::disableNormals() {
-    getMesh().disableNormals();
+    if(mesh->usingNormals()){
+        unshareMesh();
+        mesh->disableNormals();
+    }
 }
 //----------------------------------------------------------
 void of3dPrimitive::disableTextures() {
-    getMesh().disableTextures();
+    if(mesh->usingTextures()){
+        unshareMesh();
+        mesh->disableTextures();
+    }
 }
 //----------------------------------------------------------
 void of3dPrimitive::disableColors() {
-    getMesh().disableColors();
+    if(mesh->usingColors()){
+        unshareMesh();
+        mesh->disableColors();
+    }
 }
 
 
@@ -146,13 +252,14 @@ void of3dPrimitive::disableColors() {
 void of3dPrimitive::mapTexCoords( float u1, float v1, float u2, float v2 ) {
     //setTexCoords( u1, v1, u2, v2 );
 	auto prevTcoord = getTexCoords();
+    unshareMesh();
     
-	for(std::size_t j = 0; j < getMesh().getNumTexCoords(); j++ ) {
-		auto tcoord = getMesh().getTexCoord(j);
+	for(std::size_t j = 0; j < mesh->getNumTexCoords(); j++ ) {
+		auto tcoord = mesh->getTexCoord(j);
         tcoord.x = ofMap(tcoord.x, prevTcoord.x, prevTcoord.z, u1, u2);
         tcoord.y = ofMap(tcoord.y, prevTcoord.y, prevTcoord.w, v1, v2);
         
-        getMesh().setTexCoord(j, tcoord);
+        mesh->setTexCoord(j, tcoord);
     }
     
 	texCoords = {u1, v1, u2, v2};
@@ -182,7 +289,45 @@ void of3dPrimitive::normalizeAndApplySavedTexCoords() {
     // when a new mesh is created, it uses normalized tex coords, we need to reset them
     // but save the ones used previously //
 	texCoords = {0.f, 0.f, 1.f, 1.f};
-    mapTexCoords(tcoords.x, tcoords.y, tcoords.z, tcoords.w);
+    // remapping to the normalized coords is a no-op, skipping it allows
+    // to keep using a shared mesh
+    if(tcoords != texCoords){
+        mapTexCoords(tcoords.x, tcoords.y, tcoords.z, tcoords.w);
+    }
+}
+
+//----------------------------------------------------------
+void of3dPrimitive::setSharedMesh(int primitiveType, const vector<float> & params, const std::function<ofMesh()> & generate){
+	auto cached = getPrimitiveMeshCache().get(primitiveType, params, usingVbo, generate);
+	if(meshExposed){
+		// the user holds a reference to our mesh, keep it valid and
+		// up to date by copying the new geometry into it
+		*mesh = *cached;
+		meshShared = false;
+	}else{
+		mesh = cached;
+		meshShared = true;
+	}
+}
+
+//----------------------------------------------------------
+void of3dPrimitive::unshareMesh(){
+	if(meshShared){
+		shared_ptr<ofMesh> newMesh;
+		if(usingVbo){
+			newMesh = std::make_shared<ofVboMesh>();
+		}else{
+			newMesh = std::make_shared<ofMesh>();
+		}
+		*newMesh = *mesh;
+		mesh = newMesh;
+		meshShared = false;
+	}
+}
+
+//----------------------------------------------------------
+bool of3dPrimitive::isMeshShared() const{
+	return meshShared;
 }
 
 
@@ -276,6 +421,7 @@ void of3dPrimitive::setUseVbo(bool useVbo){
 		}
 		*newMesh = *mesh;
 		mesh = newMesh;
+		meshShared = false;
 	}
 	usingVbo = useVbo;
 }
@@ -308,7 +454,9 @@ void ofPlanePrimitive::set(float _width, float _height, int columns, int rows, o
     height = _height;
 	resolution = { columns, rows };
     
-    getMesh() = ofMesh::plane( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
+    setSharedMesh(OF_CACHED_PRIMITIVE_PLANE, {width, height, float(columns), float(rows), float(mode)}, [&]{
+        return ofMesh::plane( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
+    });
     
     normalizeAndApplySavedTexCoords();
     
@@ -351,14 +499,14 @@ void ofPlanePrimitive::setRows( int rows ) {
 //--------------------------------------------------------------
 void ofPlanePrimitive::setResolution( int columns, int rows ) {
 	resolution = { columns, rows };
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     
     set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
 }
 
 //--------------------------------------------------------------
 void ofPlanePrimitive::setMode(ofPrimitiveMode mode) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     
     if( mode != currMode )
         set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
@@ -418,7 +566,9 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
     radius     = _radius;
     resolution = res;
 
-    getMesh() = ofMesh::sphere( getRadius(), getResolution(), mode );
+    setSharedMesh(OF_CACHED_PRIMITIVE_SPHERE, {radius, float(resolution), float(mode)}, [&]{
+        return ofMesh::sphere( getRadius(), getResolution(), mode );
+    });
     
     normalizeAndApplySavedTexCoords();
 }
@@ -426,14 +576,14 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
 //----------------------------------------------------------
 void ofSpherePrimitive::setResolution( int res ) {
     resolution             = res;
-    ofPrimitiveMode mode   = getMesh().getMode();
+    ofPrimitiveMode mode   = mesh->getMode();
     
     set(getRadius(), getResolution(), mode );
 }
 
 //----------------------------------------------------------
 void ofSpherePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set(getRadius(), getResolution(), mode );
 }
@@ -486,7 +636,9 @@ void ofIcoSpherePrimitive::setResolution( int iterations ) {
     // store the number of iterations in the resolution //
     resolution = iterations;
     
-    getMesh() = ofMesh::icosphere( getRadius(), getResolution() );
+    setSharedMesh(OF_CACHED_PRIMITIVE_ICO_SPHERE, {radius, float(resolution)}, [&]{
+        return ofMesh::icosphere( getRadius(), getResolution() );
+    });
     normalizeAndApplySavedTexCoords();
 }
 
@@ -570,7 +722,9 @@ void ofCylinderPrimitive::set(float _radius, float _height, int radiusSegments,
     vertices[2][1] = (getResolution().x+1) * (getResolution().z+1);
     
     
-    getMesh() = ofMesh::cylinder( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
+    setSharedMesh(OF_CACHED_PRIMITIVE_CYLINDER, {getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, float(getCapped()), float(mode)}, [&]{
+        return ofMesh::cylinder( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
+    });
     
     normalizeAndApplySavedTexCoords();
     
@@ -618,39 +772,42 @@ void ofCylinderPrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setResolution( int radiusSegments, int heightSegments, int capSegments ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusSegments, heightSegments, capSegments, getCapped(), mode );
 }
 
 //----------------------------------------------------------
 void ofCylinderPrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
 }
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setTopCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setTopCapColor(): must be in triangle strip mode";
     }
-    getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
 }
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setCylinderColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMode(): must be in triangle strip mode";
     }
-    getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
 }
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setBottomCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setBottomCapColor(): must be in triangle strip mode";
     }
-    getMesh().setColorForIndices( strides[2][0], strides[2][0]+strides[2][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[2][0], strides[2][0]+strides[2][1], color );
 }
 
 //--------------------------------------------------------------
@@ -660,17 +817,17 @@ vector<ofIndexType> ofCylinderPrimitive::getTopCapIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getTopCapMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getTopCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[0][0], strides[0][0]+strides[0][1],
+    return mesh->getMeshForIndices( strides[0][0], strides[0][0]+strides[0][1],
                              vertices[0][0], vertices[0][0]+vertices[0][1] );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getCylinderIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -678,17 +835,17 @@ vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getCylinderMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[1][0], strides[1][0]+strides[1][1],
+    return mesh->getMeshForIndices( strides[1][0], strides[1][0]+strides[1][1],
                              vertices[1][0], vertices[1][0]+vertices[1][1] );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[2][0], strides[2][0] + strides[2][1] );
@@ -696,11 +853,11 @@ vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getBottomCapMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[2][0], strides[2][0]+strides[2][1],
+    return mesh->getMeshForIndices( strides[2][0], strides[2][0]+strides[2][1],
                              vertices[2][0], vertices[2][0]+vertices[2][1] );
 }
 
@@ -785,7 +942,9 @@ void ofConePrimitive::set( float _radius, float _height, int radiusSegments, int
     vertices[1][0] = vertices[0][0] + vertices[0][1];
     vertices[1][1] = (getResolution().x+1) * (getResolution().z+1);
     
-    getMesh() = ofMesh::cone( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
+    setSharedMesh(OF_CACHED_PRIMITIVE_CONE, {getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, float(mode)}, [&]{
+        return ofMesh::cone( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
+    });
     
     normalizeAndApplySavedTexCoords();
     
@@ -815,13 +974,13 @@ void ofConePrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setResolution( int radiusRes, int heightRes, int capRes ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusRes, heightRes, capRes, mode );
 }
 
 //----------------------------------------------------------
 void ofConePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
 }
@@ -840,23 +999,25 @@ void ofConePrimitive::setHeight(float _height) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setTopColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setTopColor(): must be in triangle strip mode";
     }
-    getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
 }
 
 //--------------------------------------------------------------
 void ofConePrimitive::setCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setCapColor(): must be in triangle strip mode";
     }
-    getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getConeIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices(strides[0][0], strides[0][0]+strides[0][1]);
@@ -869,16 +1030,16 @@ ofMesh ofConePrimitive::getConeMesh() const {
     
     int startVertIndex  = vertices[0][0];
     int endVertIndex    = startVertIndex + vertices[0][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getCapIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -891,11 +1052,11 @@ ofMesh ofConePrimitive::getCapMesh() const {
     
     int startVertIndex  = vertices[1][0];
     int endVertIndex    = startVertIndex + vertices[1][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
@@ -997,7 +1158,9 @@ void ofBoxPrimitive::set( float width, float height, float depth, int resWidth,
     vertices[SIDE_BOTTOM][0] = vertices[SIDE_TOP][0] + vertices[SIDE_TOP][1];
     vertices[SIDE_BOTTOM][1] = (resY+1) * (resZ+1);
     
-    getMesh() = ofMesh::box( getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z );
+    setSharedMesh(OF_CACHED_PRIMITIVE_BOX, {getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z}, [&]{
+        return ofMesh::box( getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z );
+    });
     
     normalizeAndApplySavedTexCoords();
 }
@@ -1060,7 +1223,7 @@ ofMesh ofBoxPrimitive::getSideMesh( int sideIndex ) const {
     int startVertIndex  = vertices[sideIndex][0];
     int endVertIndex    = startVertIndex + vertices[sideIndex][1];
     
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
@@ -1101,7 +1264,8 @@ void ofBoxPrimitive::setSideColor( int sideIndex, ofColor color ) {
         ofLogWarning("ofBoxPrimitive") << "setSideColor(): sideIndex out of bounds, setting SIDE_FRONT";
         sideIndex = SIDE_FRONT;
     }
-    getMesh().setColorForIndices( strides[sideIndex][0], strides[sideIndex][0]+strides[sideIndex][1], color );
+    unshareMesh();
+    mesh->setColorForIndices( strides[sideIndex][0], strides[sideIndex][0]+strides[sideIndex][1], color );
 }
 
 //--------------------------------------------------------------
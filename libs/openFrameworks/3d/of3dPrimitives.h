@@ -5,6 +5,7 @@
 #include "ofNode.h"
 #include "ofTexture.h"
 #include <map>
+#include <functional>
 
 /// \brief A class representing a 3d primitive.
 class of3dPrimitive : public ofNode {
@@ -24,9 +25,21 @@ public:
     void mapTexCoordsFromTexture( ofTexture& inTexture );
 
 
+    /// \brief Gives write access to the mesh of this primitive.
+    ///
+    /// Makes a private copy first if the mesh is shared. The returned
+    /// reference stays valid for the lifetime of the primitive: calling
+    /// set() or any other method that regenerates the geometry copies the
+    /// new mesh into the same object.
     ofMesh* getMeshPtr();
     ofMesh& getMesh();
 
+    /// \brief Gives read access to the mesh of this primitive.
+    ///
+    /// Doesn't unshare the mesh so the returned reference might point to
+    /// a mesh shared with other primitives. It's only valid until the
+    /// geometry of this primitive changes, for example by calling set(),
+    /// unless the non const getMesh() was called before.
     const ofMesh* getMeshPtr() const;
     const ofMesh& getMesh() const;
 
@@ -58,13 +71,34 @@ public:
 
     void setUseVbo(bool useVbo);
     bool isUsingVbo() const;
+
+    /// \brief Whether this primitive is using a mesh from the shared cache.
+    ///
+    /// The built in primitives share one immutable copy of their mesh with
+    /// every other primitive of the same type created with the same
+    /// parameters. Calling any non const method that gives access to the
+    /// mesh, like getMesh() or mapTexCoords(), makes a private copy first.
+    /// Once the non const getMesh() has been called the primitive keeps its
+    /// own mesh even if set() is called again.
+    bool isMeshShared() const;
 protected:
 
     // useful when creating a new model, since it uses normalized tex coords //
     void normalizeAndApplySavedTexCoords();
 
+    // uses the cached mesh for this primitive type and parameters, calling
+    // generate only if no live primitive is already sharing one
+    void setSharedMesh(int primitiveType, const std::vector<float> & params, const std::function<ofMesh()> & generate);
+
+    // makes a private copy of the mesh if it's shared, before modifying it
+    void unshareMesh();
+
 	glm::vec4 texCoords;
     bool usingVbo;
+    bool meshShared;
+    // set once the non const mesh accessors were called, from then on the
+    // mesh object is kept so references to it stay valid
+    bool meshExposed;
     std::shared_ptr<ofMesh>  mesh;
     mutable ofMesh normalsMesh;
 
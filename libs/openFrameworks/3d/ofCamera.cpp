@@ -1,8 +1,14 @@
 #include "ofCamera.h"
 #include "ofLog.h"
+#include "ofMesh.h"
+#include "ofPolyline.h"
+#include "ofTaskPool.h"
 
 using namespace std;
 
+// batches of points smaller than this are projected in the calling thread
+static const size_t minPointsPerTask = 1 << 14;
+
 //----------------------------------------
 ofCamera::ofCamera() :
 isOrtho(false),
@@ -209,6 +215,79 @@ glm::vec3 ofCamera::screenToWorld(glm::vec3 ScreenXYZ, ofRectangle viewport) con
 
 }
 
+//----------------------------------------
+void ofCamera::worldToScreen(const glm::vec3 * WorldXYZ, glm::vec3 * ScreenXYZ, std::size_t count, ofRectangle viewport) const {
+	viewport = getViewport(viewport);
+	auto mvp = getModelViewProjectionMatrix(viewport);
+
+	// fold the ndc to screen conversion in worldToScreen into two mads
+	float scaleX = viewport.width / 2.0f;
+	float offsetX = viewport.x + scaleX;
+	float scaleY = -viewport.height / 2.0f;
+	float offsetY = viewport.y - scaleY;
+
+	ofParallelForRange(0, count, [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			auto CameraXYZ4 = mvp * glm::vec4(WorldXYZ[i], 1.0);
+			float invW = 1.0f / CameraXYZ4.w;
+			ScreenXYZ[i].x = CameraXYZ4.x * invW * scaleX + offsetX;
+			ScreenXYZ[i].y = CameraXYZ4.y * invW * scaleY + offsetY;
+			ScreenXYZ[i].z = CameraXYZ4.z * invW;
+		}
+	}, minPointsPerTask);
+}
+
+//----------------------------------------
+vector<glm::vec3> ofCamera::worldToScreen(const vector<glm::vec3> & WorldXYZ, ofRectangle viewport) const {
+	vector<glm::vec3> ScreenXYZ(WorldXYZ.size());
+	worldToScreen(WorldXYZ.data(), ScreenXYZ.data(), WorldXYZ.size(), viewport);
+	return ScreenXYZ;
+}
+
+//----------------------------------------
+vector<glm::vec3> ofCamera::worldToScreen(const ofMesh & mesh, ofRectangle viewport) const {
+	vector<glm::vec3> ScreenXYZ(mesh.getNumVertices());
+	if(!ScreenXYZ.empty()){
+		worldToScreen(&toGlm(mesh.getVertices()[0]), ScreenXYZ.data(), ScreenXYZ.size(), viewport);
+	}
+	return ScreenXYZ;
+}
+
+//----------------------------------------
+vector<glm::vec3> ofCamera::worldToScreen(const ofPolyline & polyline, ofRectangle viewport) const {
+	vector<glm::vec3> ScreenXYZ(polyline.size());
+	if(!ScreenXYZ.empty()){
+		worldToScreen(&toGlm(polyline.getVertices()[0]), ScreenXYZ.data(), ScreenXYZ.size(), viewport);
+	}
+	return ScreenXYZ;
+}
+
+//----------------------------------------
+void ofCamera::screenToWorld(const glm::vec3 * ScreenXYZ, glm::vec3 * WorldXYZ, std::size_t count, ofRectangle viewport) const {
+	viewport = getViewport(viewport);
+	auto inverseCamera = glm::inverse(getModelViewProjectionMatrix(viewport));
+
+	float scaleX = 2.0f / viewport.width;
+	float offsetX = -2.0f * viewport.x / viewport.width - 1.0f;
+	float scaleY = -2.0f / viewport.height;
+	float offsetY = 2.0f * viewport.y / viewport.height + 1.0f;
+
+	ofParallelForRange(0, count, [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			glm::vec4 CameraXYZ(ScreenXYZ[i].x * scaleX + offsetX, ScreenXYZ[i].y * scaleY + offsetY, ScreenXYZ[i].z, 1.0);
+			auto world = inverseCamera * CameraXYZ;
+			WorldXYZ[i] = world.xyz() / world.w;
+		}
+	}, minPointsPerTask);
+}
+
+//----------------------------------------
+vector<glm::vec3> ofCamera::screenToWorld(const vector<glm::vec3> & ScreenXYZ, ofRectangle viewport) const {
+	vector<glm::vec3> WorldXYZ(ScreenXYZ.size());
+	screenToWorld(ScreenXYZ.data(), WorldXYZ.data(), ScreenXYZ.size(), viewport);
+	return WorldXYZ;
+}
+
 //----------------------------------------
 glm::vec3 ofCamera::worldToCamera(glm::vec3 WorldXYZ, ofRectangle viewport) const {
 	auto camera = getModelViewProjectionMatrix(getViewport(viewport)) * glm::vec4(WorldXYZ, 1.0);
@@ -2,6 +2,7 @@
 
 
 #include "ofRectangle.h"
+#include "ofBaseTypes.h"
 #include "ofGraphics.h"
 #include "ofNode.h"
 
@@ -197,6 +198,48 @@ public:
 	/// \param ScreenXYZ A point on your screen, whose 3D world coordinates you wish to know.
 	glm::vec3 screenToWorld(glm::vec3 ScreenXYZ, ofRectangle viewport = ofRectangle()) const;
 	
+	/// \brief Obtain the screen coordinates of many points in the 3D world.
+	///
+	/// Same as worldToScreen() for a single point but the viewport and the
+	/// model view projection matrix are only calculated once for the whole
+	/// batch, which is much faster when projecting thousands of points.
+	///
+	/// \param WorldXYZ Array of count points in the world.
+	/// \param ScreenXYZ Array of count points where the results are written.
+	/// It can be the same as WorldXYZ to project in place.
+	/// \param count Number of points to project.
+	/// \param viewport (Optional) A viewport. The default is ofGetCurrentViewport().
+	void worldToScreen(const glm::vec3 * WorldXYZ, glm::vec3 * ScreenXYZ, std::size_t count, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the screen coordinates of a vector of points in the 3D world.
+	/// \returns A vector with the screen coordinates of each point.
+	std::vector<glm::vec3> worldToScreen(const std::vector<glm::vec3> & WorldXYZ, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the screen coordinates of every vertex of a mesh.
+	/// \returns A vector with the screen coordinates of each vertex.
+	std::vector<glm::vec3> worldToScreen(const ofMesh & mesh, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the screen coordinates of every vertex of a polyline.
+	/// \returns A vector with the screen coordinates of each vertex.
+	std::vector<glm::vec3> worldToScreen(const ofPolyline & polyline, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the 3D world coordinates of many points on your screen.
+	///
+	/// Same as screenToWorld() for a single point but the inverse of the
+	/// model view projection matrix is only calculated once for the whole
+	/// batch.
+	///
+	/// \param ScreenXYZ Array of count points on the screen.
+	/// \param WorldXYZ Array of count points where the results are written.
+	/// It can be the same as ScreenXYZ to unproject in place.
+	/// \param count Number of points to unproject.
+	/// \param viewport (Optional) A viewport. The default is ofGetCurrentViewport().
+	void screenToWorld(const glm::vec3 * ScreenXYZ, glm::vec3 * WorldXYZ, std::size_t count, ofRectangle viewport = ofRectangle()) const;
+
+	/// \brief Obtain the 3D world coordinates of a vector of points on your screen.
+	/// \returns A vector with the world coordinates of each point.
+	std::vector<glm::vec3> screenToWorld(const std::vector<glm::vec3> & ScreenXYZ, ofRectangle viewport = ofRectangle()) const;
+
 	/// \todo worldToCamera()
 	glm::vec3 worldToCamera(glm::vec3 WorldXYZ, ofRectangle viewport = ofRectangle()) const;
 
@@ -10,6 +10,18 @@
 template<class V, class N, class C, class T>
 class ofMeshFace_;
 
+/// \brief How face normals are weighted when they are accumulated into
+/// smooth vertex normals by ofMesh_::smoothNormals().
+enum ofMeshNormalsWeighting{
+	/// \brief Every face contributes equally.
+	OF_MESH_NORMALS_UNWEIGHTED,
+	/// \brief Faces contribute proportionally to their area.
+	OF_MESH_NORMALS_AREA_WEIGHTED,
+	/// \brief Faces contribute proportionally to the angle they span at the vertex.
+	/// This is the least sensitive to how a surface is triangulated.
+	OF_MESH_NORMALS_ANGLE_WEIGHTED
+};
+
 template<typename T>
 struct ofArrayView{
 		const T * data;
@@ -352,10 +364,21 @@ public:
 	virtual void disableNormals();
 	virtual bool usingNormals() const;
 
-	void smoothNormals( float angle );
-        
-        /// \brief Duplicates vertices and updates normals to get a low-poly look.
-        void flatNormals();
+	/// \brief Calculates smooth normals for an OF_PRIMITIVE_TRIANGLES mesh.
+	///
+	/// Vertices closer than 0.01 units are treated as the same point, so
+	/// meshes with duplicated vertices along seams are smoothed across them.
+	/// Faces whose normals differ by more than \p angle degrees from the
+	/// face being shaded are not averaged in, which keeps hard edges sharp.
+	///
+	/// The mesh is rebuilt with 3 vertices per triangle, like setFromTriangles().
+	///
+	/// \param angle crease angle in degrees, 180 smooths across every edge.
+	/// \param weighting how each face normal contributes to the vertex normal.
+	void smoothNormals( float angle, ofMeshNormalsWeighting weighting = OF_MESH_NORMALS_UNWEIGHTED );
+
+	/// \brief Duplicates vertices and updates normals to get a low-poly look.
+	void flatNormals();
 
 	/// \}
 	/// \name Faces
@@ -659,6 +682,8 @@ public:
 
 private:
 
+	void setFromCornerNormals( const std::vector<glm::vec3> & cornerNormals );
+
 	std::vector<V> vertices;
 	std::vector<C> colors;
 	std::vector<N> normals;
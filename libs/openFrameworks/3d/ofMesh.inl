@@ -1,8 +1,10 @@
 #include "ofAppRunner.h"
 #include "ofBaseTypes.h"
 #include "ofMesh.h"
+#include "ofTaskPool.h"
 #include "ofVectorMath.h"
 #include <map>
+#include <limits>
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
@@ -1605,36 +1607,222 @@ const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() con
 
 
 //--------------------------------------------------------------
-template<class V, class N, class C, class T>
-std::vector<N> ofMesh_<V,N,C,T>::getFaceNormals( bool perVertex ) const{
-	// default for ofPrimitiveBase is vertex normals //
-	std::vector<N> faceNormals;
+namespace of{
+	namespace priv{
+
+		// Normal generation shared by ofMesh_::getFaceNormals, flatNormals
+		// and smoothNormals. Everything works on a flat list of triangle
+		// corners and runs in time linear to the number of triangles:
+		// coincident corners are found with a uniform hash grid instead of
+		// comparing every pair of vertices. The per face and per corner loops
+		// run in parallel for big meshes, welding is sequential.
+
+		// faces or corners computed in the same task, small meshes are
+		// processed in the calling thread
+		const std::size_t minNormalsPerTask = 1 << 12;
+
+		struct MeshWeldCell{
+			int64_t x, y, z;
+			bool operator==(const MeshWeldCell & other) const{
+				return x == other.x && y == other.y && z == other.z;
+			}
+		};
+
+		struct MeshWeldCellHash{
+			std::size_t operator()(const MeshWeldCell & c) const{
+				return std::size_t(uint64_t(c.x) * 73856093ULL ^ uint64_t(c.y) * 19349663ULL ^ uint64_t(c.z) * 83492791ULL);
+			}
+		};
+
+		// gathers the positions of every triangle corner, 3 per face
+		template<class V>
+		std::vector<glm::vec3> getTriangleCorners(const std::vector<V> & vertices, const std::vector<ofIndexType> & indices){
+			std::size_t numCorners = indices.empty() ? vertices.size() : indices.size();
+			numCorners -= numCorners % 3;
+			std::vector<glm::vec3> corners(numCorners);
+			for(std::size_t i = 0; i < numCorners; i++){
+				corners[i] = toGlm(vertices[indices.empty() ? i : indices[i]]);
+			}
+			return corners;
+		}
 
-	if( hasVertices() ) {
-		if(vertices.size() > 3 && indices.size() > 3) {
-			if(perVertex){
-				faceNormals.resize(indices.size()*3);
-			}else{
-				faceNormals.resize(indices.size());
+		inline glm::vec3 normalizeOrZero(const glm::vec3 & v){
+			float length2 = glm::dot(v, v);
+			return length2 > 0 ? v / std::sqrt(length2) : glm::vec3(0);
+		}
+
+		// (v1-v0)x(v2-v0), its length is twice the area of the triangle
+		inline glm::vec3 getTriangleCross(const glm::vec3 * triangle){
+			return glm::cross(triangle[1] - triangle[0], triangle[2] - triangle[0]);
+		}
+
+		inline void computeFaceNormals(const std::vector<glm::vec3> & corners, std::vector<glm::vec3> & faceNormals){
+			faceNormals.resize(corners.size() / 3);
+			ofParallelForRange(0, faceNormals.size(), [&](std::size_t begin, std::size_t end){
+				for(std::size_t f = begin; f < end; f++){
+					faceNormals[f] = normalizeOrZero(getTriangleCross(&corners[f * 3]));
+				}
+			}, minNormalsPerTask);
+		}
+
+		inline void computeCornerWeights(const std::vector<glm::vec3> & corners, ofMeshNormalsWeighting weighting, std::vector<float> & weights){
+			weights.assign(corners.size(), 1.f);
+			if(weighting == OF_MESH_NORMALS_UNWEIGHTED){
+				return;
+			}
+			ofParallelForRange(0, corners.size() / 3, [&](std::size_t begin, std::size_t end){
+				for(std::size_t f = begin; f < end; f++){
+					const glm::vec3 * triangle = &corners[f * 3];
+					if(weighting == OF_MESH_NORMALS_AREA_WEIGHTED){
+						float area = glm::length(getTriangleCross(triangle)) * 0.5f;
+						weights[f * 3] = weights[f * 3 + 1] = weights[f * 3 + 2] = area;
+					}else if(weighting == OF_MESH_NORMALS_ANGLE_WEIGHTED){
+						for(std::size_t k = 0; k < 3; k++){
+							auto e1 = normalizeOrZero(triangle[(k + 1) % 3] - triangle[k]);
+							auto e2 = normalizeOrZero(triangle[(k + 2) % 3] - triangle[k]);
+							weights[f * 3 + k] = std::acos(glm::clamp(glm::dot(e1, e2), -1.f, 1.f));
+						}
+					}
+				}
+			}, minNormalsPerTask);
+		}
+
+		// The grid cell of a coordinate, clamped so converting it is defined for
+		// coordinates too big for the grid or an epsilon of 0. Corners that end
+		// up in the clamped cells are still compared by their distance.
+		inline int64_t getWeldCell(float coordinate, float epsilon){
+			// leaves room for the neighbour cells without overflowing
+			const double limit = 4611686018427387904.0; // 2^62
+			double cell = std::floor(double(coordinate) / double(epsilon));
+			if(!(cell > -limit)){
+				return -int64_t(limit);
+			}
+			if(!(cell < limit)){
+				return int64_t(limit);
 			}
-			ofMeshFace_<V,N,C,T> face;
-			N n;
-			for(ofIndexType i = 0; i < indices.size(); i+=3) {
-				face.setVertex( 0, vertices[indices[i+0]] );
-				face.setVertex( 1, vertices[indices[i+1]] );
-				face.setVertex( 2, vertices[indices[i+2]] );
-
-				n = face.getFaceNormal();
-
-				faceNormals[i]=n;
-				if(perVertex) {
-					faceNormals[i+1]=n;
-					faceNormals[i+2]=n;
+			return int64_t(cell);
+		}
+
+		// Gives the same id to every corner that is within epsilon of the first
+		// corner seen at that position. Corners are bucketed in a grid with cells
+		// of size epsilon so only the 27 surrounding cells need to be searched.
+		// Returns the number of distinct positions.
+		inline std::size_t weldCorners(const std::vector<glm::vec3> & corners, float epsilon, std::vector<uint32_t> & ids){
+			const uint32_t none = std::numeric_limits<uint32_t>::max();
+			const float epsilon2 = epsilon * epsilon;
+			std::unordered_map<MeshWeldCell, uint32_t, MeshWeldCellHash> cellHead;
+			std::vector<uint32_t> nextInCell;
+			std::vector<glm::vec3> positions;
+			cellHead.reserve(corners.size());
+			ids.resize(corners.size());
+
+			for(std::size_t i = 0; i < corners.size(); i++){
+				const glm::vec3 & p = corners[i];
+				bool finite = std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+				MeshWeldCell cell = {0, 0, 0};
+				uint32_t id = none;
+				if(finite){
+					cell.x = getWeldCell(p.x, epsilon);
+					cell.y = getWeldCell(p.y, epsilon);
+					cell.z = getWeldCell(p.z, epsilon);
+					for(int64_t dx = -1; dx <= 1 && id == none; dx++){
+						for(int64_t dy = -1; dy <= 1 && id == none; dy++){
+							for(int64_t dz = -1; dz <= 1 && id == none; dz++){
+								auto head = cellHead.find({cell.x + dx, cell.y + dy, cell.z + dz});
+								if(head == cellHead.end()) continue;
+								for(uint32_t candidate = head->second; candidate != none; candidate = nextInCell[candidate]){
+									if(glm::length2(positions[candidate] - p) <= epsilon2){
+										id = candidate;
+										break;
+									}
+								}
+							}
+						}
+					}
+				}
+
+				if(id == none){
+					id = uint32_t(positions.size());
+					positions.push_back(p);
+					nextInCell.push_back(none);
+					if(finite){
+						auto inserted = cellHead.insert(std::make_pair(cell, id));
+						if(!inserted.second){
+							nextInCell[id] = inserted.first->second;
+							inserted.first->second = id;
+						}
+					}
 				}
+				ids[i] = id;
+			}
+			return positions.size();
+		}
+
+		// For every corner, averages the normals of the faces that share its
+		// position and are within creaseAngle degrees of the corner's own face.
+		inline void computeSmoothNormals(const std::vector<glm::vec3> & corners, float creaseAngle, ofMeshNormalsWeighting weighting, float epsilon, std::vector<glm::vec3> & normals){
+			std::vector<glm::vec3> faceNormals;
+			computeFaceNormals(corners, faceNormals);
+			std::vector<float> weights;
+			computeCornerWeights(corners, weighting, weights);
+			std::vector<uint32_t> ids;
+			std::size_t numPositions = weldCorners(corners, epsilon, ids);
+
+			// corners grouped by position, counting sort by id
+			std::vector<uint32_t> groupStart(numPositions + 1, 0);
+			for(auto id: ids){
+				groupStart[id + 1]++;
 			}
+			for(std::size_t i = 0; i < numPositions; i++){
+				groupStart[i + 1] += groupStart[i];
+			}
+			std::vector<uint32_t> groups(corners.size());
+			std::vector<uint32_t> groupFill(groupStart.begin(), groupStart.end() - 1);
+			for(std::size_t c = 0; c < corners.size(); c++){
+				groups[groupFill[ids[c]]++] = uint32_t(c);
+			}
+
+			float angleCos = std::cos(glm::radians(creaseAngle));
+			normals.resize(corners.size());
+			ofParallelForRange(0, corners.size(), [&](std::size_t begin, std::size_t end){
+				for(std::size_t c = begin; c < end; c++){
+					const glm::vec3 & faceNormal = faceNormals[c / 3];
+					glm::vec3 normal(0);
+					for(uint32_t g = groupStart[ids[c]]; g < groupStart[ids[c] + 1]; g++){
+						uint32_t other = groups[g];
+						const glm::vec3 & otherNormal = faceNormals[other / 3];
+						if(glm::dot(faceNormal, otherNormal) >= angleCos){
+							normal += otherNormal * weights[other];
+						}
+					}
+					normals[c] = normalizeOrZero(normal);
+				}
+			}, minNormalsPerTask);
 		}
 	}
+}
+
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+std::vector<N> ofMesh_<V,N,C,T>::getFaceNormals( bool perVertex ) const{
+	std::vector<N> faceNormals;
+	if(getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogWarning("ofMesh") << "getFaceNormals(): only works with primitive mode OF_PRIMITIVE_TRIANGLES";
+		return faceNormals;
+	}
 
+	std::vector<glm::vec3> normalsPerFace;
+	of::priv::computeFaceNormals(of::priv::getTriangleCorners(vertices, indices), normalsPerFace);
+
+	faceNormals.reserve(perVertex ? normalsPerFace.size() * 3 : normalsPerFace.size());
+	for(const auto & n: normalsPerFace){
+		faceNormals.push_back(n);
+		if(perVertex){
+			faceNormals.push_back(n);
+			faceNormals.push_back(n);
+		}
+	}
 	return faceNormals;
 }
 
@@ -1698,148 +1886,57 @@ void ofMesh_<V,N,C,T>::setFromTriangles( const std::vector<ofMeshFace_<V,N,C,T>>
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
-
-	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-		std::vector<ofMeshFace_<V,N,C,T>> triangles = getUniqueFaces();
-		std::vector<V> verts;
-		for(ofIndexType i = 0; i < triangles.size(); i++) {
-			for(ofIndexType j = 0; j < 3; j++) {
-				verts.push_back( triangles[i].getVertex(j) );
-			}
-		}
-
-		std::map<int, int> removeIds;
-
-		float epsilon = .01f;
-		for(ofIndexType i = 0; i < verts.size()-1; i++) {
-			for(ofIndexType j = i+1; j < verts.size(); j++) {
-				if(i != j) {
-					const auto& v1 = toGlm(verts[i]);
-					const auto& v2 = toGlm(verts[j]);
-					if( glm::distance(v1, v2) <= epsilon ) {
-						// average the location //
-						verts[i] = (v1+v2)/2.f;
-						verts[j] = verts[i];
-						removeIds[j] = 1;
-					}
-				}
-			}
-		}
-
-		// string of vertex in 3d space to triangle index //
-		std::map<std::string, std::vector<int> > vertHash;
-
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
-
-		std::string xStr, yStr, zStr;
-
-		for(ofIndexType i = 0; i < verts.size(); i++ ) {
-			xStr = "x"+ofToString(verts[i].x==-0?0:verts[i].x);
-			yStr = "y"+ofToString(verts[i].y==-0?0:verts[i].y);
-			zStr = "z"+ofToString(verts[i].z==-0?0:verts[i].z);
-			std::string vstring = xStr+yStr+zStr;
-			if(vertHash.find(vstring) == vertHash.end()) {
-				for(ofIndexType j = 0; j < triangles.size(); j++) {
-					for(ofIndexType k = 0; k < 3; k++) {
-						if(verts[i].x == triangles[j].getVertex(k).x) {
-							if(verts[i].y == triangles[j].getVertex(k).y) {
-								if(verts[i].z == triangles[j].getVertex(k).z) {
-									vertHash[vstring].push_back( j );
-								}
-							}
-						}
-					}
-				}
-			}
-		}
-
-//		for( std::map<std::string, std::vector<int> >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			//for( std::map<std::string, int >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
-//		}
-
-		V vert;
-		N normal;
-		float angleCos = cos(angle * DEG_TO_RAD );
-		float numNormals=0;
-
-		for(ofIndexType j = 0; j < triangles.size(); j++) {
-			for(ofIndexType k = 0; k < 3; k++) {
-				vert = triangles[j].getVertex(k);
-				xStr = "x"+ofToString(vert.x==-0?0:vert.x);
-				yStr = "y"+ofToString(vert.y==-0?0:vert.y);
-				zStr = "z"+ofToString(vert.z==-0?0:vert.z);
-
-				std::string vstring = xStr+yStr+zStr;
-				numNormals=0;
-				normal = {0.f,0.f,0.f};
-				if(vertHash.find(vstring) != vertHash.end()) {
-					for(ofIndexType i = 0; i < vertHash[vstring].size(); i++) {
-						auto f1 = triangles[j].getFaceNormal();
-						auto f2 = triangles[vertHash[vstring][i]].getFaceNormal();
-						if(glm::dot(toGlm(f1), toGlm(f2)) >= angleCos ) {
-							normal += f2;
-							numNormals+=1.f;
-						}
-					}
-					//normal /= (float)vertHash[vstring].size();
-					normal /= numNormals;
+void ofMesh_<V,N,C,T>::setFromCornerNormals( const std::vector<glm::vec3> & cornerNormals ) {
+	// unshares every vertex so each triangle corner can have its own normal,
+	// the same layout setFromTriangles produces
+	std::size_t numCorners = cornerNormals.size();
+	bool bHasColors = hasColors();
+	bool bHasTexCoords = hasTexCoords();
+	std::vector<V> newVertices(numCorners);
+	std::vector<C> newColors(bHasColors ? numCorners : 0);
+	std::vector<T> newTexCoords(bHasTexCoords ? numCorners : 0);
+	normals.resize(numCorners);
+	for(std::size_t i = 0; i < numCorners; i++){
+		ofIndexType index = indices.empty() ? ofIndexType(i) : indices[i];
+		newVertices[i] = vertices[index];
+		if(bHasColors) newColors[i] = colors[index];
+		if(bHasTexCoords) newTexCoords[i] = texCoords[index];
+		normals[i] = cornerNormals[i];
+	}
+	vertices.swap(newVertices);
+	colors.swap(newColors);
+	texCoords.swap(newTexCoords);
 
-					triangles[j].setNormal(k, normal);
-				}
-			}
-		}
+	setupIndicesAuto();
+	bVertsChanged = true;
+	bNormalsChanged = true;
+	bColorsChanged = true;
+	bTexCoordsChanged = true;
+}
 
-		//ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
-		setFromTriangles( triangles );
 
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+void ofMesh_<V,N,C,T>::smoothNormals( float angle, ofMeshNormalsWeighting weighting ) {
+	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
+		std::vector<glm::vec3> cornerNormals;
+		of::priv::computeSmoothNormals(of::priv::getTriangleCorners(vertices, indices), angle, weighting, 0.01f, cornerNormals);
+		setFromCornerNormals(cornerNormals);
 	}
 }
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::flatNormals() {
-    if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-        
-        // get copy original mesh data
-        auto numIndices = getIndices().size();
-        auto verts = getVertices();
-        auto texCoords = getTexCoords();
-        auto colors = getColors();
-        
-        // remove all data to start from scratch
-        clear();
-        
-        // add mesh data back, duplicating vertices and recalculating normals
-        N normal;
-        for(ofIndexType i = 0; i < numIndices; i++) {
-            ofIndexType indexCurr = getIndex(i);
-    
-            if(i % 3 == 0) {
-                ofIndexType indexNext1 = getIndex(i + 1);
-                ofIndexType indexNext2 = getIndex(i + 2);
-                auto e1 = verts[indexCurr] - verts[indexNext1];
-                auto e2 = verts[indexNext2] - verts[indexNext1];
-                normal = glm::normalize(glm::cross(e1, e2));
-            }
-    
-            addIndex(i);
-            addNormal(normal);
-    
-            if(indexCurr < texCoords.size()) {
-                addTexCoord(texCoords[indexCurr]);
-            }
-    
-            if(indexCurr < verts.size()) {
-                addVertex(verts[indexCurr]);
-            }
-    
-            if(indexCurr < colors.size()) {
-                addColor(colors[indexCurr]);
-            }
-        }
-    }
+	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
+		std::vector<glm::vec3> faceNormals;
+		of::priv::computeFaceNormals(of::priv::getTriangleCorners(vertices, indices), faceNormals);
+		std::vector<glm::vec3> cornerNormals(faceNormals.size() * 3);
+		for(std::size_t i = 0; i < cornerNormals.size(); i++){
+			cornerNormals[i] = faceNormals[i / 3];
+		}
+		setFromCornerNormals(cornerNormals);
+	}
 }
 
 // PLANE MESH //
@@ -0,0 +1,434 @@
+#include "ofMeshBvh.h"
+#include "ofMesh.h"
+#include "ofCamera.h"
+#include "ofLog.h"
+#include "ofTaskPool.h"
+#include <atomic>
+#include <numeric>
+
+using namespace std;
+
+namespace{
+	// nodes with less triangles than this are always leaves
+	const uint32_t minSplitSize = 4;
+	// nodes with more triangles than this are split even if the surface
+	// area heuristic says that testing all of them is cheaper
+	const uint32_t maxLeafSize = 16;
+	const int numBins = 16;
+	// nodes with more triangles than this build their children in parallel
+	const uint32_t minParallelSize = 1 << 14;
+	// limits the size of the stack needed to traverse the hierarchy
+	const int maxDepth = 64;
+
+	struct Bounds{
+		glm::vec3 min{numeric_limits<float>::max()};
+		glm::vec3 max{numeric_limits<float>::lowest()};
+
+		void grow(const glm::vec3 & p){
+			min = glm::min(min, p);
+			max = glm::max(max, p);
+		}
+
+		void grow(const Bounds & bounds){
+			min = glm::min(min, bounds.min);
+			max = glm::max(max, bounds.max);
+		}
+
+		float area() const{
+			if(min.x > max.x){
+				return 0;
+			}
+			glm::vec3 e = max - min;
+			return e.x * e.y + e.y * e.z + e.z * e.x;
+		}
+	};
+
+	struct Bin{
+		Bounds bounds;
+		uint32_t count = 0;
+	};
+
+	struct BuildContext{
+		vector<ofMeshBvh::Node> & nodes;
+		vector<uint32_t> & order;
+		const vector<Bounds> & triangleBounds;
+		const vector<glm::vec3> & centroids;
+		atomic<uint32_t> nodesUsed;
+	};
+
+	void subdivide(BuildContext & context, uint32_t nodeIndex, int depth){
+		auto & node = context.nodes[nodeIndex];
+		const uint32_t first = node.first;
+		const uint32_t count = node.count;
+		Bounds bounds, centroidBounds;
+		for(uint32_t i = first; i < first + count; i++){
+			bounds.grow(context.triangleBounds[context.order[i]]);
+			centroidBounds.grow(context.centroids[context.order[i]]);
+		}
+		node.min = bounds.min;
+		node.max = bounds.max;
+		if(count < minSplitSize || depth == maxDepth){
+			return;
+		}
+
+		// binned surface area heuristic: the centroids are sorted in bins along
+		// every axis and the split between bins that minimizes the area of
+		// the children weighted by the number of triangles in them is used
+		float bestCost = numeric_limits<float>::max();
+		int bestAxis = -1;
+		int bestBin = 0;
+		for(int axis = 0; axis < 3; axis++){
+			float minCentroid = centroidBounds.min[axis];
+			float maxCentroid = centroidBounds.max[axis];
+			if(minCentroid == maxCentroid){
+				continue;
+			}
+			Bin bins[numBins];
+			float scale = numBins / (maxCentroid - minCentroid);
+			for(uint32_t i = first; i < first + count; i++){
+				uint32_t triangle = context.order[i];
+				int bin = std::min(numBins - 1, int((context.centroids[triangle][axis] - minCentroid) * scale));
+				bins[bin].count++;
+				bins[bin].bounds.grow(context.triangleBounds[triangle]);
+			}
+
+			float leftArea[numBins - 1];
+			uint32_t leftCount[numBins - 1];
+			Bounds left;
+			uint32_t leftSum = 0;
+			for(int i = 0; i < numBins - 1; i++){
+				leftSum += bins[i].count;
+				left.grow(bins[i].bounds);
+				leftArea[i] = left.area();
+				leftCount[i] = leftSum;
+			}
+			Bounds right;
+			uint32_t rightSum = 0;
+			for(int i = numBins - 1; i > 0; i--){
+				rightSum += bins[i].count;
+				right.grow(bins[i].bounds);
+				if(leftCount[i - 1] == 0 || rightSum == 0){
+					continue;
+				}
+				float cost = leftCount[i - 1] * leftArea[i - 1] + rightSum * right.area();
+				if(cost < bestCost){
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = i;
+				}
+			}
+		}
+
+		if(bestAxis == -1 || (bestCost >= count * bounds.area() && count <= maxLeafSize)){
+			return;
+		}
+
+		float minCentroid = centroidBounds.min[bestAxis];
+		float scale = numBins / (centroidBounds.max[bestAxis] - minCentroid);
+		auto middle = partition(context.order.begin() + first, context.order.begin() + first + count, [&](uint32_t triangle){
+			return std::min(numBins - 1, int((context.centroids[triangle][bestAxis] - minCentroid) * scale)) < bestBin;
+		});
+		uint32_t leftCount = uint32_t(middle - context.order.begin()) - first;
+
+		uint32_t left = context.nodesUsed.fetch_add(2);
+		context.nodes[left].first = first;
+		context.nodes[left].count = leftCount;
+		context.nodes[left + 1].first = first + leftCount;
+		context.nodes[left + 1].count = count - leftCount;
+		node.first = left;
+		node.count = 0;
+
+		if(count > minParallelSize){
+			ofTaskGroup leftTask;
+			leftTask.run([&context, left, depth]{
+				subdivide(context, left, depth + 1);
+			});
+			subdivide(context, left + 1, depth + 1);
+			leftTask.wait();
+		}else{
+			subdivide(context, left, depth + 1);
+			subdivide(context, left + 1, depth + 1);
+		}
+	}
+
+	bool getFaceVertices(const ofMesh & mesh, vector<uint32_t> & faceVertices){
+		faceVertices.clear();
+		const bool indexed = mesh.hasIndices();
+		const size_t n = indexed ? mesh.getNumIndices() : mesh.getNumVertices();
+		auto vertex = [&](size_t i){
+			return indexed ? uint32_t(mesh.getIndex(i)) : uint32_t(i);
+		};
+		switch(mesh.getMode()){
+		case OF_PRIMITIVE_TRIANGLES:
+			for(size_t i = 0; i + 2 < n; i += 3){
+				faceVertices.insert(faceVertices.end(), {vertex(i), vertex(i + 1), vertex(i + 2)});
+			}
+			break;
+		case OF_PRIMITIVE_TRIANGLE_STRIP:
+			for(size_t i = 0; i + 2 < n; i++){
+				if(i % 2 == 0){
+					faceVertices.insert(faceVertices.end(), {vertex(i), vertex(i + 1), vertex(i + 2)});
+				}else{
+					faceVertices.insert(faceVertices.end(), {vertex(i + 1), vertex(i), vertex(i + 2)});
+				}
+			}
+			break;
+		case OF_PRIMITIVE_TRIANGLE_FAN:
+			for(size_t i = 1; i + 1 < n; i++){
+				faceVertices.insert(faceVertices.end(), {vertex(0), vertex(i), vertex(i + 1)});
+			}
+			break;
+		default:
+			ofLogError("ofMeshBvh") << "only triangles, triangle strips and triangle fans are supported";
+			return false;
+		}
+		for(auto index: faceVertices){
+			if(index >= mesh.getNumVertices()){
+				ofLogError("ofMeshBvh") << "the mesh has an index to a vertex that doesn't exist: " << index;
+				faceVertices.clear();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	ofMeshBvh::Triangle makeTriangle(const glm::vec3 & v0, const glm::vec3 & v1, const glm::vec3 & v2){
+		return {v0, v1 - v0, v2 - v0};
+	}
+
+	// distance along the ray to where it enters the box or infinity if it
+	// misses it or enters after maxDistance
+	float intersectBox(const ofMeshBvh::Node & node, const glm::vec3 & origin, const glm::vec3 & invDirection, float maxDistance){
+		glm::vec3 t0 = (node.min - origin) * invDirection;
+		glm::vec3 t1 = (node.max - origin) * invDirection;
+		glm::vec3 tMin = glm::min(t0, t1);
+		glm::vec3 tMax = glm::max(t0, t1);
+		float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.f));
+		float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+		return enter <= exit ? enter : numeric_limits<float>::infinity();
+	}
+
+	// Möller-Trumbore, triangles are hit from both sides
+	bool intersectTriangle(const ofMeshBvh::Triangle & triangle, const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance, float & distance, glm::vec2 & barycentric){
+		glm::vec3 p = glm::cross(direction, triangle.edge2);
+		float determinant = glm::dot(triangle.edge1, p);
+		if(determinant == 0){
+			return false;
+		}
+		float invDeterminant = 1.f / determinant;
+		glm::vec3 s = origin - triangle.v0;
+		float u = glm::dot(s, p) * invDeterminant;
+		if(u < 0 || u > 1){
+			return false;
+		}
+		glm::vec3 q = glm::cross(s, triangle.edge1);
+		float v = glm::dot(direction, q) * invDeterminant;
+		if(v < 0 || u + v > 1){
+			return false;
+		}
+		float t = glm::dot(triangle.edge2, q) * invDeterminant;
+		if(t < 0 || t >= maxDistance){
+			return false;
+		}
+		distance = t;
+		barycentric = {u, v};
+		return true;
+	}
+}
+
+//----------------------------------------------------------
+ofMeshBvh::ofMeshBvh(){
+
+}
+
+//----------------------------------------------------------
+ofMeshBvh::ofMeshBvh(const ofMesh & mesh){
+	build(mesh);
+}
+
+//----------------------------------------------------------
+void ofMeshBvh::build(const ofMesh & mesh){
+	clear();
+	if(!getFaceVertices(mesh, faceVertices)){
+		return;
+	}
+	uint32_t numFaces = faceVertices.size() / 3;
+	if(numFaces == 0){
+		return;
+	}
+
+	const auto & vertices = mesh.getVertices();
+	vector<Triangle> meshTriangles(numFaces);
+	vector<Bounds> triangleBounds(numFaces);
+	vector<glm::vec3> centroids(numFaces);
+	for(uint32_t i = 0; i < numFaces; i++){
+		glm::vec3 v0 = toGlm(vertices[faceVertices[i * 3]]);
+		glm::vec3 v1 = toGlm(vertices[faceVertices[i * 3 + 1]]);
+		glm::vec3 v2 = toGlm(vertices[faceVertices[i * 3 + 2]]);
+		meshTriangles[i] = makeTriangle(v0, v1, v2);
+		triangleBounds[i].grow(v0);
+		triangleBounds[i].grow(v1);
+		triangleBounds[i].grow(v2);
+		centroids[i] = (v0 + v1 + v2) / 3.f;
+	}
+
+	// a binary tree with n leaves has at most 2n - 1 nodes, children are
+	// allocated in pairs after the root
+	faces.resize(numFaces);
+	iota(faces.begin(), faces.end(), 0);
+	nodes.resize(numFaces * 2);
+	nodes[0].first = 0;
+	nodes[0].count = numFaces;
+	BuildContext context{nodes, faces, triangleBounds, centroids, {1}};
+	subdivide(context, 0, 0);
+	nodes.resize(context.nodesUsed);
+	nodes.shrink_to_fit();
+
+	// store the triangles in the order of the leaves so every leaf reads
+	// contiguous memory
+	triangles.resize(numFaces);
+	for(uint32_t i = 0; i < numFaces; i++){
+		triangles[i] = meshTriangles[faces[i]];
+	}
+}
+
+//----------------------------------------------------------
+void ofMeshBvh::refit(const ofMesh & mesh){
+	if(nodes.empty()){
+		build(mesh);
+		return;
+	}
+	const auto & vertices = mesh.getVertices();
+	for(size_t i = 0; i < triangles.size(); i++){
+		const uint32_t * v = &faceVertices[faces[i] * 3];
+		if(v[0] >= vertices.size() || v[1] >= vertices.size() || v[2] >= vertices.size()){
+			ofLogError("ofMeshBvh") << "refit(): the mesh doesn't have the same triangles, building it again";
+			build(mesh);
+			return;
+		}
+		triangles[i] = makeTriangle(toGlm(vertices[v[0]]), toGlm(vertices[v[1]]), toGlm(vertices[v[2]]));
+	}
+
+	// children are always after their parent so going backwards updates
+	// every node after its children
+	for(size_t i = nodes.size(); i > 0; i--){
+		auto & node = nodes[i - 1];
+		Bounds bounds;
+		if(node.count > 0){
+			for(uint32_t t = node.first; t < node.first + node.count; t++){
+				const auto & triangle = triangles[t];
+				bounds.grow(triangle.v0);
+				bounds.grow(triangle.v0 + triangle.edge1);
+				bounds.grow(triangle.v0 + triangle.edge2);
+			}
+		}else{
+			bounds.grow(nodes[node.first].min);
+			bounds.grow(nodes[node.first].max);
+			bounds.grow(nodes[node.first + 1].min);
+			bounds.grow(nodes[node.first + 1].max);
+		}
+		node.min = bounds.min;
+		node.max = bounds.max;
+	}
+}
+
+//----------------------------------------------------------
+void ofMeshBvh::clear(){
+	nodes.clear();
+	triangles.clear();
+	faces.clear();
+	faceVertices.clear();
+}
+
+//----------------------------------------------------------
+size_t ofMeshBvh::getNumTriangles() const{
+	return triangles.size();
+}
+
+//----------------------------------------------------------
+size_t ofMeshBvh::getNumNodes() const{
+	return nodes.size();
+}
+
+//----------------------------------------------------------
+bool ofMeshBvh::intersect(const glm::vec3 & origin, const glm::vec3 & direction, Intersection & intersection, float maxDistance) const{
+	return traverse<false>(origin, direction, intersection, maxDistance);
+}
+
+//----------------------------------------------------------
+bool ofMeshBvh::intersect(const ofCamera & camera, const glm::vec2 & screenPosition, Intersection & intersection, const ofRectangle & viewport) const{
+	auto nearPoint = camera.screenToWorld({screenPosition, -1.f}, viewport);
+	auto farPoint = camera.screenToWorld({screenPosition, 1.f}, viewport);
+	return intersect(nearPoint, farPoint - nearPoint, intersection, 1);
+}
+
+//----------------------------------------------------------
+bool ofMeshBvh::intersects(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance) const{
+	Intersection intersection;
+	return traverse<true>(origin, direction, intersection, maxDistance);
+}
+
+//----------------------------------------------------------
+template<bool anyHit>
+bool ofMeshBvh::traverse(const glm::vec3 & origin, const glm::vec3 & direction, Intersection & intersection, float maxDistance) const{
+	if(nodes.empty()){
+		return false;
+	}
+	const glm::vec3 invDirection = 1.f / direction;
+	const float infinity = numeric_limits<float>::infinity();
+	float closest = maxDistance;
+	bool hit = false;
+	if(intersectBox(nodes[0], origin, invDirection, closest) == infinity){
+		return false;
+	}
+
+	uint32_t stack[maxDepth];
+	int stackSize = 0;
+	uint32_t nodeIndex = 0;
+	while(true){
+		const auto & node = nodes[nodeIndex];
+		if(node.count > 0){
+			for(uint32_t i = node.first; i < node.first + node.count; i++){
+				float distance;
+				glm::vec2 barycentric;
+				if(intersectTriangle(triangles[i], origin, direction, closest, distance, barycentric)){
+					hit = true;
+					closest = distance;
+					if(anyHit){
+						return true;
+					}
+					intersection.face = faces[i];
+					intersection.barycentric = barycentric;
+				}
+			}
+		}else{
+			// visit the closest child first so the farthest one can be
+			// skipped if there's a hit before it
+			uint32_t nearChild = node.first;
+			uint32_t farChild = node.first + 1;
+			float nearDistance = intersectBox(nodes[nearChild], origin, invDirection, closest);
+			float farDistance = intersectBox(nodes[farChild], origin, invDirection, closest);
+			if(farDistance < nearDistance){
+				std::swap(nearChild, farChild);
+				std::swap(nearDistance, farDistance);
+			}
+			if(nearDistance != infinity){
+				if(farDistance != infinity){
+					stack[stackSize++] = farChild;
+				}
+				nodeIndex = nearChild;
+				continue;
+			}
+		}
+		if(stackSize == 0){
+			break;
+		}
+		nodeIndex = stack[--stackSize];
+	}
+
+	if(hit){
+		intersection.distance = closest;
+		intersection.position = origin + direction * closest;
+	}
+	return hit;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofRectangle.h"
+#include <limits>
+
+class ofCamera;
+
+template<class V, class N, class C, class T>
+class ofMesh_;
+using ofMesh = ofMesh_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
+
+/// \brief A bounding volume hierarchy to intersect rays with the triangles
+/// of a mesh.
+///
+/// Intersecting a ray with a mesh by testing every triangle is too slow for
+/// big meshes. A bounding volume hierarchy groups nearby triangles in boxes
+/// inside bigger boxes so a ray only needs to test the few triangles in the
+/// boxes it crosses. The most common use is picking the point of a mesh
+/// under the mouse:
+///
+/// ~~~~{.cpp}
+/// ofMeshBvh bvh(mesh);
+///
+/// // in draw(), while the camera is active or not
+/// ofMeshBvh::Intersection intersection;
+/// if(bvh.intersect(camera, {ofGetMouseX(), ofGetMouseY()}, intersection)){
+/// 	ofDrawSphere(intersection.position, 2);
+/// }
+/// ~~~~
+///
+/// Rays are in the coordinates of the mesh vertices, if the mesh is drawn
+/// with a transformation the ray has to be transformed by its inverse.
+///
+/// Triangles, triangle strips and triangle fans are supported, indexed or
+/// not. When the vertices move but the triangles stay the same, refit() is
+/// much faster than building the hierarchy again.
+class ofMeshBvh{
+public:
+	/// \brief The closest point where a ray hits the mesh.
+	struct Intersection{
+		/// \brief Distance from the ray origin in units of the ray direction.
+		float distance;
+		/// \brief Index of the triangle in the order of the mesh, the same
+		/// as in ofMesh::getFace() for indexed triangle meshes.
+		std::size_t face;
+		glm::vec3 position;
+		/// \brief Weights of the second and third vertices of the triangle,
+		/// the weight of the first one is 1 - x - y.
+		glm::vec2 barycentric;
+	};
+
+	ofMeshBvh();
+
+	/// \brief Create the hierarchy for a mesh.
+	ofMeshBvh(const ofMesh & mesh);
+
+	/// \brief Build the hierarchy for the triangles of a mesh.
+	///
+	/// Big meshes are built using several threads.
+	void build(const ofMesh & mesh);
+
+	/// \brief Update the hierarchy after moving the vertices of the mesh.
+	///
+	/// The mesh has to have the same triangles as when the hierarchy was
+	/// built. The boxes are recalculated but not rearranged so, if the
+	/// vertices moved a lot, rays become slower until the hierarchy is built
+	/// again.
+	void refit(const ofMesh & mesh);
+
+	void clear();
+
+	std::size_t getNumTriangles() const;
+	std::size_t getNumNodes() const;
+
+	/// \brief Find the closest triangle a ray hits.
+	/// \param origin The start of the ray.
+	/// \param direction The direction of the ray, it doesn't need to be
+	/// normalized.
+	/// \param intersection Set to the closest intersection if there's one.
+	/// \param maxDistance Triangles farther than this from the origin, in
+	/// units of direction, are ignored.
+	/// \returns true if the ray hits the mesh.
+	bool intersect(const glm::vec3 & origin, const glm::vec3 & direction, Intersection & intersection, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	/// \brief Find the closest triangle under a point of the screen.
+	///
+	/// The ray goes from the near to the far plane of the camera through
+	/// screenPosition, distance is 0 on the near plane and 1 on the far one.
+	/// \param viewport The viewport of the camera, the current one by default.
+	bool intersect(const ofCamera & camera, const glm::vec2 & screenPosition, Intersection & intersection, const ofRectangle & viewport = ofRectangle()) const;
+
+	/// \brief Check if a ray hits any triangle.
+	///
+	/// Faster than intersect() since it stops at the first triangle found,
+	/// useful for visibility or shadow tests.
+	bool intersects(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	/// \brief A box and either its two children, which are always
+	/// consecutive, or the range of triangles it contains.
+	struct Node{
+		glm::vec3 min;
+		uint32_t first;
+		glm::vec3 max;
+		uint32_t count;
+	};
+
+	/// \brief A triangle stored as its first vertex and two edges, which is
+	/// what the intersection test needs.
+	struct Triangle{
+		glm::vec3 v0;
+		glm::vec3 edge1;
+		glm::vec3 edge2;
+	};
+
+private:
+	template<bool anyHit>
+	bool traverse(const glm::vec3 & origin, const glm::vec3 & direction, Intersection & intersection, float maxDistance) const;
+
+	std::vector<Node> nodes;
+	std::vector<Triangle> triangles;
+	// index of every triangle in the mesh, in the order of the hierarchy
+	std::vector<uint32_t> faces;
+	// 3 vertex indices for every face in the mesh
+	std::vector<uint32_t> faceVertices;
+};
@@ -10,6 +10,7 @@
 #endif // !OF_TARGET_API_VULKAN
 #include "ofAppRunner.h"
 #include "ofFileUtils.h"
+#include "ofProfiler.h"
 
 #ifdef TARGET_LINUX
 	#include "ofIcon.h"
@@ -434,6 +435,8 @@ void ofAppGLFWWindow::draw(){
 	events().notifyDraw();
 
 #ifndef OF_TARGET_API_VULKAN
+	static auto & swapSection = ofGetProfiler().getSection("swap");
+	ofScopedTimer swapTimer(swapSection);
 	#ifdef TARGET_WIN32
 	if (currentRenderer->getBackgroundAuto() == false){
 		// on a PC resizing a window with this method of accumulation (essentially single buffering)
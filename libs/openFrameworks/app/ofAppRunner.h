@@ -67,6 +67,21 @@ uint64_t	ofGetFixedStepForFps(double fps);
 void		ofSetTimeModeFixedRate(uint64_t stepNanos = ofGetFixedStepForFps(60)); //default nanos for 1 frame at 60fps
 void		ofSetTimeModeFiltered(float alpha = 0.9);
 
+/// \brief Set how the main loop waits between frames.
+///
+/// OF_FRAME_PACING_VIRTUAL also sets the fixed rate time mode with a step of
+/// one frame at the target frame rate, or 60fps if there's none, so
+/// ofGetElapsedTimef() and ofGetLastFrameTime() advance by exactly one
+/// frame per iteration. Changing to another pacing goes back to the system
+/// time mode.
+void		ofSetFramePacing(ofFramePacing pacing);
+ofFramePacing	ofGetFramePacing();
+void		ofSetFrameLatePolicy(ofFrameLatePolicy policy, int maxCatchUpFrames = 5);
+
+/// \returns The standard deviation in seconds of the time between the frames
+/// of the last two seconds.
+double		ofGetFrameTimeJitter();
+
 void		ofSetOrientation(ofOrientation orientation, bool vFlip=true);
 ofOrientation			ofGetOrientation();
 
@@ -8,6 +8,7 @@
 #include <ofMainLoop.h>
 #include "ofWindowSettings.h"
 #include "ofConstants.h"
+#include "ofProfiler.h"
 
 //========================================================================
 // default windowing
@@ -148,6 +149,8 @@ void ofMainLoop::loopOnce(){
 
 void ofMainLoop::pollEvents(){
 	if(windowPollEvents){
+		static auto & eventsSection = ofGetProfiler().getSection("events");
+		ofScopedTimer timer(eventsSection);
 		windowPollEvents();
 	}
 }
@@ -1,5 +1,7 @@
 #include "ofEvents.h"
 #include "ofAppRunner.h"
+#include "ofProfiler.h"
+#include "ofTaskPool.h"
 
 using namespace std;
 
@@ -11,6 +13,10 @@ void ofSetFrameRate(int targetRate){
 	auto window = ofGetMainLoop()->getCurrentWindow();
 	if(window){
 		window->events().setFrameRate(targetRate);
+		// the virtual time advances one frame of the new rate per iteration
+		if(targetRate > 0 && window->events().getFramePacing() == OF_FRAME_PACING_VIRTUAL){
+			ofSetTimeModeFixedRate(ofGetFixedStepForFps(targetRate));
+		}
 	}else{
 		ofLogWarning("ofEvents") << "Trying to set framerate before mainloop is ready";
 	}
@@ -46,6 +52,67 @@ double ofGetLastFrameTime(){
 	}
 }
 
+//--------------------------------------
+void ofSetFramePacing(ofFramePacing pacing){
+	auto window = ofGetMainLoop()->getCurrentWindow();
+	if(!window){
+		ofLogWarning("ofEvents") << "Trying to set frame pacing before mainloop is ready";
+		return;
+	}
+	auto previous = window->events().getFramePacing();
+	window->events().setFramePacing(pacing);
+	if(pacing == OF_FRAME_PACING_VIRTUAL){
+		auto targetRate = window->events().getTargetFrameRate();
+		ofSetTimeModeFixedRate(ofGetFixedStepForFps(targetRate > 0 ? targetRate : 60));
+	}else if(previous == OF_FRAME_PACING_VIRTUAL){
+		// the window restored the time mode set before the virtual
+		// pacing, set it again so the clock follows
+		auto & events = window->events();
+		switch(events.getTimeMode()){
+			case ofCoreEvents::FixedRate:
+				ofSetTimeModeFixedRate(events.getTimeModeFixedRateStep());
+				break;
+			case ofCoreEvents::Filtered:
+				ofSetTimeModeFiltered(events.getTimeModeFilterAlpha());
+				break;
+			case ofCoreEvents::System:
+			default:
+				ofSetTimeModeSystem();
+				break;
+		}
+	}
+}
+
+//--------------------------------------
+ofFramePacing ofGetFramePacing(){
+	auto window = ofGetMainLoop()->getCurrentWindow();
+	if(window){
+		return window->events().getFramePacing();
+	}else{
+		return OF_FRAME_PACING_SLEEP;
+	}
+}
+
+//--------------------------------------
+void ofSetFrameLatePolicy(ofFrameLatePolicy policy, int maxCatchUpFrames){
+	auto window = ofGetMainLoop()->getCurrentWindow();
+	if(window){
+		window->events().setFrameLatePolicy(policy, maxCatchUpFrames);
+	}else{
+		ofLogWarning("ofEvents") << "Trying to set frame late policy before mainloop is ready";
+	}
+}
+
+//--------------------------------------
+double ofGetFrameTimeJitter(){
+	auto window = ofGetMainLoop()->getCurrentWindow();
+	if(window){
+		return window->events().getFrameTimeJitter();
+	}else{
+		return 0.;
+	}
+}
+
 //--------------------------------------
 uint64_t ofGetFrameNum(){
 	auto window = ofGetMainLoop()->getCurrentWindow();
@@ -190,6 +257,18 @@ void ofCoreEvents::setTimeModeFiltered(float alpha){
 	fps.setFilterAlpha(alpha);
 }
 
+ofCoreEvents::TimeMode ofCoreEvents::getTimeMode() const{
+	return timeMode;
+}
+
+uint64_t ofCoreEvents::getTimeModeFixedRateStep() const{
+	return fixedRateTimeNanos.count();
+}
+
+float ofCoreEvents::getTimeModeFilterAlpha() const{
+	return fps.getFilterAlpha();
+}
+
 //--------------------------------------
 void ofCoreEvents::setFrameRate(int _targetRate){
 	// given this FPS, what is the amount of millis per frame
@@ -236,6 +315,40 @@ uint64_t ofCoreEvents::getFrameNum() const{
 	return fps.getNumFrames();
 }
 
+//--------------------------------------
+void ofCoreEvents::setFramePacing(ofFramePacing pacing){
+	if(pacing == OF_FRAME_PACING_VIRTUAL && framePacing != OF_FRAME_PACING_VIRTUAL){
+		timeModeBeforeVirtual = timeMode;
+		fixedRateTimeNanosBeforeVirtual = fixedRateTimeNanos;
+	}else if(pacing != OF_FRAME_PACING_VIRTUAL && framePacing == OF_FRAME_PACING_VIRTUAL){
+		timeMode = timeModeBeforeVirtual;
+		fixedRateTimeNanos = fixedRateTimeNanosBeforeVirtual;
+	}
+	framePacing = pacing;
+	timer.setPrecise(pacing == OF_FRAME_PACING_PRECISE);
+}
+
+//--------------------------------------
+ofFramePacing ofCoreEvents::getFramePacing() const{
+	return framePacing;
+}
+
+//--------------------------------------
+void ofCoreEvents::setFrameLatePolicy(ofFrameLatePolicy policy, int maxCatchUpFrames){
+	frameLatePolicy = policy;
+	timer.setCatchUp(policy == OF_FRAME_LATE_CATCH_UP, maxCatchUpFrames);
+}
+
+//--------------------------------------
+ofFrameLatePolicy ofCoreEvents::getFrameLatePolicy() const{
+	return frameLatePolicy;
+}
+
+//--------------------------------------
+double ofCoreEvents::getFrameTimeJitter() const{
+	return fps.getFrameTimeJitterSecs();
+}
+
 //--------------------------------------
 bool ofCoreEvents::getMousePressed(int button) const{ //by default any button
 	if(button==-1) return pressedMouseButtons.size();
@@ -281,14 +394,29 @@ bool ofCoreEvents::notifySetup(){
 #include "ofGraphics.h"
 //------------------------------------------
 bool ofCoreEvents::notifyUpdate(){
+	static auto & updateSection = ofGetProfiler().getSection("update");
+	ofScopedTimer timer(updateSection);
+	// here instead of in the main loop since some windows update without it
+	of::priv::processMainThreadTasks();
 	return ofNotifyEvent( update, voidEventArgs );
 }
 
 //------------------------------------------
 bool ofCoreEvents::notifyDraw(){
-	auto attended = ofNotifyEvent( draw, voidEventArgs );
+	static auto & drawSection = ofGetProfiler().getSection("draw");
+	static auto & waitSection = ofGetProfiler().getSection("wait");
+	static auto & frameSection = ofGetProfiler().getSection("frame");
+
+	bool attended;
+	{
+		ofScopedTimer drawTimer(drawSection);
+		attended = ofNotifyEvent( draw, voidEventArgs );
+	}
 
-	if (bFrameRateSet){
+	// with virtual pacing the time only advances with the main loop so
+	// there's nothing to wait for
+	if (bFrameRateSet && framePacing != OF_FRAME_PACING_VIRTUAL){
+		ofScopedTimer waitTimer(waitSection);
 		timer.waitNext();
 	}
 	
@@ -303,6 +431,9 @@ bool ofCoreEvents::notifyDraw(){
 		}*/
 	}
 	fps.newFrame();
+	if(fps.getNumFrames() > 1){
+		frameSection.add(std::chrono::nanoseconds(fps.getLastFrameNanos()));
+	}
 	return attended;
 }
 
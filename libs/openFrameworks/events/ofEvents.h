@@ -235,6 +235,30 @@ enum ofTimeMode{
 	Filtered,
 };
 
+/// \brief How the main loop waits between frames when a frame rate is set.
+enum ofFramePacing{
+	/// \brief Sleep until the next frame, the default.
+	OF_FRAME_PACING_SLEEP,
+	/// \brief Sleep until shortly before the next frame and wait actively
+	/// for the rest, with much less jitter but using more processor.
+	OF_FRAME_PACING_PRECISE,
+	/// \brief Don't wait at all and advance the time of the application
+	/// by exactly one frame every iteration of the main loop, so it runs
+	/// as fast as possible and always produces the same frames. Useful to
+	/// render offline or run simulations without a window.
+	OF_FRAME_PACING_VIRTUAL,
+};
+
+/// \brief What to do when a frame takes longer than the frame rate allows.
+enum ofFrameLatePolicy{
+	/// \brief Skip the missed frames, the next one starts a period after
+	/// the late one, the default.
+	OF_FRAME_LATE_SKIP,
+	/// \brief Run the next frames without waiting until the missed ones
+	/// are recovered, keeping the average frame rate.
+	OF_FRAME_LATE_CATCH_UP,
+};
+
 class ofCoreEvents {
   public:
 	ofCoreEvents();
@@ -270,9 +294,18 @@ class ofCoreEvents {
 	void disable();
 	void enable();
 
+	enum TimeMode{
+		System,
+		FixedRate,
+		Filtered,
+	};
+
 	void setTimeModeSystem();
 	void setTimeModeFixedRate(uint64_t nanosecsPerFrame);
 	void setTimeModeFiltered(float alpha);
+	TimeMode getTimeMode() const;
+	uint64_t getTimeModeFixedRateStep() const;
+	float getTimeModeFilterAlpha() const;
 
 	void setFrameRate(int _targetRate);
 	float getFrameRate() const;
@@ -280,6 +313,18 @@ class ofCoreEvents {
 	double getLastFrameTime() const;
 	uint64_t getFrameNum() const;
 
+	/// \brief Set how to wait between frames.
+	///
+	/// This only changes how the window waits, ofSetFramePacing() also
+	/// sets the time mode that OF_FRAME_PACING_VIRTUAL needs. Switching to
+	/// OF_FRAME_PACING_VIRTUAL remembers the current time mode and
+	/// switching away from it restores it.
+	void setFramePacing(ofFramePacing pacing);
+	ofFramePacing getFramePacing() const;
+	void setFrameLatePolicy(ofFrameLatePolicy policy, int maxCatchUpFrames = 5);
+	ofFrameLatePolicy getFrameLatePolicy() const;
+	double getFrameTimeJitter() const;
+
 	bool getMousePressed(int button=-1) const;
 	bool getKeyPressed(int key=-1) const;
 	int getMouseX() const;
@@ -322,6 +367,8 @@ class ofCoreEvents {
 private:
 	float targetRate;
 	bool bFrameRateSet;
+	ofFramePacing framePacing = OF_FRAME_PACING_SLEEP;
+	ofFrameLatePolicy frameLatePolicy = OF_FRAME_LATE_SKIP;
 	ofTimer timer;
 	ofFpsCounter fps;
 
@@ -332,12 +379,10 @@ private:
 	std::set<int> pressedKeys;
 	int modifiers = 0;
 
-	enum TimeMode{
-		System,
-		FixedRate,
-		Filtered,
-	} timeMode = System;
-	std::chrono::nanoseconds fixedRateTimeNanos;
+	TimeMode timeMode = System;
+	std::chrono::nanoseconds fixedRateTimeNanos{0};
+	TimeMode timeModeBeforeVirtual = System;
+	std::chrono::nanoseconds fixedRateTimeNanosBeforeVirtual{0};
 };
 
 bool ofSendMessage(ofMessage msg);
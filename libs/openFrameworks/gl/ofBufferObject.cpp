@@ -223,6 +223,23 @@ void ofBufferObject::unmapRange(){
 	unmap();
 }
 
+void ofBufferObject::setStorage(GLsizeiptr bytes, const void * data, GLbitfield flags){
+	if(!this->data) return;
+	this->data->size = bytes;
+
+#ifdef GLEW_VERSION_4_5
+	if (GLEW_ARB_direct_state_access) {
+		glNamedBufferStorage(this->data->id, bytes, data, flags);
+		return;
+	}
+#endif
+
+	/// --------| invariant: direct state access is not available
+	bind(this->data->lastTarget);
+	glBufferStorage(this->data->lastTarget, bytes, data, flags);
+	unbind(this->data->lastTarget);
+}
+
 void ofBufferObject::copyTo(ofBufferObject & dstBuffer) const{
 #ifdef GLEW_VERSION_4_5
 	if (GLEW_ARB_direct_state_access) {
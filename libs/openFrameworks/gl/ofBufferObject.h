@@ -126,6 +126,14 @@ public:
 		return static_cast<T*>(mapRange(offset,length,access));
 	}
 
+	/// glNamedBufferStorage: https://www.opengl.org/sdk/docs/man4/html/glBufferStorage.xhtml
+	/// allocates immutable storage, which can stay mapped while it's used
+	/// when mapped with GL_MAP_PERSISTENT_BIT. needs OpenGL 4.4 or
+	/// ARB_buffer_storage and can only be called once for every allocate().
+	/// before GL 4.5 emulates glNamedBufferStorage by binding to last known
+	/// target for this buffer uploading data to that target and unbinding again
+	void setStorage(GLsizeiptr bytes, const void * data, GLbitfield flags);
+
 	void copyTo(ofBufferObject & dstBuffer) const;
 	void copyTo(ofBufferObject & dstBuffer, int readOffset, int writeOffset, size_t size) const;
 
@@ -4,6 +4,7 @@
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofGLRenderer.h"
+#include "ofPixelsReadback.h"
 #include <map>
 
 #ifdef TARGET_OPENGLES
@@ -1087,6 +1088,21 @@ void ofFbo::readToPixels(ofFloatPixels & pixels, int attachmentPoint) const{
 }
 
 #ifndef TARGET_OPENGLES
+//----------------------------------------------------------
+void ofFbo::readToPixelsAsync(ofPixelsReadback & readback, int attachmentPoint) const{
+	readback.read(*this, attachmentPoint);
+}
+
+//----------------------------------------------------------
+void ofFbo::readToPixelsAsync(ofShortPixelsReadback & readback, int attachmentPoint) const{
+	readback.read(*this, attachmentPoint);
+}
+
+//----------------------------------------------------------
+void ofFbo::readToPixelsAsync(ofFloatPixelsReadback & readback, int attachmentPoint) const{
+	readback.read(*this, attachmentPoint);
+}
+
 //----------------------------------------------------------
 void ofFbo::copyTo(ofBufferObject & buffer) const{
 	if(!bIsAllocated) return;
@@ -137,6 +137,13 @@ public:
 	void readToPixels(ofFloatPixels & pixels, int attachmentPoint = 0) const;
 
 #ifndef TARGET_OPENGLES
+	/// \brief Start reading the fbo to pixels without waiting for the GPU,
+	/// they arrive some frames later through the readback.
+	/// \sa ofPixelsReadback_
+	void readToPixelsAsync(ofPixelsReadback & readback, int attachmentPoint = 0) const;
+	void readToPixelsAsync(ofShortPixelsReadback & readback, int attachmentPoint = 0) const;
+	void readToPixelsAsync(ofFloatPixelsReadback & readback, int attachmentPoint = 0) const;
+
 	/// \brief Copy the fbo to an ofBufferObject.
 	/// \param buffer the target buffer to copy to.
 	void copyTo(ofBufferObject & buffer) const;
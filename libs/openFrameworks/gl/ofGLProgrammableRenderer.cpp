@@ -28,11 +28,30 @@ static const string COLOR_UNIFORM="globalColor";
 static const string USE_TEXTURE_UNIFORM="usingTexture";
 static const string USE_COLORS_UNIFORM="usingColors";
 static const string BITMAP_STRING_UNIFORM="bitmapText";
+static const string SRC_TEX_UNIT0_UNIFORM="src_tex_unit0";
+static const string SRC_TEX_UNIT1_UNIFORM="src_tex_unit1";
+static const string DEFAULT_UNIFORMS_BLOCK="ofDefaultUniforms";
 
 
 const string ofGLProgrammableRenderer::TYPE="ProgrammableGL";
+// high enough not to collide with the binding points applications usually
+// choose, every implementation has at least 36
+const GLuint ofGLProgrammableRenderer::DEFAULT_UNIFORMS_BINDING=15;
 static bool programmableRendererCreated = false;
 
+#ifndef TARGET_OPENGLES
+// initial size of the streaming buffer for meshes without a vbo, it grows
+// if needed
+static const GLsizeiptr streamingBufferSize = 4 * 1024 * 1024;
+// initial size of the buffer for the ofDefaultUniforms block, a few thousand
+// writes per frame
+static const GLsizeiptr uniformBufferSize = 1024 * 1024;
+#endif
+
+// keeps the indices of the shape batch in the range of ofIndexType on every
+// platform and bounds the size of each upload
+static const size_t maxShapeBatchVertices = 65536;
+
 bool ofIsGLProgrammableRenderer(){
 	return programmableRendererCreated;
 }
@@ -52,6 +71,9 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 	rectMesh.getVertices().resize(4);
 
 	bitmapStringEnabled = false;
+	bitmapStringBatching = false;
+	shapeBatching = false;
+	flushingShapes = false;
     verticesEnabled = true;
     colorsEnabled = false;
     texCoordsEnabled = false;
@@ -65,6 +87,12 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 	uniqueShader = false;
 
 	currentShader = nullptr;
+	currentShaderHasUniformsBlock = false;
+	defaultUniformsChanged = false;
+#ifndef TARGET_OPENGLES
+	uniformBufferAlignment = 256;
+	uniformsBlockSupported = false;
+#endif
 
 	currentTextureTarget = OF_NO_TEXTURE;
 	currentMaterial = nullptr;
@@ -103,9 +131,18 @@ void ofGLProgrammableRenderer::startRender() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::finishRender() {
+	flushShapes();
+	flushBitmapStrings();
+#ifndef TARGET_OPENGLES
+	streamingBuffer.endFrame();
+	uniformBuffer.endFrame();
+#endif
 	if (!uniqueShader) {
 		glUseProgram(0);
-		if(!usingCustomShader) currentShader = nullptr;
+		if(!usingCustomShader){
+			currentShader = nullptr;
+			currentShaderHasUniformsBlock = false;
+		}
 	}
 	matrixStack.clearStacks();
 	framebufferIdStack.clear();
@@ -114,6 +151,7 @@ void ofGLProgrammableRenderer::finishRender() {
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
 	if (vertexData.getVertices().empty()) return;
+	const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 	
 	
 	// tig: note that for GL3+ we use glPolygonMode to draw wireframes or filled meshes, and not the primitive mode.
@@ -176,15 +214,23 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	}else{
 		glDrawArrays(drawMode, 0, vertexData.getNumVertices());
 	}
+	stats.drawCalls++;
 #else
 	
 
 #ifndef TARGET_OPENGLES
-	meshVbo.setMesh(vertexData, GL_STREAM_DRAW, useColors, useTextures, useNormals);
+	int firstIndex = streamMesh(vertexData, useColors, useTextures, useNormals);
 	glPolygonMode(GL_FRONT_AND_BACK, ofGetGLPolyMode(renderType));
 	GLenum drawMode = ofGetGLPrimitiveMode(vertexData.getMode());
+	if(vertexData.hasIndices()) {
+		drawElements(meshVbo,drawMode, vertexData.getNumIndices(), firstIndex);
+	} else {
+		draw(meshVbo, drawMode, 0, vertexData.getNumVertices());
+	}
 #else
 	meshVbo.setMesh(vertexData, GL_STATIC_DRAW, useColors, useTextures, useNormals);
+	stats.bufferUploads++;
+	stats.uploadedBytes += vertexData.getNumVertices() * sizeof(glm::vec3) + vertexData.getNumIndices() * sizeof(ofIndexType);
 	GLenum drawMode;
 	switch(renderType){
 	case OF_MESH_POINTS:
@@ -200,12 +246,12 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 		drawMode = ofGetGLPrimitiveMode(vertexData.getMode());
 		break;
 	}
-#endif
 	if(meshVbo.getUsingIndices()) {
 		drawElements(meshVbo,drawMode, meshVbo.getNumIndices());
 	} else {
 		draw(meshVbo, drawMode, 0, vertexData.getNumVertices());
 	}
+#endif
 	
 	// tig: note further that we could glGet() and store the current polygon mode, but don't, since that would
 	// infer a massive performance hit. instead, we revert the glPolygonMode to mirror the current ofFill state
@@ -222,6 +268,84 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	//if (bSmoothHinted) endSmoothing();
 }
 
+#ifndef TARGET_OPENGLES
+//----------------------------------------------------------
+int ofGLProgrammableRenderer::streamMesh(const ofMesh & mesh, bool useColors, bool useTextures, bool useNormals) const{
+	useColors &= mesh.hasColors();
+	useTextures &= mesh.hasTexCoords();
+	useNormals &= mesh.hasNormals();
+
+	// all the attributes go in one range of the streaming buffer, one after
+	// another and aligned so the indices start at a whole index
+	auto aligned = [](size_t bytes){
+		return GLintptr((bytes + 15) / 16 * 16);
+	};
+	size_t verticesBytes = mesh.getNumVertices() * sizeof(glm::vec3);
+	size_t colorsBytes = useColors ? mesh.getNumColors() * sizeof(ofFloatColor) : 0;
+	size_t texCoordsBytes = useTextures ? mesh.getNumTexCoords() * sizeof(glm::vec2) : 0;
+	size_t normalsBytes = useNormals ? mesh.getNumNormals() * sizeof(glm::vec3) : 0;
+	size_t indicesBytes = mesh.getNumIndices() * sizeof(ofIndexType);
+	GLintptr colorsOffset = aligned(verticesBytes);
+	GLintptr texCoordsOffset = colorsOffset + aligned(colorsBytes);
+	GLintptr normalsOffset = texCoordsOffset + aligned(texCoordsBytes);
+	GLintptr indicesOffset = normalsOffset + aligned(normalsBytes);
+
+	if(!streamingBuffer.isAllocated()){
+		streamingBuffer.allocate(streamingBufferSize);
+	}
+	GLintptr offset = streamingBuffer.reserve(indicesOffset + indicesBytes);
+	auto & buffer = streamingBuffer.getBuffer();
+
+	streamingBuffer.update(offset, mesh.getVerticesPointer(), verticesBytes);
+	meshVbo.setVertexBuffer(buffer, 3, sizeof(glm::vec3), offset);
+	if(useColors){
+		streamingBuffer.update(offset + colorsOffset, mesh.getColorsPointer(), colorsBytes);
+		meshVbo.setColorBuffer(buffer, sizeof(ofFloatColor), offset + colorsOffset);
+	}else{
+		meshVbo.disableColors();
+	}
+	if(useTextures){
+		streamingBuffer.update(offset + texCoordsOffset, mesh.getTexCoordsPointer(), texCoordsBytes);
+		meshVbo.setTexCoordBuffer(buffer, sizeof(glm::vec2), offset + texCoordsOffset);
+	}else{
+		meshVbo.disableTexCoords();
+	}
+	if(useNormals){
+		streamingBuffer.update(offset + normalsOffset, mesh.getNormalsPointer(), normalsBytes);
+		meshVbo.setNormalBuffer(buffer, sizeof(glm::vec3), offset + normalsOffset);
+	}else{
+		meshVbo.disableNormals();
+	}
+	if(indicesBytes){
+		streamingBuffer.update(offset + indicesOffset, mesh.getIndexPointer(), indicesBytes);
+		meshVbo.setIndexBuffer(buffer);
+	}else{
+		meshVbo.disableIndices();
+	}
+
+	stats.bufferUploads++;
+	stats.uploadedBytes += verticesBytes + colorsBytes + texCoordsBytes + normalsBytes + indicesBytes;
+	return (offset + indicesOffset) / sizeof(ofIndexType);
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::streamVertices(const vector<glm::vec3> & vertices) const{
+	if(!streamingBuffer.isAllocated()){
+		streamingBuffer.allocate(streamingBufferSize);
+	}
+	size_t bytes = vertices.size() * sizeof(glm::vec3);
+	GLintptr offset = streamingBuffer.write(vertices.data(), bytes);
+	meshVbo.setVertexBuffer(streamingBuffer.getBuffer(), 3, sizeof(glm::vec3), offset);
+	meshVbo.disableColors();
+	meshVbo.disableTexCoords();
+	meshVbo.disableNormals();
+	meshVbo.disableIndices();
+
+	stats.bufferUploads++;
+	stats.uploadedBytes += bytes;
+}
+#endif
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVboMesh & mesh, ofPolyRenderMode renderType) const{
 	drawInstanced(mesh,renderType,1);
@@ -296,6 +420,7 @@ void ofGLProgrammableRenderer::draw(const ofNode& node) const{
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const{
 	if(poly.getVertices().empty()) return;
+	const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 
 	// use smoothness, if requested:
 	//if (bSmoothHinted) startSmoothing();
@@ -310,10 +435,18 @@ void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const{
 	GLenum drawMode = poly.isClosed()?GL_LINE_LOOP:GL_LINE_STRIP;
 
 	glDrawArrays(drawMode, 0, poly.size());
+	stats.drawCalls++;
+
+#elif !defined(TARGET_OPENGLES)
+
+	streamVertices(poly.getVertices());
+	draw(meshVbo, poly.isClosed()?GL_LINE_LOOP:GL_LINE_STRIP, 0, poly.size());
 
 #else
 
 	meshVbo.setVertexData(&poly.getVertices()[0], poly.size(), GL_DYNAMIC_DRAW);
+	stats.bufferUploads++;
+	stats.uploadedBytes += poly.size() * sizeof(glm::vec3);
 	meshVbo.draw(poly.isClosed()?GL_LINE_LOOP:GL_LINE_STRIP, 0, poly.size());
 
 #endif
@@ -421,9 +554,11 @@ void ofGLProgrammableRenderer::draw(const ofBaseVideoDraws & video, float x, flo
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int first, int total) const{
 	if(vbo.getUsingVerts()) {
+		const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 		glDrawArrays(drawMode, first, total);
+		stats.drawCalls++;
 		vbo.unbind();
 	}
 }
@@ -431,6 +566,7 @@ void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int firs
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode, int amt, int offsetelements) const{
 	if(vbo.getUsingVerts()) {
+		const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -438,6 +574,7 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
 #else
         glDrawElements(drawMode, amt, GL_UNSIGNED_INT, (void*)(sizeof(ofIndexType) * offsetelements));
 #endif
+		stats.drawCalls++;
 		vbo.unbind();
 	}
 }
@@ -445,6 +582,7 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode, int first, int total, int primCount) const{
 	if(vbo.getUsingVerts()) {
+		const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -455,6 +593,7 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 		// glDrawArraysInstanced(drawMode, first, total, primCount);
 #else
 		glDrawArraysInstanced(drawMode, first, total, primCount);
+		stats.drawCalls++;
 #endif
 		vbo.unbind();
 	}
@@ -463,6 +602,7 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint drawMode, int amt, int primCount) const{
 	if(vbo.getUsingVerts()) {
+		const_cast<ofGLProgrammableRenderer*>(this)->flushShapes();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -473,6 +613,7 @@ void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint d
         // glDrawElementsInstanced(drawMode, amt, GL_UNSIGNED_SHORT, nullptr, primCount);
 #else
         glDrawElementsInstanced(drawMode, amt, GL_UNSIGNED_INT, nullptr, primCount);
+		stats.drawCalls++;
 #endif
 		vbo.unbind();
 	}
@@ -784,25 +925,33 @@ glm::mat4 ofGLProgrammableRenderer::getCurrentNormalMatrix() const{
 void ofGLProgrammableRenderer::uploadCurrentMatrix(){
 	if(!currentShader) return;
 	// uploads the current matrix to the current shader.
+	if(currentShaderHasUniformsBlock){
+		defaultUniformsChanged = true;
+	}
 	switch(matrixStack.getCurrentMatrixMode()){
 	case OF_MATRIX_MODELVIEW:
-		currentShader->setUniformMatrix4f(MODEL_MATRIX_UNIFORM, matrixStack.getModelMatrix());
-		currentShader->setUniformMatrix4f(VIEW_MATRIX_UNIFORM, matrixStack.getViewMatrix());
-		currentShader->setUniformMatrix4f(MODELVIEW_MATRIX_UNIFORM, matrixStack.getModelViewMatrix());
-		currentShader->setUniformMatrix4f(MODELVIEW_PROJECTION_MATRIX_UNIFORM, matrixStack.getModelViewProjectionMatrix());
+		if(!currentShaderHasUniformsBlock){
+			currentShader->setUniformMatrix4f(currentUniforms.modelMatrix, matrixStack.getModelMatrix());
+			currentShader->setUniformMatrix4f(currentUniforms.viewMatrix, matrixStack.getViewMatrix());
+			currentShader->setUniformMatrix4f(currentUniforms.modelViewMatrix, matrixStack.getModelViewMatrix());
+			currentShader->setUniformMatrix4f(currentUniforms.modelViewProjectionMatrix, matrixStack.getModelViewProjectionMatrix());
+		}
 		if(currentMaterial){
 			currentMaterial->uploadMatrices(*currentShader,*this);
 		}
 		break;
 	case OF_MATRIX_PROJECTION:
-		currentShader->setUniformMatrix4f(PROJECTION_MATRIX_UNIFORM, matrixStack.getProjectionMatrix());
-		currentShader->setUniformMatrix4f(MODELVIEW_PROJECTION_MATRIX_UNIFORM, matrixStack.getModelViewProjectionMatrix());
+		if(!currentShaderHasUniformsBlock){
+			currentShader->setUniformMatrix4f(currentUniforms.projectionMatrix, matrixStack.getProjectionMatrix());
+			currentShader->setUniformMatrix4f(currentUniforms.modelViewProjectionMatrix, matrixStack.getModelViewProjectionMatrix());
+		}
 		break;
 	case OF_MATRIX_TEXTURE:
-		currentShader->setUniformMatrix4f(TEXTURE_MATRIX_UNIFORM, matrixStack.getTextureMatrix());
+		if(!currentShaderHasUniformsBlock){
+			currentShader->setUniformMatrix4f(currentUniforms.textureMatrix, matrixStack.getTextureMatrix());
+		}
 		break;
 	}
-
 }
 
 //----------------------------------------------------------
@@ -848,8 +997,10 @@ void ofGLProgrammableRenderer::setColor(int _r, int _g, int _b, int _a){
 	ofColor newColor(_r,_g,_b,_a);
 	if(newColor!=currentStyle.color){
         currentStyle.color = newColor;
-		if(currentShader){
-			currentShader->setUniform4f(COLOR_UNIFORM,_r/255.,_g/255.,_b/255.,_a/255.);
+		if(currentShaderHasUniformsBlock){
+			defaultUniformsChanged = true;
+		}else if(currentShader){
+			currentShader->setUniform4f(currentUniforms.globalColor,_r/255.,_g/255.,_b/255.,_a/255.);
 		}
 	}
 }
@@ -874,11 +1025,15 @@ void ofGLProgrammableRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(){
+	flushShapes();
+	flushBitmapStrings();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(float r, float g, float b, float a) {
+	flushShapes();
+	flushBitmapStrings();
 	glClearColor(r / 255., g / 255., b / 255., a / 255.);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -890,6 +1045,8 @@ void ofGLProgrammableRenderer::clear(float brightness, float a) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clearAlpha() {
+	flushShapes();
+	flushBitmapStrings();
 	glColorMask(0, 0, 0, 1);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -919,6 +1076,8 @@ void ofGLProgrammableRenderer::setBackgroundColor(const ofColor & c){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::background(const ofColor & c){
+	flushShapes();
+	flushBitmapStrings();
 	setBackgroundColor(c);
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 }
@@ -994,6 +1153,8 @@ void ofGLProgrammableRenderer::setLineWidth(float lineWidth){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setDepthTest(bool depthTest) {
+	flushShapes();
+	flushBitmapStrings();
 	if(depthTest) {
 		glEnable(GL_DEPTH_TEST);
 	} else {
@@ -1018,6 +1179,10 @@ void ofGLProgrammableRenderer::endSmoothing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setBlendMode(ofBlendMode blendMode){
+	if(blendMode != currentStyle.blendingMode){
+		flushShapes();
+		flushBitmapStrings();
+	}
 	switch (blendMode){
 		case OF_BLENDMODE_DISABLED:
 			glDisable(GL_BLEND);
@@ -1084,6 +1249,8 @@ void ofGLProgrammableRenderer::disablePointSprites(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableAntiAliasing(){
+	flushShapes();
+	flushBitmapStrings();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glEnable(GL_MULTISAMPLE);
 #endif
@@ -1091,6 +1258,8 @@ void ofGLProgrammableRenderer::enableAntiAliasing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableAntiAliasing(){
+	flushShapes();
+	flushBitmapStrings();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glDisable(GL_MULTISAMPLE);
 #endif
@@ -1107,7 +1276,7 @@ void ofGLProgrammableRenderer::setAlphaBitmapText(bool bitmapText){
 	bitmapStringEnabled = bitmapText;
 
 	if(wasBitmapStringEnabled!=bitmapText){
-		if(currentShader) currentShader->setUniform1f(BITMAP_STRING_UNIFORM,bitmapText);
+		if(currentShader) currentShader->setUniform1f(currentUniforms.bitmapText,bitmapText);
 	}
 }
 
@@ -1195,12 +1364,19 @@ void ofGLProgrammableRenderer::setAttributes(bool vertices, bool color, bool tex
 	}
 
 	bool usingTexture = tex & (currentTextureTarget!=OF_NO_TEXTURE);
-	if(wasUsingTexture!=usingTexture){
-		if(currentShader) currentShader->setUniform1f(USE_TEXTURE_UNIFORM,usingTexture);
-	}
-	if(wasColorsEnabled!=color){
-		if(currentShader) currentShader->setUniform1f(USE_COLORS_UNIFORM,color);
+	if(currentShaderHasUniformsBlock){
+		defaultUniformsChanged |= wasUsingTexture!=usingTexture || wasColorsEnabled!=color;
+	}else if(currentShader){
+		if(wasUsingTexture!=usingTexture){
+			currentShader->setUniform1f(currentUniforms.usingTexture,usingTexture);
+		}
+		if(wasColorsEnabled!=color){
+			currentShader->setUniform1f(currentUniforms.usingColors,color);
+		}
 	}
+	// this is called right before every draw so the block is only written
+	// once for all the changes since the previous one
+	updateDefaultUniformsBlock();
 #if defined(TARGET_OPENGLES) && !defined(TARGET_EMSCRIPTEN)
 	if(vertices){
 		glEnableClientState(GL_VERTEX_ARRAY);
@@ -1235,11 +1411,21 @@ void ofGLProgrammableRenderer::enableTextureTarget(const ofTexture & tex, int te
 
 	bool usingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	if(wasUsingTexture!=usingTexture){
-		if(currentShader) currentShader->setUniform1f(USE_TEXTURE_UNIFORM,usingTexture);
+		if(currentShaderHasUniformsBlock){
+			defaultUniformsChanged = true;
+		}else if(currentShader){
+			currentShader->setUniform1f(currentUniforms.usingTexture,usingTexture);
+		}
 	}
 
 	if((currentTextureTarget!=OF_NO_TEXTURE) && currentShader){
-		currentShader->setUniformTexture("src_tex_unit"+ofToString(textureLocation),tex,textureLocation);
+		if(textureLocation==0){
+			currentShader->setUniformTexture(currentUniforms.srcTexUnit0,tex,textureLocation);
+		}else if(textureLocation==1){
+			currentShader->setUniformTexture(currentUniforms.srcTexUnit1,tex,textureLocation);
+		}else{
+			currentShader->setUniformTexture("src_tex_unit"+ofToString(textureLocation),tex,textureLocation);
+		}
 	}
 }
 
@@ -1254,7 +1440,11 @@ void ofGLProgrammableRenderer::disableTextureTarget(int textureTarget, int textu
 
 	bool usingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	if(wasUsingTexture!=usingTexture){
-		if(currentShader) currentShader->setUniform1f(USE_TEXTURE_UNIFORM,usingTexture);
+		if(currentShaderHasUniformsBlock){
+			defaultUniformsChanged = true;
+		}else if(currentShader){
+			currentShader->setUniform1f(currentUniforms.usingTexture,usingTexture);
+		}
 	}
 	glActiveTexture(GL_TEXTURE0+textureLocation);
 	glBindTexture(textureTarget, 0);
@@ -1292,9 +1482,16 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader){
     if(currentShader && *currentShader==shader){
 		return;
     }
+	flushShapes();
+	// the batched strings are drawn with the default shaders, which the
+	// draw of the batch itself binds
+	if(!settingDefaultShader){
+		flushBitmapStrings();
+	}
 	glUseProgram(shader.getProgram());
 
 	currentShader = &shader;
+	lookupDefaultUniforms();
 	uploadMatrices();
 	setDefaultUniforms();
 	if(!settingDefaultShader){
@@ -1304,6 +1501,7 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShader & shader){
+	flushShapes();
 	glUseProgram(0);
 	usingCustomShader = false;
 	beginDefaultShader();
@@ -1312,6 +1510,8 @@ void ofGLProgrammableRenderer::unbind(const ofShader & shader){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::begin(const ofFbo & fbo, ofFboBeginMode mode){
+	flushShapes();
+	flushBitmapStrings();
 	pushView();
     pushStyle();
     if(mode & ofFboBeginMode::MatrixFlip){
@@ -1349,6 +1549,8 @@ void ofGLProgrammableRenderer::bind(const ofFbo & fbo){
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have 
 	// different implementations.
+	flushShapes();
+	flushBitmapStrings();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fbo.getId();
 	glBindFramebuffer(GL_FRAMEBUFFER, currentFramebufferId);
@@ -1367,6 +1569,8 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have
 	// different implementations.
+	flushShapes();
+	flushBitmapStrings();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fboSrc.getId();
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, currentFramebufferId);
@@ -1378,6 +1582,8 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
+	flushShapes();
+	flushBitmapStrings();
 	if(framebufferIdStack.empty()){
 		ofLogError() << "unbalanced fbo bind/unbind binding default framebuffer";
 		currentFramebufferId = defaultFramebufferId;
@@ -1391,11 +1597,14 @@ void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material){
+	flushShapes();
+	flushBitmapStrings();
     currentMaterial = &material;
     // FIXME: this invalidates the previous shader to avoid that
     // when binding 2 materials one after another, the second won't
     // get the right parameters.
     currentShader = nullptr;
+    currentShaderHasUniformsBlock = false;
     beginDefaultShader();
 }
 
@@ -1431,6 +1640,7 @@ bool ofGLProgrammableRenderer::getLightingEnabled(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofTexture & texture, int location){
+	flushShapes();
 	//we could check if it has been allocated - but we don't do that in draw()
 	if(texture.getAlphaMask()){
 		setAlphaMaskTex(*texture.getAlphaMask());
@@ -1495,12 +1705,16 @@ void ofGLProgrammableRenderer::unbind(const ofCamera & camera){
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::uploadMatrices(){
 	if(!currentShader) return;
-	currentShader->setUniformMatrix4f(MODEL_MATRIX_UNIFORM, matrixStack.getModelMatrix());
-	currentShader->setUniformMatrix4f(VIEW_MATRIX_UNIFORM, matrixStack.getViewMatrix());
-	currentShader->setUniformMatrix4f(MODELVIEW_MATRIX_UNIFORM, matrixStack.getModelViewMatrix());
-	currentShader->setUniformMatrix4f(PROJECTION_MATRIX_UNIFORM, matrixStack.getProjectionMatrix());
-	currentShader->setUniformMatrix4f(TEXTURE_MATRIX_UNIFORM, matrixStack.getTextureMatrix());
-	currentShader->setUniformMatrix4f(MODELVIEW_PROJECTION_MATRIX_UNIFORM, matrixStack.getModelViewProjectionMatrix());
+	if(currentShaderHasUniformsBlock){
+		defaultUniformsChanged = true;
+	}else{
+		currentShader->setUniformMatrix4f(currentUniforms.modelMatrix, matrixStack.getModelMatrix());
+		currentShader->setUniformMatrix4f(currentUniforms.viewMatrix, matrixStack.getViewMatrix());
+		currentShader->setUniformMatrix4f(currentUniforms.modelViewMatrix, matrixStack.getModelViewMatrix());
+		currentShader->setUniformMatrix4f(currentUniforms.projectionMatrix, matrixStack.getProjectionMatrix());
+		currentShader->setUniformMatrix4f(currentUniforms.textureMatrix, matrixStack.getTextureMatrix());
+		currentShader->setUniformMatrix4f(currentUniforms.modelViewProjectionMatrix, matrixStack.getModelViewProjectionMatrix());
+	}
 	if(currentMaterial){
 		currentMaterial->uploadMatrices(*currentShader,*this);
 	}
@@ -1509,16 +1723,77 @@ void ofGLProgrammableRenderer::uploadMatrices(){
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setDefaultUniforms(){
 	if(!currentShader) return;
-	currentShader->setUniform4f(COLOR_UNIFORM, currentStyle.color.r/255.,currentStyle.color.g/255.,currentStyle.color.b/255.,currentStyle.color.a/255.);
-	bool usingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
-	currentShader->setUniform1f(USE_TEXTURE_UNIFORM,usingTexture);
-	currentShader->setUniform1f(USE_COLORS_UNIFORM,colorsEnabled);
+	if(currentShaderHasUniformsBlock){
+		defaultUniformsChanged = true;
+	}else{
+		currentShader->setUniform4f(currentUniforms.globalColor, currentStyle.color.r/255.,currentStyle.color.g/255.,currentStyle.color.b/255.,currentStyle.color.a/255.);
+		bool usingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
+		currentShader->setUniform1f(currentUniforms.usingTexture,usingTexture);
+		currentShader->setUniform1f(currentUniforms.usingColors,colorsEnabled);
+	}
 	if(currentMaterial){
 		currentMaterial->updateMaterial(*currentShader,*this);
 		currentMaterial->updateLights(*currentShader,*this);
 	}
 }
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::lookupDefaultUniforms(){
+	currentUniforms.modelMatrix = currentShader->getUniform(MODEL_MATRIX_UNIFORM);
+	currentUniforms.viewMatrix = currentShader->getUniform(VIEW_MATRIX_UNIFORM);
+	currentUniforms.modelViewMatrix = currentShader->getUniform(MODELVIEW_MATRIX_UNIFORM);
+	currentUniforms.projectionMatrix = currentShader->getUniform(PROJECTION_MATRIX_UNIFORM);
+	currentUniforms.textureMatrix = currentShader->getUniform(TEXTURE_MATRIX_UNIFORM);
+	currentUniforms.modelViewProjectionMatrix = currentShader->getUniform(MODELVIEW_PROJECTION_MATRIX_UNIFORM);
+	currentUniforms.globalColor = currentShader->getUniform(COLOR_UNIFORM);
+	currentUniforms.usingTexture = currentShader->getUniform(USE_TEXTURE_UNIFORM);
+	currentUniforms.usingColors = currentShader->getUniform(USE_COLORS_UNIFORM);
+	currentUniforms.bitmapText = currentShader->getUniform(BITMAP_STRING_UNIFORM);
+	currentUniforms.srcTexUnit0 = currentShader->getUniform(SRC_TEX_UNIT0_UNIFORM);
+	currentUniforms.srcTexUnit1 = currentShader->getUniform(SRC_TEX_UNIT1_UNIFORM);
+
+	currentShaderHasUniformsBlock = false;
+#ifndef TARGET_OPENGLES
+	if(uniformsBlockSupported){
+		GLint index = currentShader->getUniformBlockIndex(DEFAULT_UNIFORMS_BLOCK);
+		if(index != -1){
+			glUniformBlockBinding(currentShader->getProgram(), index, DEFAULT_UNIFORMS_BINDING);
+			currentShaderHasUniformsBlock = true;
+		}
+	}
+#endif
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::updateDefaultUniformsBlock(){
+#ifndef TARGET_OPENGLES
+	if(!defaultUniformsChanged || !currentShaderHasUniformsBlock){
+		return;
+	}
+	defaultUniformsChanged = false;
+	if(!uniformBuffer.isAllocated()){
+		uniformBuffer.allocate(uniformBufferSize);
+	}
+
+	DefaultUniformsBlock block;
+	block.modelMatrix = matrixStack.getModelMatrix();
+	block.viewMatrix = matrixStack.getViewMatrix();
+	block.modelViewMatrix = matrixStack.getModelViewMatrix();
+	block.projectionMatrix = matrixStack.getProjectionMatrix();
+	block.textureMatrix = matrixStack.getTextureMatrix();
+	block.modelViewProjectionMatrix = matrixStack.getModelViewProjectionMatrix();
+	block.globalColor = glm::vec4(currentStyle.color.r/255.f,currentStyle.color.g/255.f,currentStyle.color.b/255.f,currentStyle.color.a/255.f);
+	block.usingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
+	block.usingColors = colorsEnabled;
+
+	GLintptr offset = uniformBuffer.write(&block, sizeof(block), uniformBufferAlignment);
+	if(offset >= 0){
+		uniformBuffer.getBuffer().bindRange(GL_UNIFORM_BUFFER, DEFAULT_UNIFORMS_BINDING, offset, sizeof(block));
+		stats.uniformBlockWrites++;
+	}
+#endif
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::beginDefaultShader(){
 	if(usingCustomShader && !currentMaterial)	return;
@@ -1601,7 +1876,7 @@ void ofGLProgrammableRenderer::drawLine(float x1, float y1, float z1, float x2,
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->startSmoothing();
     
-	draw(lineMesh,OF_MESH_FILL,false,false,false);
+	drawShape(lineMesh);
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->endSmoothing();
@@ -1626,7 +1901,7 @@ void ofGLProgrammableRenderer::drawRectangle(float x, float y, float z, float w,
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	rectMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP);
-	draw(rectMesh,OF_MESH_FILL,false,false,false);
+	drawShape(rectMesh);
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1643,7 +1918,7 @@ void ofGLProgrammableRenderer::drawTriangle(float x1, float y1, float z1, float
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	triangleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_STRIP : OF_PRIMITIVE_LINE_LOOP);
-	draw(triangleMesh,OF_MESH_FILL,false,false,false);
+	drawShape(triangleMesh);
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1661,7 +1936,7 @@ void ofGLProgrammableRenderer::drawCircle(float x, float y, float z,  float radi
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-	draw(circleMesh,OF_MESH_FILL,false,false,false);
+	drawShape(circleMesh);
 	
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1681,7 +1956,7 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-	draw(circleMesh,OF_MESH_FILL,false,false,false);
+	drawShape(circleMesh);
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1815,12 +2090,27 @@ void ofGLProgrammableRenderer::drawString(string textString, float x, float y, f
 
 	// (c) enable texture once before we start drawing each char (no point turning it on and off constantly)
 	//We do this because its way faster
-	mutThis->setAlphaBitmapText(true);
-	ofMesh charMesh = bitmapFont.getMesh(textString, sx, sy, currentStyle.drawBitmapMode, isVFlipped());
-	mutThis->bind(bitmapFont.getTexture(),0);
-	draw(charMesh,OF_MESH_FILL,false,true,false);
-	mutThis->unbind(bitmapFont.getTexture(),0);
-	mutThis->setAlphaBitmapText(false);
+	// strings drawn with a custom shader or a material use it, like shapes
+	if(bitmapStringBatching && !usingCustomShader && !currentMaterial){
+		// the batch can only be drawn in one viewport
+		ofRectangle nativeViewport = getNativeViewport();
+		if(nativeViewport != bitmapStringBatchViewport){
+			mutThis->flushBitmapStrings();
+			mutThis->bitmapStringBatchViewport = nativeViewport;
+		}
+		mutThis->bitmapFont.addToBatch(textString, sx, sy, isVFlipped(), matrixStack.getModelViewProjectionMatrix(), currentStyle.color);
+	}else{
+		mutThis->setAlphaBitmapText(true);
+		mutThis->bind(bitmapFont.getTexture(),0);
+		if(sx == 0 && sy == 0){
+			bitmapFont.getCachedMesh(textString, bitmapStringMesh, isVFlipped());
+			draw(bitmapStringMesh,OF_MESH_FILL,false,true,false);
+		}else{
+			draw(bitmapFont.getMesh(textString, sx, sy, currentStyle.drawBitmapMode, isVFlipped()),OF_MESH_FILL,false,true,false);
+		}
+		mutThis->unbind(bitmapFont.getTexture(),0);
+		mutThis->setAlphaBitmapText(false);
+	}
 
 
 	if (hasViewport){
@@ -1840,6 +2130,162 @@ void ofGLProgrammableRenderer::drawString(string textString, float x, float y, f
 }
 
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setBitmapStringBatching(bool batching){
+	if(!batching){
+		flushBitmapStrings();
+	}
+	bitmapStringBatching = batching;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::isBitmapStringBatching() const{
+	return bitmapStringBatching;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBitmapStrings(){
+	const ofMesh & batch = bitmapFont.getBatch();
+	if(batch.getNumVertices() == 0){
+		return;
+	}
+
+	// the batch is already in normalized device coordinates of the viewport
+	// where its strings were drawn, so it's drawn without transformations
+	ofMatrixMode previousMatrixMode = matrixStack.getCurrentMatrixMode();
+	pushView();
+	glViewport(bitmapStringBatchViewport.x, bitmapStringBatchViewport.y, bitmapStringBatchViewport.width, bitmapStringBatchViewport.height);
+	matrixMode(OF_MATRIX_PROJECTION);
+	loadMatrix(matrixStack.getOrientationMatrixInverse());
+	matrixMode(OF_MATRIX_MODELVIEW);
+	loadIdentityMatrix();
+
+	setAlphaBitmapText(true);
+	bind(bitmapFont.getTexture(),0);
+	draw(batch,OF_MESH_FILL,true,true,false);
+	unbind(bitmapFont.getTexture(),0);
+	setAlphaBitmapText(false);
+
+	popView();
+	matrixMode(previousMatrixMode);
+	bitmapFont.clearBatch();
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setShapeBatching(bool batching){
+	if(!batching){
+		flushShapes();
+	}
+	shapeBatching = batching;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::isShapeBatching() const{
+	return shapeBatching;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::drawShape(const ofMesh & shape) const{
+	// custom shaders, materials and textures might not use the colors in
+	// the vertices or might need the original coordinates
+	bool canBatch = shapeBatching && !usingCustomShader && !currentMaterial && !uniqueShader
+		&& currentTextureTarget == OF_NO_TEXTURE && shape.getNumVertices() <= maxShapeBatchVertices;
+	if(canBatch){
+		const_cast<ofGLProgrammableRenderer*>(this)->addToShapeBatch(shape);
+	}else{
+		draw(shape,OF_MESH_FILL,false,false,false);
+	}
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::addToShapeBatch(const ofMesh & shape){
+	ofPrimitiveMode shapeMode = shape.getMode();
+	bool filled = shapeMode == OF_PRIMITIVE_TRIANGLE_FAN || shapeMode == OF_PRIMITIVE_TRIANGLE_STRIP;
+	ofPrimitiveMode batchMode = filled ? OF_PRIMITIVE_TRIANGLES : OF_PRIMITIVE_LINES;
+	size_t numVertices = shape.getNumVertices();
+
+	const glm::mat4 & projection = matrixStack.getProjectionMatrix();
+	ofRectangle nativeViewport = getNativeViewport();
+	if(shapeBatch.getMode() != batchMode || shapeBatch.getNumVertices() + numVertices > maxShapeBatchVertices
+			|| projection != shapeBatchProjection || nativeViewport != shapeBatchViewport){
+		flushShapes();
+		shapeBatch.setMode(batchMode);
+		shapeBatchProjection = projection;
+		shapeBatchViewport = nativeViewport;
+	}
+
+	auto & vertices = shapeBatch.getVertices();
+	auto & colors = shapeBatch.getColors();
+	auto & indices = shapeBatch.getIndices();
+	ofIndexType first = vertices.size();
+	const glm::mat4 & modelView = matrixStack.getModelViewMatrix();
+	if(modelView == glm::mat4(1.0)){
+		vertices.insert(vertices.end(), shape.getVertices().begin(), shape.getVertices().end());
+	}else{
+		for(auto & v: shape.getVertices()){
+			vertices.push_back(glm::vec3(modelView * glm::vec4(v, 1.0)));
+		}
+	}
+	colors.resize(vertices.size(), ofFloatColor(currentStyle.color));
+
+	// the triangle strips are only used for single triangles, so they can
+	// be added as fans too
+	if(filled){
+		for(size_t i = 1; i + 1 < numVertices; i++){
+			indices.push_back(first);
+			indices.push_back(first + i);
+			indices.push_back(first + i + 1);
+		}
+	}else{
+		size_t numLines = shapeMode == OF_PRIMITIVE_LINE_LOOP ? numVertices : numVertices - 1;
+		for(size_t i = 0; i < numLines; i++){
+			indices.push_back(first + i);
+			indices.push_back(first + (i + 1) % numVertices);
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushShapes(){
+	// drawing the batch would flush it again
+	if(flushingShapes || shapeBatch.getNumVertices() == 0){
+		return;
+	}
+	flushingShapes = true;
+
+	ofMatrixMode previousMatrixMode = matrixStack.getCurrentMatrixMode();
+	pushView();
+	glViewport(shapeBatchViewport.x, shapeBatchViewport.y, shapeBatchViewport.width, shapeBatchViewport.height);
+	// the orientation is already part of the batch projection
+	matrixMode(OF_MATRIX_PROJECTION);
+	loadMatrix(matrixStack.getOrientationMatrixInverse() * shapeBatchProjection);
+	matrixMode(OF_MATRIX_MODELVIEW);
+	loadIdentityMatrix();
+
+	draw(shapeBatch,OF_MESH_FILL,true,false,false);
+
+	popView();
+	matrixMode(previousMatrixMode);
+	shapeBatch.clear();
+	flushingShapes = false;
+}
+
+//----------------------------------------------------------
+const ofGLProgrammableRenderer::Stats & ofGLProgrammableRenderer::getStats() const{
+#ifndef TARGET_OPENGLES
+	stats.stalls = streamingBuffer.getStats().stalls;
+#endif
+	return stats;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::resetStats(){
+	stats = Stats();
+#ifndef TARGET_OPENGLES
+	streamingBuffer.resetStats();
+#endif
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
@@ -1894,11 +2340,36 @@ static const string fragment_shader_header =
 		"out vec4 fragColor;\n";
 #endif
 
-static const string defaultVertexShader = vertex_shader_header + STRINGIFY(
-	uniform mat4 projectionMatrix;
-	uniform mat4 modelViewMatrix;
-	uniform mat4 textureMatrix;
-	uniform mat4 modelViewProjectionMatrix;
+// the uniforms set by the renderer, shaderSource() replaces them with the
+// ofDefaultUniforms block if the GLSL version has uniform blocks or with
+// one uniform each otherwise
+static const string default_uniforms = "%default_uniforms%\n";
+
+static const string default_uniforms_block =
+		"layout(std140) uniform ofDefaultUniforms{\n"
+		"	mat4 modelMatrix;\n"
+		"	mat4 viewMatrix;\n"
+		"	mat4 modelViewMatrix;\n"
+		"	mat4 projectionMatrix;\n"
+		"	mat4 textureMatrix;\n"
+		"	mat4 modelViewProjectionMatrix;\n"
+		"	vec4 globalColor;\n"
+		"	float usingTexture;\n"
+		"	float usingColors;\n"
+		"};\n";
+
+static const string default_uniforms_loose =
+		"uniform mat4 modelMatrix;\n"
+		"uniform mat4 viewMatrix;\n"
+		"uniform mat4 modelViewMatrix;\n"
+		"uniform mat4 projectionMatrix;\n"
+		"uniform mat4 textureMatrix;\n"
+		"uniform mat4 modelViewProjectionMatrix;\n"
+		"uniform vec4 globalColor;\n"
+		"uniform float usingTexture;\n"
+		"uniform float usingColors;\n";
+
+static const string defaultVertexShader = vertex_shader_header + default_uniforms + STRINGIFY(
 
 	IN vec4  position;
 	IN vec2  texcoord;
@@ -1919,12 +2390,9 @@ static const string defaultVertexShader = vertex_shader_header + STRINGIFY(
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderTexRectColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderTexRectColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2DRect src_tex_unit0;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -1938,12 +2406,9 @@ static const string defaultFragmentShaderTexRectColor = fragment_shader_header +
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderTexRectNoColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderTexRectNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2DRect src_tex_unit0;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -1956,13 +2421,10 @@ static const string defaultFragmentShaderTexRectNoColor = fragment_shader_header
 
 // ----------------------------------------------------------------------
 
-static const string alphaMaskFragmentShaderTexRectNoColor = fragment_shader_header + STRINGIFY(
+static const string alphaMaskFragmentShaderTexRectNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2DRect src_tex_unit0;
 	uniform sampler2DRect src_tex_unit1;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -1975,13 +2437,10 @@ static const string alphaMaskFragmentShaderTexRectNoColor = fragment_shader_head
 
 // ----------------------------------------------------------------------
 
-static const string alphaMaskFragmentShaderTex2DNoColor = fragment_shader_header + STRINGIFY(
+static const string alphaMaskFragmentShaderTex2DNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2D src_tex_unit0;
 	uniform sampler2D src_tex_unit1;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -1994,12 +2453,9 @@ static const string alphaMaskFragmentShaderTex2DNoColor = fragment_shader_header
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderTex2DColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderTex2DColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2D src_tex_unit0;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -2012,12 +2468,9 @@ static const string defaultFragmentShaderTex2DColor = fragment_shader_header + S
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderTex2DNoColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderTex2DNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2D src_tex_unit0;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -2029,12 +2482,9 @@ static const string defaultFragmentShaderTex2DNoColor = fragment_shader_header +
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderOESTexNoColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderOESTexNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
     
     uniform samplerExternalOES src_tex_unit0;
-    uniform float usingTexture;
-    uniform float usingColors;
-    uniform vec4 globalColor;
     
     IN float depth;
     IN vec4 colorVarying;
@@ -2047,12 +2497,9 @@ static const string defaultFragmentShaderOESTexNoColor = fragment_shader_header
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderOESTexColor = fragment_shader_header + STRINGIFY(
+static const string defaultFragmentShaderOESTexColor = fragment_shader_header + default_uniforms + STRINGIFY(
 																							
 	uniform samplerExternalOES src_tex_unit0;
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
 	
 	IN float depth;
 	IN vec4 colorVarying;
@@ -2065,11 +2512,7 @@ static const string defaultFragmentShaderOESTexColor = fragment_shader_header +
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderNoTexColor = fragment_shader_header + STRINGIFY (
-
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
+static const string defaultFragmentShaderNoTexColor = fragment_shader_header + default_uniforms + STRINGIFY (
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -2082,11 +2525,7 @@ static const string defaultFragmentShaderNoTexColor = fragment_shader_header + S
 
 // ----------------------------------------------------------------------
 
-static const string defaultFragmentShaderNoTexNoColor = fragment_shader_header + STRINGIFY(
-
-	uniform float usingTexture;
-	uniform float usingColors;
-	uniform vec4 globalColor;
+static const string defaultFragmentShaderNoTexNoColor = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	IN float depth;
 	IN vec4 colorVarying;
@@ -2099,21 +2538,18 @@ static const string defaultFragmentShaderNoTexNoColor = fragment_shader_header +
 
 // ----------------------------------------------------------------------
 
-static const string bitmapStringVertexShader = vertex_shader_header + STRINGIFY(
-
-	uniform mat4 projectionMatrix;
-	uniform mat4 modelViewMatrix;
-	uniform mat4 textureMatrix;
-	uniform mat4 modelViewProjectionMatrix;
+static const string bitmapStringVertexShader = vertex_shader_header + default_uniforms + STRINGIFY(
 
 	IN vec4  position;
 	IN vec4  color;
 	IN vec2  texcoord;
 
+	OUT vec4 colorVarying;
 	OUT vec2 texCoordVarying;
 
 	void main()
 	{
+		colorVarying = color;
 		texCoordVarying = texcoord;
 		gl_Position = modelViewProjectionMatrix * position;
 	}
@@ -2121,11 +2557,11 @@ static const string bitmapStringVertexShader = vertex_shader_header + STRINGIFY(
 
 // ----------------------------------------------------------------------
 
-static const string bitmapStringFragmentShader = fragment_shader_header + STRINGIFY(
+static const string bitmapStringFragmentShader = fragment_shader_header + default_uniforms + STRINGIFY(
 
 	uniform sampler2D src_tex_unit0;
-	uniform vec4 globalColor;
 
+	IN vec4 colorVarying;
 	IN vec2 texCoordVarying;
 
 	void main()
@@ -2135,7 +2571,8 @@ static const string bitmapStringFragmentShader = fragment_shader_header + STRING
 		// We will not write anything to the framebuffer if we have a transparent pixel
 		// This makes sure we don't mess up our depth buffer.
 		if (tex.a < 0.5) discard;
-		FRAG_COLOR = globalColor * tex;
+		// batched strings have the color of every string in the vertices
+		FRAG_COLOR = mix(globalColor, colorVarying, usingColors) * tex;
 	}
 );
 
@@ -2198,7 +2635,6 @@ static const string uniqueFragmentShader = fragment_shader_header + STRINGIFY(
 // video color space conversion shaders
 static const string FRAGMENT_SHADER_YUY2 = STRINGIFY(
 	uniform SAMPLER src_tex_unit0;\n
-	uniform vec4 globalColor;\n
 
 	IN vec4 colorVarying;\n
 	IN vec2 texCoordVarying;\n
@@ -2234,7 +2670,6 @@ static const string FRAGMENT_SHADER_YUY2 = STRINGIFY(
 static const string FRAGMENT_SHADER_NV12_NV21 = STRINGIFY(
 	uniform SAMPLER Ytex;\n
 	uniform SAMPLER UVtex;\n
-	uniform vec4 globalColor;\n
     uniform vec2 tex_scaleUV;\n
 
 	IN vec4 colorVarying;\n
@@ -2266,7 +2701,6 @@ static const string FRAGMENT_SHADER_PLANAR_YUV = STRINGIFY(
     uniform vec2 tex_scaleY;\n
     uniform vec2 tex_scaleU;\n
     uniform vec2 tex_scaleV;\n
-	uniform vec4 globalColor;\n
 
 	IN vec4 colorVarying;\n
 	IN vec2 texCoordVarying;\n
@@ -2310,9 +2744,19 @@ static string defaultShaderHeader(string header, GLenum textureTarget, int major
 }
 
 
+// uniform blocks are part of GLSL since 1.40, OpenGL 3.1
+static bool defaultUniformsInBlock(int major, int minor){
+#if !defined(TARGET_OPENGLES) && defined(GLEW_ARB_uniform_buffer_object)
+	return (major > 3 || (major == 3 && minor >= 1)) && GLEW_ARB_uniform_buffer_object;
+#else
+	return false;
+#endif
+}
+
 static string shaderSource(const string & src, int major, int minor){
 	string shaderSrc = src;
 	ofStringReplace(shaderSrc,"%glsl_version%",ofGLSLVersionFromGL(major,minor));
+	ofStringReplace(shaderSrc,"%default_uniforms%",defaultUniformsInBlock(major,minor) ? default_uniforms_block : default_uniforms_loose);
 #ifndef TARGET_OPENGLES
 	if(major<4 && minor<2){
 		ofStringReplace(shaderSrc,"%extensions%","#extension GL_ARB_texture_rectangle : enable");
@@ -2330,6 +2774,7 @@ static string shaderOESSource(const string & src, int major, int minor){
 	string shaderSrc = src;
 	ofStringReplace(shaderSrc,"%glsl_version%",ofGLSLVersionFromGL(major,minor));
 	ofStringReplace(shaderSrc,"%extensions%","#extension GL_OES_EGL_image_external : require");
+	ofStringReplace(shaderSrc,"%default_uniforms%",default_uniforms_loose);
 	return shaderSrc;
 }
 #endif
@@ -2385,7 +2830,7 @@ static string videoFragmentShaderSource(const ofBaseVideoDraws & video, int majo
 		header += "#define SAMPLER sampler2DRect\n";
 	}
 #endif
-	return shaderSource(header + src, major, minor);
+	return shaderSource(header + default_uniforms + src, major, minor);
 }
 
 string ofGLProgrammableRenderer::defaultVertexShaderHeader(GLenum textureTarget){
@@ -2411,6 +2856,12 @@ void ofGLProgrammableRenderer::setup(int _major, int _minor){
 
 	major = _major;
 	minor = _minor;
+#ifndef TARGET_OPENGLES
+	uniformsBlockSupported = defaultUniformsInBlock(major, minor);
+	if(uniformsBlockSupported){
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferAlignment);
+	}
+#endif
 #ifdef TARGET_RASPBERRY_PI
 	uniqueShader = true;
 #else
@@ -2651,6 +3102,8 @@ void ofGLProgrammableRenderer::saveFullViewport(ofPixels & pixels){
 }
 
 void ofGLProgrammableRenderer::saveScreen(int x, int y, int w, int h, ofPixels & pixels){
+	flushShapes();
+	flushBitmapStrings();
 
     int sh = getViewportHeight();
 
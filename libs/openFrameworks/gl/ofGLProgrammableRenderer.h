@@ -8,6 +8,7 @@
 #include "ofBitmapFont.h"
 #include "ofPath.h"
 #include "ofMaterial.h"
+#include "ofStreamingBuffer.h"
 
 
 class ofShapeTessellation;
@@ -166,6 +167,63 @@ public:
 	void drawString(std::string text, float x, float y, float z) const;
 	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
 
+	void setBitmapStringBatching(bool batching);
+	bool isBitmapStringBatching() const;
+	void flushBitmapStrings();
+
+	void setShapeBatching(bool batching);
+	bool isShapeBatching() const;
+	void flushShapes();
+
+	/// \brief Counters of the work done by the renderer, to measure the
+	/// effect of batching.
+	struct Stats{
+		/// number of glDraw* calls
+		std::size_t drawCalls = 0;
+		/// number of times the vertices of a mesh or polyline drawn without
+		/// a vbo of its own have been uploaded to the GPU
+		std::size_t bufferUploads = 0;
+		/// bytes of those uploads
+		std::size_t uploadedBytes = 0;
+		/// number of times an upload had to wait for the GPU to finish
+		/// drawing from the same memory
+		std::size_t stalls = 0;
+		/// number of times the ofDefaultUniforms block has been written
+		std::size_t uniformBlockWrites = 0;
+	};
+
+	/// \returns the counters since the renderer was created or since the
+	/// last call to resetStats().
+	const Stats & getStats() const;
+	void resetStats();
+
+	/// \brief Binding point of the ofDefaultUniforms block.
+	///
+	/// With OpenGL 3.1 or later the default shaders get the matrices,
+	/// globalColor, usingTexture and usingColors from a std140 uniform
+	/// block instead of one uniform each:
+	///
+	/// ~~~~{.glsl}
+	/// layout(std140) uniform ofDefaultUniforms{
+	/// 	mat4 modelMatrix;
+	/// 	mat4 viewMatrix;
+	/// 	mat4 modelViewMatrix;
+	/// 	mat4 projectionMatrix;
+	/// 	mat4 textureMatrix;
+	/// 	mat4 modelViewProjectionMatrix;
+	/// 	vec4 globalColor;
+	/// 	float usingTexture;
+	/// 	float usingColors;
+	/// };
+	/// ~~~~
+	///
+	/// The renderer writes it once before a draw if any of them changed,
+	/// instead of setting every uniform when they change. Custom shaders
+	/// can declare the same block to get them the same way, as long as
+	/// they draw through the renderer. Other uniform buffers shouldn't be
+	/// bound to this point.
+	static const GLuint DEFAULT_UNIFORMS_BINDING;
+
 
 	void enableTextureTarget(const ofTexture & tex, int textureLocation);
 	void disableTextureTarget(int textureTarget, int textureLocation);
@@ -244,6 +302,18 @@ private:
 	mutable ofMesh rectMesh;
 	mutable ofMesh lineMesh;
 	mutable ofVbo meshVbo;
+#ifndef TARGET_OPENGLES
+	// meshes and polylines without a vbo of their own are written here and
+	// meshVbo draws them from there
+	mutable ofStreamingBuffer streamingBuffer;
+	// returns the first index of the mesh in the streaming buffer
+	int streamMesh(const ofMesh & mesh, bool useColors, bool useTextures, bool useNormals) const;
+	void streamVertices(const std::vector<glm::vec3> & vertices) const;
+#endif
+
+	// draws one of the meshes above or adds it to the batch
+	void drawShape(const ofMesh & shape) const;
+	void addToShapeBatch(const ofMesh & shape);
 
 	void uploadCurrentMatrix();
 
@@ -255,6 +325,51 @@ private:
 	void uploadMatrices();
 	void setDefaultUniforms();
 
+	// the uniforms the renderer sets on the current shader, looked up once
+	// when it's bound instead of by name every time they change
+	struct DefaultUniforms{
+		ofShader::Uniform modelMatrix;
+		ofShader::Uniform viewMatrix;
+		ofShader::Uniform modelViewMatrix;
+		ofShader::Uniform projectionMatrix;
+		ofShader::Uniform textureMatrix;
+		ofShader::Uniform modelViewProjectionMatrix;
+		ofShader::Uniform globalColor;
+		ofShader::Uniform usingTexture;
+		ofShader::Uniform usingColors;
+		ofShader::Uniform bitmapText;
+		ofShader::Uniform srcTexUnit0;
+		ofShader::Uniform srcTexUnit1;
+	};
+	void lookupDefaultUniforms();
+	DefaultUniforms currentUniforms;
+	// true if the current shader has the ofDefaultUniforms block, then the
+	// matrices and style are only marked as changed until the next draw
+	bool currentShaderHasUniformsBlock;
+	bool defaultUniformsChanged;
+	// writes the block if something in it changed, before every draw
+	void updateDefaultUniformsBlock();
+#ifndef TARGET_OPENGLES
+	// std140 layout of the ofDefaultUniforms block
+	struct DefaultUniformsBlock{
+		glm::mat4 modelMatrix;
+		glm::mat4 viewMatrix;
+		glm::mat4 modelViewMatrix;
+		glm::mat4 projectionMatrix;
+		glm::mat4 textureMatrix;
+		glm::mat4 modelViewProjectionMatrix;
+		glm::vec4 globalColor;
+		float usingTexture;
+		float usingColors;
+		float padding[2];
+	};
+	// every write of the block goes to a new range so the draws that use
+	// the previous values don't have to finish first
+	ofStreamingBuffer uniformBuffer;
+	GLint uniformBufferAlignment;
+	bool uniformsBlockSupported;
+#endif
+
 	void setAttributes(bool vertices, bool color, bool tex, bool normals);
 	void setAlphaBitmapText(bool bitmapText);
 
@@ -280,6 +395,17 @@ private:
 	std::deque <ofStyle> styleHistory;
 	of3dGraphics graphics3d;
 	ofBitmapFont bitmapFont;
+	mutable ofMesh bitmapStringMesh;
+	bool bitmapStringBatching;
+	ofRectangle bitmapStringBatchViewport;
+	bool shapeBatching;
+	bool flushingShapes;
+	// the batched shapes are in eye coordinates and drawn with the
+	// projection and viewport that were current when they were added
+	ofMesh shapeBatch;
+	glm::mat4 shapeBatchProjection;
+	ofRectangle shapeBatchViewport;
+	mutable Stats stats;
 	ofPath path;
 	const ofAppBaseWindow * window;
 
@@ -33,6 +33,7 @@ ofGLRenderer::ofGLRenderer(const ofAppBaseWindow * _window)
 	window = _window;
 	currentFramebufferId = 0;
 	defaultFramebufferId = 0;
+	bitmapStringBatching = false;
 	path.setMode(ofPath::POLYLINES);
 	path.setUseShapeColor(false);
 }
@@ -73,6 +74,7 @@ void ofGLRenderer::startRender(){
 }
 
 void ofGLRenderer::finishRender(){
+	flushBitmapStrings();
 	matrixStack.clearStacks();
 	framebufferIdStack.clear();
 }
@@ -446,17 +448,20 @@ void ofGLRenderer::unbind(const ofBaseVideoDraws & video){
 
 //----------------------------------------------------------
 void ofGLRenderer::bind(const ofShader & shader){
+	flushBitmapStrings();
 	glUseProgram(shader.getProgram());
 }
 
 //----------------------------------------------------------
 void ofGLRenderer::unbind(const ofShader & shader){
+	flushBitmapStrings();
 	glUseProgram(0);
 }
 
 
 //----------------------------------------------------------
 void ofGLRenderer::begin(const ofFbo & fbo, ofFboBeginMode mode){
+	flushBitmapStrings();
 	pushView();
 	pushStyle();
     if(mode & ofFboBeginMode::MatrixFlip){
@@ -501,6 +506,7 @@ void ofGLRenderer::bind(const ofFbo & fbo){
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have
 	// different implementations.
+	flushBitmapStrings();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fbo.getId();
 	glBindFramebuffer(GL_FRAMEBUFFER, currentFramebufferId);
@@ -519,6 +525,7 @@ void ofGLRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fboDst, int att
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have
 	// different implementations.
+	flushBitmapStrings();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fboSrc.getId();
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, currentFramebufferId);
@@ -530,6 +537,7 @@ void ofGLRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fboDst, int att
 
 //----------------------------------------------------------
 void ofGLRenderer::unbind(const ofFbo & fbo){
+	flushBitmapStrings();
 	if(framebufferIdStack.empty()){
 		ofLogError() << "unbalanced fbo bind/unbind binding default framebuffer";
 		currentFramebufferId = defaultFramebufferId;
@@ -1075,11 +1083,13 @@ void ofGLRenderer::setHexColor(int hexColor){
 
 //----------------------------------------------------------
 void ofGLRenderer::clear(){
+	flushBitmapStrings();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 //----------------------------------------------------------
 void ofGLRenderer::clear(float r, float g, float b, float a) {
+	flushBitmapStrings();
 	glClearColor(r / 255., g / 255., b / 255., a / 255.);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -1091,6 +1101,7 @@ void ofGLRenderer::clear(float brightness, float a) {
 
 //----------------------------------------------------------
 void ofGLRenderer::clearAlpha() {
+	flushBitmapStrings();
 	glColorMask(0, 0, 0, 1);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -1120,6 +1131,7 @@ void ofGLRenderer::setBackgroundColor(const ofColor & color){
 
 //----------------------------------------------------------
 void ofGLRenderer::background(const ofColor & c){
+	flushBitmapStrings();
 	setBackgroundColor(c);
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -1189,6 +1201,7 @@ void ofGLRenderer::setLineWidth(float lineWidth){
 
 //----------------------------------------------------------
 void ofGLRenderer::setDepthTest(bool depthTest){
+	flushBitmapStrings();
 	if(depthTest) {
 		glEnable(GL_DEPTH_TEST);
 	} else {
@@ -1226,6 +1239,7 @@ void ofGLRenderer::endSmoothing(){
 
 //----------------------------------------------------------
 void ofGLRenderer::setBlendMode(ofBlendMode blendMode){
+	flushBitmapStrings();
 	switch (blendMode){
 		case OF_BLENDMODE_DISABLED:
 			glDisable(GL_BLEND);
@@ -1393,11 +1407,13 @@ void ofGLRenderer::disablePointSprites(){
 
 //----------------------------------------------------------
 void ofGLRenderer::enableAntiAliasing(){
+	flushBitmapStrings();
 	glEnable(GL_MULTISAMPLE);
 }
 
 //----------------------------------------------------------
 void ofGLRenderer::disableAntiAliasing(){
+	flushBitmapStrings();
 	glDisable(GL_MULTISAMPLE);
 }
 
@@ -1638,7 +1654,96 @@ void ofGLRenderer::drawString(string textString, float x, float y, float z) cons
 		default:
 			break;
 	}
-	// remember the current blend mode so that we can restore it at the end of this method.
+	if(bitmapStringBatching){
+		// the batch can only be drawn in one viewport
+		ofRectangle nativeViewport = getNativeViewport();
+		if(nativeViewport != bitmapStringBatchViewport){
+			mutThis->flushBitmapStrings();
+			mutThis->bitmapStringBatchViewport = nativeViewport;
+		}
+		glm::mat4 modelview, projection;
+		glGetFloatv(GL_MODELVIEW_MATRIX, glm::value_ptr(modelview));
+		glGetFloatv(GL_PROJECTION_MATRIX, glm::value_ptr(projection));
+		mutThis->bitmapFont.addToBatch(textString, sx, sy, vflipped, projection * modelview, currentStyle.color);
+	}else{
+		// remember the current blend mode so that we can restore it at the end of this method.
+		GLint blend_src, blend_dst;
+		glGetIntegerv( GL_BLEND_SRC, &blend_src );
+		glGetIntegerv( GL_BLEND_DST, &blend_dst );
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+#ifndef TARGET_OPENGLES
+		// this temporarily enables alpha testing,
+		// which discards pixels unless their alpha is 1.0f
+		glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
+		glEnable(GL_ALPHA_TEST);
+		glAlphaFunc(GL_GREATER, 0);
+#endif
+
+		mutThis->bind(bitmapFont.getTexture(),0);
+		if(sx == 0 && sy == 0){
+			bitmapFont.getCachedMesh(textString,bitmapStringMesh,vflipped);
+			draw(bitmapStringMesh,OF_MESH_FILL,false,true,false);
+		}else{
+			draw(bitmapFont.getMesh(textString,sx,sy,currentStyle.drawBitmapMode,vflipped),OF_MESH_FILL,false,true,false);
+		}
+		mutThis->unbind(bitmapFont.getTexture(),0);
+
+#ifndef TARGET_OPENGLES
+		glPopAttrib();
+#endif
+		// restore blendmode
+		glBlendFunc(blend_src, blend_dst);
+	}
+
+	if (hasModelView)
+		mutThis->popMatrix();
+
+	if (hasProjection)
+	{
+		mutThis->matrixMode(OF_MATRIX_PROJECTION);
+		mutThis->popMatrix();
+		mutThis->matrixMode(OF_MATRIX_MODELVIEW);
+	}
+
+	if (hasViewport)
+		mutThis->popView();
+
+}
+
+//----------------------------------------------------------
+void ofGLRenderer::setBitmapStringBatching(bool batching){
+	if(!batching){
+		flushBitmapStrings();
+	}
+	bitmapStringBatching = batching;
+}
+
+//----------------------------------------------------------
+bool ofGLRenderer::isBitmapStringBatching() const{
+	return bitmapStringBatching;
+}
+
+//----------------------------------------------------------
+void ofGLRenderer::flushBitmapStrings(){
+	const ofMesh & batch = bitmapFont.getBatch();
+	if(batch.getNumVertices() == 0){
+		return;
+	}
+
+	// the batch is already in normalized device coordinates of the viewport
+	// where its strings were drawn, so it's drawn without transformations
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glViewport(bitmapStringBatchViewport.x, bitmapStringBatchViewport.y, bitmapStringBatchViewport.width, bitmapStringBatchViewport.height);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
 	GLint blend_src, blend_dst;
 	glGetIntegerv( GL_BLEND_SRC, &blend_src );
 	glGetIntegerv( GL_BLEND_DST, &blend_dst );
@@ -1646,37 +1751,45 @@ void ofGLRenderer::drawString(string textString, float x, float y, float z) cons
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 #ifndef TARGET_OPENGLES
-	// this temporarily enables alpha testing,
-	// which discards pixels unless their alpha is 1.0f
 	glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
 	glEnable(GL_ALPHA_TEST);
 	glAlphaFunc(GL_GREATER, 0);
 #endif
 
-	ofMesh charMesh = bitmapFont.getMesh(textString,sx,sy,currentStyle.drawBitmapMode,vflipped);
-	mutThis->bind(bitmapFont.getTexture(),0);
-	draw(charMesh,OF_MESH_FILL,false,true,false);
-	mutThis->unbind(bitmapFont.getTexture(),0);
+	bind(bitmapFont.getTexture(),0);
+	draw(batch,OF_MESH_FILL,true,true,false);
+	unbind(bitmapFont.getTexture(),0);
 
 #ifndef TARGET_OPENGLES
 	glPopAttrib();
 #endif
-	// restore blendmode
 	glBlendFunc(blend_src, blend_dst);
+	// the color array leaves the current color undefined
+	setColor(currentStyle.color);
 
-	if (hasModelView)
-		mutThis->popMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+	matrixMode(matrixStack.getCurrentMatrixMode());
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	bitmapFont.clearBatch();
+}
 
-	if (hasProjection)
-	{
-		mutThis->matrixMode(OF_MATRIX_PROJECTION);
-		mutThis->popMatrix();
-		mutThis->matrixMode(OF_MATRIX_MODELVIEW);
+//----------------------------------------------------------
+void ofGLRenderer::setShapeBatching(bool batching){
+	if(batching){
+		ofLogWarning("ofGLRenderer") << "setShapeBatching(): shape batching is only available with the programmable renderer";
 	}
+}
 
-	if (hasViewport)
-		mutThis->popView();
+//----------------------------------------------------------
+bool ofGLRenderer::isShapeBatching() const{
+	return false;
+}
 
+//----------------------------------------------------------
+void ofGLRenderer::flushShapes(){
 }
 
 //----------------------------------------------------------
@@ -1905,6 +2018,7 @@ void ofGLRenderer::saveFullViewport(ofPixels & pixels){
 
 //----------------------------------------------------------
 void ofGLRenderer::saveScreen(int x, int y, int w, int h, ofPixels & pixels){
+	flushBitmapStrings();
 
 	int sh = getViewportHeight();
 
@@ -162,6 +162,14 @@ public:
 	void drawString(std::string text, float x, float y, float z) const;
 	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
 
+	void setBitmapStringBatching(bool batching);
+	bool isBitmapStringBatching() const;
+	void flushBitmapStrings();
+
+	void setShapeBatching(bool batching);
+	bool isShapeBatching() const;
+	void flushShapes();
+
 
 	// gl specifics
 	void enableTextureTarget(const ofTexture & tex, int textureLocation);
@@ -244,6 +252,9 @@ private:
 	std::deque <ofStyle> styleHistory;
 	of3dGraphics graphics3d;
 	ofBitmapFont bitmapFont;
+	mutable ofMesh bitmapStringMesh;
+	bool bitmapStringBatching;
+	ofRectangle bitmapStringBatchViewport;
 	ofPath path;
 	const ofAppBaseWindow * window;
 
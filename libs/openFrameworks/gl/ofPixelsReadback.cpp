@@ -0,0 +1,244 @@
+#include "ofPixelsReadback.h"
+#include "ofFbo.h"
+#include "ofGLUtils.h"
+#include "ofTaskPool.h"
+#include "ofLog.h"
+#include <cstring>
+#include <mutex>
+
+#ifndef TARGET_OPENGLES
+
+using namespace std;
+
+template<typename PixelType>
+struct ofPixelsReadback_<PixelType>::Worker{
+	mutex freeMutex;
+	vector<shared_ptr<Pixels>> free;
+};
+
+//--------------------------------------------------------------
+template<typename PixelType>
+ofPixelsReadback_<PixelType>::ofPixelsReadback_()
+:first(0)
+,pending(0)
+,frames(0)
+,callbackInWorkerThread(false)
+,worker(make_shared<Worker>()){
+
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+ofPixelsReadback_<PixelType>::~ofPixelsReadback_(){
+	clear();
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::setup(size_t numBuffers){
+	clear();
+	buffers.resize(max<size_t>(numBuffers, 1));
+	frames = 0;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::clear(){
+	for(auto & buffer: buffers){
+		if(buffer.fence){
+			glDeleteSync(buffer.fence);
+		}
+	}
+	buffers.clear();
+	first = 0;
+	pending = 0;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::setCallback(function<void(Pixels &, size_t)> callback, bool inWorkerThread){
+	this->callback = callback;
+	callbackInWorkerThread = inWorkerThread;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsReadback_<PixelType>::read(const ofFbo & fbo, int attachmentPoint){
+	if(!fbo.isAllocated()){
+		ofLogError("ofPixelsReadback") << "read(): fbo not allocated";
+		return false;
+	}
+	return read(fbo.getTexture(attachmentPoint));
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsReadback_<PixelType>::read(const ofTexture & texture){
+	if(!texture.isAllocated()){
+		ofLogError("ofPixelsReadback") << "read(): texture not allocated";
+		return false;
+	}
+	if(buffers.empty()){
+		setup();
+	}
+
+	update();
+	if(pending == buffers.size()){
+		if(callback){
+			stats.stalls++;
+			isReady(buffers[first], true);
+			deliver();
+		}else{
+			// the copy to a buffer that's still being written waits in the
+			// GPU, not here
+			glDeleteSync(buffers[first].fence);
+			buffers[first].fence = nullptr;
+			first = (first + 1) % buffers.size();
+			pending--;
+			stats.dropped++;
+		}
+	}
+
+	const ofTextureData & texData = texture.getTextureData();
+	int glFormat = ofGetGLFormatFromInternal(texData.glInternalFormat);
+	Buffer & buffer = buffers[(first + pending) % buffers.size()];
+	buffer.width = texData.width;
+	buffer.height = texData.height;
+	buffer.channels = ofGetNumChannelsFromGLFormat(glFormat);
+	buffer.frame = frames++;
+	GLsizeiptr bytes = buffer.width * buffer.height * buffer.channels * sizeof(PixelType);
+	if(!buffer.buffer.isAllocated() || buffer.buffer.size() != bytes){
+		buffer.buffer.allocate(bytes, GL_STREAM_READ);
+	}
+
+	ofSetPixelStoreiAlignment(GL_PACK_ALIGNMENT, buffer.width, sizeof(PixelType), buffer.channels);
+	buffer.buffer.bind(GL_PIXEL_PACK_BUFFER);
+	glBindTexture(texData.textureTarget, texData.textureID);
+	glGetTexImage(texData.textureTarget, 0, glFormat, ofGetGlType(Pixels()), 0);
+	glBindTexture(texData.textureTarget, 0);
+	buffer.buffer.unbind(GL_PIXEL_PACK_BUFFER);
+	buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	pending++;
+	stats.reads++;
+	return true;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsReadback_<PixelType>::isReady(Buffer & buffer, bool wait){
+	GLenum result = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	while(wait && result == GL_TIMEOUT_EXPIRED){
+		result = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+	}
+	return result != GL_TIMEOUT_EXPIRED;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+size_t ofPixelsReadback_<PixelType>::pop(Pixels & pixels){
+	Buffer & buffer = buffers[first];
+	glDeleteSync(buffer.fence);
+	buffer.fence = nullptr;
+
+	pixels.allocate(buffer.width, buffer.height, buffer.channels);
+	size_t bytes = pixels.getTotalBytes();
+	buffer.buffer.bind(GL_PIXEL_PACK_BUFFER);
+	auto data = buffer.buffer.mapRange<PixelType>(0, bytes, GL_MAP_READ_BIT);
+	if(data){
+		memcpy(pixels.getData(), data, bytes);
+		buffer.buffer.unmapRange();
+	}else{
+		ofLogError("ofPixelsReadback") << "couldn't map the pixel buffer";
+	}
+	buffer.buffer.unbind(GL_PIXEL_PACK_BUFFER);
+
+	first = (first + 1) % buffers.size();
+	pending--;
+	stats.delivered++;
+	return buffer.frame;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::deliver(){
+	if(!callbackInWorkerThread){
+		size_t frame = pop(pixels);
+		callback(pixels, frame);
+		return;
+	}
+
+	shared_ptr<Pixels> workerPixels;
+	{
+		lock_guard<mutex> lock(worker->freeMutex);
+		if(!worker->free.empty()){
+			workerPixels = worker->free.back();
+			worker->free.pop_back();
+		}
+	}
+	if(!workerPixels){
+		workerPixels = make_shared<Pixels>();
+	}
+	size_t frame = pop(*workerPixels);
+	auto state = worker;
+	auto function = callback;
+	ofGetTaskPool().submit([state, workerPixels, function, frame]{
+		function(*workerPixels, frame);
+		lock_guard<mutex> lock(state->freeMutex);
+		state->free.push_back(workerPixels);
+	});
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsReadback_<PixelType>::getPixels(Pixels & pixels){
+	if(pending == 0 || !isReady(buffers[first], false)){
+		return false;
+	}
+	pop(pixels);
+	return true;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::update(){
+	if(!callback){
+		return;
+	}
+	while(pending > 0 && isReady(buffers[first], false)){
+		deliver();
+	}
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::flush(){
+	for(size_t i = 0; i < pending; i++){
+		isReady(buffers[(first + i) % buffers.size()], true);
+	}
+	update();
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+size_t ofPixelsReadback_<PixelType>::getNumPending() const{
+	return pending;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+const typename ofPixelsReadback_<PixelType>::Stats & ofPixelsReadback_<PixelType>::getStats() const{
+	return stats;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsReadback_<PixelType>::resetStats(){
+	stats = Stats();
+}
+
+template class ofPixelsReadback_<unsigned char>;
+template class ofPixelsReadback_<unsigned short>;
+template class ofPixelsReadback_<float>;
+
+#endif
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofBufferObject.h"
+#include "ofPixels.h"
+#include <functional>
+#include <memory>
+
+class ofTexture;
+class ofFbo;
+
+#ifndef TARGET_OPENGLES
+/// \brief Reads textures and fbos back to pixels without waiting for the
+/// GPU.
+///
+/// ofTexture::readToPixels() and ofFbo::readToPixels() wait until the GPU
+/// has finished drawing to the texture and then copy it. With a readback the
+/// copy goes to one of a ring of pixel buffers and is delivered some frames
+/// later, once the GPU has finished it:
+///
+/// ~~~~{.cpp}
+/// // setup
+/// readback.setup(3);
+///
+/// // draw
+/// fbo.readToPixelsAsync(readback);
+/// if(readback.getPixels(pixels)){
+/// 	// the pixels of a previous frame
+/// }
+/// ~~~~
+///
+/// The pixels can also be passed to a callback, in the main thread or in
+/// the threads of ofGetTaskPool() to convert or encode them without slowing
+/// down the application:
+///
+/// ~~~~{.cpp}
+/// readback.setCallback([](ofPixels & pixels, std::size_t frame){
+/// 	ofSaveImage(pixels, ofToString(frame, 5, '0') + ".png");
+/// }, true);
+/// ~~~~
+///
+/// If every buffer of the ring is full, read() waits for the oldest one
+/// and passes it to the callback, which counts as a stall, so the number of
+/// buffers should be bigger than the frames the GPU goes behind the
+/// application. Without a callback the oldest frame is discarded instead.
+///
+/// Needs OpenGL 3.2 for the fences, it's not available with OpenGL ES.
+template<typename PixelType>
+class ofPixelsReadback_{
+public:
+	typedef ofPixels_<PixelType> Pixels;
+
+	struct Stats{
+		/// number of calls to read()
+		std::size_t reads = 0;
+		/// number of frames delivered to getPixels() or the callback
+		std::size_t delivered = 0;
+		/// number of times read() had to wait because all the buffers
+		/// were still being copied, only with a callback
+		std::size_t stalls = 0;
+		/// number of frames discarded because all the buffers were full
+		/// and getPixels() wasn't called, only without a callback
+		std::size_t dropped = 0;
+	};
+
+	ofPixelsReadback_();
+	~ofPixelsReadback_();
+	ofPixelsReadback_(const ofPixelsReadback_ &) = delete;
+	ofPixelsReadback_ & operator=(const ofPixelsReadback_ &) = delete;
+
+	/// \brief Set the number of reads that can be in flight, which is also
+	/// the frames it takes for the pixels to arrive in the worst case.
+	///
+	/// The buffers are allocated on the first read. Reads that didn't
+	/// arrive yet are discarded.
+	void setup(std::size_t numBuffers = 3);
+	void clear();
+
+	/// \brief Set a function to call with every frame once it arrives,
+	/// instead of getting it with getPixels().
+	///
+	/// frame is the number of the read, starting from 0. With
+	/// inWorkerThread the function is called from the threads of
+	/// ofGetTaskPool(), possibly for several frames at the same time and
+	/// out of order, otherwise from update() in the thread that reads.
+	/// Pass nullptr to stop calling it.
+	void setCallback(std::function<void(Pixels & pixels, std::size_t frame)> callback, bool inWorkerThread = false);
+
+	/// \brief Start copying a texture to the next buffer of the ring.
+	/// \returns false if the texture is not allocated.
+	bool read(const ofTexture & texture);
+	bool read(const ofFbo & fbo, int attachmentPoint = 0);
+
+	/// \brief Copy the oldest read to pixels if the GPU has finished it.
+	///
+	/// It never waits for the GPU. Not to be used with a callback.
+	/// \returns true if pixels contains a new frame.
+	bool getPixels(Pixels & pixels);
+
+	/// \brief Pass the reads the GPU has finished to the callback. It's
+	/// also called by read().
+	void update();
+
+	/// \brief Wait for all the reads in flight and pass them to the
+	/// callback, for example after reading the last frame of a recording.
+	void flush();
+
+	/// \returns the number of reads that didn't arrive yet.
+	std::size_t getNumPending() const;
+
+	const Stats & getStats() const;
+	void resetStats();
+
+private:
+	struct Buffer{
+		ofBufferObject buffer;
+		GLsync fence = nullptr;
+		std::size_t frame = 0;
+		std::size_t width = 0;
+		std::size_t height = 0;
+		std::size_t channels = 0;
+	};
+	struct Worker;
+
+	bool isReady(Buffer & buffer, bool wait);
+	// copies the oldest read to pixels and releases its buffer, returns
+	// the number of its frame
+	std::size_t pop(Pixels & pixels);
+	void deliver();
+
+	std::vector<Buffer> buffers;
+	std::size_t first;
+	std::size_t pending;
+	std::size_t frames;
+	std::function<void(Pixels &, std::size_t)> callback;
+	bool callbackInWorkerThread;
+	// pixels reused for the main thread callback
+	Pixels pixels;
+	// pixels reused by the worker threads, shared with the tasks in case
+	// they outlive the readback
+	std::shared_ptr<Worker> worker;
+	Stats stats;
+};
+
+typedef ofPixelsReadback_<unsigned char> ofPixelsReadback;
+typedef ofPixelsReadback_<unsigned short> ofShortPixelsReadback;
+typedef ofPixelsReadback_<float> ofFloatPixelsReadback;
+#endif
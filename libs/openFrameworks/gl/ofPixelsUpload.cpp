@@ -0,0 +1,221 @@
+#include "ofPixelsUpload.h"
+#include "ofTexture.h"
+#include "ofGLUtils.h"
+#include "ofLog.h"
+#include <cstring>
+
+#ifndef TARGET_OPENGLES
+
+using namespace std;
+
+//--------------------------------------------------------------
+template<typename PixelType>
+ofPixelsUpload_<PixelType>::ofPixelsUpload_()
+:next(0)
+,persistent(false)
+,fences(false){
+
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+ofPixelsUpload_<PixelType>::~ofPixelsUpload_(){
+	clear();
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::setup(size_t numBuffers){
+	clear();
+	buffers.resize(max<size_t>(numBuffers, 1));
+
+	// without fences the buffers are orphaned when they're mapped so the
+	// driver gives new memory if the previous one is still being copied
+#ifdef GLEW_ARB_sync
+	fences = GLEW_ARB_sync;
+#else
+	fences = true;
+#endif
+	persistent = false;
+#ifdef GLEW_ARB_buffer_storage
+	persistent = fences && GLEW_ARB_buffer_storage;
+#endif
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::clear(){
+	for(auto & buffer: buffers){
+		if(buffer.fence){
+			glDeleteSync(buffer.fence);
+		}
+		if(buffer.mapped){
+			buffer.buffer.bind(GL_PIXEL_UNPACK_BUFFER);
+			buffer.buffer.unmap();
+			buffer.buffer.unbind(GL_PIXEL_UNPACK_BUFFER);
+		}
+	}
+	buffers.clear();
+	next = 0;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::allocate(Buffer & buffer, GLsizeiptr bytes){
+	if(buffer.mapped){
+		buffer.buffer.bind(GL_PIXEL_UNPACK_BUFFER);
+		buffer.buffer.unmap();
+		buffer.buffer.unbind(GL_PIXEL_UNPACK_BUFFER);
+		buffer.mapped = nullptr;
+	}
+	buffer.buffer = ofBufferObject();
+	buffer.buffer.allocate();
+	buffer.size = bytes;
+
+	buffer.buffer.bind(GL_PIXEL_UNPACK_BUFFER);
+	if(persistent){
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		buffer.buffer.setStorage(bytes, nullptr, flags);
+		buffer.mapped = buffer.buffer.mapRange<PixelType>(0, bytes, flags);
+	}else{
+		buffer.buffer.setData(bytes, nullptr, GL_STREAM_DRAW);
+	}
+	buffer.buffer.unbind(GL_PIXEL_UNPACK_BUFFER);
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsUpload_<PixelType>::begin(Pixels & pixels, size_t width, size_t height, ofPixelFormat pixelFormat){
+	if(buffers.empty()){
+		setup();
+	}
+	int index = next;
+	Buffer & buffer = buffers[index];
+	if(buffer.writing){
+		ofLogError("ofPixelsUpload") << "begin(): every buffer is being written, call end() first";
+		return -1;
+	}
+	next = (next + 1) % buffers.size();
+
+	if(buffer.fence){
+		GLenum result = glClientWaitSync(buffer.fence, 0, 0);
+		if(result == GL_TIMEOUT_EXPIRED){
+			stats.stalls++;
+			do{
+				result = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			}while(result == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(buffer.fence);
+		buffer.fence = nullptr;
+	}
+
+	GLsizeiptr bytes = Pixels::bytesFromPixelFormat(width, height, pixelFormat);
+	if(!buffer.buffer.isAllocated() || buffer.size < bytes){
+		allocate(buffer, bytes);
+	}
+	if(!persistent){
+		// the fence already says the gpu is done with this buffer
+		GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+		if(fences){
+			access |= GL_MAP_UNSYNCHRONIZED_BIT;
+		}
+		buffer.buffer.bind(GL_PIXEL_UNPACK_BUFFER);
+		buffer.mapped = buffer.buffer.mapRange<PixelType>(0, bytes, access);
+		buffer.buffer.unbind(GL_PIXEL_UNPACK_BUFFER);
+	}
+	if(!buffer.mapped){
+		ofLogError("ofPixelsUpload") << "begin(): couldn't map the pixel buffer";
+		return -1;
+	}
+
+	buffer.pixels.setFromExternalPixels(buffer.mapped, width, height, pixelFormat);
+	pixels.setFromExternalPixels(buffer.mapped, width, height, pixelFormat);
+	buffer.writing = true;
+	return index;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::end(int index, ofTexture & texture){
+	if(index < 0 || size_t(index) >= buffers.size() || !buffers[index].writing){
+		ofLogError("ofPixelsUpload") << "end(): " << index << " is not a buffer returned by begin()";
+		return;
+	}
+	auto start = chrono::steady_clock::now();
+	submit(buffers[index], texture);
+	stats.uploadTime += chrono::steady_clock::now() - start;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::submit(Buffer & buffer, ofTexture & texture){
+	if(!persistent){
+		buffer.buffer.bind(GL_PIXEL_UNPACK_BUFFER);
+		buffer.buffer.unmapRange();
+		buffer.buffer.unbind(GL_PIXEL_UNPACK_BUFFER);
+		buffer.mapped = nullptr;
+	}
+	buffer.writing = false;
+
+	// the pixels only describe the data now, their memory is not mapped
+	// anymore or is being read by the gpu
+	const Pixels & pixels = buffer.pixels;
+	int glInternalFormat = ofGetGlInternalFormat(pixels);
+	if(!texture.isAllocated() || texture.getWidth() != pixels.getWidth() || texture.getHeight() != pixels.getHeight() || texture.getTextureData().glInternalFormat != glInternalFormat){
+		texture.allocate(pixels.getWidth(), pixels.getHeight(), glInternalFormat, ofGetUsingArbTex(), ofGetGlFormat(pixels), ofGetGlType(pixels));
+		if((pixels.getPixelFormat() == OF_PIXELS_GRAY || pixels.getPixelFormat() == OF_PIXELS_GRAY_ALPHA) && ofIsGLProgrammableRenderer()){
+			texture.setRGToRGBASwizzles(true);
+		}
+	}
+	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, pixels.getBytesStride());
+	texture.loadData(buffer.buffer, ofGetGlFormat(pixels), ofGetGlType(pixels));
+	if(fences){
+		buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	stats.uploads++;
+	stats.bytesUploaded += pixels.getTotalBytes();
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::loadData(ofTexture & texture, const Pixels & pixels){
+	if(!pixels.isAllocated()){
+		ofLogError("ofPixelsUpload") << "loadData(): pixels not allocated";
+		return;
+	}
+	auto start = chrono::steady_clock::now();
+	Pixels mapped;
+	int index = begin(mapped, pixels.getWidth(), pixels.getHeight(), pixels.getPixelFormat());
+	if(index < 0){
+		texture.loadData(pixels);
+		return;
+	}
+	memcpy(mapped.getData(), pixels.getData(), pixels.getTotalBytes());
+	submit(buffers[index], texture);
+	stats.uploadTime += chrono::steady_clock::now() - start;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsUpload_<PixelType>::isPersistentlyMapped() const{
+	return persistent;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+const typename ofPixelsUpload_<PixelType>::Stats & ofPixelsUpload_<PixelType>::getStats() const{
+	return stats;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+void ofPixelsUpload_<PixelType>::resetStats(){
+	stats = Stats();
+}
+
+template class ofPixelsUpload_<unsigned char>;
+template class ofPixelsUpload_<unsigned short>;
+template class ofPixelsUpload_<float>;
+
+#endif
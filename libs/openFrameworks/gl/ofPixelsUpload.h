@@ -0,0 +1,122 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofBufferObject.h"
+#include "ofPixels.h"
+#include <chrono>
+
+class ofTexture;
+
+#ifndef TARGET_OPENGLES
+/// \brief Uploads pixels to textures through a ring of pixel buffers, so
+/// the copy to the GPU happens while the application keeps running.
+///
+/// ofTexture::loadData() copies the pixels during the call, usually to a
+/// driver buffer first and from there to the texture. With an upload the
+/// pixels are copied once, to memory mapped from one of the buffers, and
+/// the GPU copies them to the texture by itself:
+///
+/// ~~~~{.cpp}
+/// upload.loadData(texture, pixels);
+/// ~~~~
+///
+/// Other threads can also write the pixels directly to the mapped memory,
+/// for example while decoding a frame, so the main thread only starts the
+/// transfer:
+///
+/// ~~~~{.cpp}
+/// // main thread
+/// ofPixels pixels;
+/// int buffer = upload.begin(pixels, 3840, 2160, OF_PIXELS_RGBA);
+/// decoder.decodeInto(pixels); // in another thread
+///
+/// // main thread, once the decoder is done
+/// upload.end(buffer, texture);
+/// ~~~~
+///
+/// A buffer is written again once a fence says the GPU has finished copying
+/// it to the texture. If it hasn't, begin() waits, which counts as a stall.
+///
+/// With OpenGL 4.4 or ARB_buffer_storage the buffers stay mapped, otherwise
+/// they're mapped in begin() and unmapped in end(). It's not available with
+/// OpenGL ES.
+template<typename PixelType>
+class ofPixelsUpload_{
+public:
+	typedef ofPixels_<PixelType> Pixels;
+
+	struct Stats{
+		/// number of textures updated
+		std::size_t uploads = 0;
+		/// bytes of those updates
+		std::size_t bytesUploaded = 0;
+		/// number of times begin() had to wait for the GPU to finish
+		/// copying a previous upload
+		std::size_t stalls = 0;
+		/// time spent in loadData() and end(), bytesUploaded / uploadTime
+		/// is the throughput seen by the thread that uploads
+		std::chrono::nanoseconds uploadTime{0};
+	};
+
+	ofPixelsUpload_();
+	~ofPixelsUpload_();
+	ofPixelsUpload_(const ofPixelsUpload_ &) = delete;
+	ofPixelsUpload_ & operator=(const ofPixelsUpload_ &) = delete;
+
+	/// \brief Set the number of buffers in the ring, the uploads that can
+	/// be on their way at the same time.
+	///
+	/// The buffers are allocated on the first upload with the size of the
+	/// pixels.
+	void setup(std::size_t numBuffers = 3);
+	void clear();
+
+	/// \brief Copy the pixels to the next buffer and start copying it to
+	/// the texture, allocating the texture if its size or format are
+	/// different.
+	void loadData(ofTexture & texture, const Pixels & pixels);
+
+	/// \brief Map the next buffer and point pixels to its memory so it can
+	/// be written from any thread until end() is called.
+	///
+	/// Has to be called from the thread with the GL context.
+	/// \returns the buffer to pass to end() or -1 if every buffer is
+	/// already being written.
+	int begin(Pixels & pixels, std::size_t width, std::size_t height, ofPixelFormat pixelFormat);
+
+	/// \brief Start copying a buffer returned by begin() to the texture.
+	///
+	/// The pixels pointing to the buffer can't be used anymore afterwards.
+	void end(int buffer, ofTexture & texture);
+
+	/// \returns true if the buffers stay mapped.
+	bool isPersistentlyMapped() const;
+
+	const Stats & getStats() const;
+	void resetStats();
+
+private:
+	struct Buffer{
+		ofBufferObject buffer;
+		GLsizeiptr size = 0;
+		GLsync fence = nullptr;
+		PixelType * mapped = nullptr;
+		bool writing = false;
+		// points to the mapped memory while it's being written
+		Pixels pixels;
+	};
+
+	void allocate(Buffer & buffer, GLsizeiptr bytes);
+	void submit(Buffer & buffer, ofTexture & texture);
+
+	std::vector<Buffer> buffers;
+	std::size_t next;
+	bool persistent;
+	bool fences;
+	Stats stats;
+};
+
+typedef ofPixelsUpload_<unsigned char> ofPixelsUpload;
+typedef ofPixelsUpload_<unsigned short> ofShortPixelsUpload;
+typedef ofPixelsUpload_<float> ofFloatPixelsUpload;
+#endif
@@ -914,11 +914,26 @@ void ofShader::dispatchCompute(GLuint x, GLuint y, GLuint z) const{
 
 //--------------------------------------------------------------
 void ofShader::setUniformTexture(const string & name, const ofBaseHasTexture& img, int textureLocation)  const{
-	setUniformTexture(name, img.getTexture(), textureLocation);
+	setUniformTexture(getUniform(name), img.getTexture(), textureLocation);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniformTexture(const string & name, int textureTarget, GLint textureID, int textureLocation) const{
+	setUniformTexture(getUniform(name), textureTarget, textureID, textureLocation);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniformTexture(const string & name, const ofTexture& tex, int textureLocation)  const{
+	setUniformTexture(getUniform(name), tex, textureLocation);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniformTexture(const Uniform & uniform, const ofBaseHasTexture& img, int textureLocation)  const{
+	setUniformTexture(uniform, img.getTexture(), textureLocation);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniformTexture(const Uniform & uniform, int textureTarget, GLint textureID, int textureLocation) const{
 	if(bLoaded) {
 		glActiveTexture(GL_TEXTURE0 + textureLocation);
 		if (!ofIsGLProgrammableRenderer()){
@@ -928,15 +943,15 @@ void ofShader::setUniformTexture(const string & name, int textureTarget, GLint t
 		} else {
 			glBindTexture(textureTarget, textureID);
 		}
-		setUniform1i(name, textureLocation);
+		setUniform1i(uniform, textureLocation);
 		glActiveTexture(GL_TEXTURE0);
 	}
 }
 
 //--------------------------------------------------------------
-void ofShader::setUniformTexture(const string & name, const ofTexture& tex, int textureLocation)  const{
+void ofShader::setUniformTexture(const Uniform & uniform, const ofTexture& tex, int textureLocation)  const{
 	if(bLoaded) {
-		ofTextureData texData = tex.getTextureData();
+		const ofTextureData & texData = tex.getTextureData();
 		glActiveTexture(GL_TEXTURE0 + textureLocation);
 		if (!ofIsGLProgrammableRenderer()){
 			glEnable(texData.textureTarget);
@@ -955,73 +970,89 @@ void ofShader::setUniformTexture(const string & name, const ofTexture& tex, int
 			}
 #endif
 		}
-		setUniform1i(name, textureLocation);
+		setUniform1i(uniform, textureLocation);
 		glActiveTexture(GL_TEXTURE0);
 	}
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform1i(const string & name, int v1)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform1i(loc, v1);
-	}
+	setUniform1i(getUniform(name), v1);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform2i(const string & name, int v1, int v2)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform2i(loc, v1, v2);
-	}
+	setUniform2i(getUniform(name), v1, v2);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform3i(const string & name, int v1, int v2, int v3)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform3i(loc, v1, v2, v3);
-	}
+	setUniform3i(getUniform(name), v1, v2, v3);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform4i(const string & name, int v1, int v2, int v3, int v4)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) 	glUniform4i(loc, v1, v2, v3, v4);
-	}
+	setUniform4i(getUniform(name), v1, v2, v3, v4);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform1f(const string & name, float v1)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform1f(loc, v1);
-	}
+	setUniform1f(getUniform(name), v1);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform2f(const string & name, float v1, float v2)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform2f(loc, v1, v2);
-	}
+	setUniform2f(getUniform(name), v1, v2);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform3f(const string & name, float v1, float v2, float v3)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform3f(loc, v1, v2, v3);
-	}
+	setUniform3f(getUniform(name), v1, v2, v3);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform4f(const string & name, float v1, float v2, float v3, float v4)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform4f(loc, v1, v2, v3, v4);
-	}
+	setUniform4f(getUniform(name), v1, v2, v3, v4);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform1i(const Uniform & uniform, int v1)  const{
+	if(bLoaded && uniform.location != -1) glUniform1i(uniform.location, v1);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform2i(const Uniform & uniform, int v1, int v2)  const{
+	if(bLoaded && uniform.location != -1) glUniform2i(uniform.location, v1, v2);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform3i(const Uniform & uniform, int v1, int v2, int v3)  const{
+	if(bLoaded && uniform.location != -1) glUniform3i(uniform.location, v1, v2, v3);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4i(const Uniform & uniform, int v1, int v2, int v3, int v4)  const{
+	if(bLoaded && uniform.location != -1) glUniform4i(uniform.location, v1, v2, v3, v4);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform1f(const Uniform & uniform, float v1)  const{
+	if(bLoaded && uniform.location != -1) glUniform1f(uniform.location, v1);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform2f(const Uniform & uniform, float v1, float v2)  const{
+	if(bLoaded && uniform.location != -1) glUniform2f(uniform.location, v1, v2);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform3f(const Uniform & uniform, float v1, float v2, float v3)  const{
+	if(bLoaded && uniform.location != -1) glUniform3f(uniform.location, v1, v2, v3);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4f(const Uniform & uniform, float v1, float v2, float v3, float v4)  const{
+	if(bLoaded && uniform.location != -1) glUniform4f(uniform.location, v1, v2, v3, v4);
 }
 
 
@@ -1045,90 +1076,129 @@ void ofShader::setUniform4f(const string & name, const ofFloatColor & v) const{
 	setUniform4f(name,v.r,v.g,v.b,v.a);
 }
 
+//--------------------------------------------------------------
+void ofShader::setUniform2f(const Uniform & uniform, const glm::vec2 & v) const{
+	setUniform2f(uniform,v.x,v.y);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform3f(const Uniform & uniform, const glm::vec3 & v) const{
+	setUniform3f(uniform,v.x,v.y,v.z);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4f(const Uniform & uniform, const glm::vec4 & v) const{
+	setUniform4f(uniform,v.x,v.y,v.z,v.w);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4f(const Uniform & uniform, const ofFloatColor & v) const{
+	setUniform4f(uniform,v.r,v.g,v.b,v.a);
+}
+
 //--------------------------------------------------------------
 void ofShader::setUniform1iv(const string & name, const int* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform1iv(loc, count, v);
-	}
+	setUniform1iv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform2iv(const string & name, const int* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform2iv(loc, count, v);
-	}
+	setUniform2iv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform3iv(const string & name, const int* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform3iv(loc, count, v);
-	}
+	setUniform3iv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform4iv(const string & name, const int* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform4iv(loc, count, v);
-	}
+	setUniform4iv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform1fv(const string & name, const float* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform1fv(loc, count, v);
-	}
+	setUniform1fv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform2fv(const string & name, const float* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform2fv(loc, count, v);
-	}
+	setUniform2fv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform3fv(const string & name, const float* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform3fv(loc, count, v);
-	}
+	setUniform3fv(getUniform(name), v, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniform4fv(const string & name, const float* v, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniform4fv(loc, count, v);
-	}
+	setUniform4fv(getUniform(name), v, count);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform1iv(const Uniform & uniform, const int* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform1iv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform2iv(const Uniform & uniform, const int* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform2iv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform3iv(const Uniform & uniform, const int* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform3iv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4iv(const Uniform & uniform, const int* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform4iv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform1fv(const Uniform & uniform, const float* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform1fv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform2fv(const Uniform & uniform, const float* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform2fv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform3fv(const Uniform & uniform, const float* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform3fv(uniform.location, count, v);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniform4fv(const Uniform & uniform, const float* v, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniform4fv(uniform.location, count, v);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniforms(const ofParameterGroup & parameters) const{
 	for(std::size_t i=0;i<parameters.size();i++){
-		if(parameters[i].type()==typeid(ofParameter<int>).name()){
+		// comparing the type_info directly doesn't build a string with the
+		// name of the type of every parameter
+		const std::type_info & type = typeid(parameters[i]);
+		if(type==typeid(ofParameter<int>)){
 			setUniform1i(parameters[i].getEscapedName(),parameters[i].cast<int>());
-		}else if(parameters[i].type()==typeid(ofParameter<float>).name()){
+		}else if(type==typeid(ofParameter<float>)){
 			setUniform1f(parameters[i].getEscapedName(),parameters[i].cast<float>());
-		}else if(parameters[i].type()==typeid(ofParameter<glm::vec2>).name()){
+		}else if(type==typeid(ofParameter<glm::vec2>)){
 			setUniform2f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec2>());
-		}else if(parameters[i].type()==typeid(ofParameter<glm::vec3>).name()){
+		}else if(type==typeid(ofParameter<glm::vec3>)){
 			setUniform3f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec3>());
-		}else if(parameters[i].type()==typeid(ofParameter<glm::vec4>).name()){
+		}else if(type==typeid(ofParameter<glm::vec4>)){
 			setUniform4f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec4>());
-		}else if(parameters[i].type()==typeid(ofParameter<ofVec2f>).name()){
+		}else if(type==typeid(ofParameter<ofVec2f>)){
 			setUniform2f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec2>());
-		}else if(parameters[i].type()==typeid(ofParameter<ofVec3f>).name()){
+		}else if(type==typeid(ofParameter<ofVec3f>)){
 			setUniform3f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec3>());
-		}else if(parameters[i].type()==typeid(ofParameter<ofVec4f>).name()){
+		}else if(type==typeid(ofParameter<ofVec4f>)){
 			setUniform4f(parameters[i].getEscapedName(),parameters[i].cast<glm::vec4>());
-		}else if(parameters[i].type()==typeid(ofParameterGroup).name()){
+		}else if(type==typeid(ofParameterGroup)){
 			setUniforms((ofParameterGroup&)parameters[i]);
 		}
 	}
@@ -1136,18 +1206,22 @@ void ofShader::setUniforms(const ofParameterGroup & parameters) const{
 
 //--------------------------------------------------------------
 void ofShader::setUniformMatrix3f(const string & name, const glm::mat3 & m, int count)  const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniformMatrix3fv(loc, count, GL_FALSE, glm::value_ptr(m));
-	}
+	setUniformMatrix3f(getUniform(name), m, count);
 }
 
 //--------------------------------------------------------------
 void ofShader::setUniformMatrix4f(const string & name, const glm::mat4 & m, int count) const{
-	if(bLoaded) {
-		int loc = getUniformLocation(name);
-		if (loc != -1) glUniformMatrix4fv(loc, count, GL_FALSE, glm::value_ptr(m));
-	}
+	setUniformMatrix4f(getUniform(name), m, count);
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniformMatrix3f(const Uniform & uniform, const glm::mat3 & m, int count)  const{
+	if(bLoaded && uniform.location != -1) glUniformMatrix3fv(uniform.location, count, GL_FALSE, glm::value_ptr(m));
+}
+
+//--------------------------------------------------------------
+void ofShader::setUniformMatrix4f(const Uniform & uniform, const glm::mat4 & m, int count) const{
+	if(bLoaded && uniform.location != -1) glUniformMatrix4fv(uniform.location, count, GL_FALSE, glm::value_ptr(m));
 }
 
 #ifndef TARGET_OPENGLES
@@ -1287,6 +1361,13 @@ GLint ofShader::getUniformLocation(const string & name)  const{
 	}
 }
 
+//--------------------------------------------------------------
+ofShader::Uniform ofShader::getUniform(const string & name) const{
+	Uniform uniform;
+	uniform.location = getUniformLocation(name);
+	return uniform;
+}
+
 #ifndef TARGET_OPENGLES
 #ifdef GLEW_ARB_uniform_buffer_object
 //--------------------------------------------------------------
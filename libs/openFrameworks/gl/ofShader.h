@@ -133,10 +133,36 @@ public:
 	void dispatchCompute(GLuint x, GLuint y, GLuint z) const;
 #endif
 
+	/// \brief The location of a uniform, looked up by name once with
+	/// getUniform() so setting it later doesn't need to search for it.
+	///
+	/// ~~~~{.cpp}
+	/// // setup, after loading the shader
+	/// time = shader.getUniform("time");
+	///
+	/// // draw
+	/// shader.begin();
+	/// shader.setUniform1f(time, ofGetElapsedTimef());
+	/// ~~~~
+	///
+	/// A uniform belongs to the shader that returned it and is valid until
+	/// that shader is loaded or linked again. Setting a uniform the shader
+	/// doesn't have does nothing, the same as setting it by name.
+	struct Uniform{
+		GLint location = -1;
+	};
+
+	/// \returns the uniform with that name, or one with location -1 if the
+	/// shader doesn't have an active uniform called like that.
+	Uniform getUniform(const std::string & name) const;
+
 	// set a texture reference
 	void setUniformTexture(const std::string & name, const ofBaseHasTexture& img, int textureLocation) const;
 	void setUniformTexture(const std::string & name, const ofTexture& img, int textureLocation) const;
 	void setUniformTexture(const std::string & name, int textureTarget, GLint textureID, int textureLocation) const;
+	void setUniformTexture(const Uniform & uniform, const ofBaseHasTexture& img, int textureLocation) const;
+	void setUniformTexture(const Uniform & uniform, const ofTexture& img, int textureLocation) const;
+	void setUniformTexture(const Uniform & uniform, int textureTarget, GLint textureID, int textureLocation) const;
 
 	// set a single uniform value
 	void setUniform1i(const std::string & name, int v1) const;
@@ -154,6 +180,21 @@ public:
 	void setUniform4f(const std::string & name, const glm::vec4 & v) const;
 	void setUniform4f(const std::string & name, const ofFloatColor & v) const;
 
+	void setUniform1i(const Uniform & uniform, int v1) const;
+	void setUniform2i(const Uniform & uniform, int v1, int v2) const;
+	void setUniform3i(const Uniform & uniform, int v1, int v2, int v3) const;
+	void setUniform4i(const Uniform & uniform, int v1, int v2, int v3, int v4) const;
+
+	void setUniform1f(const Uniform & uniform, float v1) const;
+	void setUniform2f(const Uniform & uniform, float v1, float v2) const;
+	void setUniform3f(const Uniform & uniform, float v1, float v2, float v3) const;
+	void setUniform4f(const Uniform & uniform, float v1, float v2, float v3, float v4) const;
+
+	void setUniform2f(const Uniform & uniform, const glm::vec2 & v) const;
+	void setUniform3f(const Uniform & uniform, const glm::vec3 & v) const;
+	void setUniform4f(const Uniform & uniform, const glm::vec4 & v) const;
+	void setUniform4f(const Uniform & uniform, const ofFloatColor & v) const;
+
 	// set an array of uniform values
 	void setUniform1iv(const std::string & name, const int* v, int count = 1) const;
 	void setUniform2iv(const std::string & name, const int* v, int count = 1) const;
@@ -165,11 +206,23 @@ public:
 	void setUniform3fv(const std::string & name, const float* v, int count = 1) const;
 	void setUniform4fv(const std::string & name, const float* v, int count = 1) const;
 
+	void setUniform1iv(const Uniform & uniform, const int* v, int count = 1) const;
+	void setUniform2iv(const Uniform & uniform, const int* v, int count = 1) const;
+	void setUniform3iv(const Uniform & uniform, const int* v, int count = 1) const;
+	void setUniform4iv(const Uniform & uniform, const int* v, int count = 1) const;
+
+	void setUniform1fv(const Uniform & uniform, const float* v, int count = 1) const;
+	void setUniform2fv(const Uniform & uniform, const float* v, int count = 1) const;
+	void setUniform3fv(const Uniform & uniform, const float* v, int count = 1) const;
+	void setUniform4fv(const Uniform & uniform, const float* v, int count = 1) const;
+
 	void setUniforms(const ofParameterGroup & parameters) const;
 
 	// note: it may be more optimal to use a 4x4 matrix than a 3x3 matrix, if possible
 	void setUniformMatrix3f(const std::string & name, const glm::mat3 & m, int count = 1) const;
 	void setUniformMatrix4f(const std::string & name, const glm::mat4 & m, int count = 1) const;
+	void setUniformMatrix3f(const Uniform & uniform, const glm::mat3 & m, int count = 1) const;
+	void setUniformMatrix4f(const Uniform & uniform, const glm::mat4 & m, int count = 1) const;
 
 	GLint getUniformLocation(const std::string & name) const;
 
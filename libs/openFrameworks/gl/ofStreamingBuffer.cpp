@@ -0,0 +1,238 @@
+#include "ofStreamingBuffer.h"
+#include "ofLog.h"
+#include <cstring>
+
+#ifndef TARGET_OPENGLES
+
+using namespace std;
+
+// the buffer doesn't grow over this size just to avoid waiting for the gpu
+static const GLsizeiptr maxGrowthSize = 64 * 1024 * 1024;
+
+//--------------------------------------------------------------
+ofStreamingBuffer::ofStreamingBuffer()
+:bufferSize(0)
+,mapped(nullptr)
+,written(0)
+,retired(0)
+,growOnNextFrame(false){
+
+}
+
+//--------------------------------------------------------------
+ofStreamingBuffer::~ofStreamingBuffer(){
+	clear();
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::allocate(GLsizeiptr bytes){
+	if(bytes <= 0){
+		ofLogError("ofStreamingBuffer") << "allocate(): invalid size " << bytes;
+		return;
+	}
+	reallocate(bytes);
+}
+
+//--------------------------------------------------------------
+bool ofStreamingBuffer::isAllocated() const{
+	return buffer.isAllocated();
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::clear(){
+	releaseFences();
+	if(mapped){
+		buffer.bind(GL_COPY_WRITE_BUFFER);
+		buffer.unmap();
+		buffer.unbind(GL_COPY_WRITE_BUFFER);
+		mapped = nullptr;
+	}
+	buffer = ofBufferObject();
+	bufferSize = 0;
+	written = 0;
+	retired = 0;
+	growOnNextFrame = false;
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::reallocate(GLsizeiptr bytes){
+	clear();
+	buffer.allocate();
+	bufferSize = bytes;
+
+	// the storage is bound to the copy target while it's set up so a vertex
+	// array object that might be bound doesn't change
+#ifdef GLEW_ARB_buffer_storage
+	if(GLEW_ARB_buffer_storage){
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		buffer.bind(GL_COPY_WRITE_BUFFER);
+		buffer.setStorage(bytes, nullptr, flags);
+		mapped = buffer.mapRange<uint8_t>(0, bytes, flags);
+		buffer.unbind(GL_COPY_WRITE_BUFFER);
+		if(mapped){
+			return;
+		}
+		ofLogWarning("ofStreamingBuffer") << "couldn't map the buffer persistently, using glBufferSubData";
+		// the storage of the previous buffer can't change anymore
+		buffer.allocate();
+	}
+#endif
+
+	buffer.bind(GL_COPY_WRITE_BUFFER);
+	buffer.setData(bytes, nullptr, GL_STREAM_DRAW);
+	buffer.unbind(GL_COPY_WRITE_BUFFER);
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::releaseFences(){
+	for(auto & fence: fences){
+		glDeleteSync(fence.sync);
+	}
+	fences.clear();
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::waitUntil(uint64_t position){
+	while(retired < position && !fences.empty()){
+		const Fence & fence = fences.front();
+		GLenum result = glClientWaitSync(fence.sync, 0, 0);
+		if(result == GL_TIMEOUT_EXPIRED){
+			// the gpu is still drawing from this range, a bigger buffer
+			// would have avoided waiting
+			stats.stalls++;
+			growOnNextFrame = true;
+			do{
+				result = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			}while(result == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(fence.sync);
+		retired = fence.position;
+		fences.pop_front();
+	}
+}
+
+//--------------------------------------------------------------
+GLintptr ofStreamingBuffer::reserve(GLsizeiptr bytes, GLsizeiptr alignment){
+	if(!isAllocated()){
+		ofLogError("ofStreamingBuffer") << "reserve(): buffer not allocated";
+		return -1;
+	}
+	if(bytes > bufferSize){
+		reallocate(max(bufferSize * 2, bytes * 2));
+		stats.reallocations++;
+	}
+
+	uint64_t size = bufferSize;
+	uint64_t offset = written % size;
+	uint64_t alignedOffset = (offset + alignment - 1) / alignment * alignment;
+	uint64_t start = written + (alignedOffset - offset);
+	if(alignedOffset + bytes > size){
+		// the data doesn't fit until the end, it starts again from the
+		// beginning of the buffer
+		start = written + (size - offset);
+	}
+	uint64_t end = start + bytes;
+
+	if(end - retired > size){
+		waitUntil(end - size);
+		if(end - retired > size){
+			// there's not enough space for the data of this frame
+			if(bufferSize < maxGrowthSize){
+				reallocate(min(bufferSize * 2, maxGrowthSize));
+				stats.reallocations++;
+				return reserve(bytes, alignment);
+			}
+
+			// the buffer doesn't grow anymore, wait for the gpu to draw
+			// everything written until now and start again from the
+			// beginning of the buffer
+			ofLogWarning("ofStreamingBuffer") << "reserve(): more than " << bufferSize
+				<< " bytes written in one frame, waiting for the gpu";
+			uint64_t fenced = fences.empty() ? retired : fences.back().position;
+			if(written > fenced){
+				fences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), written});
+			}
+			stats.stalls++;
+			waitUntil(written);
+			start = (written + size - 1) / size * size;
+			end = start + bytes;
+			retired = start;
+		}
+	}
+
+	written = end;
+	stats.writes++;
+	return start % size;
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::update(GLintptr offset, const void * data, GLsizeiptr bytes){
+	if(mapped){
+		memcpy(mapped + offset, data, bytes);
+	}else{
+		buffer.bind(GL_COPY_WRITE_BUFFER);
+		buffer.updateData(offset, bytes, data);
+		buffer.unbind(GL_COPY_WRITE_BUFFER);
+	}
+	stats.bytesWritten += bytes;
+}
+
+//--------------------------------------------------------------
+GLintptr ofStreamingBuffer::write(const void * data, GLsizeiptr bytes, GLsizeiptr alignment){
+	GLintptr offset = reserve(bytes, alignment);
+	if(offset >= 0){
+		update(offset, data, bytes);
+	}
+	return offset;
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::endFrame(){
+	if(!isAllocated()){
+		return;
+	}
+	if(growOnNextFrame && bufferSize < maxGrowthSize){
+		// nothing written until now is needed anymore, so there's
+		// nothing to fence
+		reallocate(min(bufferSize * 2, maxGrowthSize));
+		stats.reallocations++;
+		return;
+	}
+	growOnNextFrame = false;
+	uint64_t fenced = fences.empty() ? retired : fences.back().position;
+	if(written > fenced){
+		fences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), written});
+	}
+}
+
+//--------------------------------------------------------------
+ofBufferObject & ofStreamingBuffer::getBuffer(){
+	return buffer;
+}
+
+//--------------------------------------------------------------
+const ofBufferObject & ofStreamingBuffer::getBuffer() const{
+	return buffer;
+}
+
+//--------------------------------------------------------------
+GLsizeiptr ofStreamingBuffer::size() const{
+	return bufferSize;
+}
+
+//--------------------------------------------------------------
+bool ofStreamingBuffer::isPersistentlyMapped() const{
+	return mapped != nullptr;
+}
+
+//--------------------------------------------------------------
+const ofStreamingBuffer::Stats & ofStreamingBuffer::getStats() const{
+	return stats;
+}
+
+//--------------------------------------------------------------
+void ofStreamingBuffer::resetStats(){
+	stats = Stats();
+}
+
+#endif
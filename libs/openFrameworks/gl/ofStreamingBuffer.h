@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofBufferObject.h"
+#include <deque>
+
+#ifndef TARGET_OPENGLES
+/// \brief A buffer to send data that changes every frame to the GPU without
+/// reallocating its memory or waiting for the GPU on every upload.
+///
+/// Every write() goes to the next free range of one big buffer and returns
+/// its offset, so the data can be drawn from there, for example with
+/// ofVbo::setVertexBuffer(). endFrame() puts a fence after the data written
+/// during the frame, and the ranges behind a fence are only written again
+/// once the GPU has passed it, so nothing is overwritten while it's still
+/// being drawn.
+///
+/// With OpenGL 4.4 or ARB_buffer_storage the buffer stays mapped and writes
+/// are just copies to its memory, otherwise they use glBufferSubData. The
+/// buffer grows when the data of one frame doesn't fit or when writes had to
+/// wait for the GPU, up to 64MB. Once it's that big, a frame that writes more
+/// than fits waits for the GPU to draw what was written before reusing it.
+///
+/// Needs OpenGL 3.2 for the fences, it's not available with OpenGL ES.
+class ofStreamingBuffer{
+public:
+	struct Stats{
+		/// bytes written since the last resetStats()
+		std::size_t bytesWritten = 0;
+		/// number of writes
+		std::size_t writes = 0;
+		/// number of times a write had to wait for the GPU to finish
+		/// drawing a previous frame
+		std::size_t stalls = 0;
+		/// number of times the buffer had to grow
+		std::size_t reallocations = 0;
+	};
+
+	ofStreamingBuffer();
+	~ofStreamingBuffer();
+	ofStreamingBuffer(const ofStreamingBuffer &) = delete;
+	ofStreamingBuffer & operator=(const ofStreamingBuffer &) = delete;
+
+	/// \brief Allocate the buffer, releasing any previous one.
+	///
+	/// Around three times the data written in a frame avoids waiting for
+	/// the GPU.
+	void allocate(GLsizeiptr bytes);
+	bool isAllocated() const;
+	void clear();
+
+	/// \brief Copy data to the next free range of the buffer.
+	/// \returns the offset of the data in the buffer or -1 if it's not
+	/// allocated.
+	GLintptr write(const void * data, GLsizeiptr bytes, GLsizeiptr alignment = 16);
+
+	/// \brief Reserve a range to fill with several calls to update(), for
+	/// data that needs to be in the same buffer.
+	///
+	/// The buffer can grow on the next reserve() or write(), so getBuffer()
+	/// has to be called after reserving.
+	/// \returns the offset of the range or -1 if it's not allocated.
+	GLintptr reserve(GLsizeiptr bytes, GLsizeiptr alignment = 16);
+
+	/// \brief Copy data to a range returned by the last reserve().
+	void update(GLintptr offset, const void * data, GLsizeiptr bytes);
+
+	/// \brief Put a fence after everything written until now, called once a
+	/// frame after drawing with the data.
+	void endFrame();
+
+	ofBufferObject & getBuffer();
+	const ofBufferObject & getBuffer() const;
+	GLsizeiptr size() const;
+
+	/// \returns true if the buffer stays mapped and writes don't call GL.
+	bool isPersistentlyMapped() const;
+
+	const Stats & getStats() const;
+	void resetStats();
+
+private:
+	struct Fence{
+		GLsync sync;
+		// position in the stream of bytes after the fenced data
+		uint64_t position;
+	};
+
+	void reallocate(GLsizeiptr bytes);
+	void releaseFences();
+	// waits until the bytes before position can be written again
+	void waitUntil(uint64_t position);
+
+	ofBufferObject buffer;
+	GLsizeiptr bufferSize;
+	uint8_t * mapped;
+	// positions in the stream of bytes written since the allocation, the
+	// offset in the buffer is the position modulo its size
+	uint64_t written;
+	uint64_t retired;
+	std::deque<Fence> fences;
+	bool growOnNextFrame;
+	Stats stats;
+};
+#endif
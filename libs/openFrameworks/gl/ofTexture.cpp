@@ -4,6 +4,7 @@
 #include "ofGraphics.h"
 #include "ofPixels.h"
 #include "ofGLUtils.h"
+#include "ofPixelsReadback.h"
 #include <map>
 
 #ifdef TARGET_ANDROID
@@ -1244,6 +1245,21 @@ void ofTexture::readToPixels(ofFloatPixels & pixels) const {
 }
 
 #ifndef TARGET_OPENGLES
+//----------------------------------------------------------
+void ofTexture::readToPixelsAsync(ofPixelsReadback & readback) const{
+	readback.read(*this);
+}
+
+//----------------------------------------------------------
+void ofTexture::readToPixelsAsync(ofShortPixelsReadback & readback) const{
+	readback.read(*this);
+}
+
+//----------------------------------------------------------
+void ofTexture::readToPixelsAsync(ofFloatPixelsReadback & readback) const{
+	readback.read(*this);
+}
+
 //----------------------------------------------------------
 void ofTexture::copyTo(ofBufferObject & buffer) const{
 	ofSetPixelStoreiAlignment(GL_PACK_ALIGNMENT,getWidth(),ofGetBytesPerChannelFromGLType(ofGetGlTypeFromInternal(texData.glInternalFormat)),ofGetNumChannelsFromGLFormat(ofGetGLFormatFromInternal(texData.glInternalFormat)));
@@ -5,6 +5,12 @@
 #include "ofConstants.h"
 #include "ofVboMesh.h"
 
+template<typename T>
+class ofPixelsReadback_;
+typedef ofPixelsReadback_<unsigned char> ofPixelsReadback;
+typedef ofPixelsReadback_<unsigned short> ofShortPixelsReadback;
+typedef ofPixelsReadback_<float> ofFloatPixelsReadback;
+
 /// \file
 /// ofTexture is used to create OpenGL textures that live on your graphics card
 /// (GPU). While you can certainly use ofTexture directly to manipulate and
@@ -859,6 +865,17 @@ class ofTexture : public ofBaseDraws {
 	void readToPixels(ofFloatPixels & pixels) const;
 
 #ifndef TARGET_OPENGLES
+	/// \brief Start reading the texture to pixels without waiting for the
+	/// GPU, they arrive some frames later through the readback.
+	///
+	/// \warning This is not supported in OpenGL ES.
+	///
+	/// \param readback The ring of buffers to read to.
+	/// \sa ofPixelsReadback_
+	void readToPixelsAsync(ofPixelsReadback & readback) const;
+	void readToPixelsAsync(ofShortPixelsReadback & readback) const;
+	void readToPixelsAsync(ofFloatPixelsReadback & readback) const;
+
 	/// \brief Copy the texture to an ofBufferObject.
 	/// \param buffer the target buffer to copy to.
 	void copyTo(ofBufferObject & buffer) const;
@@ -392,40 +392,37 @@ static void addBitmapCharacter(ofMesh & charMesh, int & vertexCount, int charact
 	}	
 }
 
-ofMesh ofBitmapFont::getMesh(const string & text, int x, int y, ofDrawBitmapMode mode, bool vFlipped) const{
+static void layoutBitmapString(ofMesh & charMesh, const string & text, bool vFlipped){
 	int len = (int)text.length();
 	float fontSize = 8.0f;
 
-	ofMesh charMesh;
 	charMesh.setMode(OF_PRIMITIVE_TRIANGLES);
 	charMesh.getVertices().resize(6 * len);
 	charMesh.getTexCoords().resize(6 * len);
 
 	int vertexCount = 0;
 	int column = 0;
+	int line = 0;
 	float lineHeight = fontSize*1.7f;
-	int newLineDirection = 1.0f;
-
-	if(!vFlipped){
-		newLineDirection  = -1;
-		// this would align multiline texts to the last line when vflip is disabled
-		//int lines = ofStringTimesInString(textString,"\n");
-		//y = lines*lineHeight;
-	}
 
-	float sx = x;
-	float sy = y-fontSize;
+	// the mesh is laid out at 0,0 and translated by whole pixels, so the
+	// offset of every line is rounded the same way it would be if the
+	// position was added before rounding to a positive coordinate
+	int sx = 0;
+	int sy = -fontSize;
 
 	for(int c = 0; c < len; c++){
 		if(text[c] == '\n'){
-
-			sy += lineHeight*newLineDirection;
-//			if(mode == OF_BITMAPMODE_SIMPLE) {
-				sx = x;
-//			} else {
-//				sx = 0;
-//			}
-
+			line++;
+			if(vFlipped){
+				sy = -fontSize + (int)(lineHeight*line);
+			}else{
+				// this would align multiline texts to the last line when vflip is disabled
+				//int lines = ofStringTimesInString(textString,"\n");
+				//y = lines*lineHeight;
+				sy = -fontSize - (int)ceil(lineHeight*line);
+			}
+			sx = 0;
 			column = 0;
 		} else if (text[c] == '\t'){
 			//move the cursor to the position of the next tab
@@ -437,7 +434,7 @@ ofMesh ofBitmapFont::getMesh(const string & text, int x, int y, ofDrawBitmapMode
 			// < 32 = control characters - don't draw
 			// solves a bug with control characters
 			// getting drawn when they ought to not be
-			addBitmapCharacter(charMesh, vertexCount, text[c], (int)sx, (int)sy, vFlipped);
+			addBitmapCharacter(charMesh, vertexCount, text[c], sx, sy, vFlipped);
 
 			sx += fontSize;
 			column++;
@@ -446,11 +443,116 @@ ofMesh ofBitmapFont::getMesh(const string & text, int x, int y, ofDrawBitmapMode
 	//We do this because its way faster
 	charMesh.getVertices().resize(vertexCount);
 	charMesh.getTexCoords().resize(vertexCount);
+}
+
+ofMesh ofBitmapFont::getMesh(const string & text, int x, int y, ofDrawBitmapMode mode, bool vFlipped) const{
+	std::unique_lock<std::mutex> lock(cacheMutex);
+	ofMesh charMesh = getCachedMeshUnlocked(text, vFlipped);
+	lock.unlock();
+	if(x != 0 || y != 0){
+		glm::vec3 offset(x, y, 0);
+		for(auto & v: charMesh.getVertices()){
+			v += offset;
+		}
+	}
 	return charMesh;
+}
+
+void ofBitmapFont::getCachedMesh(const string & text, ofMesh & mesh, bool vFlipped) const{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	mesh = getCachedMeshUnlocked(text, vFlipped);
+}
+
+const ofMesh & ofBitmapFont::getCachedMeshUnlocked(const string & text, bool vFlipped) const{
+	if(maxCachedStrings == 0){
+		uncachedMesh.clear();
+		layoutBitmapString(uncachedMesh, text, vFlipped);
+		return uncachedMesh;
+	}
+
+	auto & index = cacheIndex[vFlipped];
+	auto it = index.find(text);
+	if(it != index.end()){
+		cache.splice(cache.begin(), cache, it->second);
+		return it->second->mesh;
+	}
+
+	if(cache.size() >= maxCachedStrings){
+		// reuse the least recently used entry to keep its memory
+		auto & oldest = cache.back();
+		cacheIndex[oldest.vFlipped].erase(oldest.text);
+		cache.splice(cache.begin(), cache, std::prev(cache.end()));
+	}else{
+		cache.emplace_front();
+	}
+	auto & entry = cache.front();
+	entry.text = text;
+	entry.vFlipped = vFlipped;
+	entry.mesh.clear();
+	layoutBitmapString(entry.mesh, text, vFlipped);
+	index[text] = cache.begin();
+	return entry.mesh;
+}
+
+void ofBitmapFont::setCacheSize(std::size_t maxStrings){
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	maxCachedStrings = maxStrings;
+	while(cache.size() > maxCachedStrings){
+		cacheIndex[cache.back().vFlipped].erase(cache.back().text);
+		cache.pop_back();
+	}
+}
+
+std::size_t ofBitmapFont::getCacheSize() const{
+	return maxCachedStrings;
+}
+
+void ofBitmapFont::clearCache(){
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	cache.clear();
+	cacheIndex[0].clear();
+	cacheIndex[1].clear();
+}
+
+void ofBitmapFont::addToBatch(const string & text, int x, int y, bool vFlipped, const glm::mat4 & modelViewProjection, const ofFloatColor & color){
+	// the cached mesh can be discarded by other threads once unlocked
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	const ofMesh & charMesh = getCachedMeshUnlocked(text, vFlipped);
+	const auto & vertices = charMesh.getVertices();
+	const auto & texCoords = charMesh.getTexCoords();
+	auto & batchVertices = batch.getVertices();
+	auto & batchTexCoords = batch.getTexCoords();
+	auto & batchColors = batch.getColors();
+	glm::vec4 offset(x, y, 0, 0);
+	glm::vec4 clip[6];
+	for(std::size_t i = 0; i + 6 <= vertices.size(); i += 6){
+		bool visible = true;
+		for(std::size_t j = 0; j < 6; j++){
+			clip[j] = modelViewProjection * (glm::vec4(vertices[i + j], 1) + offset);
+			visible &= clip[j].w > 0;
+		}
+		if(!visible){
+			continue;
+		}
+		for(std::size_t j = 0; j < 6; j++){
+			batchVertices.push_back(clip[j].xyz() / clip[j].w);
+			batchTexCoords.push_back(texCoords[i + j]);
+			batchColors.push_back(color);
+		}
+	}
+}
+
+const ofMesh & ofBitmapFont::getBatch() const{
+	return batch;
+}
 
+void ofBitmapFont::clearBatch(){
+	batch.clear();
 }
 
-ofBitmapFont::ofBitmapFont(){
+ofBitmapFont::ofBitmapFont()
+:maxCachedStrings(128){
+	batch.setMode(OF_PRIMITIVE_TRIANGLES);
 #ifdef TARGET_ANDROID
 	ofAddListener(ofxAndroidEvents().unloadGL,this,&ofBitmapFont::unloadTexture);
 #endif
@@ -481,7 +583,8 @@ ofRectangle ofBitmapFont::getBoundingBox(const string & text, int x, int y, ofDr
         return ofRectangle(x,y,0,0);
     }
 
-	const ofMesh & mesh = getMesh(text,x,y, mode, vFlipped);
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	const ofMesh & mesh = getCachedMeshUnlocked(text, vFlipped);
 	glm::vec2 max(numeric_limits<float>::lowest(),numeric_limits<float>::lowest());
 	glm::vec2 min(numeric_limits<float>::max(),numeric_limits<float>::max());
 	for(const auto & p : mesh.getVertices()){
@@ -490,5 +593,6 @@ ofRectangle ofBitmapFont::getBoundingBox(const string & text, int x, int y, ofDr
 		if(p.x>max.x) max.x = p.x;
 		if(p.y>max.y) max.y = p.y;
 	}
-	return ofRectangle(min,max);
+	glm::vec2 offset(x, y);
+	return ofRectangle(min + offset, max + offset);
 }
@@ -6,6 +6,9 @@
 #include "ofTexture.h"
 #include "ofMesh.h"
 #include "ofGraphics.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
 class ofRectangle;
 
 /*
@@ -21,12 +24,64 @@ class ofBitmapFont{
 public:
 	ofBitmapFont();
 	~ofBitmapFont();
+
+	/// \brief Get the mesh of a string, a copy that the caller owns.
+	///
+	/// Uses the cache of getCachedMesh() so it's faster for strings used
+	/// recently. It can be called from any thread.
 	ofMesh getMesh(const std::string & text, int x, int y, ofDrawBitmapMode mode=OF_BITMAPMODE_MODEL_BILLBOARD, bool vFlipped=true) const;
 	const ofTexture & getTexture() const;
+
+	/// \brief Get the bounding box of a string.
+	///
+	/// Like getMesh() it uses the cache and can be called from any thread.
 	ofRectangle getBoundingBox(const std::string & text, int x, int y, ofDrawBitmapMode mode = ofGetStyle().drawBitmapMode, bool vFlipped = ofIsVFlipped()) const;
+
+	/// \brief Copy the mesh of a string at 0,0 from a cache of the last
+	/// strings used.
+	///
+	/// Text drawn every frame rarely changes, so the meshes of the most
+	/// recently used strings are kept instead of laying out every character
+	/// again. The mesh is copied while the cache is locked, so it can be
+	/// called from any thread, and reusing the same mesh reuses its memory.
+	void getCachedMesh(const std::string & text, ofMesh & mesh, bool vFlipped=true) const;
+
+	/// \brief Set the maximum number of strings in the cache, when there
+	/// are more the least recently used ones are discarded. 0 disables the
+	/// cache.
+	void setCacheSize(std::size_t maxStrings);
+	std::size_t getCacheSize() const;
+	void clearCache();
+
+	/// \brief Add a string to a batch so several strings can be drawn with
+	/// one draw call.
+	///
+	/// The characters are transformed by modelViewProjection so the batch
+	/// is in normalized device coordinates and has to be drawn with identity
+	/// matrices in the same viewport. Characters behind the camera are
+	/// discarded.
+	void addToBatch(const std::string & text, int x, int y, bool vFlipped, const glm::mat4 & modelViewProjection, const ofFloatColor & color);
+	const ofMesh & getBatch() const;
+	void clearBatch();
+
 private:
+	struct CachedMesh{
+		std::string text;
+		bool vFlipped;
+		ofMesh mesh;
+	};
+
 	static void init();
+	const ofMesh & getCachedMeshUnlocked(const std::string & text, bool vFlipped) const;
 	static ofPixels pixels;
 	void unloadTexture();
 	mutable ofTexture texture;
+
+	// most recently used first, indexed by text for each vFlipped
+	mutable std::list<CachedMesh> cache;
+	mutable std::unordered_map<std::string, std::list<CachedMesh>::iterator> cacheIndex[2];
+	mutable ofMesh uncachedMesh;
+	mutable std::mutex cacheMutex;
+	std::size_t maxCachedStrings;
+	ofMesh batch;
 };
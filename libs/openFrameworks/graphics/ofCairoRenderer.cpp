@@ -7,6 +7,8 @@
 #include "ofTrueTypeFont.h"
 #include "ofNode.h"
 #include "ofGraphics.h"
+#include "ofTaskPool.h"
+#include <atomic>
 
 using namespace std;
 
@@ -27,6 +29,9 @@ ofCairoRenderer::ofCairoRenderer()
 	multiPage = false;
 	b3D = false;
 	currentMatrixMode=OF_MATRIX_MODELVIEW;
+	tileSize = 0;
+	tileThreads = 0;
+	tilePixels = nullptr;
 }
 
 ofCairoRenderer::~ofCairoRenderer(){
@@ -82,7 +87,12 @@ void ofCairoRenderer::setup(string _filename, Type _type, bool multiPage_, bool
 	case IMAGE:
 		imageBuffer.allocate(outputsize.width, outputsize.height, OF_PIXELS_BGRA);
 		imageBuffer.set(0);
-		surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,outputsize.width, outputsize.height,outputsize.width*4);
+		if(tileSize>0){
+			cairo_rectangle_t extents = {0, 0, outputsize.width, outputsize.height};
+			surface = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+		}else{
+			surface = cairo_image_surface_create_for_data(imageBuffer.getData(),CAIRO_FORMAT_ARGB32,outputsize.width, outputsize.height,outputsize.width*4);
+		}
 		break;
 	case FROM_FILE_EXTENSION:
 		ofLogFatalError("ofCairoRenderer") << "setup(): couldn't determine type from extension for filename: \"" << _filename << "\"!";
@@ -106,13 +116,186 @@ void ofCairoRenderer::setupMemoryOnly(Type _type, bool multiPage_, bool b3D_, of
 	setup("",_type,multiPage_,b3D_,outputsize);
 }
 
-void ofCairoRenderer::flush(){
+void ofCairoRenderer::setTiledRendering(int _tileSize, std::size_t numThreads){
 	if(surface){
+		ofLogWarning("ofCairoRenderer") << "setTiledRendering(): has to be called before setup, ignoring";
+		return;
+	}
+	tileSize = std::max(_tileSize, 0);
+	tileThreads = numThreads;
+}
+
+bool ofCairoRenderer::isTiledRendering() const{
+	return surface && cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_RECORDING;
+}
+
+void ofCairoRenderer::restartRecording(){
+	// new drawing goes to an empty recording, the state of the context is
+	// carried over so it continues exactly as before
+	cairo_matrix_t matrix;
+	cairo_get_matrix(cr,&matrix);
+	cairo_identity_matrix(cr);
+	cairo_rectangle_list_t * clip = cairo_copy_clip_rectangle_list(cr);
+	if(clip->status != CAIRO_STATUS_SUCCESS){
+		// cairo can't return clips that aren't made of rectangles, keep
+		// drawing to the same recording instead which will be replayed
+		// whole next time, see rasterizeTiles()
+		cairo_rectangle_list_destroy(clip);
+		cairo_set_matrix(cr,&matrix);
+		return;
+	}
+
+	int width = imageBuffer.getWidth();
+	int height = imageBuffer.getHeight();
+	cairo_rectangle_t extents = {0, 0, (double)width, (double)height};
+	cairo_surface_t * recording = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+	cairo_t * recordingCr = cairo_create(recording);
+
+	// the recording starts with the current pixels so replaying it gives
+	// the same result as drawing on top of them, blend modes included.
+	// The recording only references them: every tile reads its own region
+	// of the pixels before writing it, and the surface over them is never
+	// flushed or destroyed while a recording uses it, which is what would
+	// make cairo copy the whole image
+	cairo_surface_t * pixels = cairo_image_surface_create_for_data(imageBuffer.getData(), CAIRO_FORMAT_ARGB32, width, height, imageBuffer.getBytesStride());
+	cairo_set_operator(recordingCr, CAIRO_OPERATOR_SOURCE);
+	cairo_set_source_surface(recordingCr, pixels, 0, 0);
+	cairo_paint(recordingCr);
+
+	cairo_set_source(recordingCr, cairo_get_source(cr));
+	cairo_set_operator(recordingCr, cairo_get_operator(cr));
+	cairo_set_antialias(recordingCr, cairo_get_antialias(cr));
+	cairo_set_fill_rule(recordingCr, cairo_get_fill_rule(cr));
+	cairo_set_line_width(recordingCr, cairo_get_line_width(cr));
+	cairo_set_line_cap(recordingCr, cairo_get_line_cap(cr));
+	cairo_set_line_join(recordingCr, cairo_get_line_join(cr));
+	cairo_set_miter_limit(recordingCr, cairo_get_miter_limit(cr));
+	cairo_set_tolerance(recordingCr, cairo_get_tolerance(cr));
+	cairo_set_font_face(recordingCr, cairo_get_font_face(cr));
+	cairo_matrix_t fontMatrix;
+	cairo_get_font_matrix(cr, &fontMatrix);
+	cairo_set_font_matrix(recordingCr, &fontMatrix);
+	for(int i=0;i<clip->num_rectangles;i++){
+		const cairo_rectangle_t & r = clip->rectangles[i];
+		cairo_rectangle(recordingCr, r.x, r.y, r.width, r.height);
+	}
+	cairo_clip(recordingCr);
+	cairo_rectangle_list_destroy(clip);
+	cairo_set_matrix(recordingCr,&matrix);
+
+	cairo_destroy(cr);
+	cairo_surface_destroy(surface);
+	cr = recordingCr;
+	surface = recording;
+	// after the recording that referenced it
+	if(tilePixels){
+		cairo_surface_destroy(tilePixels);
+	}
+	tilePixels = pixels;
+}
+
+void ofCairoRenderer::rasterizeTiles(){
+	cairo_surface_flush(surface);
+
+	// if the clip isn't made of rectangles the recording can't be
+	// restarted afterwards and is replayed whole again next time, so it
+	// needs a copy of the pixels it started with before the tiles
+	// overwrite them. Flushing the surface over the pixels makes cairo
+	// take that copy
+	if(tilePixels){
+		cairo_matrix_t matrix;
+		cairo_get_matrix(cr,&matrix);
+		cairo_identity_matrix(cr);
+		cairo_rectangle_list_t * clip = cairo_copy_clip_rectangle_list(cr);
+		if(clip->status != CAIRO_STATUS_SUCCESS){
+			cairo_surface_flush(tilePixels);
+		}
+		cairo_rectangle_list_destroy(clip);
+		cairo_set_matrix(cr,&matrix);
+	}
+
+	int width = imageBuffer.getWidth();
+	int height = imageBuffer.getHeight();
+	int tilesX = (width + tileSize - 1) / tileSize;
+	int tilesY = (height + tileSize - 1) / tileSize;
+	int numTiles = tilesX * tilesY;
+	size_t stride = imageBuffer.getBytesStride();
+	unsigned char * data = imageBuffer.getData();
+
+	size_t numThreads = tileThreads;
+	if(numThreads == 0){
+		numThreads = ofGetTaskPool().getNumThreads() + 1;
+	}
+	numThreads = std::min(numThreads, (size_t)numTiles);
+
+	// replaying a recording isn't thread safe so every thread gets its
+	// own copy. Painting the recording into another one takes a snapshot
+	// of it, flushing the original detaches that snapshot so the next
+	// copy doesn't share it
+	vector<cairo_surface_t*> recordings(numThreads, surface);
+	cairo_rectangle_t extents = {0, 0, (double)width, (double)height};
+	for(size_t i=1;i<numThreads;i++){
+		recordings[i] = cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+		cairo_t * copyCr = cairo_create(recordings[i]);
+		cairo_set_operator(copyCr, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface(copyCr, surface, 0, 0);
+		cairo_paint(copyCr);
+		cairo_destroy(copyCr);
+		cairo_surface_flush(surface);
+	}
+
+	// every tile is a surface over its own region of the output pixels so
+	// there's nothing to stitch afterwards. The recording starts with the
+	// previous pixels so tiles replace their region instead of blending
+	// over it. Tiles are placed at integer offsets which makes cairo replay
+	// the commands directly instead of resampling them, so the result is
+	// the same as drawing to a single surface.
+	std::atomic<int> nextTile(0);
+	auto renderTiles = [&](cairo_surface_t * recording){
+		for(int tile = nextTile++; tile < numTiles; tile = nextTile++){
+			int x = (tile % tilesX) * tileSize;
+			int y = (tile / tilesX) * tileSize;
+			int w = std::min(tileSize, width - x);
+			int h = std::min(tileSize, height - y);
+			cairo_surface_t * tileSurface = cairo_image_surface_create_for_data(data + y * stride + x * 4, CAIRO_FORMAT_ARGB32, w, h, stride);
+			cairo_t * tileCr = cairo_create(tileSurface);
+			cairo_set_operator(tileCr, CAIRO_OPERATOR_SOURCE);
+			cairo_set_source_surface(tileCr, recording, -x, -y);
+			cairo_paint(tileCr);
+			cairo_destroy(tileCr);
+			cairo_surface_flush(tileSurface);
+			cairo_surface_destroy(tileSurface);
+		}
+	};
+
+	ofTaskGroup group;
+	for(size_t i=1;i<numThreads;i++){
+		auto recording = recordings[i];
+		group.run([&renderTiles, recording]{
+			renderTiles(recording);
+		});
+	}
+	renderTiles(surface);
+	group.wait();
+	for(size_t i=1;i<numThreads;i++){
+		cairo_surface_destroy(recordings[i]);
+	}
+
+	restartRecording();
+}
+
+void ofCairoRenderer::flush(){
+	if(isTiledRendering()){
+		rasterizeTiles();
+	}else if(surface){
 		cairo_surface_flush(surface);
 	}
 }
 
 void ofCairoRenderer::close(){
+	if(isTiledRendering()){
+		rasterizeTiles();
+	}
 	if(surface){
 		cairo_surface_flush(surface);
 		if(type==IMAGE && filename!=""){
@@ -126,6 +309,10 @@ void ofCairoRenderer::close(){
 		cairo_destroy(cr);
 		cr = nullptr;
 	}
+	if(tilePixels){
+		cairo_surface_destroy(tilePixels);
+		tilePixels = nullptr;
+	}
 }
 
 
@@ -135,7 +322,12 @@ void ofCairoRenderer::startRender(){
 		page=1;
 	}else{
 		page++;
-		if(getBackgroundAuto()){
+		if(isTiledRendering()){
+			// the previous page was rasterized in finishRender
+			if(getBackgroundAuto()){
+				clear();
+			}
+		}else if(getBackgroundAuto()){
 			cairo_show_page(cr);
 			clear();
 		}else{
@@ -145,7 +337,7 @@ void ofCairoRenderer::startRender(){
 }
 
 void ofCairoRenderer::finishRender(){
-	cairo_surface_flush(surface);
+	flush();
 }
 
 void ofCairoRenderer::setStyle(const ofStyle & style){
@@ -1359,6 +1551,8 @@ cairo_surface_t * ofCairoRenderer::getCairoSurface(){
 ofPixels & ofCairoRenderer::getImageSurfacePixels(){
 	if(type!=IMAGE){
 		ofLogError("ofCairoRenderer") << "getImageSurfacePixels(): can only get pixels from image surface";
+	}else if(isTiledRendering()){
+		rasterizeTiles();
 	}
 	return imageBuffer;
 }
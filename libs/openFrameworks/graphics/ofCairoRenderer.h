@@ -27,6 +27,30 @@ public:
 	};
 	void setup(std::string filename, Type type=ofCairoRenderer::FROM_FILE_EXTENSION, bool multiPage=true, bool b3D=false, ofRectangle outputsize = ofRectangle(0,0,0,0));
 	void setupMemoryOnly(Type _type, bool multiPage=true, bool b3D=false, ofRectangle viewport = ofRectangle(0,0,0,0));
+
+	/// \brief Rasterize IMAGE output in tiles using several threads.
+	///
+	/// When enabled the draw calls are recorded and, every time the frame
+	/// finishes or the pixels are requested, replayed in parallel into
+	/// tiles of tileSize x tileSize pixels that write directly into the
+	/// output pixels. The result is the same as rendering into a single
+	/// surface but large images render much faster.
+	///
+	/// Has to be called before setup() and only affects IMAGE renderers.
+	///
+	/// The recording is replaced by a new one every time the tiles are
+	/// rasterized, in flush(), finishRender() and getImageSurfacePixels(),
+	/// and so are the context and the surface. Call getCairoContext() and
+	/// getCairoSurface() again after any of those instead of keeping the
+	/// pointers. The transformation, clip and drawing state carry over but
+	/// the states saved with cairo_save() don't, unless the clip isn't made
+	/// of rectangles, then the same context keeps recording.
+	///
+	/// \param tileSize Size in pixels of each tile, 0 disables tiling.
+	/// \param numThreads Number of threads to use, counting the one that
+	/// draws, 0 uses every worker of ofGetTaskPool().
+	void setTiledRendering(int tileSize, std::size_t numThreads = 0);
+	bool isTiledRendering() const;
 	void close();
 	void flush();
 
@@ -155,7 +179,13 @@ public:
 	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
 
 	// cairo specifics
+	/// \brief The context the renderer draws to.
+	///
+	/// With tiled rendering it changes every time the tiles are rasterized,
+	/// see setTiledRendering().
 	cairo_t * getCairoContext();
+	/// \brief The surface the renderer draws to, a recording surface with
+	/// tiled rendering that changes like the context.
 	cairo_surface_t * getCairoSurface();
 	ofPixels & getImageSurfacePixels();
 	ofBuffer & getContentBuffer();
@@ -171,6 +201,8 @@ private:
 	glm::vec3 transform(glm::vec3 vec) const;
 	static _cairo_status stream_function(void *closure,const unsigned char *data, unsigned int length);
 	void draw(const ofPixels & img, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void restartRecording();
+	void rasterizeTiles();
 
 	mutable std::deque<glm::vec3> curvePoints;
 	cairo_t * cr;
@@ -202,6 +234,11 @@ private:
 	ofBuffer streamBuffer;
 	ofPixels imageBuffer;
 
+	int tileSize;
+	std::size_t tileThreads;
+	// the output pixels as the start of the current recording
+	cairo_surface_t * tilePixels;
+
 	ofStyle currentStyle;
 	std::deque <ofStyle> styleHistory;
 	of3dGraphics graphics3d;
@@ -0,0 +1,243 @@
+#include "ofColorLut.h"
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include <sstream>
+
+using namespace std;
+
+//----------------------------------------------------------
+ofColorLut::ofColorLut()
+:size(0)
+,b3D(false)
+,domainMin(0)
+,domainMax(1){
+
+}
+
+//----------------------------------------------------------
+bool ofColorLut::load(const std::filesystem::path & path){
+	ofFile file(path, ofFile::ReadOnly);
+	if(!file.exists()){
+		ofLogError("ofColorLut") << "load(): couldn't find " << path;
+		return false;
+	}
+	return load(file.readToBuffer());
+}
+
+//----------------------------------------------------------
+bool ofColorLut::load(const ofBuffer & buffer){
+	clear();
+	istringstream stream(buffer.getText());
+	string line;
+	size_t lineNum = 0;
+	size_t expected = 0;
+	bool is3D = false;
+	glm::vec3 min(0), max(1);
+	vector<glm::vec3> entries;
+	while(getline(stream, line)){
+		lineNum++;
+		auto start = line.find_first_not_of(" \t\r");
+		if(start == string::npos || line[start] == '#'){
+			continue;
+		}
+		const char * data = line.c_str() + start;
+		char * end;
+		float r = strtof(data, &end);
+		if(end != data){
+			// data line, 3 floats
+			float g = strtof(end, &end);
+			float b = strtof(end, &end);
+			if(expected == 0){
+				ofLogError("ofColorLut") << "load(): found data before the table size in line " << lineNum;
+				return false;
+			}
+			entries.emplace_back(r, g, b);
+			continue;
+		}
+
+		istringstream keywordLine(line.substr(start));
+		string keyword;
+		keywordLine >> keyword;
+		if(keyword == "TITLE"){
+			auto first = line.find('"');
+			auto last = line.rfind('"');
+			if(first != string::npos && last > first){
+				title = line.substr(first + 1, last - first - 1);
+			}
+		}else if(keyword == "LUT_1D_SIZE" || keyword == "LUT_3D_SIZE"){
+			is3D = keyword == "LUT_3D_SIZE";
+			keywordLine >> size;
+			expected = is3D ? size * size * size : size;
+			if(size < 2){
+				ofLogError("ofColorLut") << "load(): invalid table size in line " << lineNum;
+				size = 0;
+				return false;
+			}
+		}else if(keyword == "DOMAIN_MIN"){
+			keywordLine >> min.r >> min.g >> min.b;
+		}else if(keyword == "DOMAIN_MAX"){
+			keywordLine >> max.r >> max.g >> max.b;
+		}else if(keyword == "LUT_1D_INPUT_RANGE" || keyword == "LUT_3D_INPUT_RANGE"){
+			float rangeMin = 0, rangeMax = 1;
+			keywordLine >> rangeMin >> rangeMax;
+			min = glm::vec3(rangeMin);
+			max = glm::vec3(rangeMax);
+		}else{
+			ofLogWarning("ofColorLut") << "load(): ignoring unknown keyword " << keyword << " in line " << lineNum;
+		}
+	}
+
+	if(expected == 0 || entries.size() != expected){
+		ofLogError("ofColorLut") << "load(): expected " << expected << " entries but found " << entries.size();
+		size = 0;
+		return false;
+	}
+
+	table = std::move(entries);
+	b3D = is3D;
+	setDomain(min, max);
+	return true;
+}
+
+//----------------------------------------------------------
+void ofColorLut::allocate1D(size_t _size){
+	clear();
+	size = std::max<size_t>(_size, 2);
+	b3D = false;
+	table.resize(size);
+	for(size_t i = 0; i < size; i++){
+		table[i] = glm::vec3(float(i) / (size - 1));
+	}
+}
+
+//----------------------------------------------------------
+void ofColorLut::allocate3D(size_t _size){
+	clear();
+	size = std::max<size_t>(_size, 2);
+	b3D = true;
+	table.resize(size * size * size);
+	float step = 1.f / (size - 1);
+	auto entry = table.begin();
+	for(size_t b = 0; b < size; b++){
+		for(size_t g = 0; g < size; g++){
+			for(size_t r = 0; r < size; r++){
+				*entry++ = glm::vec3(r * step, g * step, b * step);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofColorLut::clear(){
+	table.clear();
+	size = 0;
+	b3D = false;
+	title.clear();
+	domainMin = glm::vec3(0);
+	domainMax = glm::vec3(1);
+}
+
+//----------------------------------------------------------
+bool ofColorLut::isAllocated() const{
+	return size > 0;
+}
+
+//----------------------------------------------------------
+bool ofColorLut::is3D() const{
+	return b3D;
+}
+
+//----------------------------------------------------------
+size_t ofColorLut::getSize() const{
+	return size;
+}
+
+//----------------------------------------------------------
+void ofColorLut::setDomain(const glm::vec3 & min, const glm::vec3 & max){
+	domainMin = min;
+	domainMax = max;
+}
+
+//----------------------------------------------------------
+const glm::vec3 & ofColorLut::getDomainMin() const{
+	return domainMin;
+}
+
+//----------------------------------------------------------
+const glm::vec3 & ofColorLut::getDomainMax() const{
+	return domainMax;
+}
+
+//----------------------------------------------------------
+vector<glm::vec3> & ofColorLut::getData(){
+	return table;
+}
+
+//----------------------------------------------------------
+const vector<glm::vec3> & ofColorLut::getData() const{
+	return table;
+}
+
+//----------------------------------------------------------
+const string & ofColorLut::getTitle() const{
+	return title;
+}
+
+//----------------------------------------------------------
+glm::vec3 ofColorLut::apply(const glm::vec3 & color) const{
+	if(size == 0){
+		return color;
+	}
+	// position in the table, from 0 to size - 1
+	glm::vec3 p = glm::clamp((color - domainMin) / (domainMax - domainMin), 0.f, 1.f) * float(size - 1);
+	return b3D ? apply3D(p) : apply1D(p);
+}
+
+//----------------------------------------------------------
+glm::vec3 ofColorLut::apply1D(const glm::vec3 & p) const{
+	glm::vec3 result;
+	for(int c = 0; c < 3; c++){
+		size_t i = std::min(size_t(p[c]), size - 2);
+		float f = p[c] - i;
+		result[c] = table[i][c] * (1.f - f) + table[i + 1][c] * f;
+	}
+	return result;
+}
+
+//----------------------------------------------------------
+glm::vec3 ofColorLut::apply3D(const glm::vec3 & p) const{
+	// tetrahedral interpolation: the cube around the color is split in 6
+	// tetrahedra along its diagonal and the color is interpolated from the
+	// 4 corners of the one that contains it, which needs less lookups than
+	// trilinear interpolation and keeps the neutral axis exact
+	size_t r = std::min(size_t(p.r), size - 2);
+	size_t g = std::min(size_t(p.g), size - 2);
+	size_t b = std::min(size_t(p.b), size - 2);
+	float fr = p.r - r;
+	float fg = p.g - g;
+	float fb = p.b - b;
+
+	const size_t dr = 1;
+	const size_t dg = size;
+	const size_t db = size * size;
+	const glm::vec3 * c000 = &table[r + g * dg + b * db];
+	const glm::vec3 & c111 = c000[dr + dg + db];
+
+	if(fr > fg){
+		if(fg > fb){
+			return (1.f - fr) * c000[0] + (fr - fg) * c000[dr] + (fg - fb) * c000[dr + dg] + fb * c111;
+		}else if(fr > fb){
+			return (1.f - fr) * c000[0] + (fr - fb) * c000[dr] + (fb - fg) * c000[dr + db] + fg * c111;
+		}else{
+			return (1.f - fb) * c000[0] + (fb - fr) * c000[db] + (fr - fg) * c000[dr + db] + fg * c111;
+		}
+	}else{
+		if(fb > fg){
+			return (1.f - fb) * c000[0] + (fb - fg) * c000[db] + (fg - fr) * c000[dg + db] + fr * c111;
+		}else if(fb > fr){
+			return (1.f - fg) * c000[0] + (fg - fb) * c000[dg] + (fb - fr) * c000[dg + db] + fr * c111;
+		}else{
+			return (1.f - fg) * c000[0] + (fg - fr) * c000[dg] + (fr - fb) * c000[dr + dg] + fb * c111;
+		}
+	}
+}
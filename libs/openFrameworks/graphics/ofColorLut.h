@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofConstants.h"
+
+class ofBuffer;
+
+/// \brief A color look up table used to apply a color grade to pixels.
+///
+/// A look up table maps every input color to an output color. 1D tables map
+/// every channel independently while 3D tables map full colors, which allows
+/// to store any color transformation. They are usually created in color
+/// grading software and exported as .cube files:
+///
+/// ~~~~{.cpp}
+/// ofColorLut lut;
+/// lut.load("grade.cube");
+/// pixels.applyLut(lut);
+/// ~~~~
+///
+/// Values between the entries of a 1D table are linearly interpolated, 3D
+/// tables use tetrahedral interpolation.
+class ofColorLut{
+public:
+	ofColorLut();
+
+	/// \brief Load a look up table from a .cube file.
+	/// \returns true if the file was loaded correctly.
+	bool load(const std::filesystem::path & path);
+
+	/// \brief Load a look up table from a buffer with the contents of a .cube file.
+	/// \returns true if the buffer was parsed correctly.
+	bool load(const ofBuffer & buffer);
+
+	/// \brief Allocate an identity 1D table.
+	/// \param size Number of entries per channel.
+	void allocate1D(std::size_t size);
+
+	/// \brief Allocate an identity 3D table.
+	/// \param size Number of entries per side of the cube.
+	void allocate3D(std::size_t size);
+
+	void clear();
+
+	bool isAllocated() const;
+	bool is3D() const;
+
+	/// \returns The number of entries per channel of a 1D table or per side
+	/// of the cube of a 3D table.
+	std::size_t getSize() const;
+
+	/// \brief Set the range of input values the table covers, [0, 1] by default.
+	void setDomain(const glm::vec3 & min, const glm::vec3 & max);
+	const glm::vec3 & getDomainMin() const;
+	const glm::vec3 & getDomainMax() const;
+
+	/// \brief Access the entries of the table.
+	///
+	/// A 1D table has getSize() entries. A 3D table has getSize()^3 entries
+	/// with red changing fastest, then green, then blue, which is the same
+	/// order used by .cube files.
+	std::vector<glm::vec3> & getData();
+	const std::vector<glm::vec3> & getData() const;
+
+	/// \returns The title stored in the .cube file, if any.
+	const std::string & getTitle() const;
+
+	/// \brief Map a color through the table.
+	/// \param color An rgb color with values normally in the [0, 1] range.
+	/// \returns The mapped color.
+	glm::vec3 apply(const glm::vec3 & color) const;
+
+private:
+	glm::vec3 apply1D(const glm::vec3 & color) const;
+	glm::vec3 apply3D(const glm::vec3 & color) const;
+
+	std::vector<glm::vec3> table;
+	std::size_t size;
+	bool b3D;
+	glm::vec3 domainMin, domainMax;
+	std::string title;
+};
@@ -8,6 +8,7 @@
 #include "ofCairoRenderer.h"
 #endif
 #include "ofGLRenderer.h"
+#include "ofGLUtils.h"
 
 
 #ifndef TARGET_WIN32
@@ -1307,6 +1308,70 @@ void ofDrawBitmapStringHighlight(string text, int x, int y, const ofColor& backg
 	ofPopStyle();
 }
 
+//--------------------------------------------------
+void ofEnableBitmapStringBatching(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->setBitmapStringBatching(true);
+	}else{
+		ofLogWarning("ofGraphics") << "ofEnableBitmapStringBatching(): bitmap string batching is only available with the OpenGL renderers";
+	}
+}
+
+//--------------------------------------------------
+void ofDisableBitmapStringBatching(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->setBitmapStringBatching(false);
+	}
+}
+
+//--------------------------------------------------
+bool ofIsBitmapStringBatching(){
+	auto renderer = ofGetGLRenderer();
+	return renderer && renderer->isBitmapStringBatching();
+}
+
+//--------------------------------------------------
+void ofFlushBitmapStrings(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->flushBitmapStrings();
+	}
+}
+
+//--------------------------------------------------
+void ofEnableShapeBatching(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->setShapeBatching(true);
+	}else{
+		ofLogWarning("ofGraphics") << "ofEnableShapeBatching(): shape batching is only available with the programmable renderer";
+	}
+}
+
+//--------------------------------------------------
+void ofDisableShapeBatching(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->setShapeBatching(false);
+	}
+}
+
+//--------------------------------------------------
+bool ofIsShapeBatching(){
+	auto renderer = ofGetGLRenderer();
+	return renderer && renderer->isShapeBatching();
+}
+
+//--------------------------------------------------
+void ofFlushShapes(){
+	auto renderer = ofGetGLRenderer();
+	if(renderer){
+		renderer->flushShapes();
+	}
+}
+
 
 // end text
 //--------------------------------------------------
@@ -669,6 +669,45 @@ void ofDrawBitmapStringHighlight(std::string text, const glm::vec3& position, co
 void ofDrawBitmapStringHighlight(std::string text, const glm::vec2& position, const ofColor& background = ofColor::black, const ofColor& foreground = ofColor::white);
 void ofDrawBitmapStringHighlight(std::string text, int x, int y, const ofColor& background = ofColor::black, const ofColor& foreground = ofColor::white);
 
+/// \brief Draw the bitmap strings together instead of one by one.
+///
+/// Overlays that print many lines of text every frame are much faster
+/// when batching, since all the strings are drawn with one draw call. The
+/// strings are collected until the end of the frame or until something
+/// that could change how they look happens: drawing to a different
+/// framebuffer or viewport, binding a shader, changing the blend mode or
+/// depth test and clearing or saving the screen. Until then they are drawn
+/// over anything else drawn after them. Strings drawn with a custom shader
+/// or material bound are drawn right away with the programmable renderer.
+/// Only available with the OpenGL renderers.
+void ofEnableBitmapStringBatching();
+void ofDisableBitmapStringBatching();
+bool ofIsBitmapStringBatching();
+
+/// \brief Draw the bitmap strings collected while batching now.
+void ofFlushBitmapStrings();
+
+/// \brief Draw the rectangles, circles, ellipses, triangles and lines
+/// together instead of one by one.
+///
+/// While batching, those shapes are collected in one mesh, already
+/// transformed by the current matrix and with the current color in their
+/// vertices, and drawn with one upload and one draw call when something
+/// that could change how they look happens: drawing anything else, binding
+/// a shader, texture or fbo, changing the blend mode or depth test,
+/// clearing or saving the screen and at the end of the frame. Sketches that
+/// draw thousands of small shapes every frame are much faster that way.
+/// Shapes drawn with a custom shader, material or texture bound are drawn
+/// right away. Only available with the programmable renderer.
+///
+/// \note Call ofFlushShapes() before calling OpenGL directly.
+void ofEnableShapeBatching();
+void ofDisableShapeBatching();
+bool ofIsShapeBatching();
+
+/// \brief Draw the shapes collected while batching now.
+void ofFlushShapes();
+
 
 /// \}
 /// \name Rendering Settings
@@ -0,0 +1,270 @@
+#include "ofParticleSystem.h"
+#include "ofLog.h"
+#include "ofMath.h"
+#include "ofTaskPool.h"
+#include <atomic>
+
+using namespace std;
+
+namespace{
+	// blocks smaller than this are not worth running in another thread
+	const size_t minBlockSize = 1 << 14;
+
+	template<typename Array>
+	void compact(Array & array, const vector<unsigned char> & alive, size_t numAlive){
+		size_t dst = 0;
+		for(size_t src = 0; src < array.size(); src++){
+			if(alive[src]){
+				array[dst++] = array[src];
+			}
+		}
+		array.resize(numAlive);
+	}
+}
+
+//----------------------------------------------------------
+ofParticleSystem::ofParticleSystem()
+:acceleration(0)
+,damping(0)
+,hasDead(false){
+
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::reserve(size_t capacity){
+	positions.reserve(capacity);
+	velocities.reserve(capacity);
+	colors.reserve(capacity);
+	ages.reserve(capacity);
+	lifetimes.reserve(capacity);
+}
+
+//----------------------------------------------------------
+size_t ofParticleSystem::add(const glm::vec3 & position, const glm::vec3 & velocity, const ofFloatColor & color, float lifetime){
+	positions.push_back(position);
+	velocities.push_back(velocity);
+	colors.push_back(color);
+	ages.push_back(0);
+	lifetimes.push_back(lifetime);
+	return positions.size() - 1;
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::resize(size_t size){
+	positions.resize(size, glm::vec3(0));
+	velocities.resize(size, glm::vec3(0));
+	colors.resize(size, ofFloatColor::white);
+	ages.resize(size, 0);
+	lifetimes.resize(size, numeric_limits<float>::max());
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::clear(){
+	positions.clear();
+	velocities.clear();
+	colors.clear();
+	ages.clear();
+	lifetimes.clear();
+	hasDead = false;
+}
+
+//----------------------------------------------------------
+size_t ofParticleSystem::size() const{
+	return positions.size();
+}
+
+//----------------------------------------------------------
+bool ofParticleSystem::empty() const{
+	return positions.empty();
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::kill(size_t index){
+	if(index >= size()){
+		ofLogError("ofParticleSystem") << "kill(): index " << index << " out of bounds";
+		return;
+	}
+	ages[index] = numeric_limits<float>::infinity();
+	hasDead = true;
+}
+
+//----------------------------------------------------------
+bool ofParticleSystem::isAlive(size_t index) const{
+	return index < size() && ages[index] < lifetimes[index];
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::removeDead(){
+	const size_t count = size();
+	vector<unsigned char> alive(count);
+	size_t numAlive = 0;
+	for(size_t i = 0; i < count; i++){
+		alive[i] = ages[i] < lifetimes[i];
+		numAlive += alive[i];
+	}
+	hasDead = false;
+	if(numAlive == count){
+		return;
+	}
+
+	// every array is independent so big systems compact them in parallel
+	if(count >= minBlockSize * 4 && ofGetTaskPool().getNumThreads() > 0){
+		ofTaskGroup group;
+		group.run([&]{ compact(positions, alive, numAlive); });
+		group.run([&]{ compact(velocities, alive, numAlive); });
+		group.run([&]{ compact(colors, alive, numAlive); });
+		compact(ages, alive, numAlive);
+		compact(lifetimes, alive, numAlive);
+		group.wait();
+	}else{
+		compact(positions, alive, numAlive);
+		compact(velocities, alive, numAlive);
+		compact(colors, alive, numAlive);
+		compact(ages, alive, numAlive);
+		compact(lifetimes, alive, numAlive);
+	}
+}
+
+//----------------------------------------------------------
+glm::vec3 * ofParticleSystem::getPositions(){
+	return positions.data();
+}
+
+//----------------------------------------------------------
+const glm::vec3 * ofParticleSystem::getPositions() const{
+	return positions.data();
+}
+
+//----------------------------------------------------------
+glm::vec3 * ofParticleSystem::getVelocities(){
+	return velocities.data();
+}
+
+//----------------------------------------------------------
+const glm::vec3 * ofParticleSystem::getVelocities() const{
+	return velocities.data();
+}
+
+//----------------------------------------------------------
+ofFloatColor * ofParticleSystem::getColors(){
+	return colors.data();
+}
+
+//----------------------------------------------------------
+const ofFloatColor * ofParticleSystem::getColors() const{
+	return colors.data();
+}
+
+//----------------------------------------------------------
+float * ofParticleSystem::getAges(){
+	return ages.data();
+}
+
+//----------------------------------------------------------
+const float * ofParticleSystem::getAges() const{
+	return ages.data();
+}
+
+//----------------------------------------------------------
+float * ofParticleSystem::getLifetimes(){
+	return lifetimes.data();
+}
+
+//----------------------------------------------------------
+const float * ofParticleSystem::getLifetimes() const{
+	return lifetimes.data();
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::setAcceleration(const glm::vec3 & _acceleration){
+	acceleration = _acceleration;
+}
+
+//----------------------------------------------------------
+const glm::vec3 & ofParticleSystem::getAcceleration() const{
+	return acceleration;
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::setDamping(float _damping){
+	damping = ofClamp(_damping, 0, 1);
+}
+
+//----------------------------------------------------------
+float ofParticleSystem::getDamping() const{
+	return damping;
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::parallelUpdate(const function<void(size_t begin, size_t end)> & job){
+	ofParallelForRange(0, size(), job, minBlockSize);
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::update(float dt){
+	const glm::vec3 deltaVelocity = acceleration * dt;
+	const float velocityScale = pow(1.f - damping, dt);
+	atomic<bool> anyDead(false);
+	parallelUpdate([&](size_t begin, size_t end){
+		// one loop per attribute keeps every loop simple enough to vectorize
+		glm::vec3 * v = velocities.data();
+		for(size_t i = begin; i < end; i++){
+			v[i] = (v[i] + deltaVelocity) * velocityScale;
+		}
+		glm::vec3 * p = positions.data();
+		for(size_t i = begin; i < end; i++){
+			p[i] += v[i] * dt;
+		}
+		float * age = ages.data();
+		const float * lifetime = lifetimes.data();
+		bool dead = false;
+		for(size_t i = begin; i < end; i++){
+			age[i] += dt;
+			dead |= age[i] >= lifetime[i];
+		}
+		if(dead){
+			anyDead = true;
+		}
+	});
+	if(anyDead || hasDead){
+		removeDead();
+	}
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::updateVbo(ofVbo & vbo, int ageAttributeLocation) const{
+	const int count = size();
+	if(count == 0){
+		return;
+	}
+	// an age attribute added after the first update gets every buffer
+	// allocated again, so all of them keep the same size
+	bool addAge = ageAttributeLocation >= 0 && !vbo.hasAttribute(ageAttributeLocation);
+	if(!vbo.getIsAllocated() || vbo.getNumVertices() < count || addAge){
+		vbo.setVertexData(positions.data(), count, GL_STREAM_DRAW);
+		vbo.setColorData(colors.data(), count, GL_STREAM_DRAW);
+		if(ageAttributeLocation >= 0){
+			vbo.setAttributeData(ageAttributeLocation, ages.data(), 1, count, GL_STREAM_DRAW);
+		}
+	}else{
+		vbo.updateVertexData(positions.data(), count);
+		vbo.updateColorData(colors.data(), count);
+		if(ageAttributeLocation >= 0){
+			vbo.updateAttributeData(ageAttributeLocation, ages.data(), count);
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofParticleSystem::draw() const{
+	if(empty()){
+		return;
+	}
+	getVbo().draw(GL_POINTS, 0, size());
+}
+
+//----------------------------------------------------------
+const ofVbo & ofParticleSystem::getVbo() const{
+	updateVbo(const_cast<ofParticleSystem*>(this)->vbo);
+	return vbo;
+}
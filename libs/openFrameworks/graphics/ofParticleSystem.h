@@ -0,0 +1,210 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofColor.h"
+#include "ofVbo.h"
+#include <functional>
+#include <limits>
+
+namespace of{
+namespace priv{
+	/// \brief Allocator for std::vector that aligns its memory to a number
+	/// of bytes, by default the size of a cache line.
+	template<typename T, std::size_t Alignment = 64>
+	class AlignedAllocator{
+	public:
+		typedef T value_type;
+
+		template<typename U>
+		struct rebind{
+			typedef AlignedAllocator<U, Alignment> other;
+		};
+
+		AlignedAllocator(){}
+
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment> &){}
+
+		T * allocate(std::size_t n){
+			// allocate enough to align the pointer and store the original
+			// one right before it to free it later
+			std::size_t bytes = n * sizeof(T) + Alignment + sizeof(void*);
+			void * memory = ::operator new(bytes);
+			std::uintptr_t start = reinterpret_cast<std::uintptr_t>(memory) + sizeof(void*);
+			std::uintptr_t aligned = (start + Alignment - 1) & ~std::uintptr_t(Alignment - 1);
+			reinterpret_cast<void**>(aligned)[-1] = memory;
+			return reinterpret_cast<T*>(aligned);
+		}
+
+		void deallocate(T * p, std::size_t){
+			::operator delete(reinterpret_cast<void**>(p)[-1]);
+		}
+
+		template<typename U>
+		bool operator==(const AlignedAllocator<U, Alignment> &) const{
+			return true;
+		}
+
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment> &) const{
+			return false;
+		}
+	};
+}
+}
+
+/// \brief A container for large numbers of particles.
+///
+/// Instead of a vector of particle objects, ofParticleSystem stores every
+/// attribute of the particles in its own array: positions, velocities,
+/// colors, ages and lifetimes. Updating one attribute of every particle
+/// reads contiguous memory which is much more cache friendly and easy for
+/// the compiler to vectorize, the work can be split in blocks that run in
+/// parallel and the positions and colors can be uploaded to the graphics
+/// card as they are, without building a mesh every frame:
+///
+/// ~~~~{.cpp}
+/// // update()
+/// for(int i = 0; i < 100; i++){
+/// 	particles.add(emitter, {ofRandom(-1, 1), ofRandom(-1, 1), 0}, ofColor::white, 5);
+/// }
+/// particles.parallelUpdate([&](std::size_t begin, std::size_t end){
+/// 	auto positions = particles.getPositions();
+/// 	auto velocities = particles.getVelocities();
+/// 	for(std::size_t i = begin; i < end; i++){
+/// 		velocities[i] += attraction(positions[i]);
+/// 	}
+/// });
+/// particles.update(ofGetLastFrameTime());
+///
+/// // draw()
+/// particles.draw();
+/// ~~~~
+///
+/// Particles die when their age reaches their lifetime. Dead particles are
+/// removed in update() keeping the order of the rest, so the index of a
+/// particle can change from one frame to the next.
+class ofParticleSystem{
+public:
+	ofParticleSystem();
+
+	/// \brief Reserve memory for a number of particles so adding them
+	/// doesn't need to allocate.
+	void reserve(std::size_t capacity);
+
+	/// \brief Add a particle.
+	/// \param lifetime Seconds until the particle dies, it lives forever by
+	/// default.
+	/// \returns The index of the new particle.
+	std::size_t add(const glm::vec3 & position, const glm::vec3 & velocity = glm::vec3(0), const ofFloatColor & color = ofFloatColor::white, float lifetime = std::numeric_limits<float>::max());
+
+	/// \brief Change the number of particles.
+	///
+	/// New particles are at the origin, still, white and live forever, their
+	/// attributes can then be set directly in the arrays, for example from
+	/// a parallelUpdate().
+	void resize(std::size_t size);
+
+	/// \brief Remove all the particles.
+	void clear();
+
+	std::size_t size() const;
+	bool empty() const;
+
+	/// \brief Make a particle die, it's removed in the next update().
+	void kill(std::size_t index);
+	bool isAlive(std::size_t index) const;
+
+	/// \brief Remove the dead particles, keeping the order of the rest.
+	///
+	/// update() already does this, it's only needed when killing
+	/// particles without updating.
+	void removeDead();
+
+	/// \name Particle attributes
+	/// \{
+
+	/// Every attribute is stored in its own array with an element per
+	/// particle, the pointers are valid until particles are added or
+	/// removed.
+
+	glm::vec3 * getPositions();
+	const glm::vec3 * getPositions() const;
+	glm::vec3 * getVelocities();
+	const glm::vec3 * getVelocities() const;
+	ofFloatColor * getColors();
+	const ofFloatColor * getColors() const;
+
+	/// \brief Seconds every particle has been alive.
+	float * getAges();
+	const float * getAges() const;
+
+	/// \brief Seconds every particle will live.
+	float * getLifetimes();
+	const float * getLifetimes() const;
+
+	/// \}
+
+	/// \name Simulation
+	/// \{
+
+	/// \brief Acceleration applied to every particle, for example gravity.
+	void setAcceleration(const glm::vec3 & acceleration);
+	const glm::vec3 & getAcceleration() const;
+
+	/// \brief Fraction of the velocity lost every second, 0 by default.
+	void setDamping(float damping);
+	float getDamping() const;
+
+	/// \brief Run a job over all the particles, split in blocks that run in
+	/// parallel in ofGetTaskPool().
+	///
+	/// job is called with ranges of particle indices, possibly from
+	/// several threads at the same time, so it should only modify the
+	/// particles in its range. Adding or removing particles from it is not
+	/// allowed.
+	void parallelUpdate(const std::function<void(std::size_t begin, std::size_t end)> & job);
+
+	/// \brief Advance the simulation.
+	///
+	/// Applies the acceleration and damping to the velocities, moves every
+	/// particle by its velocity, ages them and removes the ones that die.
+	/// \param dt Seconds since the last update, usually ofGetLastFrameTime().
+	void update(float dt);
+
+	/// \}
+
+	/// \name Drawing
+	/// \{
+
+	/// \brief Upload the positions and colors to a vbo.
+	///
+	/// The arrays are uploaded directly from the particle storage, the vbo
+	/// is only reallocated when the number of particles grows.
+	/// \param ageAttributeLocation If not negative, the ages are also
+	/// uploaded as a float attribute at this location to use them from a
+	/// shader.
+	void updateVbo(ofVbo & vbo, int ageAttributeLocation = -1) const;
+
+	/// \brief Draw every particle as a point.
+	void draw() const;
+
+	/// \returns The vbo used by draw(), updated with the current particles.
+	const ofVbo & getVbo() const;
+
+	/// \}
+
+private:
+	template<typename T>
+	using Array = std::vector<T, of::priv::AlignedAllocator<T>>;
+
+	Array<glm::vec3> positions;
+	Array<glm::vec3> velocities;
+	Array<ofFloatColor> colors;
+	Array<float> ages;
+	Array<float> lifetimes;
+	glm::vec3 acceleration;
+	float damping;
+	bool hasDead;
+	ofVbo vbo;
+};
@@ -0,0 +1,559 @@
+#pragma once
+
+#include "ofPixels.h"
+#include "ofTaskPool.h"
+#include <type_traits>
+
+/// \file
+/// Typed views of ofPixels and parallel kernels to write per pixel filters.
+///
+/// The iterators of ofPixels_ find out the number of channels and the pixel
+/// format while running, so every access branches and loops over them can't
+/// be vectorized. The views and kernels in this file take the number of
+/// channels as a template parameter instead, so the loops over the channels
+/// unroll and the compiler can vectorize the loops over the pixels once the
+/// function passed to a kernel is inlined.
+///
+/// The kernels split the image in blocks of rows that run in parallel in
+/// ofGetTaskPool(), small images run in the calling thread:
+///
+/// ~~~~{.cpp}
+/// ofPixels rgb, gray;
+/// ofLoadImage(rgb, "image.png");
+/// // invert in place
+/// ofPixelsMap<3>(rgb, [](ofPixelValue<unsigned char, 3> p){
+/// 	for(size_t c = 0; c < 3; c++){
+/// 		p[c] = 255 - p[c];
+/// 	}
+/// 	return p;
+/// });
+/// // the number of channels of the result comes from the function
+/// ofPixelsMap<3>(rgb, gray, [](ofPixelValue<unsigned char, 3> p){
+/// 	return ofPixelValue<unsigned char, 1>{{p[1]}};
+/// });
+/// // 3x3 blur
+/// float blur[3][3] = {{1/16.f, 2/16.f, 1/16.f}, {2/16.f, 4/16.f, 2/16.f}, {1/16.f, 2/16.f, 1/16.f}};
+/// ofPixels blurred;
+/// ofPixelsConvolve<3>(rgb, blurred, blur);
+/// ~~~~
+///
+/// Only formats with one plane can be viewed, passing pixels with a
+/// different number of channels than the kernel expects logs an error and
+/// does nothing.
+
+/// \brief The channels of a pixel with the number of channels known at
+/// compile time.
+///
+/// The channel-wise operators loop over a constant number of channels, so
+/// they unroll. They don't saturate, use ofPixelValueCast() to convert to a
+/// wider type before operations that can overflow.
+template<typename T, std::size_t Channels>
+struct ofPixelValue{
+	using value_type = T;
+	static constexpr std::size_t channels = Channels;
+
+	T v[Channels];
+
+	T & operator[](std::size_t channel){
+		return v[channel];
+	}
+
+	const T & operator[](std::size_t channel) const{
+		return v[channel];
+	}
+
+	ofPixelValue & operator+=(const ofPixelValue & other){
+		for(std::size_t c = 0; c < Channels; c++){
+			v[c] += other.v[c];
+		}
+		return *this;
+	}
+
+	ofPixelValue & operator-=(const ofPixelValue & other){
+		for(std::size_t c = 0; c < Channels; c++){
+			v[c] -= other.v[c];
+		}
+		return *this;
+	}
+
+	ofPixelValue & operator*=(const ofPixelValue & other){
+		for(std::size_t c = 0; c < Channels; c++){
+			v[c] *= other.v[c];
+		}
+		return *this;
+	}
+
+	ofPixelValue & operator*=(T scalar){
+		for(std::size_t c = 0; c < Channels; c++){
+			v[c] *= scalar;
+		}
+		return *this;
+	}
+
+	ofPixelValue & operator/=(T scalar){
+		for(std::size_t c = 0; c < Channels; c++){
+			v[c] /= scalar;
+		}
+		return *this;
+	}
+
+	ofPixelValue operator+(const ofPixelValue & other) const{
+		return ofPixelValue(*this) += other;
+	}
+
+	ofPixelValue operator-(const ofPixelValue & other) const{
+		return ofPixelValue(*this) -= other;
+	}
+
+	ofPixelValue operator*(const ofPixelValue & other) const{
+		return ofPixelValue(*this) *= other;
+	}
+
+	ofPixelValue operator*(T scalar) const{
+		return ofPixelValue(*this) *= scalar;
+	}
+
+	ofPixelValue operator/(T scalar) const{
+		return ofPixelValue(*this) /= scalar;
+	}
+
+	/// \returns a value with every channel set to value.
+	static ofPixelValue filled(T value){
+		ofPixelValue result;
+		for(std::size_t c = 0; c < Channels; c++){
+			result.v[c] = value;
+		}
+		return result;
+	}
+};
+
+namespace of{
+namespace priv{
+	// converts a channel, rounding and clamping to the range of To when it's
+	// an integer type
+	template<typename To, typename From>
+	inline To convertChannel(From value, std::true_type /*toInteger*/){
+		using limits = std::numeric_limits<To>;
+		From clamped = std::min(std::max(value, From(limits::lowest())), From(limits::max()));
+		if(std::is_floating_point<From>::value){
+			return To(std::is_signed<To>::value ? std::floor(clamped + From(0.5)) : clamped + From(0.5));
+		}else{
+			return To(clamped);
+		}
+	}
+
+	template<typename To, typename From>
+	inline To convertChannel(From value, std::false_type /*toInteger*/){
+		return To(value);
+	}
+
+	// whether two pixels use the same memory, allocating one of them could
+	// free the memory read through the other
+	template<typename A, typename B>
+	inline bool pixelsAlias(const ofPixels_<A> & a, const ofPixels_<B> & b){
+		return static_cast<const void*>(&a) == static_cast<const void*>(&b)
+			|| (a.getData() != nullptr && static_cast<const void*>(a.getData()) == static_cast<const void*>(b.getData()));
+	}
+
+	// rows per block so every block has enough values to be worth running in
+	// another thread
+	inline std::size_t pixelRowsGrain(std::size_t width, std::size_t channels){
+		const std::size_t minValuesPerBlock = 1 << 16;
+		return std::max<std::size_t>(minValuesPerBlock / std::max<std::size_t>(width * channels, 1), 1);
+	}
+}
+}
+
+/// \brief Convert the channels of a pixel value to another type.
+///
+/// Converting to an integer type rounds and clamps to its range, so a float
+/// value can be converted back to unsigned char without wrapping around.
+template<typename To, typename From, std::size_t Channels>
+inline ofPixelValue<To, Channels> ofPixelValueCast(const ofPixelValue<From, Channels> & value){
+	ofPixelValue<To, Channels> result;
+	for(std::size_t c = 0; c < Channels; c++){
+		result.v[c] = of::priv::convertChannel<To>(value.v[c], std::is_integral<To>());
+	}
+	return result;
+}
+
+/// \brief A view of pixels with the number of channels known at compile time.
+///
+/// Doesn't own the pixels, they have to outlive the view. T can be const to
+/// view pixels that can't be modified. Pixels are loaded and stored as a
+/// ofPixelValue.
+template<typename T, std::size_t Channels>
+class ofPixelView{
+public:
+	using PixelType = typename std::remove_const<T>::type;
+	using value_type = ofPixelValue<PixelType, Channels>;
+	static constexpr std::size_t channels = Channels;
+
+	/// \brief Create an invalid view.
+	ofPixelView(){}
+
+	/// \brief View a block of interleaved pixels, rows are width * Channels
+	/// values apart.
+	ofPixelView(T * data, std::size_t width, std::size_t height)
+	:data(data)
+	,width(width)
+	,height(height){}
+
+	/// \brief View some pixels, logs an error and creates an invalid view if
+	/// they don't have Channels channels in one plane.
+	ofPixelView(ofPixels_<PixelType> & pixels){
+		set(pixels.getData(), pixels);
+	}
+
+	/// \brief View some const pixels, T has to be const too.
+	ofPixelView(const ofPixels_<PixelType> & pixels){
+		set(pixels.getData(), pixels);
+	}
+
+	/// \returns false if the view has no pixels.
+	bool isValid() const{
+		return data != nullptr && width > 0 && height > 0;
+	}
+
+	std::size_t getWidth() const{
+		return width;
+	}
+
+	std::size_t getHeight() const{
+		return height;
+	}
+
+	T * getData() const{
+		return data;
+	}
+
+	/// \returns a pointer to the first channel of the first pixel of a row.
+	T * getLine(std::size_t y) const{
+		return data + y * width * Channels;
+	}
+
+	value_type get(std::size_t x, std::size_t y) const{
+		return load(getLine(y) + x * Channels);
+	}
+
+	void set(std::size_t x, std::size_t y, const value_type & value) const{
+		store(getLine(y) + x * Channels, value);
+	}
+
+	/// \brief Read a pixel from its first channel.
+	static value_type load(const PixelType * pixel){
+		value_type value;
+		for(std::size_t c = 0; c < Channels; c++){
+			value.v[c] = pixel[c];
+		}
+		return value;
+	}
+
+	/// \brief Write a pixel from its first channel.
+	static void store(PixelType * pixel, const value_type & value){
+		for(std::size_t c = 0; c < Channels; c++){
+			pixel[c] = value.v[c];
+		}
+	}
+
+private:
+	template<typename Data>
+	void set(Data * pixelsData, const ofPixels_<PixelType> & pixels){
+		if(!pixels.isAllocated()){
+			return;
+		}
+		if(pixels.getNumPlanes() != 1 || pixels.getNumChannels() != Channels){
+			ofLogError("ofPixelView") << "pixels with " << pixels.getNumChannels() << " channels and "
+				<< pixels.getNumPlanes() << " planes can't be viewed as " << Channels << " channels";
+			return;
+		}
+		data = pixelsData;
+		width = pixels.getWidth();
+		height = pixels.getHeight();
+	}
+
+	T * data = nullptr;
+	std::size_t width = 0;
+	std::size_t height = 0;
+};
+
+/// \brief The pixels around a pixel, passed to the function of
+/// ofPixelsFilter().
+///
+/// Pixels outside of the image repeat the ones in the border.
+template<typename PixelType, std::size_t Channels, std::size_t Radius>
+class ofPixelNeighborhood{
+public:
+	using value_type = ofPixelValue<PixelType, Channels>;
+	static constexpr std::size_t channels = Channels;
+	static constexpr int radius = Radius;
+	static constexpr std::size_t size = 2 * Radius + 1;
+
+	/// \returns the pixel at dx, dy from the center, both in [-Radius, Radius].
+	value_type operator()(int dx, int dy) const{
+		return ofPixelView<const PixelType, Channels>::load(lines[dy + radius] + offsets[dx + radius]);
+	}
+
+	/// \returns a channel of the pixel at dx, dy from the center.
+	PixelType get(int dx, int dy, std::size_t channel) const{
+		return lines[dy + radius][offsets[dx + radius] + channel];
+	}
+
+	value_type center() const{
+		return (*this)(0, 0);
+	}
+
+private:
+	template<std::size_t C, std::size_t R, typename T, typename Function>
+	friend void ofPixelsFilter(const ofPixels_<T> & src, ofPixels_<T> & dst, Function function);
+
+	const PixelType * lines[size];
+	std::size_t offsets[size];
+};
+
+/// \brief Replace every pixel with the result of a function of its value.
+///
+/// \param function Called with an ofPixelValue<PixelType, Channels> and
+/// returns the new one, possibly from several threads at the same time.
+template<std::size_t Channels, typename PixelType, typename Function>
+void ofPixelsMap(ofPixels_<PixelType> & pixels, Function function){
+	ofPixelView<PixelType, Channels> view(pixels);
+	if(!view.isValid()){
+		return;
+	}
+	using View = ofPixelView<PixelType, Channels>;
+	ofParallelForRange(0, view.getHeight(), [&](std::size_t firstLine, std::size_t lastLine){
+		PixelType * pixels = view.getLine(firstLine);
+		std::size_t numPixels = (lastLine - firstLine) * view.getWidth();
+		for(std::size_t i = 0; i < numPixels; i++){
+			View::store(pixels + i * Channels, function(View::load(pixels + i * Channels)));
+		}
+	}, of::priv::pixelRowsGrain(view.getWidth(), Channels));
+}
+
+/// \brief Write the result of a function of every pixel of src to dst.
+///
+/// dst is allocated with the size of src and the number of channels of the
+/// values returned by the function if it doesn't have them already. dst can
+/// be src, if it has to be allocated again the result is written to a
+/// temporary first.
+///
+/// \param function Called with an ofPixelValue<SrcType, Channels> and
+/// returns an ofPixelValue<DstType, N>, possibly from several threads at the
+/// same time.
+template<std::size_t Channels, typename SrcType, typename DstType, typename Function>
+void ofPixelsMap(const ofPixels_<SrcType> & src, ofPixels_<DstType> & dst, Function function){
+	using Result = decltype(function(std::declval<ofPixelValue<SrcType, Channels>>()));
+	static_assert(std::is_same<typename Result::value_type, DstType>::value, "the function has to return values of the type of dst");
+	constexpr std::size_t DstChannels = Result::channels;
+	using SrcView = ofPixelView<const SrcType, Channels>;
+	using DstView = ofPixelView<DstType, DstChannels>;
+	SrcView srcView(src);
+	if(!srcView.isValid()){
+		return;
+	}
+	if(dst.getWidth() != srcView.getWidth() || dst.getHeight() != srcView.getHeight() || dst.getNumChannels() != DstChannels || dst.getNumPlanes() != 1){
+		if(of::priv::pixelsAlias(src, dst)){
+			// allocating would free the pixels being read
+			ofPixels_<DstType> result;
+			ofPixelsMap<Channels>(src, result, function);
+			dst = std::move(result);
+			return;
+		}
+		dst.allocate(srcView.getWidth(), srcView.getHeight(), DstChannels);
+	}
+	DstView dstView(dst);
+	if(!dstView.isValid()){
+		return;
+	}
+	ofParallelForRange(0, srcView.getHeight(), [&](std::size_t firstLine, std::size_t lastLine){
+		const SrcType * srcPixels = srcView.getLine(firstLine);
+		DstType * dstPixels = dstView.getLine(firstLine);
+		std::size_t numPixels = (lastLine - firstLine) * srcView.getWidth();
+		for(std::size_t i = 0; i < numPixels; i++){
+			DstView::store(dstPixels + i * DstChannels, function(SrcView::load(srcPixels + i * Channels)));
+		}
+	}, of::priv::pixelRowsGrain(srcView.getWidth(), Channels));
+}
+
+/// \brief Write the result of a function of the pixels at the same position
+/// in a and b to dst.
+///
+/// a and b need the same size and Channels channels, dst is allocated like
+/// in ofPixelsMap() and can be a or b, if it has to be allocated again the
+/// result is written to a temporary first.
+///
+/// \param function Called with an ofPixelValue<AType, Channels> and an
+/// ofPixelValue<BType, Channels> and returns an ofPixelValue<DstType, N>,
+/// possibly from several threads at the same time.
+template<std::size_t Channels, typename AType, typename BType, typename DstType, typename Function>
+void ofPixelsZip(const ofPixels_<AType> & a, const ofPixels_<BType> & b, ofPixels_<DstType> & dst, Function function){
+	using Result = decltype(function(std::declval<ofPixelValue<AType, Channels>>(), std::declval<ofPixelValue<BType, Channels>>()));
+	static_assert(std::is_same<typename Result::value_type, DstType>::value, "the function has to return values of the type of dst");
+	constexpr std::size_t DstChannels = Result::channels;
+	using AView = ofPixelView<const AType, Channels>;
+	using BView = ofPixelView<const BType, Channels>;
+	using DstView = ofPixelView<DstType, DstChannels>;
+	AView aView(a);
+	BView bView(b);
+	if(!aView.isValid() || !bView.isValid()){
+		return;
+	}
+	if(aView.getWidth() != bView.getWidth() || aView.getHeight() != bView.getHeight()){
+		ofLogError("ofPixelsZip") << "pixels of different sizes " << aView.getWidth() << "x" << aView.getHeight()
+			<< " and " << bView.getWidth() << "x" << bView.getHeight();
+		return;
+	}
+	if(dst.getWidth() != aView.getWidth() || dst.getHeight() != aView.getHeight() || dst.getNumChannels() != DstChannels || dst.getNumPlanes() != 1){
+		if(of::priv::pixelsAlias(a, dst) || of::priv::pixelsAlias(b, dst)){
+			// allocating would free the pixels being read
+			ofPixels_<DstType> result;
+			ofPixelsZip<Channels>(a, b, result, function);
+			dst = std::move(result);
+			return;
+		}
+		dst.allocate(aView.getWidth(), aView.getHeight(), DstChannels);
+	}
+	DstView dstView(dst);
+	if(!dstView.isValid()){
+		return;
+	}
+	ofParallelForRange(0, aView.getHeight(), [&](std::size_t firstLine, std::size_t lastLine){
+		const AType * aPixels = aView.getLine(firstLine);
+		const BType * bPixels = bView.getLine(firstLine);
+		DstType * dstPixels = dstView.getLine(firstLine);
+		std::size_t numPixels = (lastLine - firstLine) * aView.getWidth();
+		for(std::size_t i = 0; i < numPixels; i++){
+			DstView::store(dstPixels + i * DstChannels, function(AView::load(aPixels + i * Channels), BView::load(bPixels + i * Channels)));
+		}
+	}, of::priv::pixelRowsGrain(aView.getWidth(), Channels));
+}
+
+/// \brief Combine a value computed from every pixel.
+///
+/// ~~~~{.cpp}
+/// float brightness = ofPixelsReduce<3>(pixels, 0.f,
+/// 	[](ofPixelValue<unsigned char, 3> p){ return (p[0] + p[1] + p[2]) / 3.f; },
+/// 	[](float a, float b){ return a + b; }) / (pixels.getWidth() * pixels.getHeight());
+/// ~~~~
+///
+/// The pixels are reduced in the same order for the same image, so the
+/// result is always the same, see ofParallelReduce().
+///
+/// \param map Called with an ofPixelValue<PixelType, Channels> to get its value.
+/// \param reduce Combines two values, it has to be associative.
+/// \returns identity if the pixels can't be viewed with Channels channels.
+template<std::size_t Channels, typename PixelType, typename T, typename Map, typename Reduce>
+T ofPixelsReduce(const ofPixels_<PixelType> & pixels, T identity, Map map, Reduce reduce){
+	using View = ofPixelView<const PixelType, Channels>;
+	View view(pixels);
+	if(!view.isValid()){
+		return identity;
+	}
+	return ofParallelReduce(0, view.getHeight(), identity, [&](std::size_t y){
+		T value = identity;
+		const PixelType * end = view.getLine(y + 1);
+		for(const PixelType * pixel = view.getLine(y); pixel < end; pixel += Channels){
+			value = reduce(value, map(View::load(pixel)));
+		}
+		return value;
+	}, reduce, of::priv::pixelRowsGrain(view.getWidth(), Channels));
+}
+
+/// \brief Replace every pixel with a function of the pixels around it.
+///
+/// dst is allocated like src and can't be src or pixels that share its
+/// memory, like ones set with setFromExternalPixels().
+///
+/// \param function Called with an ofPixelNeighborhood<PixelType, Channels,
+/// Radius> and returns the new ofPixelValue<PixelType, Channels>, possibly
+/// from several threads at the same time.
+template<std::size_t Channels, std::size_t Radius, typename PixelType, typename Function>
+void ofPixelsFilter(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, Function function){
+	using SrcView = ofPixelView<const PixelType, Channels>;
+	using DstView = ofPixelView<PixelType, Channels>;
+	using Neighborhood = ofPixelNeighborhood<PixelType, Channels, Radius>;
+	// every pixel reads its neighbors, so it can't write over src
+	if(of::priv::pixelsAlias(src, dst)){
+		ofLogError("ofPixelsFilter") << "src and dst can't be the same pixels or share their memory";
+		return;
+	}
+	SrcView srcView(src);
+	if(!srcView.isValid()){
+		return;
+	}
+	std::size_t width = srcView.getWidth();
+	std::size_t height = srcView.getHeight();
+	if(dst.getWidth() != width || dst.getHeight() != height || dst.getNumChannels() != Channels || dst.getNumPlanes() != 1){
+		dst.allocate(width, height, Channels);
+	}
+	DstView dstView(dst);
+	if(!dstView.isValid()){
+		return;
+	}
+	const int radius = Radius;
+	const int lastX = int(width) - 1;
+	const int lastY = int(height) - 1;
+	ofParallelForRange(0, height, [&](std::size_t firstLine, std::size_t lastLine){
+		Neighborhood neighborhood;
+		for(std::size_t y = firstLine; y < lastLine; y++){
+			for(int dy = -radius; dy <= radius; dy++){
+				neighborhood.lines[dy + radius] = srcView.getLine(std::min(std::max(int(y) + dy, 0), lastY));
+			}
+			PixelType * dstLine = dstView.getLine(y);
+			// the borders clamp the positions of the neighbors, the pixels
+			// in between only move them
+			std::size_t interiorBegin = std::min<std::size_t>(Radius, width);
+			std::size_t interiorEnd = std::max<std::size_t>(width > Radius ? width - Radius : 0, interiorBegin);
+			auto clamped = [&](std::size_t x){
+				for(int dx = -radius; dx <= radius; dx++){
+					neighborhood.offsets[dx + radius] = std::min(std::max(int(x) + dx, 0), lastX) * Channels;
+				}
+				DstView::store(dstLine + x * Channels, function(static_cast<const Neighborhood&>(neighborhood)));
+			};
+			for(std::size_t x = 0; x < interiorBegin; x++){
+				clamped(x);
+			}
+			for(int dx = -radius; dx <= radius; dx++){
+				neighborhood.offsets[dx + radius] = (int(interiorBegin) + dx) * Channels;
+			}
+			for(std::size_t x = interiorBegin; x < interiorEnd; x++){
+				DstView::store(dstLine + x * Channels, function(static_cast<const Neighborhood&>(neighborhood)));
+				for(std::size_t i = 0; i < Neighborhood::size; i++){
+					neighborhood.offsets[i] += Channels;
+				}
+			}
+			for(std::size_t x = interiorEnd; x < width; x++){
+				clamped(x);
+			}
+		}
+	}, of::priv::pixelRowsGrain(width, Channels * (2 * Radius + 1) * (2 * Radius + 1)));
+}
+
+/// \brief Convolve the pixels with a square kernel of odd size, like 3x3 or
+/// 5x5.
+///
+/// The sums are calculated in float and rounded and clamped to the range of
+/// integer pixel types. dst is allocated like src and can't be src or share
+/// its memory.
+///
+/// \param kernel Weights of the pixels around each pixel, kernel[0][0] is
+/// the weight of the top left one.
+template<std::size_t Channels, typename PixelType, std::size_t Size>
+void ofPixelsConvolve(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, const float (&kernel)[Size][Size]){
+	static_assert(Size % 2 == 1, "the kernel needs an odd size");
+	constexpr std::size_t Radius = Size / 2;
+	using Neighborhood = ofPixelNeighborhood<PixelType, Channels, Radius>;
+	ofPixelsFilter<Channels, Radius>(src, dst, [&kernel](const Neighborhood & neighborhood){
+		ofPixelValue<float, Channels> sum = ofPixelValue<float, Channels>::filled(0);
+		for(std::size_t ky = 0; ky < Size; ky++){
+			for(std::size_t kx = 0; kx < Size; kx++){
+				float weight = kernel[ky][kx];
+				for(std::size_t c = 0; c < Channels; c++){
+					sum[c] += weight * neighborhood.get(int(kx) - int(Radius), int(ky) - int(Radius), c);
+				}
+			}
+		}
+		return ofPixelValueCast<PixelType>(sum);
+	});
+}
@@ -1,6 +1,10 @@
 #include "ofPixels.h"
 #include "ofMath.h"
+#include "ofColorLut.h"
+#include "ofTaskPool.h"
 #include <algorithm>
+#include <limits>
+#include <type_traits>
 
 using namespace std;
 
@@ -508,6 +512,287 @@ void ofPixels_<PixelType>::swapRgb(){
 	}
 }
 
+// blocks with less values than this are transformed in the calling thread,
+// for smaller ones running them in other threads costs more than it saves
+static const size_t minValuesPerBlock = 1 << 18;
+
+// calls f(begin, end) over blocks of the pixel range from several threads
+template<typename F>
+static void forEachPixelBlock(size_t numPixels, size_t channels, const F & f){
+	size_t minPixelsPerBlock = std::max<size_t>(minValuesPerBlock / std::max<size_t>(channels, 1), 1);
+	ofParallelForRange(0, numPixels, [&f](size_t begin, size_t end){
+		f(begin, end);
+	}, minPixelsPerBlock);
+}
+
+// number of channels that hold color, the rest are left as is
+static size_t colorChannelsFromPixelFormat(ofPixelFormat format){
+	switch(format){
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_BGR:
+	case OF_PIXELS_RGBA:
+	case OF_PIXELS_BGRA:
+		return 3;
+	case OF_PIXELS_GRAY:
+	case OF_PIXELS_GRAY_ALPHA:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+static bool isBgr(ofPixelFormat format){
+	return format == OF_PIXELS_BGR || format == OF_PIXELS_BGRA;
+}
+
+// converts a value in the units of the pixel type back to it, integer
+// types are rounded and clamped, floating point ones are stored as is
+template<typename PixelType>
+static PixelType toPixelValue(float value, std::true_type /*floating point*/){
+	return PixelType(value);
+}
+
+template<typename PixelType>
+static PixelType toPixelValue(float value, std::false_type /*floating point*/){
+	return PixelType(ofClamp(value, 0, ofColor_<PixelType>::limit()) + 0.5f);
+}
+
+template<typename PixelType>
+static PixelType toPixelValue(float value){
+	return toPixelValue<PixelType>(value, std::is_floating_point<PixelType>());
+}
+
+// applies curve(value, channel) with normalized values to every color
+// channel, channel is 0, 1, 2 for red, green, blue in any pixel format
+template<typename PixelType, typename Curve>
+static void applyCurve(ofPixels_<PixelType> & pixels, const Curve & curve, std::false_type /*use table*/){
+	const size_t channels = pixels.getNumChannels();
+	const size_t colorChannels = colorChannelsFromPixelFormat(pixels.getPixelFormat());
+	const bool bgr = isBgr(pixels.getPixelFormat());
+	const float limit = ofColor_<PixelType>::limit();
+	PixelType * data = pixels.getData();
+	forEachPixelBlock(pixels.getWidth() * pixels.getHeight(), channels, [&](size_t begin, size_t end){
+		for(size_t c = 0; c < colorChannels; c++){
+			const size_t channel = bgr ? 2 - c : c;
+			for(size_t i = begin; i < end; i++){
+				PixelType & value = data[i * channels + c];
+				value = toPixelValue<PixelType>(curve(value / limit, channel) * limit);
+			}
+		}
+	});
+}
+
+// integer types up to 16 bits have few enough values to evaluate the curve
+// once per value and then just look up every pixel in a table
+template<typename PixelType, typename Curve>
+static void applyCurve(ofPixels_<PixelType> & pixels, const Curve & curve, std::true_type /*use table*/){
+	typedef typename std::make_unsigned<PixelType>::type Index;
+	const size_t tableSize = size_t(std::numeric_limits<Index>::max()) + 1;
+	const size_t channels = pixels.getNumChannels();
+	const size_t colorChannels = colorChannelsFromPixelFormat(pixels.getPixelFormat());
+	const size_t numPixels = pixels.getWidth() * pixels.getHeight();
+	if(numPixels * colorChannels < tableSize){
+		applyCurve(pixels, curve, std::false_type());
+		return;
+	}
+	const bool bgr = isBgr(pixels.getPixelFormat());
+	const float limit = ofColor_<PixelType>::limit();
+	vector<vector<PixelType>> tables(colorChannels, vector<PixelType>(tableSize));
+	for(size_t c = 0; c < colorChannels; c++){
+		const size_t channel = bgr ? 2 - c : c;
+		for(size_t i = 0; i < tableSize; i++){
+			tables[c][i] = toPixelValue<PixelType>(curve(PixelType(Index(i)) / limit, channel) * limit);
+		}
+	}
+	PixelType * data = pixels.getData();
+	forEachPixelBlock(numPixels, channels, [&](size_t begin, size_t end){
+		for(size_t c = 0; c < colorChannels; c++){
+			const PixelType * table = tables[c].data();
+			for(size_t i = begin; i < end; i++){
+				PixelType & value = data[i * channels + c];
+				value = table[Index(value)];
+			}
+		}
+	});
+}
+
+template<typename PixelType, typename Curve>
+static void applyCurve(ofPixels_<PixelType> & pixels, const Curve & curve, const string & name){
+	if(colorChannelsFromPixelFormat(pixels.getPixelFormat()) == 0){
+		ofLogWarning("ofPixels") << name << " not supported for this pixel format";
+		return;
+	}
+	applyCurve(pixels, curve, std::integral_constant<bool, std::is_integral<PixelType>::value && sizeof(PixelType) <= 2>());
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::convertRgbToHsb(){
+	if(colorChannelsFromPixelFormat(pixelFormat) != 3){
+		ofLogWarning("ofPixels") << "rgb to hsb conversion not supported for this pixel format";
+		return;
+	}
+	const size_t channels = getNumChannels();
+	const size_t r = isBgr(pixelFormat) ? 2 : 0;
+	const size_t b = 2 - r;
+	const float limit = ofColor_<PixelType>::limit();
+	PixelType * data = pixels;
+	// same as ofColor::getHsb
+	forEachPixelBlock(width * height, channels, [&](size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			PixelType * pixel = data + i * channels;
+			float red = pixel[r];
+			float green = pixel[1];
+			float blue = pixel[b];
+			float max = std::max(red, std::max(green, blue));
+			float min = std::min(red, std::min(green, blue));
+			float hue = 0;
+			float saturation = 0;
+			if(max != min){
+				float hueSixth;
+				if(red == max){
+					hueSixth = (green - blue) / (max - min);
+					if(hueSixth < 0){
+						hueSixth += 6;
+					}
+				}else if(green == max){
+					hueSixth = 2 + (blue - red) / (max - min);
+				}else{
+					hueSixth = 4 + (red - green) / (max - min);
+				}
+				hue = limit * hueSixth / 6;
+				saturation = limit * (max - min) / max;
+			}
+			pixel[r] = toPixelValue<PixelType>(hue);
+			pixel[1] = toPixelValue<PixelType>(saturation);
+			pixel[b] = toPixelValue<PixelType>(max);
+		}
+	});
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::convertHsbToRgb(){
+	if(colorChannelsFromPixelFormat(pixelFormat) != 3){
+		ofLogWarning("ofPixels") << "hsb to rgb conversion not supported for this pixel format";
+		return;
+	}
+	const size_t channels = getNumChannels();
+	const size_t r = isBgr(pixelFormat) ? 2 : 0;
+	const size_t b = 2 - r;
+	const float limit = ofColor_<PixelType>::limit();
+	PixelType * data = pixels;
+	// same as ofColor::setHsb
+	forEachPixelBlock(width * height, channels, [&](size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			PixelType * pixel = data + i * channels;
+			float hue = pixel[r];
+			float saturation = ofClamp(pixel[1], 0, limit);
+			float brightness = ofClamp(pixel[b], 0, limit);
+			float red = brightness, green = brightness, blue = brightness;
+			if(brightness == 0){
+				red = green = blue = 0;
+			}else if(saturation > 0){
+				float hueSix = hue * 6 / limit;
+				float saturationNorm = saturation / limit;
+				int hueSixCategory = int(floor(hueSix));
+				float hueSixRemainder = hueSix - hueSixCategory;
+				float pv = (1 - saturationNorm) * brightness;
+				float qv = (1 - saturationNorm * hueSixRemainder) * brightness;
+				float tv = (1 - saturationNorm * (1 - hueSixRemainder)) * brightness;
+				switch(((hueSixCategory % 6) + 6) % 6){
+				case 0: red = brightness; green = tv; blue = pv; break;
+				case 1: red = qv; green = brightness; blue = pv; break;
+				case 2: red = pv; green = brightness; blue = tv; break;
+				case 3: red = pv; green = qv; blue = brightness; break;
+				case 4: red = tv; green = pv; blue = brightness; break;
+				case 5: red = brightness; green = pv; blue = qv; break;
+				}
+			}
+			pixel[r] = toPixelValue<PixelType>(red);
+			pixel[1] = toPixelValue<PixelType>(green);
+			pixel[b] = toPixelValue<PixelType>(blue);
+		}
+	});
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::convertSrgbToLinear(){
+	applyCurve(*this, [](float value, size_t){
+		return value <= 0.04045f ? value / 12.92f : pow((value + 0.055f) / 1.055f, 2.4f);
+	}, "srgb to linear conversion");
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::convertLinearToSrgb(){
+	applyCurve(*this, [](float value, size_t){
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * pow(value, 1.f / 2.4f) - 0.055f;
+	}, "linear to srgb conversion");
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::applyGamma(float gamma){
+	if(gamma <= 0){
+		ofLogWarning("ofPixels") << "applyGamma(): gamma has to be bigger than 0";
+		return;
+	}
+	const float exponent = 1.f / gamma;
+	applyCurve(*this, [exponent](float value, size_t){
+		return value > 0 ? pow(value, exponent) : value;
+	}, "gamma correction");
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::applyLevels(float inputBlack, float inputWhite, float gamma, float outputBlack, float outputWhite){
+	if(inputWhite == inputBlack || gamma <= 0){
+		ofLogWarning("ofPixels") << "applyLevels(): the input range can't be empty and gamma has to be bigger than 0";
+		return;
+	}
+	const float exponent = 1.f / gamma;
+	applyCurve(*this, [=](float value, size_t){
+		float v = ofClamp((value - inputBlack) / (inputWhite - inputBlack), 0, 1);
+		return outputBlack + pow(v, exponent) * (outputWhite - outputBlack);
+	}, "levels adjustment");
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::applyContrast(float contrast, float pivot){
+	applyCurve(*this, [contrast, pivot](float value, size_t){
+		return (value - pivot) * contrast + pivot;
+	}, "contrast adjustment");
+}
+
+template<typename PixelType>
+void ofPixels_<PixelType>::applyLut(const ofColorLut & lut){
+	if(!lut.isAllocated()){
+		ofLogWarning("ofPixels") << "applyLut(): the look up table is not allocated";
+		return;
+	}
+	if(!lut.is3D()){
+		// 1d tables map every channel independently, gray pixels use the red one
+		applyCurve(*this, [&lut](float value, size_t channel){
+			return lut.apply(glm::vec3(value))[channel];
+		}, "look up table");
+		return;
+	}
+	if(colorChannelsFromPixelFormat(pixelFormat) != 3){
+		ofLogWarning("ofPixels") << "3d look up table not supported for this pixel format";
+		return;
+	}
+	const size_t channels = getNumChannels();
+	const size_t r = isBgr(pixelFormat) ? 2 : 0;
+	const size_t b = 2 - r;
+	const float limit = ofColor_<PixelType>::limit();
+	PixelType * data = pixels;
+	forEachPixelBlock(width * height, channels, [&](size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			PixelType * pixel = data + i * channels;
+			glm::vec3 color = lut.apply(glm::vec3(pixel[r], pixel[1], pixel[b]) / limit) * limit;
+			pixel[r] = toPixelValue<PixelType>(color.r);
+			pixel[1] = toPixelValue<PixelType>(color.g);
+			pixel[b] = toPixelValue<PixelType>(color.b);
+		}
+	});
+}
+
 template<typename PixelType>
 void ofPixels_<PixelType>::clear(){
 	if(pixels){
@@ -55,6 +55,7 @@ enum ofInterpolationMethod {
 	OF_INTERPOLATE_BICUBIC			=3
 };
 
+class ofColorLut;
 
 /// \brief A class representing a collection of pixels.
 template <typename PixelType>
@@ -197,6 +198,61 @@ public:
 	/// image, leaving the G and A channels as is.
 	void swapRgb();
 
+	/// \}
+
+	/// \name Color Transforms
+	/// \{
+
+	/// These work on RGB, BGR, RGBA, BGRA and, when it makes sense, GRAY
+	/// pixels. Alpha is left as is. Large images are processed using
+	/// several threads.
+	///
+	/// Values are normalized to the [0, 1] range before transforming them,
+	/// float pixels are not clamped so they can hold HDR values.
+
+	/// \brief Convert every pixel from RGB to HSB, storing hue, saturation
+	/// and brightness in the red, green and blue channels.
+	///
+	/// The results are the same as ofColor::getHsb() for every pixel.
+	void convertRgbToHsb();
+
+	/// \brief Convert every pixel from HSB, stored in the red, green and blue
+	/// channels, to RGB.
+	///
+	/// The results are the same as ofColor::setHsb() for every pixel.
+	void convertHsbToRgb();
+
+	/// \brief Convert the color channels from the sRGB transfer function to
+	/// linear values.
+	void convertSrgbToLinear();
+
+	/// \brief Convert the color channels from linear values to the sRGB
+	/// transfer function.
+	void convertLinearToSrgb();
+
+	/// \brief Apply a gamma correction to the color channels.
+	///
+	/// Every value v becomes v^(1/gamma), so values bigger than 1 brighten
+	/// the midtones and smaller ones darken them.
+	void applyGamma(float gamma);
+
+	/// \brief Remap the color channels like a levels adjustment.
+	///
+	/// Values between inputBlack and inputWhite are stretched to the full
+	/// range, corrected with gamma as in applyGamma() and then compressed
+	/// to the range between outputBlack and outputWhite.
+	void applyLevels(float inputBlack, float inputWhite, float gamma = 1, float outputBlack = 0, float outputWhite = 1);
+
+	/// \brief Scale the distance of the color channels to pivot.
+	///
+	/// A contrast bigger than 1 increases the contrast, smaller than 1
+	/// reduces it.
+	void applyContrast(float contrast, float pivot = 0.5);
+
+	/// \brief Map the color of every pixel through a look up table.
+	/// \sa ofColorLut
+	void applyLut(const ofColorLut & lut);
+
 	/// \}
 	/// \name Pixels Access
 	/// \{
@@ -0,0 +1,1156 @@
+#include "ofRecordingRenderer.h"
+#include "ofMesh.h"
+#include "ofImage.h"
+#include "ofCamera.h"
+#include "ofTrueTypeFont.h"
+#include <array>
+#include <cstring>
+
+using namespace std;
+
+const string ofRecordingRenderer::TYPE="recording";
+
+enum class of::priv::RecordingCommand: unsigned char{
+	DrawPolyline,
+	DrawPath,
+	DrawMesh,
+	DrawPrimitive,
+	DrawNode,
+	DrawImage,
+	DrawFloatImage,
+	DrawShortImage,
+	DrawVideo,
+	PushView,
+	PopView,
+	Viewport,
+	SetupScreenPerspective,
+	SetupScreenOrtho,
+	SetOrientation,
+	SetCoordHandedness,
+	PushMatrix,
+	PopMatrix,
+	Translate,
+	Scale,
+	Rotate,
+	MatrixMode,
+	LoadIdentityMatrix,
+	LoadMatrix,
+	MultMatrix,
+	LoadViewMatrix,
+	MultViewMatrix,
+	SetupGraphicDefaults,
+	SetupScreen,
+	SetRectMode,
+	SetFillMode,
+	SetLineWidth,
+	SetDepthTest,
+	SetBlendMode,
+	SetLineSmoothing,
+	SetCircleResolution,
+	SetAntiAliasing,
+	SetColor,
+	SetBitmapTextMode,
+	SetBackgroundColor,
+	Background,
+	SetBackgroundAuto,
+	Clear,
+	ClearColor,
+	ClearAlpha,
+	DrawLine,
+	DrawRectangle,
+	DrawTriangle,
+	DrawCircle,
+	DrawEllipse,
+	DrawString,
+	DrawStringFont,
+	SetStyle,
+	PushStyle,
+	PopStyle,
+	SetCurveResolution,
+	SetPolyMode,
+	NumCommands
+};
+
+namespace{
+	typedef of::priv::RecordingCommand Command;
+
+	struct CommandReader{
+		const unsigned char * data;
+
+		template<typename T>
+		T read(){
+			T value;
+			memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return value;
+		}
+	};
+
+	// FNV-1a
+	struct Hasher{
+		uint64_t value = 14695981039346656037ull;
+
+		void add(const void * data, size_t size){
+			auto bytes = static_cast<const unsigned char*>(data);
+			for(size_t i = 0; i < size; i++){
+				value = (value ^ bytes[i]) * 1099511628211ull;
+			}
+		}
+
+		template<typename T>
+		void add(const T & value){
+			add(&value, sizeof(T));
+		}
+
+		template<typename T>
+		void add(const vector<T> & values){
+			add(values.size());
+			if(!values.empty()){
+				add(values.data(), values.size() * sizeof(T));
+			}
+		}
+	};
+
+	void hashMesh(Hasher & hasher, const ofMesh & mesh){
+		hasher.add(mesh.getMode());
+		hasher.add(mesh.getVertices());
+		hasher.add(mesh.getColors());
+		hasher.add(mesh.getNormals());
+		hasher.add(mesh.getTexCoords());
+		hasher.add(mesh.getIndices());
+	}
+
+	void hashPolyline(Hasher & hasher, const ofPolyline & polyline){
+		hasher.add(polyline.isClosed());
+		hasher.add(polyline.getVertices());
+	}
+
+	void hashPath(Hasher & hasher, const ofPath & path){
+		// only the members each type of command uses are initialized
+		const auto & commands = path.getCommands();
+		hasher.add(commands.size());
+		for(const auto & command: commands){
+			hasher.add(command.type);
+			switch(command.type){
+			case ofPath::Command::moveTo:
+			case ofPath::Command::lineTo:
+			case ofPath::Command::curveTo:
+				hasher.add(command.to);
+				break;
+			case ofPath::Command::bezierTo:
+			case ofPath::Command::quadBezierTo:
+				hasher.add(command.to);
+				hasher.add(command.cp1);
+				hasher.add(command.cp2);
+				break;
+			case ofPath::Command::arc:
+			case ofPath::Command::arcNegative:
+				hasher.add(command.to);
+				hasher.add(command.radiusX);
+				hasher.add(command.radiusY);
+				hasher.add(command.angleBegin);
+				hasher.add(command.angleEnd);
+				break;
+			case ofPath::Command::close:
+				break;
+			}
+		}
+		hasher.add(path.isFilled());
+		hasher.add(path.getFillColor());
+		hasher.add(path.getStrokeColor());
+		hasher.add(path.getStrokeWidth());
+		hasher.add(path.getWindingMode());
+		hasher.add(path.getUseShapeColor());
+		hasher.add(path.getCurveResolution());
+		hasher.add(path.getCircleResolution());
+	}
+
+	void hashStyle(Hasher & hasher, const ofStyle & style){
+		hasher.add(style.color);
+		hasher.add(style.bgColor);
+		hasher.add(style.polyMode);
+		hasher.add(style.rectMode);
+		hasher.add(style.bFill);
+		hasher.add(style.drawBitmapMode);
+		hasher.add(style.blendingMode);
+		hasher.add(style.smoothing);
+		hasher.add(style.circleResolution);
+		hasher.add(style.sphereResolution);
+		hasher.add(style.curveResolution);
+		hasher.add(style.lineWidth);
+	}
+
+	// commands that only set one style value which stays current until the
+	// same command is recorded again
+	bool isStateCommand(Command command){
+		switch(command){
+		case Command::SetRectMode:
+		case Command::SetFillMode:
+		case Command::SetLineWidth:
+		case Command::SetDepthTest:
+		case Command::SetBlendMode:
+		case Command::SetLineSmoothing:
+		case Command::SetCircleResolution:
+		case Command::SetAntiAliasing:
+		case Command::SetColor:
+		case Command::SetBitmapTextMode:
+		case Command::SetBackgroundColor:
+		case Command::SetBackgroundAuto:
+		case Command::SetCurveResolution:
+		case Command::SetPolyMode:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// commands that change the style in ways the optimizer doesn't follow
+	bool resetsStyle(Command command){
+		switch(command){
+		case Command::SetupGraphicDefaults:
+		case Command::Background:
+		case Command::SetStyle:
+		case Command::PopStyle:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void setupPerspective(ofMatrixStack & matrixStack, float width, float height, float fov, float nearDist, float farDist){
+		if(width<0 || height<0){
+			ofRectangle currentViewport = matrixStack.getCurrentViewport();
+			width = currentViewport.width;
+			height = currentViewport.height;
+		}
+		float eyeX = width / 2;
+		float eyeY = height / 2;
+		float dist = eyeY / tanf(PI * fov / 360);
+		float aspect = height > 0 ? width / height : 1;
+		if(nearDist == 0) nearDist = dist / 10.0f;
+		if(farDist == 0) farDist = dist * 10.0f;
+
+		matrixStack.matrixMode(OF_MATRIX_PROJECTION);
+		matrixStack.loadMatrix(glm::perspective(ofDegToRad(fov), aspect, nearDist, farDist));
+		matrixStack.matrixMode(OF_MATRIX_MODELVIEW);
+		matrixStack.loadViewMatrix(glm::lookAt(glm::vec3{eyeX, eyeY, dist}, glm::vec3{eyeX, eyeY, 0.f}, glm::vec3{0.f, 1.f, 0.f}));
+	}
+}
+
+//----------------------------------------------------------
+ofRecordingRenderer::ofRecordingRenderer(const ofRectangle & viewport)
+:hash(0)
+,hashDirty(true)
+,matrixStack(nullptr)
+,bBackgroundAuto(true)
+,graphics3d(this){
+	matrixStack.nativeViewport(viewport);
+}
+
+//----------------------------------------------------------
+template<typename T>
+void ofRecordingRenderer::write(const T & value) const{
+	size_t position = commands.size();
+	commands.resize(position + sizeof(T));
+	memcpy(commands.data() + position, &value, sizeof(T));
+}
+
+//----------------------------------------------------------
+template<typename... Args>
+void ofRecordingRenderer::record(Command command, const Args&... args) const{
+	offsets.push_back(commands.size());
+	write(command);
+	int expand[] = {0, (write(args), 0)...};
+	(void)expand;
+	hashDirty = true;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::reset(){
+	commands.clear();
+	offsets.clear();
+	meshes.used = 0;
+	paths.used = 0;
+	polylines.used = 0;
+	strings.used = 0;
+	styles.used = 0;
+	hashDirty = true;
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getNumCommands() const{
+	return offsets.size();
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::empty() const{
+	return offsets.empty();
+}
+
+//----------------------------------------------------------
+size_t ofRecordingRenderer::getSizeInBytes() const{
+	return commands.size();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::replay(ofBaseRenderer & renderer) const{
+	CommandReader reader{commands.data()};
+	const unsigned char * end = commands.data() + commands.size();
+	while(reader.data < end){
+		auto command = reader.read<Command>();
+		switch(command){
+		case Command::DrawPolyline:
+			renderer.draw(polylines.items[reader.read<uint32_t>()]);
+			break;
+		case Command::DrawPath:
+			renderer.draw(paths.items[reader.read<uint32_t>()]);
+			break;
+		case Command::DrawMesh:{
+			const ofMesh & mesh = meshes.items[reader.read<uint32_t>()];
+			auto mode = reader.read<ofPolyRenderMode>();
+			auto useColors = reader.read<bool>();
+			auto useTextures = reader.read<bool>();
+			auto useNormals = reader.read<bool>();
+			renderer.draw(mesh, mode, useColors, useTextures, useNormals);
+		}break;
+		case Command::DrawPrimitive:{
+			auto primitive = reader.read<const of3dPrimitive*>();
+			renderer.draw(*primitive, reader.read<ofPolyRenderMode>());
+		}break;
+		case Command::DrawNode:
+			renderer.draw(*reader.read<const ofNode*>());
+			break;
+		case Command::DrawImage:
+		case Command::DrawFloatImage:
+		case Command::DrawShortImage:{
+			auto image = reader.read<const void*>();
+			auto r = reader.read<std::array<float,9>>();
+			if(command == Command::DrawImage){
+				renderer.draw(*static_cast<const ofImage*>(image), r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8]);
+			}else if(command == Command::DrawFloatImage){
+				renderer.draw(*static_cast<const ofFloatImage*>(image), r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8]);
+			}else{
+				renderer.draw(*static_cast<const ofShortImage*>(image), r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8]);
+			}
+		}break;
+		case Command::DrawVideo:{
+			auto video = reader.read<const ofBaseVideoDraws*>();
+			auto r = reader.read<std::array<float,4>>();
+			renderer.draw(*video, r[0], r[1], r[2], r[3]);
+		}break;
+		case Command::PushView:
+			renderer.pushView();
+			break;
+		case Command::PopView:
+			renderer.popView();
+			break;
+		case Command::Viewport:{
+			auto r = reader.read<std::array<float,4>>();
+			renderer.viewport(r[0], r[1], r[2], r[3], reader.read<bool>());
+		}break;
+		case Command::SetupScreenPerspective:{
+			auto r = reader.read<std::array<float,5>>();
+			renderer.setupScreenPerspective(r[0], r[1], r[2], r[3], r[4]);
+		}break;
+		case Command::SetupScreenOrtho:{
+			auto r = reader.read<std::array<float,4>>();
+			renderer.setupScreenOrtho(r[0], r[1], r[2], r[3]);
+		}break;
+		case Command::SetOrientation:{
+			auto orientation = reader.read<ofOrientation>();
+			renderer.setOrientation(orientation, reader.read<bool>());
+		}break;
+		case Command::SetCoordHandedness:
+			renderer.setCoordHandedness(reader.read<ofHandednessType>());
+			break;
+		case Command::PushMatrix:
+			renderer.pushMatrix();
+			break;
+		case Command::PopMatrix:
+			renderer.popMatrix();
+			break;
+		case Command::Translate:
+			renderer.translate(reader.read<glm::vec3>());
+			break;
+		case Command::Scale:{
+			auto s = reader.read<glm::vec3>();
+			renderer.scale(s.x, s.y, s.z);
+		}break;
+		case Command::Rotate:{
+			auto radians = reader.read<float>();
+			auto axis = reader.read<glm::vec3>();
+			renderer.rotateRad(radians, axis.x, axis.y, axis.z);
+		}break;
+		case Command::MatrixMode:
+			renderer.matrixMode(reader.read<ofMatrixMode>());
+			break;
+		case Command::LoadIdentityMatrix:
+			renderer.loadIdentityMatrix();
+			break;
+		case Command::LoadMatrix:
+			renderer.loadMatrix(reader.read<glm::mat4>());
+			break;
+		case Command::MultMatrix:
+			renderer.multMatrix(reader.read<glm::mat4>());
+			break;
+		case Command::LoadViewMatrix:
+			renderer.loadViewMatrix(reader.read<glm::mat4>());
+			break;
+		case Command::MultViewMatrix:
+			renderer.multViewMatrix(reader.read<glm::mat4>());
+			break;
+		case Command::SetupGraphicDefaults:
+			renderer.setupGraphicDefaults();
+			break;
+		case Command::SetupScreen:
+			renderer.setupScreen();
+			break;
+		case Command::SetRectMode:
+			renderer.setRectMode(reader.read<ofRectMode>());
+			break;
+		case Command::SetFillMode:
+			renderer.setFillMode(reader.read<ofFillFlag>());
+			break;
+		case Command::SetLineWidth:
+			renderer.setLineWidth(reader.read<float>());
+			break;
+		case Command::SetDepthTest:
+			renderer.setDepthTest(reader.read<bool>());
+			break;
+		case Command::SetBlendMode:
+			renderer.setBlendMode(reader.read<ofBlendMode>());
+			break;
+		case Command::SetLineSmoothing:
+			renderer.setLineSmoothing(reader.read<bool>());
+			break;
+		case Command::SetCircleResolution:
+			renderer.setCircleResolution(reader.read<int>());
+			break;
+		case Command::SetAntiAliasing:
+			if(reader.read<bool>()){
+				renderer.enableAntiAliasing();
+			}else{
+				renderer.disableAntiAliasing();
+			}
+			break;
+		case Command::SetColor:
+			renderer.setColor(reader.read<ofColor>());
+			break;
+		case Command::SetBitmapTextMode:
+			renderer.setBitmapTextMode(reader.read<ofDrawBitmapMode>());
+			break;
+		case Command::SetBackgroundColor:
+			renderer.setBackgroundColor(reader.read<ofColor>());
+			break;
+		case Command::Background:
+			renderer.background(reader.read<ofColor>());
+			break;
+		case Command::SetBackgroundAuto:
+			renderer.setBackgroundAuto(reader.read<bool>());
+			break;
+		case Command::Clear:
+			renderer.clear();
+			break;
+		case Command::ClearColor:{
+			auto c = reader.read<std::array<float,4>>();
+			renderer.clear(c[0], c[1], c[2], c[3]);
+		}break;
+		case Command::ClearAlpha:
+			renderer.clearAlpha();
+			break;
+		case Command::DrawLine:{
+			auto p = reader.read<std::array<float,6>>();
+			renderer.drawLine(p[0], p[1], p[2], p[3], p[4], p[5]);
+		}break;
+		case Command::DrawRectangle:{
+			auto r = reader.read<std::array<float,5>>();
+			renderer.drawRectangle(r[0], r[1], r[2], r[3], r[4]);
+		}break;
+		case Command::DrawTriangle:{
+			auto p = reader.read<std::array<float,9>>();
+			renderer.drawTriangle(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8]);
+		}break;
+		case Command::DrawCircle:{
+			auto c = reader.read<std::array<float,4>>();
+			renderer.drawCircle(c[0], c[1], c[2], c[3]);
+		}break;
+		case Command::DrawEllipse:{
+			auto e = reader.read<std::array<float,5>>();
+			renderer.drawEllipse(e[0], e[1], e[2], e[3], e[4]);
+		}break;
+		case Command::DrawString:{
+			const string & text = strings.items[reader.read<uint32_t>()];
+			auto p = reader.read<glm::vec3>();
+			renderer.drawString(text, p.x, p.y, p.z);
+		}break;
+		case Command::DrawStringFont:{
+			auto font = reader.read<const ofTrueTypeFont*>();
+			const string & text = strings.items[reader.read<uint32_t>()];
+			auto p = reader.read<glm::vec2>();
+			renderer.drawString(*font, text, p.x, p.y);
+		}break;
+		case Command::SetStyle:
+			renderer.setStyle(styles.items[reader.read<uint32_t>()]);
+			break;
+		case Command::PushStyle:
+			renderer.pushStyle();
+			break;
+		case Command::PopStyle:
+			renderer.popStyle();
+			break;
+		case Command::SetCurveResolution:
+			renderer.setCurveResolution(reader.read<int>());
+			break;
+		case Command::SetPolyMode:
+			renderer.setPolyMode(reader.read<ofPolyWindingMode>());
+			break;
+		case Command::NumCommands:
+			ofLogError("ofRecordingRenderer") << "replay(): corrupted command buffer";
+			return;
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::optimize(){
+	const size_t numKinds = size_t(Command::NumCommands);
+	// last state command of each kind that nothing has used yet
+	vector<size_t> pending(numKinds, size_t(-1));
+	// last value of each kind that reached a draw, only the offset of the
+	// command that set it is stored
+	vector<size_t> current(numKinds, size_t(-1));
+	vector<bool> dead(offsets.size(), false);
+
+	auto commandSize = [&](size_t i){
+		return (i + 1 < offsets.size() ? offsets[i + 1] : commands.size()) - offsets[i];
+	};
+	auto sameCommand = [&](size_t a, size_t b){
+		return commandSize(a) == commandSize(b) &&
+			memcmp(&commands[offsets[a]], &commands[offsets[b]], commandSize(a)) == 0;
+	};
+
+	for(size_t i = 0; i < offsets.size(); i++){
+		auto command = Command(commands[offsets[i]]);
+		auto kind = size_t(command);
+		if(isStateCommand(command)){
+			if(pending[kind] != size_t(-1)){
+				dead[pending[kind]] = true;
+				pending[kind] = size_t(-1);
+			}
+			if(current[kind] != size_t(-1) && sameCommand(current[kind], i)){
+				dead[i] = true;
+			}else{
+				pending[kind] = i;
+			}
+		}else{
+			for(size_t k = 0; k < numKinds; k++){
+				if(pending[k] != size_t(-1)){
+					current[k] = pending[k];
+					pending[k] = size_t(-1);
+				}
+			}
+			if(resetsStyle(command)){
+				std::fill(current.begin(), current.end(), size_t(-1));
+			}
+		}
+	}
+
+	size_t out = 0;
+	vector<size_t> newOffsets;
+	newOffsets.reserve(offsets.size());
+	for(size_t i = 0; i < offsets.size(); i++){
+		if(dead[i]) continue;
+		size_t size = commandSize(i);
+		memmove(&commands[out], &commands[offsets[i]], size);
+		newOffsets.push_back(out);
+		out += size;
+	}
+	commands.resize(out);
+	offsets.swap(newOffsets);
+	hashDirty = true;
+}
+
+//----------------------------------------------------------
+uint64_t ofRecordingRenderer::getHash() const{
+	if(hashDirty){
+		Hasher hasher;
+		hasher.add(commands);
+		for(uint32_t i = 0; i < meshes.used; i++){
+			hashMesh(hasher, meshes.items[i]);
+		}
+		for(uint32_t i = 0; i < paths.used; i++){
+			hashPath(hasher, paths.items[i]);
+		}
+		for(uint32_t i = 0; i < polylines.used; i++){
+			hashPolyline(hasher, polylines.items[i]);
+		}
+		for(uint32_t i = 0; i < strings.used; i++){
+			hasher.add(strings.items[i].size());
+			hasher.add(strings.items[i].data(), strings.items[i].size());
+		}
+		for(uint32_t i = 0; i < styles.used; i++){
+			hashStyle(hasher, styles.items[i]);
+		}
+		hash = hasher.value;
+		hashDirty = false;
+	}
+	return hash;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPolyline & poly) const{
+	record(Command::DrawPolyline, polylines.add(poly));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofPath & shape) const{
+	record(Command::DrawPath, paths.add(shape));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
+	record(Command::DrawMesh, meshes.add(vertexData), renderType, useColors, useTextures, useNormals);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const of3dPrimitive& model, ofPolyRenderMode renderType) const{
+	record(Command::DrawPrimitive, &model, renderType);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofNode& node) const{
+	record(Command::DrawNode, &node);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Command::DrawImage, (const void*)&image, std::array<float,9>{{x, y, z, w, h, sx, sy, sw, sh}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Command::DrawFloatImage, (const void*)&image, std::array<float,9>{{x, y, z, w, h, sx, sy, sw, sh}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const{
+	record(Command::DrawShortImage, (const void*)&image, std::array<float,9>{{x, y, z, w, h, sx, sy, sw, sh}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const{
+	record(Command::DrawVideo, &video, std::array<float,4>{{x, y, w, h}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushView(){
+	record(Command::PushView);
+	matrixStack.pushView();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popView(){
+	record(Command::PopView);
+	matrixStack.popView();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(ofRectangle viewport_){
+	viewport(viewport_.x, viewport_.y, viewport_.width, viewport_.height, isVFlipped());
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::viewport(float x, float y, float width, float height, bool vflip){
+	record(Command::Viewport, std::array<float,4>{{x, y, width, height}}, vflip);
+	matrixStack.viewport(x, y, width, height, vflip);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenPerspective(float width, float height, float fov, float nearDist, float farDist){
+	record(Command::SetupScreenPerspective, std::array<float,5>{{width, height, fov, nearDist, farDist}});
+	setupPerspective(matrixStack, width, height, fov, nearDist, farDist);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreenOrtho(float width, float height, float nearDist, float farDist){
+	record(Command::SetupScreenOrtho, std::array<float,4>{{width, height, nearDist, farDist}});
+	if(width<0 || height<0){
+		ofRectangle currentViewport = getCurrentViewport();
+		width = currentViewport.width;
+		height = currentViewport.height;
+	}
+	matrixStack.matrixMode(OF_MATRIX_PROJECTION);
+	matrixStack.loadMatrix(glm::ortho(0.f, width, 0.f, height, nearDist, farDist));
+	matrixStack.matrixMode(OF_MATRIX_MODELVIEW);
+	matrixStack.loadViewMatrix(glm::mat4(1.0));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setOrientation(ofOrientation orientation, bool vFlip){
+	record(Command::SetOrientation, orientation, vFlip);
+	matrixStack.setOrientation(orientation, vFlip);
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getCurrentViewport() const{
+	return matrixStack.getCurrentViewport();
+}
+
+//----------------------------------------------------------
+ofRectangle ofRecordingRenderer::getNativeViewport() const{
+	return matrixStack.getNativeViewport();
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportWidth() const{
+	return getCurrentViewport().width;
+}
+
+//----------------------------------------------------------
+int ofRecordingRenderer::getViewportHeight() const{
+	return getCurrentViewport().height;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::isVFlipped() const{
+	return matrixStack.isVFlipped();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCoordHandedness(ofHandednessType handedness){
+	record(Command::SetCoordHandedness, handedness);
+}
+
+//----------------------------------------------------------
+ofHandednessType ofRecordingRenderer::getCoordHandedness() const{
+	return matrixStack.getHandedness();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushMatrix(){
+	record(Command::PushMatrix);
+	matrixStack.pushMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popMatrix(){
+	record(Command::PopMatrix);
+	matrixStack.popMatrix();
+}
+
+//----------------------------------------------------------
+glm::mat4 ofRecordingRenderer::getCurrentMatrix(ofMatrixMode matrixMode_) const{
+	switch(matrixMode_){
+	case OF_MATRIX_MODELVIEW:
+		return matrixStack.getModelViewMatrix();
+	case OF_MATRIX_PROJECTION:
+		return matrixStack.getProjectionMatrix();
+	case OF_MATRIX_TEXTURE:
+		return matrixStack.getTextureMatrix();
+	default:
+		ofLogWarning("ofRecordingRenderer") << "getCurrentMatrix(): invalid matrix mode " << matrixMode_;
+		return glm::mat4(1.0);
+	}
+}
+
+//----------------------------------------------------------
+glm::mat4 ofRecordingRenderer::getCurrentOrientationMatrix() const{
+	return matrixStack.getOrientationMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(float x, float y, float z){
+	translate(glm::vec3(x, y, z));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::translate(const glm::vec3 & p){
+	record(Command::Translate, p);
+	matrixStack.translate(p.x, p.y, p.z);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::scale(float xAmnt, float yAmnt, float zAmnt){
+	record(Command::Scale, glm::vec3(xAmnt, yAmnt, zAmnt));
+	matrixStack.scale(xAmnt, yAmnt, zAmnt);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateRad(float radians, float vecX, float vecY, float vecZ){
+	record(Command::Rotate, radians, glm::vec3(vecX, vecY, vecZ));
+	matrixStack.rotateRad(radians, vecX, vecY, vecZ);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateXRad(float radians){
+	rotateRad(radians, 1, 0, 0);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateYRad(float radians){
+	rotateRad(radians, 0, 1, 0);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateZRad(float radians){
+	rotateRad(radians, 0, 0, 1);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::rotateRad(float radians){
+	rotateZRad(radians);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::matrixMode(ofMatrixMode mode){
+	record(Command::MatrixMode, mode);
+	matrixStack.matrixMode(mode);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadIdentityMatrix(){
+	record(Command::LoadIdentityMatrix);
+	matrixStack.loadIdentityMatrix();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const glm::mat4 & m){
+	record(Command::LoadMatrix, m);
+	matrixStack.loadMatrix(m);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadMatrix(const float * m){
+	loadMatrix(glm::make_mat4(m));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const glm::mat4 & m){
+	record(Command::MultMatrix, m);
+	matrixStack.multMatrix(m);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multMatrix(const float * m){
+	multMatrix(glm::make_mat4(m));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::loadViewMatrix(const glm::mat4 & m){
+	record(Command::LoadViewMatrix, m);
+	matrixStack.loadViewMatrix(m);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::multViewMatrix(const glm::mat4 & m){
+	record(Command::MultViewMatrix, m);
+	matrixStack.multViewMatrix(m);
+}
+
+//----------------------------------------------------------
+glm::mat4 ofRecordingRenderer::getCurrentViewMatrix() const{
+	return matrixStack.getViewMatrix();
+}
+
+//----------------------------------------------------------
+glm::mat4 ofRecordingRenderer::getCurrentNormalMatrix() const{
+	return glm::transpose(glm::inverse(getCurrentMatrix(OF_MATRIX_MODELVIEW)));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::bind(const ofCamera & camera, const ofRectangle & viewport_){
+	// the camera is recorded as the matrices it sets so it doesn't need
+	// to exist when replaying
+	pushView();
+	viewport(viewport_);
+	setOrientation(matrixStack.getOrientation(), camera.isVFlipped());
+	matrixMode(OF_MATRIX_PROJECTION);
+	loadMatrix(camera.getProjectionMatrix(viewport_));
+	matrixMode(OF_MATRIX_MODELVIEW);
+	loadViewMatrix(camera.getModelViewMatrix());
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::unbind(const ofCamera & camera){
+	popView();
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupGraphicDefaults(){
+	record(Command::SetupGraphicDefaults);
+	currentStyle = ofStyle();
+	path.setMode(ofPath::POLYLINES);
+	path.setUseShapeColor(false);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setupScreen(){
+	record(Command::SetupScreen);
+	setupPerspective(matrixStack, -1, -1, 60, 0, 0);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setRectMode(ofRectMode mode){
+	record(Command::SetRectMode, mode);
+	currentStyle.rectMode = mode;
+}
+
+//----------------------------------------------------------
+ofRectMode ofRecordingRenderer::getRectMode(){
+	return currentStyle.rectMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setFillMode(ofFillFlag fill){
+	record(Command::SetFillMode, fill);
+	currentStyle.bFill = (fill==OF_FILLED);
+	path.setFilled(currentStyle.bFill);
+	path.setStrokeWidth(currentStyle.bFill ? 0 : currentStyle.lineWidth);
+}
+
+//----------------------------------------------------------
+ofFillFlag ofRecordingRenderer::getFillMode(){
+	return currentStyle.bFill ? OF_FILLED : OF_OUTLINE;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineWidth(float lineWidth){
+	record(Command::SetLineWidth, lineWidth);
+	currentStyle.lineWidth = lineWidth;
+	if(!currentStyle.bFill){
+		path.setStrokeWidth(lineWidth);
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setDepthTest(bool depthTest){
+	record(Command::SetDepthTest, depthTest);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBlendMode(ofBlendMode blendMode){
+	record(Command::SetBlendMode, blendMode);
+	currentStyle.blendingMode = blendMode;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setLineSmoothing(bool smooth){
+	record(Command::SetLineSmoothing, smooth);
+	currentStyle.smoothing = smooth;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCircleResolution(int res){
+	record(Command::SetCircleResolution, res);
+	currentStyle.circleResolution = res;
+	path.setCircleResolution(res);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::enableAntiAliasing(){
+	record(Command::SetAntiAliasing, true);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::disableAntiAliasing(){
+	record(Command::SetAntiAliasing, false);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b){
+	setColor(ofColor(r, g, b));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int r, int g, int b, int a){
+	setColor(ofColor(r, g, b, a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color){
+	record(Command::SetColor, color);
+	currentStyle.color = color;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(const ofColor & color, int _a){
+	setColor(ofColor(color, _a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setColor(int gray){
+	setColor(ofColor(gray));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setHexColor(int hexColor){
+	setColor(ofColor::fromHex(hexColor));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
+	record(Command::SetBitmapTextMode, mode);
+	currentStyle.drawBitmapMode = mode;
+}
+
+//----------------------------------------------------------
+ofColor ofRecordingRenderer::getBackgroundColor(){
+	return currentStyle.bgColor;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundColor(const ofColor & c){
+	record(Command::SetBackgroundColor, c);
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(const ofColor & c){
+	record(Command::Background, c);
+	currentStyle.bgColor = c;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(float brightness){
+	background(ofColor(brightness));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int hexColor, float _a){
+	background((hexColor >> 16) & 0xff, (hexColor >> 8) & 0xff, (hexColor >> 0) & 0xff, _a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::background(int r, int g, int b, int a){
+	background(ofColor(r, g, b, a));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setBackgroundAuto(bool bAuto){
+	record(Command::SetBackgroundAuto, bAuto);
+	bBackgroundAuto = bAuto;
+}
+
+//----------------------------------------------------------
+bool ofRecordingRenderer::getBackgroundAuto(){
+	return bBackgroundAuto;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(){
+	record(Command::Clear);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float r, float g, float b, float a){
+	record(Command::ClearColor, std::array<float,4>{{r, g, b, a}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clear(float brightness, float a){
+	clear(brightness, brightness, brightness, a);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::clearAlpha(){
+	record(Command::ClearAlpha);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const{
+	record(Command::DrawLine, std::array<float,6>{{x1, y1, z1, x2, y2, z2}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawRectangle(float x, float y, float z, float w, float h) const{
+	record(Command::DrawRectangle, std::array<float,5>{{x, y, z, w, h}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const{
+	record(Command::DrawTriangle, std::array<float,9>{{x1, y1, z1, x2, y2, z2, x3, y3, z3}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawCircle(float x, float y, float z, float radius) const{
+	record(Command::DrawCircle, std::array<float,4>{{x, y, z, radius}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawEllipse(float x, float y, float z, float width, float height) const{
+	record(Command::DrawEllipse, std::array<float,5>{{x, y, z, width, height}});
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(string text, float x, float y, float z) const{
+	record(Command::DrawString, strings.add(text), glm::vec3(x, y, z));
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::drawString(const ofTrueTypeFont & font, string text, float x, float y) const{
+	record(Command::DrawStringFont, &font, strings.add(text), glm::vec2(x, y));
+}
+
+//----------------------------------------------------------
+ofPath & ofRecordingRenderer::getPath(){
+	return path;
+}
+
+//----------------------------------------------------------
+ofStyle ofRecordingRenderer::getStyle() const{
+	return currentStyle;
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setStyle(const ofStyle & style){
+	record(Command::SetStyle, styles.add(style));
+	currentStyle = style;
+	path.setFilled(style.bFill);
+	path.setStrokeWidth(style.bFill ? 0 : style.lineWidth);
+	path.setCircleResolution(style.circleResolution);
+	path.setCurveResolution(style.curveResolution);
+	path.setPolyWindingMode(style.polyMode);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::pushStyle(){
+	record(Command::PushStyle);
+	styleHistory.push_back(currentStyle);
+	if(styleHistory.size() > OF_MAX_STYLE_HISTORY){
+		styleHistory.pop_front();
+		ofLogWarning("ofGraphics") << "ofPushStyle(): maximum number of style pushes << " << OF_MAX_STYLE_HISTORY << " reached, did you forget to pop somewhere?";
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::popStyle(){
+	record(Command::PopStyle);
+	if(!styleHistory.empty()){
+		currentStyle = styleHistory.back();
+		styleHistory.pop_back();
+	}
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setCurveResolution(int resolution){
+	record(Command::SetCurveResolution, resolution);
+	currentStyle.curveResolution = resolution;
+	path.setCurveResolution(resolution);
+}
+
+//----------------------------------------------------------
+void ofRecordingRenderer::setPolyMode(ofPolyWindingMode mode){
+	record(Command::SetPolyMode, mode);
+	currentStyle.polyMode = mode;
+	path.setPolyWindingMode(mode);
+}
+
+//----------------------------------------------------------
+const of3dGraphics & ofRecordingRenderer::get3dGraphics() const{
+	return graphics3d;
+}
+
+//----------------------------------------------------------
+of3dGraphics & ofRecordingRenderer::get3dGraphics(){
+	return graphics3d;
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "ofBaseTypes.h"
+#include "ofMatrixStack.h"
+#include "of3dGraphics.h"
+#include "ofPath.h"
+#include <deque>
+
+namespace of{
+namespace priv{
+	enum class RecordingCommand: unsigned char;
+}
+}
+
+/// \brief A renderer that records the drawing calls instead of executing them.
+///
+/// Everything drawn with an ofRecordingRenderer is serialized into a compact
+/// command buffer that can later be replayed into any other renderer, for
+/// example to render the same frame to the screen and to a PDF or to redraw
+/// a static layer without running the code that generated it:
+///
+/// ~~~~{.cpp}
+/// auto recorder = std::make_shared<ofRecordingRenderer>();
+/// auto previous = ofGetCurrentRenderer();
+/// ofSetCurrentRenderer(recorder, true);
+/// drawScene();
+/// ofSetCurrentRenderer(previous);
+///
+/// // in draw()
+/// recorder->replay(*ofGetCurrentRenderer());
+/// ~~~~
+///
+/// Meshes, paths, polylines and strings are copied into the recording.
+/// Images, videos, fonts, 3d primitives and nodes are recorded by reference
+/// so they have to outlive the recording and are drawn with whatever they
+/// contain at the moment of replaying. Cameras are recorded as the matrices
+/// they set when the recording was made.
+///
+/// The recording renderer keeps track of the style and matrices so queries
+/// like getStyle() or getCurrentMatrix() return the same as other renderers.
+class ofRecordingRenderer: public ofBaseRenderer{
+public:
+	/// \param viewport The native viewport reported while recording,
+	/// until viewport() is called.
+	ofRecordingRenderer(const ofRectangle & viewport = ofRectangle());
+
+	static const std::string TYPE;
+	const std::string & getType(){ return TYPE; }
+
+	/// \brief Discards all the recorded commands.
+	///
+	/// The memory used by the recording is kept to be reused by the next
+	/// one so recording every frame doesn't allocate once it stabilizes.
+	void reset();
+
+	/// \brief Executes all the recorded commands on another renderer.
+	///
+	/// startRender() and finishRender() are not recorded, the caller
+	/// decides where a frame begins and ends.
+	void replay(ofBaseRenderer & renderer) const;
+
+	/// \brief Removes state changes that have no effect.
+	///
+	/// Style changes that are overwritten before anything is drawn or that
+	/// set the value that is already current are removed from the recording.
+	/// The result of replaying it doesn't change.
+	void optimize();
+
+	/// \returns A hash of the recorded commands and their contents.
+	///
+	/// Meshes, paths, polylines, strings and styles are hashed by content.
+	/// Images, videos, fonts, 3d primitives and nodes are recorded by
+	/// reference and only their address is hashed, so changing their
+	/// pixels, geometry or transformation doesn't change the hash. Two
+	/// recordings with the same hash draw the same as long as those
+	/// objects didn't change, so it can be used to skip redrawing a layer
+	/// that didn't change.
+	uint64_t getHash() const;
+
+	/// \returns The number of recorded commands.
+	std::size_t getNumCommands() const;
+
+	/// \returns true if there are no recorded commands.
+	bool empty() const;
+
+	/// \returns The size in bytes of the command buffer, without the
+	/// copied meshes, paths, polylines and strings.
+	std::size_t getSizeInBytes() const;
+
+	void startRender(){}
+	void finishRender(){}
+
+	using ofBaseRenderer::draw;
+	void draw(const ofPolyline & poly) const;
+	void draw(const ofPath & shape) const;
+	void draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const;
+	void draw(const of3dPrimitive& model, ofPolyRenderMode renderType) const;
+	void draw(const ofNode& node) const;
+	void draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const;
+	void draw(const ofBaseVideoDraws & video, float x, float y, float w, float h) const;
+
+	//--------------------------------------------
+	// transformations
+	void pushView();
+	void popView();
+
+	void viewport(ofRectangle viewport);
+	void viewport(float x = 0, float y = 0, float width = -1, float height = -1, bool vflip=true);
+	void setupScreenPerspective(float width = -1, float height = -1, float fov = 60, float nearDist = 0, float farDist = 0);
+	void setupScreenOrtho(float width = -1, float height = -1, float nearDist = -1, float farDist = 1);
+	void setOrientation(ofOrientation orientation, bool vFlip);
+	ofRectangle getCurrentViewport() const;
+	ofRectangle getNativeViewport() const;
+	int getViewportWidth() const;
+	int getViewportHeight() const;
+	bool isVFlipped() const;
+
+	void setCoordHandedness(ofHandednessType handedness);
+	ofHandednessType getCoordHandedness() const;
+
+	void pushMatrix();
+	void popMatrix();
+	glm::mat4 getCurrentMatrix(ofMatrixMode matrixMode_) const;
+	glm::mat4 getCurrentOrientationMatrix() const;
+	void translate(float x, float y, float z = 0);
+	void translate(const glm::vec3 & p);
+	void scale(float xAmnt, float yAmnt, float zAmnt = 1);
+	void rotateRad(float radians, float vecX, float vecY, float vecZ);
+	void rotateXRad(float radians);
+	void rotateYRad(float radians);
+	void rotateZRad(float radians);
+	void rotateRad(float radians);
+	void matrixMode(ofMatrixMode mode);
+	void loadIdentityMatrix (void);
+	void loadMatrix (const glm::mat4 & m);
+	void loadMatrix (const float *m);
+	void multMatrix (const glm::mat4 & m);
+	void multMatrix (const float *m);
+	void loadViewMatrix(const glm::mat4 & m);
+	void multViewMatrix(const glm::mat4 & m);
+	glm::mat4 getCurrentViewMatrix() const;
+	glm::mat4 getCurrentNormalMatrix() const;
+
+	void bind(const ofCamera & camera, const ofRectangle & viewport);
+	void unbind(const ofCamera & camera);
+
+	void setupGraphicDefaults();
+	void setupScreen();
+
+	// drawing modes
+	void setRectMode(ofRectMode mode);
+	ofRectMode getRectMode();
+	void setFillMode(ofFillFlag fill);
+	ofFillFlag getFillMode();
+	void setLineWidth(float lineWidth);
+	void setDepthTest(bool depthTest);
+	void setBlendMode(ofBlendMode blendMode);
+	void setLineSmoothing(bool smooth);
+	void setCircleResolution(int res);
+	void enableAntiAliasing();
+	void disableAntiAliasing();
+
+	// color options
+	void setColor(int r, int g, int b);
+	void setColor(int r, int g, int b, int a);
+	void setColor(const ofColor & color);
+	void setColor(const ofColor & color, int _a);
+	void setColor(int gray);
+	void setHexColor( int hexColor );
+
+	void setBitmapTextMode(ofDrawBitmapMode mode);
+
+	// bg color
+	ofColor getBackgroundColor();
+	void setBackgroundColor(const ofColor & c);
+	void background(const ofColor & c);
+	void background(float brightness);
+	void background(int hexColor, float _a=255.0f);
+	void background(int r, int g, int b, int a=255);
+	void setBackgroundAuto(bool bManual);
+	bool getBackgroundAuto();
+
+	void clear();
+	void clear(float r, float g, float b, float a=0);
+	void clear(float brightness, float a=0);
+	void clearAlpha();
+
+	// drawing
+	void drawLine(float x1, float y1, float z1, float x2, float y2, float z2) const;
+	void drawRectangle(float x, float y, float z, float w, float h) const;
+	void drawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) const;
+	void drawCircle(float x, float y, float z, float radius) const;
+	void drawEllipse(float x, float y, float z, float width, float height) const;
+	void drawString(std::string text, float x, float y, float z) const;
+	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
+
+	ofPath & getPath();
+	ofStyle getStyle() const;
+	void setStyle(const ofStyle & style);
+	void pushStyle();
+	void popStyle();
+	void setCurveResolution(int resolution);
+	void setPolyMode(ofPolyWindingMode mode);
+
+	const of3dGraphics & get3dGraphics() const;
+	of3dGraphics & get3dGraphics();
+
+private:
+	// copies of the recorded objects. Slots are reused after reset() so the
+	// memory allocated by their contents is reused too
+	template<typename T>
+	struct Pool{
+		std::vector<T> items;
+		uint32_t used = 0;
+
+		uint32_t add(const T & item){
+			if(used < items.size()){
+				items[used] = item;
+			}else{
+				items.push_back(item);
+			}
+			return used++;
+		}
+	};
+
+	template<typename T>
+	void write(const T & value) const;
+	template<typename... Args>
+	void record(of::priv::RecordingCommand command, const Args&... args) const;
+
+	// draw calls are const in ofBaseRenderer but still need to be recorded
+	mutable std::vector<unsigned char> commands;
+	mutable std::vector<std::size_t> offsets;
+	mutable Pool<ofMesh> meshes;
+	mutable Pool<ofPath> paths;
+	mutable Pool<ofPolyline> polylines;
+	mutable Pool<std::string> strings;
+	mutable Pool<ofStyle> styles;
+	mutable uint64_t hash;
+	mutable bool hashDirty;
+
+	ofMatrixStack matrixStack;
+	ofStyle currentStyle;
+	std::deque<ofStyle> styleHistory;
+	bool bBackgroundAuto;
+	of3dGraphics graphics3d;
+	ofPath path;
+};
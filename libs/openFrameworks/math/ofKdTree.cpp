@@ -0,0 +1,368 @@
+#include "ofKdTree.h"
+#include "ofTaskPool.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace{
+	// ranges this small are searched linearly
+	const size_t leafSize = 8;
+
+	// ranges bigger than this build their halves in parallel
+	const size_t minParallelSize = 1 << 15;
+
+	template<typename VecType>
+	float distanceSquared(const VecType & a, const VecType & b){
+		VecType d = a - b;
+		return glm::dot(d, d);
+	}
+
+	template<typename VecType>
+	void buildRange(typename ofKdTree_<VecType>::Tree & tree, size_t begin, size_t end){
+		if(end - begin <= leafSize){
+			return;
+		}
+
+		// split the range in the axis where the points are more spread
+		auto & entries = tree.entries;
+		VecType min = entries[begin].position;
+		VecType max = min;
+		for(size_t i = begin + 1; i < end; i++){
+			min = glm::min(min, entries[i].position);
+			max = glm::max(max, entries[i].position);
+		}
+		VecType extent = max - min;
+		unsigned char axis = 0;
+		for(int i = 1; i < VecType::length(); i++){
+			if(extent[i] > extent[axis]){
+				axis = i;
+			}
+		}
+
+		size_t mid = begin + (end - begin) / 2;
+		nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end,
+			[axis](const typename ofKdTree_<VecType>::Entry & a, const typename ofKdTree_<VecType>::Entry & b){
+				return a.position[axis] < b.position[axis];
+			});
+		tree.axes[mid] = axis;
+
+		if(end - begin > minParallelSize){
+			ofTaskGroup left;
+			left.run([&tree, begin, mid]{
+				buildRange<VecType>(tree, begin, mid);
+			});
+			buildRange<VecType>(tree, mid + 1, end);
+			left.wait();
+		}else{
+			buildRange<VecType>(tree, begin, mid);
+			buildRange<VecType>(tree, mid + 1, end);
+		}
+	}
+
+	template<typename VecType>
+	void closest(const typename ofKdTree_<VecType>::Tree & tree, size_t begin, size_t end, const VecType & target, uint32_t & nearest, float & nearestDistance){
+		const auto & entries = tree.entries;
+		if(end - begin <= leafSize){
+			for(size_t i = begin; i < end; i++){
+				float distance = distanceSquared(entries[i].position, target);
+				if(distance < nearestDistance){
+					nearestDistance = distance;
+					nearest = entries[i].index;
+				}
+			}
+			return;
+		}
+
+		size_t mid = begin + (end - begin) / 2;
+		const auto & node = entries[mid];
+		float distance = distanceSquared(node.position, target);
+		if(distance < nearestDistance){
+			nearestDistance = distance;
+			nearest = node.index;
+		}
+
+		// search the side of the target first so the other one can be
+		// skipped if it's farther than the closest point found
+		float offset = target[tree.axes[mid]] - node.position[tree.axes[mid]];
+		if(offset < 0){
+			closest(tree, begin, mid, target, nearest, nearestDistance);
+			if(offset * offset < nearestDistance){
+				closest(tree, mid + 1, end, target, nearest, nearestDistance);
+			}
+		}else{
+			closest(tree, mid + 1, end, target, nearest, nearestDistance);
+			if(offset * offset < nearestDistance){
+				closest(tree, begin, mid, target, nearest, nearestDistance);
+			}
+		}
+	}
+
+	typedef pair<float, uint32_t> Candidate;
+
+	// candidates is a max heap with the farthest of the closest points found
+	// so far at the front
+	void addCandidate(vector<Candidate> & candidates, size_t count, float distance, uint32_t index){
+		if(candidates.size() < count){
+			candidates.emplace_back(distance, index);
+			push_heap(candidates.begin(), candidates.end());
+		}else if(distance < candidates.front().first){
+			pop_heap(candidates.begin(), candidates.end());
+			candidates.back() = Candidate(distance, index);
+			push_heap(candidates.begin(), candidates.end());
+		}
+	}
+
+	float farthestCandidate(const vector<Candidate> & candidates, size_t count){
+		return candidates.size() < count ? numeric_limits<float>::max() : candidates.front().first;
+	}
+
+	template<typename VecType>
+	void closestN(const typename ofKdTree_<VecType>::Tree & tree, size_t begin, size_t end, const VecType & target, size_t count, vector<Candidate> & candidates){
+		const auto & entries = tree.entries;
+		if(end - begin <= leafSize){
+			for(size_t i = begin; i < end; i++){
+				addCandidate(candidates, count, distanceSquared(entries[i].position, target), entries[i].index);
+			}
+			return;
+		}
+
+		size_t mid = begin + (end - begin) / 2;
+		const auto & node = entries[mid];
+		addCandidate(candidates, count, distanceSquared(node.position, target), node.index);
+
+		float offset = target[tree.axes[mid]] - node.position[tree.axes[mid]];
+		if(offset < 0){
+			closestN(tree, begin, mid, target, count, candidates);
+			if(offset * offset < farthestCandidate(candidates, count)){
+				closestN(tree, mid + 1, end, target, count, candidates);
+			}
+		}else{
+			closestN(tree, mid + 1, end, target, count, candidates);
+			if(offset * offset < farthestCandidate(candidates, count)){
+				closestN(tree, begin, mid, target, count, candidates);
+			}
+		}
+	}
+
+	template<typename VecType>
+	void inRadius(const typename ofKdTree_<VecType>::Tree & tree, size_t begin, size_t end, const VecType & target, float radius, vector<size_t> & indices){
+		const auto & entries = tree.entries;
+		const float radiusSquared = radius * radius;
+		if(end - begin <= leafSize){
+			for(size_t i = begin; i < end; i++){
+				if(distanceSquared(entries[i].position, target) <= radiusSquared){
+					indices.push_back(entries[i].index);
+				}
+			}
+			return;
+		}
+
+		size_t mid = begin + (end - begin) / 2;
+		const auto & node = entries[mid];
+		if(distanceSquared(node.position, target) <= radiusSquared){
+			indices.push_back(node.index);
+		}
+		float offset = target[tree.axes[mid]] - node.position[tree.axes[mid]];
+		if(offset <= radius){
+			inRadius(tree, begin, mid, target, radius, indices);
+		}
+		if(offset >= -radius){
+			inRadius(tree, mid + 1, end, target, radius, indices);
+		}
+	}
+
+	template<typename VecType>
+	bool isInBox(const VecType & p, const VecType & min, const VecType & max){
+		for(int i = 0; i < VecType::length(); i++){
+			if(p[i] < min[i] || p[i] > max[i]){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename VecType>
+	void inBox(const typename ofKdTree_<VecType>::Tree & tree, size_t begin, size_t end, const VecType & min, const VecType & max, vector<size_t> & indices){
+		const auto & entries = tree.entries;
+		if(end - begin <= leafSize){
+			for(size_t i = begin; i < end; i++){
+				if(isInBox(entries[i].position, min, max)){
+					indices.push_back(entries[i].index);
+				}
+			}
+			return;
+		}
+
+		size_t mid = begin + (end - begin) / 2;
+		const auto & node = entries[mid];
+		if(isInBox(node.position, min, max)){
+			indices.push_back(node.index);
+		}
+		unsigned char axis = tree.axes[mid];
+		if(min[axis] <= node.position[axis]){
+			inBox(tree, begin, mid, min, max, indices);
+		}
+		if(max[axis] >= node.position[axis]){
+			inBox(tree, mid + 1, end, min, max, indices);
+		}
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+ofKdTree_<VecType>::ofKdTree_(){
+
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+ofKdTree_<VecType>::ofKdTree_(const vector<VecType> & points){
+	build(points);
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::build(const vector<VecType> & points){
+	build(points.data(), points.size());
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::build(const VecType * newPoints, size_t count){
+	clear();
+	if(count == 0){
+		return;
+	}
+	points.assign(newPoints, newPoints + count);
+	Tree tree;
+	tree.entries.resize(count);
+	for(size_t i = 0; i < count; i++){
+		tree.entries[i].position = points[i];
+		tree.entries[i].index = i;
+	}
+	buildTree(tree);
+	trees.push_back(std::move(tree));
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+size_t ofKdTree_<VecType>::add(const VecType & point){
+	size_t index = points.size();
+	points.push_back(point);
+
+	Tree tree;
+	tree.entries.push_back({point, uint32_t(index)});
+	tree.axes.resize(1);
+	trees.push_back(std::move(tree));
+
+	// merge the smallest trees while they are of similar size, this keeps
+	// the number of trees logarithmic and every point is only rebuilt a
+	// logarithmic number of times
+	while(trees.size() > 1 && trees[trees.size() - 2].entries.size() <= trees.back().entries.size() * 2){
+		auto & smallest = trees.back().entries;
+		auto & merged = trees[trees.size() - 2];
+		merged.entries.insert(merged.entries.end(), smallest.begin(), smallest.end());
+		trees.pop_back();
+		buildTree(merged);
+	}
+	return index;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::buildTree(Tree & tree){
+	tree.axes.assign(tree.entries.size(), 0);
+	buildRange<VecType>(tree, 0, tree.entries.size());
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::clear(){
+	points.clear();
+	trees.clear();
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+size_t ofKdTree_<VecType>::size() const{
+	return points.size();
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+bool ofKdTree_<VecType>::empty() const{
+	return points.empty();
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+const VecType & ofKdTree_<VecType>::operator[](size_t index) const{
+	return points[index];
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+const vector<VecType> & ofKdTree_<VecType>::getPoints() const{
+	return points;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+VecType ofKdTree_<VecType>::getClosestPoint(const VecType & target, size_t * nearestIndex) const{
+	if(points.empty()){
+		if(nearestIndex != nullptr){
+			*nearestIndex = 0;
+		}
+		return target;
+	}
+	uint32_t nearest = 0;
+	float nearestDistance = numeric_limits<float>::max();
+	for(auto & tree: trees){
+		closest(tree, 0, tree.entries.size(), target, nearest, nearestDistance);
+	}
+	if(nearestIndex != nullptr){
+		*nearestIndex = nearest;
+	}
+	return points[nearest];
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::findClosest(const VecType & target, size_t count, vector<size_t> & indices) const{
+	indices.clear();
+	if(count == 0){
+		return;
+	}
+	vector<Candidate> candidates;
+	candidates.reserve(std::min(count, points.size()));
+	for(auto & tree: trees){
+		closestN(tree, 0, tree.entries.size(), target, count, candidates);
+	}
+	sort_heap(candidates.begin(), candidates.end());
+	indices.reserve(candidates.size());
+	for(auto & candidate: candidates){
+		indices.push_back(candidate.second);
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::findInRadius(const VecType & target, float radius, vector<size_t> & indices) const{
+	indices.clear();
+	for(auto & tree: trees){
+		inRadius(tree, 0, tree.entries.size(), target, radius, indices);
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofKdTree_<VecType>::findInBox(const VecType & min, const VecType & max, vector<size_t> & indices) const{
+	indices.clear();
+	for(auto & tree: trees){
+		inBox(tree, 0, tree.entries.size(), min, max, indices);
+	}
+}
+
+template class ofKdTree_<glm::vec2>;
+template class ofKdTree_<glm::vec3>;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ofConstants.h"
+
+/// \brief A k-d tree to search the closest points in a 2d or 3d point cloud.
+///
+/// Looking for the closest point to a position in a vector of points needs
+/// to compare it with every point. A k-d tree splits the space recursively
+/// so a search only needs to look at a few of them, which makes it possible
+/// to run thousands of queries per frame on millions of points:
+///
+/// ~~~~{.cpp}
+/// ofKdTree3d tree(mesh.getVertices());
+///
+/// std::size_t nearest;
+/// auto closest = tree.getClosestPoint(position, &nearest);
+///
+/// std::vector<std::size_t> neighbours;
+/// tree.findInRadius(position, 20, neighbours);
+/// ~~~~
+///
+/// The tree keeps a copy of the points and returns their indices in the
+/// original vector. Points can be added after building the tree but not
+/// moved, for points that move every frame use ofSpatialGrid_ instead.
+template<typename VecType>
+class ofKdTree_{
+public:
+	ofKdTree_();
+
+	/// \brief Create a tree for a set of points.
+	ofKdTree_(const std::vector<VecType> & points);
+
+	/// \brief Build the tree for a set of points, discarding the previous
+	/// ones.
+	///
+	/// Large sets of points are built using several threads.
+	void build(const std::vector<VecType> & points);
+	void build(const VecType * points, std::size_t count);
+
+	/// \brief Add a point to the tree.
+	///
+	/// New points are kept in smaller trees that are merged with each other
+	/// as they grow instead of rebuilding the whole tree every time, so
+	/// adding a point is cheap even when the tree is big.
+	///
+	/// \returns The index of the new point.
+	std::size_t add(const VecType & point);
+
+	void clear();
+
+	std::size_t size() const;
+	bool empty() const;
+
+	const VecType & operator[](std::size_t index) const;
+	const std::vector<VecType> & getPoints() const;
+
+	/// \brief Find the closest point to a position.
+	/// \param target The position to search from.
+	/// \param nearestIndex If not null, it's set to the index of the closest point.
+	/// \returns The closest point or target if the tree is empty.
+	VecType getClosestPoint(const VecType & target, std::size_t * nearestIndex = nullptr) const;
+
+	/// \brief Find the closest points to a position.
+	/// \param target The position to search from.
+	/// \param count The number of points to find.
+	/// \param indices Filled with the indices of the closest points, sorted
+	/// from the closest to the farthest.
+	void findClosest(const VecType & target, std::size_t count, std::vector<std::size_t> & indices) const;
+
+	/// \brief Find every point closer to a position than a radius.
+	/// \param indices Filled with the indices of the points found, in no
+	/// particular order.
+	void findInRadius(const VecType & target, float radius, std::vector<std::size_t> & indices) const;
+
+	/// \brief Find every point inside an axis aligned box.
+	/// \param indices Filled with the indices of the points found, in no
+	/// particular order.
+	void findInBox(const VecType & min, const VecType & max, std::vector<std::size_t> & indices) const;
+
+	/// \brief A point and its index in the original vector.
+	struct Entry{
+		VecType position;
+		uint32_t index;
+	};
+
+	/// \brief A tree stored in a single array, the median of every range is
+	/// its node and the halves at each side are its children.
+	struct Tree{
+		std::vector<Entry> entries;
+		std::vector<unsigned char> axes;
+	};
+
+private:
+	void buildTree(Tree & tree);
+
+	std::vector<VecType> points;
+	// sorted from the biggest to the smallest
+	std::vector<Tree> trees;
+};
+
+typedef ofKdTree_<glm::vec2> ofKdTree2d;
+typedef ofKdTree_<glm::vec3> ofKdTree3d;
@@ -2,12 +2,9 @@
 #include "ofUtils.h"
 #include "float.h"
 
-#ifndef TARGET_WIN32
-	#include <sys/time.h>
-#endif
-
 #include "ofNoise.h"
 #include "ofPolyline.h"
+#include "ofPixels.h"
 
 using namespace std;
 
@@ -21,51 +18,61 @@ int ofNextPow2(int a){
 
 //--------------------------------------------------
 void ofSeedRandom() {
-
-	// good info here:
-	// http://stackoverflow.com/questions/322938/recommended-way-to-initialize-srand
-
-	#ifdef TARGET_WIN32
-		srand(GetTickCount());
-	#elif !defined(TARGET_EMSCRIPTEN)
-		// use XOR'd second, microsecond precision AND pid as seed
-		struct timeval tv;
-		gettimeofday(&tv, 0);
-		long int n = (tv.tv_sec ^ tv.tv_usec) ^ getpid();
-		srand(n);
-	#else
-		struct timeval tv;
-		gettimeofday(&tv, 0);
-		long int n = (tv.tv_sec ^ tv.tv_usec);
-		srand(n);
-	#endif
+	of::priv::seedRandomEngines(0, false);
 }
 
 //--------------------------------------------------
 void ofSeedRandom(int val) {
-	srand((long) val);
+	of::priv::seedRandomEngines(val, true);
 }
 
 //--------------------------------------------------
 float ofRandom(float max) {
-	return (max * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return ofRandom(0, max);
 }
 
 //--------------------------------------------------
 float ofRandom(float x, float y) {
 	float high = MAX(x, y);
 	float low = MIN(x, y);
-	return max(low, (low + ((high - low) * rand() / float(RAND_MAX))) * (1.0f - std::numeric_limits<float>::epsilon()));
+	float value = ofGetRandomEngine().uniform(low, high);
+	// rounding can push the value up to the excluded upper limit
+	return value < high ? value : low;
 }
 
 //--------------------------------------------------
 float ofRandomf() {
-	return -1.0f + (2.0f * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return ofRandom(-1.f, 1.f);
 }
 
 //--------------------------------------------------
 float ofRandomuf() {
-	return (rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return ofGetRandomEngine().uniform();
+}
+
+//--------------------------------------------------
+void ofRandomFill(vector<float> & values, float min, float max) {
+	ofGetRandomEngine().fillUniform(values.data(), values.size(), min, max);
+}
+
+//--------------------------------------------------
+void ofRandomFill(ofPixels_<float> & pixels, float min, float max) {
+	ofGetRandomEngine().fillUniform(pixels, min, max);
+}
+
+//--------------------------------------------------
+void ofRandomFillNormal(vector<float> & values, float mean, float stddev) {
+	ofGetRandomEngine().fillNormal(values.data(), values.size(), mean, stddev);
+}
+
+//--------------------------------------------------
+void ofRandomFillInSphere(vector<glm::vec3> & points, float radius) {
+	ofGetRandomEngine().fillInSphere(points.data(), points.size(), radius);
+}
+
+//--------------------------------------------------
+void ofRandomFillOnCircle(vector<glm::vec2> & points, float radius) {
+	ofGetRandomEngine().fillOnCircle(points.data(), points.size(), radius);
 }
 
 //---- new to 006
@@ -1,15 +1,13 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofRandomEngine.h"
 
 /// \file
 /// ofMath provides a collection of mathematical utilities and functions.
 ///
-/// \warning Many ofRandom-style functions wrap `rand()` which is not reentrant
-/// or thread safe.  To generate random numbers simultaneously in multiple
-/// threads, consider using c++11 uniform_real_distribution.
-///
-/// \sa http://en.cppreference.com/w/cpp/numeric/random/uniform_real_distribution
+/// The ofRandom-style functions use a fast per thread ofRandomEngine, so they
+/// can be called from several threads at the same time.
 
 /// \name Random Numbers
 /// \{
@@ -24,8 +22,6 @@
 /// float randomNumber = ofRandom(20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps C++'s `rand()` which is not reentrant or thread safe.
-///
 /// \param max The maximum value of the random number.
 float ofRandom(float max); 
 
@@ -39,8 +35,6 @@ float ofRandom(float max);
 /// float randomNumber = ofRandom(-30, 20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \param val0 the minimum value of the random number.
 /// \param val1 The maximum value of the random number.
 /// \returns A random floating point number between val0 and val1.
@@ -48,15 +42,11 @@ float ofRandom(float val0, float val1);
 
 /// \brief Get a random floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between -1 and 1.
 float ofRandomf();
 
 /// \brief Get a random unsigned floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between 0 and 1.
 float ofRandomuf();
 
@@ -65,8 +55,6 @@ float ofRandomuf();
 ///
 /// A random number in the range [0, ofGetWidth()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetWidth().
 float ofRandomWidth();
 
@@ -74,15 +62,38 @@ float ofRandomWidth();
 ///
 /// A random number in the range [0, ofGetHeight()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetHeight().
 float ofRandomHeight();
 
+/// \brief Fill a vector with random numbers in the range [min, max).
+///
+/// Much faster than calling ofRandom() for each element.
+///
+/// \param values The vector to fill, it keeps its size.
+/// \param min The minimum value of the random numbers.
+/// \param max The maximum value of the random numbers.
+void ofRandomFill(std::vector<float> & values, float min = 0, float max = 1);
+
+/// \brief Fill every value of some float pixels with random numbers in the range [min, max).
+void ofRandomFill(ofPixels_<float> & pixels, float min = 0, float max = 1);
+
+/// \brief Fill a vector with normally distributed random numbers.
+///
+/// \param values The vector to fill, it keeps its size.
+/// \param mean The mean of the distribution.
+/// \param stddev The standard deviation of the distribution.
+void ofRandomFillNormal(std::vector<float> & values, float mean = 0, float stddev = 1);
+
+/// \brief Fill a vector with random points uniformly distributed inside a sphere centered at the origin.
+void ofRandomFillInSphere(std::vector<glm::vec3> & points, float radius = 1);
+
+/// \brief Fill a vector with random points uniformly distributed on a circle centered at the origin.
+void ofRandomFillOnCircle(std::vector<glm::vec2> & points, float radius = 1);
+
 /// \brief Seed the seeds the random number generator with a unique value.
 ///
-/// This seeds the random number generator with an acceptably random value, 
-/// generated from clock time and the PID.
+/// This seeds the random number generator of every thread with an acceptably
+/// random value.
 void ofSeedRandom();
 
 /// \brief Seed the random number generator.
@@ -91,6 +102,10 @@ void ofSeedRandom();
 /// seed can be used to initialize the random number generator during app
 /// setup.  This can be useful for debugging and testing.
 ///
+/// The calling thread will repeat the same sequence every time it's seeded
+/// with the same value. Other threads are reseeded too, with sequences
+/// derived from the same value but different from each other.
+///
 /// \param val The value with which to seed the generator.
 void ofSeedRandom(int val);
 
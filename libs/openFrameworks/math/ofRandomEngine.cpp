@@ -0,0 +1,233 @@
+#include "ofRandomEngine.h"
+#include "ofPixels.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace{
+	uint64_t splitMix64(uint64_t & x){
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t rotl(uint32_t x, int k){
+		return (x << k) | (x >> (32 - k));
+	}
+
+	float toUniform(uint32_t r){
+		return (r >> 8) * (1.0f / 16777216.0f);
+	}
+
+	// in (0, 1] so it's safe to take its log
+	float toUniformNonZero(uint32_t r){
+		return ((r >> 8) + 1) * (1.0f / 16777216.0f);
+	}
+
+	// 8 independent xoshiro128** generators advanced in lockstep. There's no
+	// dependency between lanes so the compiler can vectorize next(), which
+	// makes the batch fills several times faster than drawing numbers one by
+	// one. They are seeded from the calling engine so batches are as
+	// reproducible as single draws.
+	struct ofRandomLanes{
+		static const int count = 8;
+		uint32_t s0[count], s1[count], s2[count], s3[count];
+
+		ofRandomLanes(ofRandomEngine & engine){
+			for(int i = 0; i < count; i++){
+				s0[i] = engine();
+				s1[i] = engine();
+				s2[i] = engine();
+				s3[i] = engine() | 1;
+			}
+		}
+
+		void next(uint32_t * out){
+			for(int i = 0; i < count; i++){
+				out[i] = rotl(s1[i] * 5, 7) * 9;
+				const uint32_t t = s1[i] << 9;
+				s2[i] ^= s0[i];
+				s3[i] ^= s1[i];
+				s1[i] ^= s2[i];
+				s0[i] ^= s3[i];
+				s2[i] ^= t;
+				s3[i] = rotl(s3[i], 11);
+			}
+		}
+	};
+
+	// below this the cost of seeding the lanes isn't worth it
+	const std::size_t minBatchSize = 64;
+
+	std::mutex seedMutex;
+	uint64_t currentSeed = 0;
+	std::thread::id seedOwner;
+	std::atomic<uint32_t> seedGeneration(0);
+	std::atomic<uint64_t> nextStream(1);
+
+	uint64_t nonDeterministicSeed(){
+		std::random_device device;
+		uint64_t seed = (uint64_t(device()) << 32) ^ device();
+		return seed ^ uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	}
+
+	struct ofThreadRandomEngine{
+		ofThreadRandomEngine()
+		:generation(0)
+		,stream(nextStream++){}
+
+		ofRandomEngine engine;
+		uint32_t generation;
+		uint64_t stream;
+	};
+
+	ofThreadRandomEngine & getThreadRandomEngine(){
+#if HAS_TLS
+		thread_local ofThreadRandomEngine threadEngine;
+#else
+		static ofThreadRandomEngine threadEngine;
+#endif
+		return threadEngine;
+	}
+}
+
+//--------------------------------------------------
+ofRandomEngine::ofRandomEngine(){
+	seed(nonDeterministicSeed());
+}
+
+//--------------------------------------------------
+ofRandomEngine::ofRandomEngine(uint64_t seedValue, uint64_t stream){
+	seed(seedValue, stream);
+}
+
+//--------------------------------------------------
+void ofRandomEngine::seed(uint64_t seedValue, uint64_t stream){
+	uint64_t streamState = stream;
+	uint64_t x = seedValue ^ splitMix64(streamState);
+	uint64_t a = splitMix64(x);
+	uint64_t b = splitMix64(x);
+	state[0] = uint32_t(a);
+	state[1] = uint32_t(a >> 32);
+	state[2] = uint32_t(b);
+	state[3] = uint32_t(b >> 32);
+	if(state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0){
+		state[0] = 1;
+	}
+}
+
+//--------------------------------------------------
+float ofRandomEngine::uniform(float min, float max){
+	return min + (max - min) * uniform();
+}
+
+//--------------------------------------------------
+float ofRandomEngine::normal(float mean, float stddev){
+	float u1 = toUniformNonZero((*this)());
+	float u2 = uniform();
+	return mean + stddev * sqrt(-2.f * log(u1)) * cos(TWO_PI * u2);
+}
+
+//--------------------------------------------------
+void ofRandomEngine::fillUniform(float * values, std::size_t count, float min, float max){
+	std::size_t i = 0;
+	float range = max - min;
+	if(count >= minBatchSize){
+		ofRandomLanes lanes(*this);
+		uint32_t r[ofRandomLanes::count];
+		for(; i + ofRandomLanes::count <= count; i += ofRandomLanes::count){
+			lanes.next(r);
+			for(int l = 0; l < ofRandomLanes::count; l++){
+				values[i + l] = min + range * toUniform(r[l]);
+			}
+		}
+	}
+	for(; i < count; i++){
+		values[i] = min + range * uniform();
+	}
+}
+
+//--------------------------------------------------
+void ofRandomEngine::fillUniform(ofPixels_<float> & pixels, float min, float max){
+	fillUniform(pixels.getData(), pixels.size(), min, max);
+}
+
+//--------------------------------------------------
+void ofRandomEngine::fillNormal(float * values, std::size_t count, float mean, float stddev){
+	// Box-Muller, every pair of uniform numbers gives a pair of normal ones
+	std::size_t i = 0;
+	if(count >= minBatchSize){
+		ofRandomLanes lanes(*this);
+		uint32_t r[ofRandomLanes::count];
+		for(; i + ofRandomLanes::count <= count; i += ofRandomLanes::count){
+			lanes.next(r);
+			for(int l = 0; l < ofRandomLanes::count; l += 2){
+				float radius = stddev * sqrt(-2.f * log(toUniformNonZero(r[l])));
+				float angle = TWO_PI * toUniform(r[l + 1]);
+				values[i + l] = mean + radius * cos(angle);
+				values[i + l + 1] = mean + radius * sin(angle);
+			}
+		}
+	}
+	for(; i < count; i++){
+		values[i] = normal(mean, stddev);
+	}
+}
+
+//--------------------------------------------------
+void ofRandomEngine::fillInSphere(glm::vec3 * points, std::size_t count, float radius){
+	// a vector of 3 normal numbers points in a uniformly distributed
+	// direction, scaling it by the cubic root of a uniform number
+	// distributes the points uniformly in the volume
+	static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 has to be tightly packed");
+	if(count == 0) return;
+	fillNormal(&points[0].x, count * 3);
+	for(std::size_t i = 0; i < count; i++){
+		float length = glm::length(points[i]);
+		if(length > 0){
+			points[i] *= radius * cbrt(uniform()) / length;
+		}
+	}
+}
+
+//--------------------------------------------------
+void ofRandomEngine::fillOnCircle(glm::vec2 * points, std::size_t count, float radius){
+	static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "glm::vec2 has to be tightly packed");
+	if(count == 0) return;
+	// generate the angles in place, in the first half of the array
+	float * angles = &points[0].x;
+	fillUniform(angles, count, 0, TWO_PI);
+	// then expand them backwards so no angle is overwritten before it's used
+	for(std::size_t i = count; i > 0; i--){
+		float angle = angles[i - 1];
+		points[i - 1] = {radius * cos(angle), radius * sin(angle)};
+	}
+}
+
+//--------------------------------------------------
+ofRandomEngine & ofGetRandomEngine(){
+	auto & threadEngine = getThreadRandomEngine();
+	if(threadEngine.generation != seedGeneration.load(std::memory_order_acquire)){
+		std::unique_lock<std::mutex> lock(seedMutex);
+		auto stream = seedOwner == std::this_thread::get_id() ? 0 : threadEngine.stream;
+		threadEngine.engine.seed(currentSeed, stream);
+		threadEngine.generation = seedGeneration.load();
+	}
+	return threadEngine.engine;
+}
+
+namespace of{
+namespace priv{
+	void seedRandomEngines(uint64_t seed, bool deterministic){
+		std::unique_lock<std::mutex> lock(seedMutex);
+		currentSeed = deterministic ? seed : nonDeterministicSeed();
+		seedOwner = std::this_thread::get_id();
+		seedGeneration++;
+	}
+}
+}
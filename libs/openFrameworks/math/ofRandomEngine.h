@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ofConstants.h"
+
+template<typename T>
+class ofPixels_;
+
+/// \brief A fast pseudo random number generator.
+///
+/// ofRandomEngine implements xoshiro128**, a small generator with 128 bits of
+/// state, a period of 2^128 - 1 and much better statistical quality than
+/// `rand()`. It satisfies the C++ UniformRandomBitGenerator requirements so it
+/// can be used with the standard distributions and algorithms like
+/// std::shuffle.
+///
+/// Every thread has its own engine, returned by ofGetRandomEngine(), which is
+/// what ofRandom() and the other random functions use, so they can be called
+/// from any thread without locking. ofSeedRandom() reseeds all of them.
+///
+/// To get reproducible results from several threads create one engine per
+/// task with the same seed and a different stream:
+///
+/// ~~~~{.cpp}
+/// ofRandomEngine engine(42, taskIndex);
+/// engine.fillUniform(values.data(), values.size(), -1, 1);
+/// ~~~~
+///
+/// \sa http://xoshiro.di.unimi.it/
+class ofRandomEngine{
+public:
+	typedef uint32_t result_type;
+
+	/// \brief Creates an engine seeded with a non deterministic value.
+	ofRandomEngine();
+
+	/// \brief Creates an engine with a known seed.
+	///
+	/// Engines created with the same seed and different streams produce
+	/// independent sequences.
+	///
+	/// \param seed The seed for the generator.
+	/// \param stream The stream index, for example the index of a thread or task.
+	ofRandomEngine(uint64_t seed, uint64_t stream = 0);
+
+	/// \brief Reseeds the engine, see ofRandomEngine(uint64_t, uint64_t).
+	void seed(uint64_t seed, uint64_t stream = 0);
+
+	/// \returns The next 32 bit random number.
+	result_type operator()(){
+		const uint32_t result = rotl(state[1] * 5, 7) * 9;
+		const uint32_t t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 11);
+		return result;
+	}
+
+	static constexpr result_type min(){
+		return 0;
+	}
+
+	static constexpr result_type max(){
+		return 0xFFFFFFFFu;
+	}
+
+	/// \returns A random floating point number in the range [0, 1).
+	float uniform(){
+		return ((*this)() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/// \returns A random floating point number in the range [min, max).
+	float uniform(float min, float max);
+
+	/// \returns A normally distributed random number.
+	float normal(float mean = 0, float stddev = 1);
+
+	/// \brief Fills an array with uniformly distributed numbers in the range [min, max).
+	void fillUniform(float * values, std::size_t count, float min = 0, float max = 1);
+
+	/// \brief Fills all the values of some float pixels with uniformly
+	/// distributed numbers in the range [min, max).
+	void fillUniform(ofPixels_<float> & pixels, float min = 0, float max = 1);
+
+	/// \brief Fills an array with normally distributed numbers.
+	void fillNormal(float * values, std::size_t count, float mean = 0, float stddev = 1);
+
+	/// \brief Fills an array with points uniformly distributed inside a sphere.
+	void fillInSphere(glm::vec3 * points, std::size_t count, float radius = 1);
+
+	/// \brief Fills an array with points uniformly distributed on a circle.
+	void fillOnCircle(glm::vec2 * points, std::size_t count, float radius = 1);
+
+private:
+	static uint32_t rotl(uint32_t x, int k){
+		return (x << k) | (x >> (32 - k));
+	}
+
+	uint32_t state[4];
+};
+
+/// \brief Get the random engine for the calling thread.
+///
+/// Each thread gets its own engine the first time it calls this or any of
+/// the ofRandom functions. The thread that calls ofSeedRandom(int) gets a
+/// reproducible sequence, other threads get different sequences derived from
+/// the same seed.
+///
+/// \returns The random engine of the calling thread.
+ofRandomEngine & ofGetRandomEngine();
+
+namespace of{
+namespace priv{
+	void seedRandomEngines(uint64_t seed, bool deterministic);
+}
+}
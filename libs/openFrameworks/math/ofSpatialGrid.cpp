@@ -0,0 +1,279 @@
+#include "ofSpatialGrid.h"
+#include "ofLog.h"
+#include "ofTaskPool.h"
+
+using namespace std;
+
+namespace{
+	const uint32_t none = ~0u;
+
+	const size_t minBuckets = 16;
+
+	// below this many points computing the cells in the calling thread is
+	// faster than splitting the work
+	const size_t minPointsPerBlock = 1 << 16;
+
+	// cells are clamped to this range so converting huge coordinates to
+	// int is defined and iterating over cells never overflows, points out
+	// of it share the cells at the border
+	const float maxCellCoord = float(1 << 30);
+
+	size_t nextPowerOfTwo(size_t n){
+		size_t power = minBuckets;
+		while(power < n){
+			power *= 2;
+		}
+		return power;
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+ofSpatialGrid_<VecType>::ofSpatialGrid_(float cellSize)
+:cellSize(cellSize)
+,heads(minBuckets, none)
+,count(0){
+
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::setCellSize(float newCellSize){
+	if(newCellSize <= 0){
+		ofLogError("ofSpatialGrid") << "setCellSize(): the cell size has to be bigger than 0";
+		return;
+	}
+	cellSize = newCellSize;
+	for(size_t i = 0; i < positions.size(); i++){
+		cells[i] = getCell(positions[i]);
+	}
+	rehash(heads.size());
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+float ofSpatialGrid_<VecType>::getCellSize() const{
+	return cellSize;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::build(const vector<VecType> & points){
+	positions = points;
+	count = points.size();
+	cells.resize(count);
+	buckets.assign(count, none);
+	next.resize(count);
+	prev.resize(count);
+	freeIndices.clear();
+
+	// computing the cells is the expensive part, linking them is cheap
+	ofParallelForRange(0, count, [this](size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			cells[i] = getCell(positions[i]);
+		}
+	}, minPointsPerBlock);
+
+	heads.assign(nextPowerOfTwo(count), none);
+	for(size_t i = 0; i < count; i++){
+		link(i);
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+size_t ofSpatialGrid_<VecType>::add(const VecType & point){
+	uint32_t index;
+	if(!freeIndices.empty()){
+		index = freeIndices.back();
+		freeIndices.pop_back();
+		positions[index] = point;
+		cells[index] = getCell(point);
+	}else{
+		index = positions.size();
+		positions.push_back(point);
+		cells.push_back(getCell(point));
+		buckets.push_back(none);
+		next.push_back(none);
+		prev.push_back(none);
+	}
+	count++;
+	if(count > heads.size()){
+		rehash(heads.size() * 2);
+	}
+	link(index);
+	return index;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::update(size_t index, const VecType & position){
+	if(!contains(index)){
+		ofLogError("ofSpatialGrid") << "update(): there's no point with index " << index;
+		return;
+	}
+	positions[index] = position;
+	auto cell = getCell(position);
+	if(cell != cells[index]){
+		unlink(index);
+		cells[index] = cell;
+		link(index);
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::remove(size_t index){
+	if(!contains(index)){
+		ofLogError("ofSpatialGrid") << "remove(): there's no point with index " << index;
+		return;
+	}
+	unlink(index);
+	freeIndices.push_back(index);
+	count--;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::clear(){
+	positions.clear();
+	cells.clear();
+	buckets.clear();
+	next.clear();
+	prev.clear();
+	freeIndices.clear();
+	heads.assign(minBuckets, none);
+	count = 0;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+size_t ofSpatialGrid_<VecType>::size() const{
+	return count;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+bool ofSpatialGrid_<VecType>::empty() const{
+	return count == 0;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+bool ofSpatialGrid_<VecType>::contains(size_t index) const{
+	return index < buckets.size() && buckets[index] != none;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+const VecType & ofSpatialGrid_<VecType>::getPosition(size_t index) const{
+	return positions[index];
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::findInRadius(const VecType & center, float radius, vector<size_t> & indices) const{
+	indices.clear();
+	if(!(radius >= 0)){
+		return;
+	}
+	const float radiusSquared = radius * radius;
+	auto minCell = getCell(center - radius);
+	auto maxCell = getCell(center + radius);
+
+	// with a radius much bigger than the cells checking every point is
+	// faster than visiting the cells
+	uint64_t numCells = 1;
+	for(int i = 0; i < 3; i++){
+		numCells *= uint64_t(int64_t(maxCell[i]) - minCell[i] + 1);
+		if(numCells > count){
+			for(size_t j = 0; j < positions.size(); j++){
+				if(buckets[j] != none){
+					VecType d = positions[j] - center;
+					if(glm::dot(d, d) <= radiusSquared){
+						indices.push_back(j);
+					}
+				}
+			}
+			return;
+		}
+	}
+
+	glm::ivec3 cell;
+	for(cell.z = minCell.z; cell.z <= maxCell.z; cell.z++){
+		for(cell.y = minCell.y; cell.y <= maxCell.y; cell.y++){
+			for(cell.x = minCell.x; cell.x <= maxCell.x; cell.x++){
+				// different cells can share a bucket, only the points in
+				// this cell are checked so none is found twice
+				for(uint32_t i = heads[getBucket(cell)]; i != none; i = next[i]){
+					if(cells[i] == cell){
+						VecType d = positions[i] - center;
+						if(glm::dot(d, d) <= radiusSquared){
+							indices.push_back(i);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+glm::ivec3 ofSpatialGrid_<VecType>::getCell(const VecType & position) const{
+	glm::ivec3 cell(0);
+	for(int i = 0; i < VecType::length(); i++){
+		// written so NaN ends in a valid cell too
+		float coord = floor(position[i] / cellSize);
+		cell[i] = coord < maxCellCoord ? (coord > -maxCellCoord ? int(coord) : -int(maxCellCoord)) : int(maxCellCoord);
+	}
+	return cell;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+uint32_t ofSpatialGrid_<VecType>::getBucket(const glm::ivec3 & cell) const{
+	uint32_t hash = uint32_t(cell.x) * 73856093u ^ uint32_t(cell.y) * 19349663u ^ uint32_t(cell.z) * 83492791u;
+	return hash & (heads.size() - 1);
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::link(uint32_t index){
+	uint32_t bucket = getBucket(cells[index]);
+	buckets[index] = bucket;
+	prev[index] = none;
+	next[index] = heads[bucket];
+	if(heads[bucket] != none){
+		prev[heads[bucket]] = index;
+	}
+	heads[bucket] = index;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::unlink(uint32_t index){
+	if(prev[index] != none){
+		next[prev[index]] = next[index];
+	}else{
+		heads[buckets[index]] = next[index];
+	}
+	if(next[index] != none){
+		prev[next[index]] = prev[index];
+	}
+	buckets[index] = none;
+}
+
+//----------------------------------------------------------
+template<typename VecType>
+void ofSpatialGrid_<VecType>::rehash(size_t numBuckets){
+	heads.assign(numBuckets, none);
+	for(size_t i = 0; i < buckets.size(); i++){
+		if(buckets[i] != none){
+			link(i);
+		}
+	}
+}
+
+template class ofSpatialGrid_<glm::vec2>;
+template class ofSpatialGrid_<glm::vec3>;
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ofConstants.h"
+
+/// \brief A uniform grid to find neighbours among points that move.
+///
+/// The space is divided in cells of the same size and every point is stored
+/// in the cell that contains it, so finding the points around a position
+/// only needs to look at the cells that overlap the search radius. Moving a
+/// point only changes the cell it's stored in, which makes the grid a good
+/// fit for particle systems where every point moves every frame:
+///
+/// ~~~~{.cpp}
+/// ofSpatialGrid3d grid(radius);
+/// grid.build(positions);
+///
+/// // update()
+/// for(std::size_t i = 0; i < positions.size(); i++){
+/// 	grid.update(i, positions[i]);
+/// }
+/// grid.findInRadius(positions[0], radius, neighbours);
+/// ~~~~
+///
+/// Searches are fastest when the radius is close to the cell size. Cells are
+/// stored in a hash table so the grid has no bounds and only uses memory
+/// for the cells that contain points.
+template<typename VecType>
+class ofSpatialGrid_{
+public:
+	/// \param cellSize The size of the side of every cell.
+	ofSpatialGrid_(float cellSize = 10);
+
+	/// \brief Change the size of the cells, redistributing every point.
+	void setCellSize(float cellSize);
+	float getCellSize() const;
+
+	/// \brief Build the grid for a set of points, discarding the previous
+	/// ones. Every point gets its index in the vector.
+	void build(const std::vector<VecType> & points);
+
+	/// \brief Add a point to the grid.
+	/// \returns The index of the new point. Indices of removed points are
+	/// reused.
+	std::size_t add(const VecType & point);
+
+	/// \brief Move a point to a new position.
+	void update(std::size_t index, const VecType & position);
+
+	/// \brief Remove a point from the grid, the indices of the rest of the
+	/// points don't change.
+	void remove(std::size_t index);
+
+	void clear();
+
+	/// \returns The number of points in the grid.
+	std::size_t size() const;
+	bool empty() const;
+
+	/// \returns true if index corresponds to a point in the grid, false if
+	/// it was removed or never added.
+	bool contains(std::size_t index) const;
+
+	const VecType & getPosition(std::size_t index) const;
+
+	/// \brief Find every point closer to a position than a radius.
+	/// \param indices Filled with the indices of the points found, in no
+	/// particular order.
+	void findInRadius(const VecType & center, float radius, std::vector<std::size_t> & indices) const;
+
+private:
+	glm::ivec3 getCell(const VecType & position) const;
+	uint32_t getBucket(const glm::ivec3 & cell) const;
+	void link(uint32_t index);
+	void unlink(uint32_t index);
+	void rehash(std::size_t numBuckets);
+
+	float cellSize;
+	std::vector<VecType> positions;
+	std::vector<glm::ivec3> cells;
+	// every bucket of the hash table is a double linked list of points
+	std::vector<uint32_t> buckets;
+	std::vector<uint32_t> next;
+	std::vector<uint32_t> prev;
+	std::vector<uint32_t> heads;
+	std::vector<uint32_t> freeIndices;
+	std::size_t count;
+};
+
+typedef ofSpatialGrid_<glm::vec2> ofSpatialGrid2d;
+typedef ofSpatialGrid_<glm::vec3> ofSpatialGrid3d;
@@ -15,8 +15,10 @@
 #include "ofThread.h"
 #include "ofThreadChannel.h"
 #endif
+#include "ofTaskPool.h"
 
 #include "ofFpsCounter.h"
+#include "ofProfiler.h"
 #include "ofJson.h"
 #include "ofXml.h"
 
@@ -33,6 +35,9 @@
 //--------------------------
 // math
 #include "ofMath.h"
+#include "ofRandomEngine.h"
+#include "ofKdTree.h"
+#include "ofSpatialGrid.h"
 #include "ofVectorMath.h"
 
 //--------------------------
@@ -49,6 +54,8 @@
 #include "ofGLUtils.h"
 #include "ofLight.h"
 #include "ofMaterial.h"
+#include "ofPixelsReadback.h"
+#include "ofPixelsUpload.h"
 #include "ofShader.h"
 #include "ofTexture.h"
 #include "ofVbo.h"
@@ -64,10 +71,14 @@
 	#include "ofCairoRenderer.h"
 #endif
 #include "ofGraphics.h"
+#include "ofColorLut.h"
+#include "ofPixelKernels.h"
 #include "ofImage.h"
+#include "ofParticleSystem.h"
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
+#include "ofRecordingRenderer.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
@@ -109,6 +120,7 @@
 #include "ofCamera.h"
 #include "ofEasyCam.h"
 #include "ofMesh.h"
+#include "ofMeshBvh.h"
 #include "ofNode.h"
 
 //--------------------------
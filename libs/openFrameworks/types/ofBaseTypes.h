@@ -1902,6 +1902,17 @@ public:
 	virtual void setLightPosition(int lightIndex, const glm::vec4 & position)=0;
 	virtual void setLightSpotDirection(int lightIndex, const glm::vec4 & direction)=0;
 
+	// bitmap strings, renderers that don't batch them draw every string
+	// right away
+	virtual void setBitmapStringBatching(bool batching){}
+	virtual bool isBitmapStringBatching() const{ return false; }
+	virtual void flushBitmapStrings(){}
+
+	// shapes, renderers that don't batch them draw every shape right away
+	virtual void setShapeBatching(bool batching){}
+	virtual bool isShapeBatching() const{ return false; }
+	virtual void flushShapes(){}
+
 	virtual int getGLVersionMajor()=0;
 	virtual int getGLVersionMinor()=0;
 
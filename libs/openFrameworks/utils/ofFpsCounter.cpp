@@ -1,4 +1,5 @@
 #include "ofFpsCounter.h"
+#include <cmath>
 
 ofFpsCounter::ofFpsCounter()
 :nFrameCount(0)
@@ -21,7 +22,7 @@ ofFpsCounter::ofFpsCounter(double targetFPS)
 void ofFpsCounter::newFrame(){
 	auto now = ofGetCurrentTime();
 	update(now.getAsSeconds());
-	timestamps.push(now.getAsSeconds());
+	timestamps.push_back(now.getAsSeconds());
 
 	lastFrameTime = now - then;
 	uint64_t filtered = filteredTime.count() * filterAlpha + lastFrameTime.count() * (1-filterAlpha);
@@ -37,7 +38,7 @@ void ofFpsCounter::update(){
 
 void ofFpsCounter::update(double now){
 	while(!timestamps.empty() && timestamps.front() + 2 < now){
-		timestamps.pop();
+		timestamps.pop_front();
 	}
 
 	auto diff = 0.0;
@@ -75,6 +76,24 @@ double ofFpsCounter::getLastFrameFilteredSecs() const{
 	return std::chrono::duration<double>(filteredTime).count();
 }
 
+double ofFpsCounter::getFrameTimeJitterSecs() const{
+	if(timestamps.size() < 3){
+		return 0;
+	}
+	auto numFrames = timestamps.size() - 1;
+	auto mean = (timestamps.back() - timestamps.front()) / numFrames;
+	auto variance = 0.0;
+	for(size_t i = 1; i < timestamps.size(); i++){
+		auto diff = timestamps[i] - timestamps[i-1] - mean;
+		variance += diff * diff;
+	}
+	return sqrt(variance / numFrames);
+}
+
 void ofFpsCounter::setFilterAlpha(float alpha){
 	filterAlpha = alpha;
 }
+
+float ofFpsCounter::getFilterAlpha() const{
+	return filterAlpha;
+}
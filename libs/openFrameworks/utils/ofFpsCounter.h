@@ -2,7 +2,7 @@
 
 #include "ofConstants.h"
 #include "ofUtils.h"
-#include <queue>
+#include <deque>
 
 class ofFpsCounter {
 public:
@@ -22,7 +22,12 @@ public:
 	double getLastFrameSecs() const;
 	uint64_t getLastFrameFilteredNanos() const;
 	double getLastFrameFilteredSecs() const;
+
+	/// \brief Standard deviation of the time between frames in the last
+	/// two seconds, a measure of how regular the frame rate is.
+	double getFrameTimeJitterSecs() const;
 	void setFilterAlpha(float alpha);
+	float getFilterAlpha() const;
 
 private:
 	void update(double now);
@@ -32,5 +37,5 @@ private:
 	std::chrono::nanoseconds lastFrameTime;
 	std::chrono::nanoseconds filteredTime;
 	double filterAlpha;
-	std::queue<double> timestamps;
+	std::deque<double> timestamps;
 };
@@ -0,0 +1,432 @@
+#include "ofProfiler.h"
+#include "ofLog.h"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace{
+	// small index of the calling thread, used to pick a counter slot and as
+	// the thread id in traces
+	size_t getThreadIndex(){
+	#if HAS_TLS
+		static atomic<size_t> nextIndex(0);
+		thread_local size_t index = nextIndex++;
+		return index;
+	#else
+		return std::hash<std::thread::id>()(this_thread::get_id());
+	#endif
+	}
+
+	void atomicAdd(atomic<double> & value, double add){
+		double current = value.load(memory_order_relaxed);
+		while(!value.compare_exchange_weak(current, current + add, memory_order_relaxed)){}
+	}
+
+	void atomicMin(atomic<double> & value, double candidate){
+		double current = value.load(memory_order_relaxed);
+		while(candidate < current && !value.compare_exchange_weak(current, candidate, memory_order_relaxed)){}
+	}
+
+	void atomicMax(atomic<double> & value, double candidate){
+		double current = value.load(memory_order_relaxed);
+		while(candidate > current && !value.compare_exchange_weak(current, candidate, memory_order_relaxed)){}
+	}
+
+	string escapeJson(const string & str){
+		string escaped;
+		escaped.reserve(str.size());
+		for(char c: str){
+			if(c == '"' || c == '\\'){
+				escaped += '\\';
+				escaped += c;
+			}else if(static_cast<unsigned char>(c) < 0x20){
+				char code[7];
+				snprintf(code, sizeof(code), "\\u%04x", c);
+				escaped += code;
+			}else{
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+
+	string escapeCsv(const string & str){
+		if(str.find_first_of(",\"\n\r") == string::npos){
+			return str;
+		}
+		string escaped = "\"";
+		for(char c: str){
+			if(c == '"'){
+				escaped += '"';
+			}
+			escaped += c;
+		}
+		return escaped + "\"";
+	}
+}
+
+//----------------------------------------------------------
+ofHistogram::ofHistogram(double minValue, double maxValue, size_t bucketsPerDecade)
+:minValue(std::max(minValue, numeric_limits<double>::min()))
+,maxValue(std::max(maxValue, this->minValue))
+,bucketsPerDecade(std::max<size_t>(bucketsPerDecade, 1))
+,numBuckets(size_t(ceil(log10(this->maxValue / this->minValue) * this->bucketsPerDecade)) + 2)
+,buckets(new atomic<uint64_t>[numBuckets]){
+	reset();
+}
+
+//----------------------------------------------------------
+size_t ofHistogram::getBucket(double value) const{
+	if(!(value >= minValue)){
+		return 0;
+	}
+	if(value >= maxValue){
+		return numBuckets - 1;
+	}
+	auto bucket = size_t(log10(value / minValue) * bucketsPerDecade) + 1;
+	return std::min(bucket, numBuckets - 2);
+}
+
+//----------------------------------------------------------
+void ofHistogram::add(double value){
+	buckets[getBucket(value)].fetch_add(1, memory_order_relaxed);
+	atomicAdd(sum, value);
+	atomicMin(min, value);
+	atomicMax(max, value);
+	count.fetch_add(1, memory_order_relaxed);
+}
+
+//----------------------------------------------------------
+void ofHistogram::reset(){
+	for(size_t i = 0; i < numBuckets; i++){
+		buckets[i] = 0;
+	}
+	count = 0;
+	sum = 0;
+	min = numeric_limits<double>::max();
+	max = numeric_limits<double>::lowest();
+}
+
+//----------------------------------------------------------
+uint64_t ofHistogram::getCount() const{
+	return count;
+}
+
+//----------------------------------------------------------
+double ofHistogram::getMin() const{
+	return count ? min.load() : 0;
+}
+
+//----------------------------------------------------------
+double ofHistogram::getMax() const{
+	return count ? max.load() : 0;
+}
+
+//----------------------------------------------------------
+double ofHistogram::getMean() const{
+	auto n = count.load();
+	return n ? sum / n : 0;
+}
+
+//----------------------------------------------------------
+double ofHistogram::getPercentile(double percentile) const{
+	// values can be added while reading so the buckets are copied first
+	vector<uint64_t> counts(numBuckets);
+	uint64_t total = 0;
+	for(size_t i = 0; i < numBuckets; i++){
+		counts[i] = buckets[i];
+		total += counts[i];
+	}
+	if(total == 0){
+		return 0;
+	}
+	double observedMin = getMin();
+	double observedMax = getMax();
+	double rank = std::min(std::max(percentile, 0.0), 1.0) * total;
+	double accumulated = 0;
+	for(size_t i = 0; i < numBuckets; i++){
+		if(counts[i] == 0 || accumulated + counts[i] < rank){
+			accumulated += counts[i];
+			continue;
+		}
+		double lower = std::max(getBucketLowerBound(i), observedMin);
+		double upper = i + 1 < numBuckets ? getBucketLowerBound(i + 1) : observedMax;
+		upper = std::min(upper, observedMax);
+		double fraction = (rank - accumulated) / counts[i];
+		return lower + (upper - lower) * fraction;
+	}
+	return observedMax;
+}
+
+//----------------------------------------------------------
+size_t ofHistogram::getNumBuckets() const{
+	return numBuckets;
+}
+
+//----------------------------------------------------------
+uint64_t ofHistogram::getBucketCount(size_t bucket) const{
+	return bucket < numBuckets ? buckets[bucket].load() : 0;
+}
+
+//----------------------------------------------------------
+double ofHistogram::getBucketLowerBound(size_t bucket) const{
+	if(bucket == 0){
+		return numeric_limits<double>::lowest();
+	}
+	if(bucket >= numBuckets - 1){
+		return maxValue;
+	}
+	return minValue * pow(10.0, (bucket - 1) / bucketsPerDecade);
+}
+
+//----------------------------------------------------------
+ofCounter::ofCounter(){
+	reset();
+}
+
+//----------------------------------------------------------
+void ofCounter::add(int64_t value){
+	slots[getThreadIndex() % slots.size()].value.fetch_add(value, memory_order_relaxed);
+}
+
+//----------------------------------------------------------
+int64_t ofCounter::get() const{
+	int64_t total = 0;
+	for(auto & slot: slots){
+		total += slot.value.load(memory_order_relaxed);
+	}
+	return total;
+}
+
+//----------------------------------------------------------
+void ofCounter::reset(){
+	for(auto & slot: slots){
+		slot.value = 0;
+	}
+}
+
+//----------------------------------------------------------
+ofProfiler::Section::Section(ofProfiler & profiler, const string & name)
+:profiler(profiler)
+,name(name){
+
+}
+
+//----------------------------------------------------------
+const string & ofProfiler::Section::getName() const{
+	return name;
+}
+
+//----------------------------------------------------------
+ofHistogram & ofProfiler::Section::getHistogram(){
+	return histogram;
+}
+
+//----------------------------------------------------------
+const ofHistogram & ofProfiler::Section::getHistogram() const{
+	return histogram;
+}
+
+//----------------------------------------------------------
+void ofProfiler::Section::add(chrono::nanoseconds duration){
+	if(profiler.isEnabled()){
+		auto end = chrono::steady_clock::now();
+		profiler.record(*this, end - chrono::duration_cast<chrono::steady_clock::duration>(duration), end);
+	}
+}
+
+//----------------------------------------------------------
+ofProfiler::ofProfiler()
+:enabled(true)
+,tracing(false)
+,maxTraceEvents(0)
+,droppedTraceEvents(0)
+,epoch(chrono::steady_clock::now()){
+
+}
+
+//----------------------------------------------------------
+ofProfiler::Section & ofProfiler::getSection(const string & name){
+	lock_guard<mutex> lock(sectionsMutex);
+	auto & section = sections[name];
+	if(!section){
+		section.reset(new Section(*this, name));
+	}
+	return *section;
+}
+
+//----------------------------------------------------------
+ofCounter & ofProfiler::getCounter(const string & name){
+	lock_guard<mutex> lock(sectionsMutex);
+	auto & counter = counters[name];
+	if(!counter){
+		counter.reset(new ofCounter);
+	}
+	return *counter;
+}
+
+//----------------------------------------------------------
+vector<string> ofProfiler::getSectionNames() const{
+	lock_guard<mutex> lock(sectionsMutex);
+	vector<string> names;
+	for(auto & section: sections){
+		names.push_back(section.first);
+	}
+	return names;
+}
+
+//----------------------------------------------------------
+vector<string> ofProfiler::getCounterNames() const{
+	lock_guard<mutex> lock(sectionsMutex);
+	vector<string> names;
+	for(auto & counter: counters){
+		names.push_back(counter.first);
+	}
+	return names;
+}
+
+//----------------------------------------------------------
+void ofProfiler::setEnabled(bool _enabled){
+	enabled = _enabled;
+}
+
+//----------------------------------------------------------
+bool ofProfiler::isEnabled() const{
+	return enabled;
+}
+
+//----------------------------------------------------------
+void ofProfiler::startTrace(size_t maxEvents){
+	lock_guard<mutex> lock(traceMutex);
+	trace.clear();
+	maxTraceEvents = maxEvents;
+	droppedTraceEvents = 0;
+	tracing = true;
+}
+
+//----------------------------------------------------------
+void ofProfiler::stopTrace(){
+	tracing = false;
+	lock_guard<mutex> lock(traceMutex);
+	if(droppedTraceEvents > 0){
+		ofLogWarning("ofProfiler") << "stopTrace(): " << droppedTraceEvents << " events were dropped after reaching the maximum of " << maxTraceEvents;
+	}
+}
+
+//----------------------------------------------------------
+bool ofProfiler::isTracing() const{
+	return tracing;
+}
+
+//----------------------------------------------------------
+void ofProfiler::record(Section & section, chrono::steady_clock::time_point start, chrono::steady_clock::time_point end){
+	section.histogram.add(chrono::duration<double>(end - start).count());
+	if(tracing){
+		lock_guard<mutex> lock(traceMutex);
+		if(trace.size() < maxTraceEvents){
+			trace.push_back({&section, getThreadIndex(), start - epoch, end - start});
+		}else{
+			droppedTraceEvents++;
+		}
+	}
+}
+
+//----------------------------------------------------------
+bool ofProfiler::saveTrace(const std::filesystem::path & path) const{
+	ofFile file(path, ofFile::WriteOnly);
+	if(!file.is_open()){
+		ofLogError("ofProfiler") << "saveTrace(): couldn't open " << path.string();
+		return false;
+	}
+	lock_guard<mutex> lock(traceMutex);
+	file << "{\"traceEvents\":[";
+	char numbers[128];
+	for(size_t i = 0; i < trace.size(); i++){
+		auto & event = trace[i];
+		// chrome traces are in microseconds
+		snprintf(numbers, sizeof(numbers), "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%llu",
+			event.start.count() / 1000.0,
+			event.duration.count() / 1000.0,
+			(unsigned long long)event.thread);
+		file << (i == 0 ? "\n" : ",\n")
+			 << "{\"name\":\"" << escapeJson(event.section->getName()) << "\",\"ph\":\"X\"," << numbers << "}";
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return !file.fail();
+}
+
+//----------------------------------------------------------
+bool ofProfiler::saveCsv(const std::filesystem::path & path) const{
+	ofFile file(path, ofFile::WriteOnly);
+	if(!file.is_open()){
+		ofLogError("ofProfiler") << "saveCsv(): couldn't open " << path.string();
+		return false;
+	}
+	lock_guard<mutex> lock(sectionsMutex);
+	file << "type,name,count,mean,min,p50,p90,p99,max\n";
+	char numbers[160];
+	for(auto & section: sections){
+		auto & histogram = section.second->getHistogram();
+		snprintf(numbers, sizeof(numbers), "%llu,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g",
+			(unsigned long long)histogram.getCount(),
+			histogram.getMean(),
+			histogram.getMin(),
+			histogram.getPercentile(0.5),
+			histogram.getPercentile(0.9),
+			histogram.getPercentile(0.99),
+			histogram.getMax());
+		file << "section," << escapeCsv(section.first) << "," << numbers << "\n";
+	}
+	for(auto & counter: counters){
+		file << "counter," << escapeCsv(counter.first) << "," << counter.second->get() << ",,,,,,\n";
+	}
+	return !file.fail();
+}
+
+//----------------------------------------------------------
+void ofProfiler::reset(){
+	{
+		lock_guard<mutex> lock(sectionsMutex);
+		for(auto & section: sections){
+			section.second->getHistogram().reset();
+		}
+		for(auto & counter: counters){
+			counter.second->reset();
+		}
+	}
+	lock_guard<mutex> lock(traceMutex);
+	trace.clear();
+	droppedTraceEvents = 0;
+}
+
+//----------------------------------------------------------
+ofProfiler & ofGetProfiler(){
+	// never destroyed so it can still be used while other static objects
+	// are destroyed on exit
+	static ofProfiler * profiler = new ofProfiler;
+	return *profiler;
+}
+
+//----------------------------------------------------------
+ofScopedTimer::ofScopedTimer(ofProfiler::Section & section)
+:section(section.profiler.isEnabled() ? &section : nullptr){
+	if(this->section){
+		start = chrono::steady_clock::now();
+	}
+}
+
+//----------------------------------------------------------
+ofScopedTimer::ofScopedTimer(const string & name)
+:ofScopedTimer(ofGetProfiler().getSection(name)){
+
+}
+
+//----------------------------------------------------------
+ofScopedTimer::~ofScopedTimer(){
+	if(section){
+		section->profiler.record(*section, start, chrono::steady_clock::now());
+	}
+}
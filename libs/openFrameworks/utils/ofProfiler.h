@@ -0,0 +1,236 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// \brief Distribution of a series of values in fixed buckets.
+///
+/// The buckets grow logarithmically between a minimum and a maximum value,
+/// so every bucket covers the same relative range, which suits durations
+/// that can go from microseconds to seconds. Values outside that range go
+/// to two extra buckets for the lower and higher ones.
+///
+/// Adding values is lock free and can be done from several threads at the
+/// same time.
+class ofHistogram{
+public:
+	/// \param minValue Lower bound of the first bucket.
+	/// \param maxValue Upper bound of the last bucket.
+	/// \param bucketsPerDecade Number of buckets between a value and ten
+	/// times that value, 20 gives a resolution of about 12%.
+	ofHistogram(double minValue = 1e-6, double maxValue = 10, std::size_t bucketsPerDecade = 20);
+
+	ofHistogram(const ofHistogram &) = delete;
+	ofHistogram & operator=(const ofHistogram &) = delete;
+
+	void add(double value);
+	void reset();
+
+	std::uint64_t getCount() const;
+	double getMin() const;
+	double getMax() const;
+	double getMean() const;
+
+	/// \brief Approximate value below which a fraction of the values are.
+	///
+	/// The value is interpolated inside the bucket where that fraction is
+	/// reached, so its precision is the width of the buckets.
+	/// \param percentile Fraction between 0 and 1, 0.99 for the 99th
+	/// percentile.
+	double getPercentile(double percentile) const;
+
+	/// \returns The number of buckets including the two for values out of
+	/// range.
+	std::size_t getNumBuckets() const;
+	std::uint64_t getBucketCount(std::size_t bucket) const;
+	double getBucketLowerBound(std::size_t bucket) const;
+
+private:
+	std::size_t getBucket(double value) const;
+
+	double minValue;
+	double maxValue;
+	double bucketsPerDecade;
+	std::size_t numBuckets;
+	std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;
+	std::atomic<std::uint64_t> count;
+	std::atomic<double> sum;
+	std::atomic<double> min;
+	std::atomic<double> max;
+};
+
+/// \brief A counter that many threads can increment at the same time.
+///
+/// Every thread adds to one of a few slots in separate cache lines so
+/// threads don't compete for the same memory, and reading the counter adds
+/// all the slots together. Incrementing is lock free and very cheap, reading
+/// is slower.
+class ofCounter{
+public:
+	ofCounter();
+
+	ofCounter(const ofCounter &) = delete;
+	ofCounter & operator=(const ofCounter &) = delete;
+
+	void add(std::int64_t value = 1);
+	std::int64_t get() const;
+	void reset();
+
+private:
+	struct Slot{
+		std::atomic<std::int64_t> value;
+		char padding[64 - sizeof(std::atomic<std::int64_t>)];
+	};
+	std::array<Slot, 16> slots;
+};
+
+/// \brief Collects timings of named sections of code and counters.
+///
+/// ofGetProfiler() returns the one used by the core, which already times
+/// these sections of every frame:
+/// - update: the update event.
+/// - draw: the draw event.
+/// - wait: waiting for the next frame when a frame rate is set.
+/// - swap: showing the frame, which can block with vertical sync.
+/// - events: processing mouse, keyboard and window events.
+/// - frame: the whole time between frames.
+///
+/// and counts the tasks run by ofGetTaskPool() in the counter tasks.
+///
+/// Applications can time their own code with ofScopedTimer:
+///
+/// ~~~~{.cpp}
+/// void ofApp::update(){
+/// 	ofScopedTimer timer("physics");
+/// 	world.update();
+/// }
+///
+/// // later
+/// auto & physics = ofGetProfiler().getSection("physics").getHistogram();
+/// ofLogNotice() << "physics p99: " << physics.getPercentile(0.99) * 1000 << "ms";
+/// ~~~~
+///
+/// Every section keeps a histogram of its durations in seconds. While
+/// tracing, every measurement is also recorded with the time it happened
+/// and the thread that made it, to be saved with saveTrace() and opened in
+/// chrome://tracing or Perfetto.
+///
+/// Sections and counters are the same for all the windows, in applications
+/// with several windows the timings of the core mix all of them.
+class ofProfiler{
+public:
+	/// \brief A named section of code with a histogram of its durations.
+	class Section{
+	public:
+		const std::string & getName() const;
+		ofHistogram & getHistogram();
+		const ofHistogram & getHistogram() const;
+
+		/// \brief Add a duration measured without ofScopedTimer.
+		///
+		/// While tracing it's recorded as ending at the moment it's added.
+		void add(std::chrono::nanoseconds duration);
+
+	private:
+		friend class ofProfiler;
+		friend class ofScopedTimer;
+		Section(ofProfiler & profiler, const std::string & name);
+		ofProfiler & profiler;
+		std::string name;
+		ofHistogram histogram;
+	};
+
+	ofProfiler();
+
+	ofProfiler(const ofProfiler &) = delete;
+	ofProfiler & operator=(const ofProfiler &) = delete;
+
+	/// \brief Get a section by its name, creating it if it doesn't exist.
+	///
+	/// Sections are never destroyed so the reference can be kept to avoid
+	/// looking the name up every time, which needs a lock.
+	Section & getSection(const std::string & name);
+
+	/// \brief Get a counter by its name, creating it if it doesn't exist.
+	///
+	/// Like sections, counters are never destroyed.
+	ofCounter & getCounter(const std::string & name);
+
+	std::vector<std::string> getSectionNames() const;
+	std::vector<std::string> getCounterNames() const;
+
+	/// \brief Enable or disable measuring, enabled by default.
+	///
+	/// When disabled ofScopedTimer doesn't even read the clock.
+	void setEnabled(bool enabled);
+	bool isEnabled() const;
+
+	/// \brief Start recording every measurement of every section.
+	/// \param maxEvents Measurements after this many are dropped, so a
+	/// trace left running doesn't use all the memory.
+	void startTrace(std::size_t maxEvents = 1 << 20);
+	void stopTrace();
+	bool isTracing() const;
+
+	/// \brief Save the recorded trace as Chrome trace event JSON.
+	bool saveTrace(const std::filesystem::path & path) const;
+
+	/// \brief Save the statistics of every section and the value of every
+	/// counter as CSV, with durations in seconds.
+	bool saveCsv(const std::filesystem::path & path) const;
+
+	/// \brief Clear the histograms, counters and the recorded trace.
+	void reset();
+
+	/// \brief Record a measurement of a section, used by ofScopedTimer.
+	void record(Section & section, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+private:
+	struct TraceEvent{
+		const Section * section;
+		std::size_t thread;
+		std::chrono::nanoseconds start;
+		std::chrono::nanoseconds duration;
+	};
+
+	mutable std::mutex sectionsMutex;
+	std::map<std::string, std::unique_ptr<Section>> sections;
+	std::map<std::string, std::unique_ptr<ofCounter>> counters;
+	std::atomic<bool> enabled;
+	std::atomic<bool> tracing;
+	mutable std::mutex traceMutex;
+	std::vector<TraceEvent> trace;
+	std::size_t maxTraceEvents;
+	std::size_t droppedTraceEvents;
+	std::chrono::steady_clock::time_point epoch;
+};
+
+/// \returns The profiler used by the core, never destroyed.
+ofProfiler & ofGetProfiler();
+
+/// \brief Measures the time since it's created until it goes out of scope
+/// and records it in a section of a profiler.
+class ofScopedTimer{
+public:
+	/// \brief Time a section, the fastest way when the section is kept.
+	ofScopedTimer(ofProfiler::Section & section);
+
+	/// \brief Time the section with this name in ofGetProfiler().
+	ofScopedTimer(const std::string & name);
+
+	~ofScopedTimer();
+
+	ofScopedTimer(const ofScopedTimer &) = delete;
+	ofScopedTimer & operator=(const ofScopedTimer &) = delete;
+
+private:
+	ofProfiler::Section * section;
+	std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	#define OF_HAS_STD_STRING_VIEW 1
+	#include <string_view>
+#endif
+
+#ifdef OF_HAS_STD_STRING_VIEW
+
+/// \brief A reference to a range of characters that doesn't own them.
+///
+/// When compiling with C++17 this is std::string_view, otherwise a minimal
+/// class with the same interface for the functions that use it.
+using ofStringView = std::string_view;
+
+#else
+
+/// \brief A reference to a range of characters that doesn't own them.
+///
+/// Parsing a view of a part of a string avoids copying that part to a new
+/// string. The characters have to stay valid while the view is used, so a
+/// view of a temporary string can't be stored.
+///
+/// When compiling with C++17 this is std::string_view, otherwise this class
+/// which implements the part of its interface that the string utilities
+/// need.
+class ofStringView{
+public:
+	typedef char value_type;
+	typedef const char * const_iterator;
+	typedef const char * iterator;
+	static const std::size_t npos = std::string::npos;
+
+	ofStringView()
+	:ptr(nullptr)
+	,count(0){}
+
+	ofStringView(const char * str)
+	:ptr(str)
+	,count(str ? std::strlen(str) : 0){}
+
+	ofStringView(const char * str, std::size_t count)
+	:ptr(str)
+	,count(count){}
+
+	ofStringView(const std::string & str)
+	:ptr(str.data())
+	,count(str.size()){}
+
+	operator std::string() const{
+		return std::string(ptr, count);
+	}
+
+	const char * data() const{
+		return ptr;
+	}
+
+	std::size_t size() const{
+		return count;
+	}
+
+	std::size_t length() const{
+		return count;
+	}
+
+	bool empty() const{
+		return count == 0;
+	}
+
+	const char * begin() const{
+		return ptr;
+	}
+
+	const char * end() const{
+		return ptr + count;
+	}
+
+	const char & operator[](std::size_t pos) const{
+		return ptr[pos];
+	}
+
+	const char & front() const{
+		return ptr[0];
+	}
+
+	const char & back() const{
+		return ptr[count - 1];
+	}
+
+	void remove_prefix(std::size_t n){
+		ptr += n;
+		count -= n;
+	}
+
+	void remove_suffix(std::size_t n){
+		count -= n;
+	}
+
+	ofStringView substr(std::size_t pos = 0, std::size_t n = npos) const{
+		pos = std::min(pos, count);
+		return ofStringView(ptr + pos, std::min(n, count - pos));
+	}
+
+	std::size_t find(ofStringView str, std::size_t pos = 0) const{
+		if(pos > count || str.count > count - pos){
+			return npos;
+		}
+		auto found = std::search(begin() + pos, end(), str.begin(), str.end());
+		return found == end() && !str.empty() ? npos : std::size_t(found - ptr);
+	}
+
+	std::size_t find(char c, std::size_t pos = 0) const{
+		if(pos >= count){
+			return npos;
+		}
+		auto found = static_cast<const char*>(std::memchr(ptr + pos, c, count - pos));
+		return found ? std::size_t(found - ptr) : npos;
+	}
+
+	int compare(ofStringView str) const{
+		int result = count && str.count ? std::memcmp(ptr, str.ptr, std::min(count, str.count)) : 0;
+		if(result != 0){
+			return result;
+		}
+		return count < str.count ? -1 : (count > str.count ? 1 : 0);
+	}
+
+private:
+	const char * ptr;
+	std::size_t count;
+};
+
+inline bool operator==(ofStringView a, ofStringView b){
+	return a.size() == b.size() && a.compare(b) == 0;
+}
+
+inline bool operator!=(ofStringView a, ofStringView b){
+	return !(a == b);
+}
+
+inline bool operator<(ofStringView a, ofStringView b){
+	return a.compare(b) < 0;
+}
+
+inline std::ostream & operator<<(std::ostream & os, ofStringView str){
+	return os.write(str.data(), str.size());
+}
+
+#endif
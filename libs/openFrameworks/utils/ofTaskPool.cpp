@@ -0,0 +1,427 @@
+#include "ofTaskPool.h"
+#include "ofLog.h"
+#include "ofProfiler.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace{
+#if HAS_TLS
+	thread_local const ofTaskPool * currentPool = nullptr;
+	thread_local int currentWorker = -1;
+#endif
+
+	// parallelFor splits ranges in a few blocks per thread so threads that
+	// finish early can take more work when the blocks take different times
+	const size_t blocksPerThread = 4;
+
+	// every pool, so the update of the windows can call the functions
+	// passed to runOnMainThread() in any of them. recursive since those
+	// functions can create or destroy pools
+	recursive_mutex poolsMutex;
+	vector<ofTaskPool *> & getPools(){
+		static vector<ofTaskPool *> * pools = new vector<ofTaskPool *>;
+		return *pools;
+	}
+}
+
+struct ofTaskPool::Worker{
+	mutex tasksMutex;
+	deque<Task> tasks;
+	std::thread thread;
+	std::thread::id id;
+};
+
+//----------------------------------------------------------
+ofTaskPool::ofTaskPool(size_t numThreads)
+:pending(0)
+,stopping(false){
+#ifndef TARGET_NO_THREADS
+	if(numThreads == 0){
+		numThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers.emplace_back(new Worker);
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers[i]->thread = std::thread(&ofTaskPool::workerLoop, this, i);
+	}
+#endif
+	lock_guard<recursive_mutex> lock(poolsMutex);
+	getPools().push_back(this);
+}
+
+//----------------------------------------------------------
+ofTaskPool::~ofTaskPool(){
+	{
+		lock_guard<recursive_mutex> lock(poolsMutex);
+		auto & pools = getPools();
+		pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+	}
+	{
+		lock_guard<mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+	for(auto & worker: workers){
+		worker->thread.join();
+	}
+}
+
+//----------------------------------------------------------
+void ofTaskPool::submit(std::function<void()> function){
+	Task task{std::move(function), chrono::steady_clock::now()};
+	if(workers.empty()){
+		runTask(task, -1);
+		return;
+	}
+
+	int index = getWorkerIndex();
+	if(index >= 0){
+		auto & worker = *workers[index];
+		lock_guard<mutex> lock(worker.tasksMutex);
+		worker.tasks.push_back(std::move(task));
+	}else{
+		lock_guard<mutex> lock(globalMutex);
+		globalTasks.push_back(std::move(task));
+	}
+	pending++;
+
+	// locking makes sure a worker that just found no tasks is already
+	// waiting before it's notified
+	{
+		lock_guard<mutex> lock(sleepMutex);
+	}
+	wakeUp.notify_one();
+}
+
+//----------------------------------------------------------
+void ofTaskPool::runOnMainThread(std::function<void()> function){
+	lock_guard<mutex> lock(mainThreadMutex);
+	mainThreadTasks.push_back(std::move(function));
+}
+
+//----------------------------------------------------------
+void ofTaskPool::processMainThreadTasks(){
+	vector<std::function<void()>> tasks;
+	{
+		lock_guard<mutex> lock(mainThreadMutex);
+		swap(tasks, mainThreadTasks);
+	}
+	for(auto & task: tasks){
+		task();
+	}
+}
+
+//----------------------------------------------------------
+bool ofTaskPool::runPendingTask(){
+	int index = getWorkerIndex();
+	Task task;
+	if(popTask(index, task)){
+		runTask(task, index);
+		return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+size_t ofTaskPool::getBlockSize(size_t count, size_t grain) const{
+	grain = std::max<size_t>(grain, 1);
+	size_t numBlocks = std::min((count + grain - 1) / grain, (workers.size() + 1) * blocksPerThread);
+	numBlocks = std::max<size_t>(numBlocks, 1);
+	return (count + numBlocks - 1) / numBlocks;
+}
+
+//----------------------------------------------------------
+void ofTaskPool::parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> & function){
+	if(end <= begin){
+		return;
+	}
+	const size_t count = end - begin;
+	const size_t blockSize = getBlockSize(count, grain);
+	const size_t numBlocks = (count + blockSize - 1) / blockSize;
+	if(numBlocks == 1 || workers.empty()){
+		function(begin, end);
+		return;
+	}
+
+	// helpers that start after all the blocks are taken return without
+	// touching the function, which may not exist anymore by then
+	struct State{
+		atomic<size_t> next;
+		atomic<size_t> done;
+		atomic<bool> failed;
+		mutex doneMutex;
+		condition_variable finished;
+		exception_ptr exception;
+	};
+	auto state = make_shared<State>();
+	state->next = 0;
+	state->done = 0;
+	state->failed = false;
+	auto functionPtr = &function;
+	auto runBlocks = [state, functionPtr, begin, end, blockSize, numBlocks]{
+		size_t block;
+		while((block = state->next++) < numBlocks){
+			if(!state->failed){
+				size_t blockBegin = begin + block * blockSize;
+				try{
+					(*functionPtr)(blockBegin, std::min(blockBegin + blockSize, end));
+				}catch(...){
+					lock_guard<mutex> lock(state->doneMutex);
+					if(!state->failed){
+						state->exception = current_exception();
+						state->failed = true;
+					}
+				}
+			}
+			lock_guard<mutex> lock(state->doneMutex);
+			if(++state->done == numBlocks){
+				state->finished.notify_all();
+			}
+		}
+	};
+
+	size_t numHelpers = std::min(workers.size(), numBlocks - 1);
+	for(size_t i = 0; i < numHelpers; i++){
+		submit(runBlocks);
+	}
+	runBlocks();
+
+	// every block is taken, wait for the ones still running in other threads
+	{
+		unique_lock<mutex> lock(state->doneMutex);
+		state->finished.wait(lock, [&]{
+			return state->done == numBlocks;
+		});
+	}
+	if(state->exception){
+		rethrow_exception(state->exception);
+	}
+}
+
+//----------------------------------------------------------
+size_t ofTaskPool::getNumThreads() const{
+	return workers.size();
+}
+
+//----------------------------------------------------------
+bool ofTaskPool::isWorkerThread() const{
+	return getWorkerIndex() >= 0;
+}
+
+//----------------------------------------------------------
+void ofTaskPool::setTimingCallback(std::function<void(const ofTaskTiming &)> callback){
+	shared_ptr<std::function<void(const ofTaskTiming &)>> newCallback;
+	if(callback){
+		newCallback = make_shared<std::function<void(const ofTaskTiming &)>>(std::move(callback));
+	}
+	atomic_store(&timingCallback, newCallback);
+}
+
+//----------------------------------------------------------
+void ofTaskPool::workerLoop(size_t index){
+#if HAS_TLS
+	currentPool = this;
+	currentWorker = index;
+#else
+	{
+		lock_guard<mutex> lock(idsMutex);
+		workers[index]->id = this_thread::get_id();
+	}
+#endif
+	Task task;
+	while(true){
+		if(popTask(index, task)){
+			runTask(task, index);
+			continue;
+		}
+		unique_lock<mutex> lock(sleepMutex);
+		wakeUp.wait(lock, [this]{
+			return pending > 0 || stopping;
+		});
+		// queued tasks are finished before stopping
+		if(pending <= 0 && stopping){
+			return;
+		}
+	}
+}
+
+//----------------------------------------------------------
+bool ofTaskPool::popTask(int index, Task & task){
+	// a worker takes the newest task from its own queue, which is the most
+	// likely to still be in its cache, and the oldest from the others
+	if(index >= 0){
+		auto & worker = *workers[index];
+		lock_guard<mutex> lock(worker.tasksMutex);
+		if(!worker.tasks.empty()){
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			pending--;
+			return true;
+		}
+	}
+	{
+		lock_guard<mutex> lock(globalMutex);
+		if(!globalTasks.empty()){
+			task = std::move(globalTasks.front());
+			globalTasks.pop_front();
+			pending--;
+			return true;
+		}
+	}
+	const size_t start = index + 1;
+	for(size_t i = 0; i < workers.size(); i++){
+		auto & victim = *workers[(start + i) % workers.size()];
+		lock_guard<mutex> lock(victim.tasksMutex);
+		if(!victim.tasks.empty()){
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			pending--;
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+void ofTaskPool::runTask(Task & task, int worker){
+	static auto & tasksCounter = ofGetProfiler().getCounter("tasks");
+	tasksCounter.add();
+	auto start = chrono::steady_clock::now();
+	try{
+		task.function();
+	}catch(std::exception & e){
+		ofLogError("ofTaskPool") << "task threw an exception: " << e.what();
+	}catch(...){
+		ofLogError("ofTaskPool") << "task threw an unknown exception";
+	}
+	auto callback = atomic_load(&timingCallback);
+	if(callback){
+		ofTaskTiming timing;
+		timing.worker = worker;
+		timing.waitTime = start - task.queued;
+		timing.runTime = chrono::steady_clock::now() - start;
+		(*callback)(timing);
+	}
+	// release whatever the task captured before waiting for the next one
+	task.function = nullptr;
+}
+
+//----------------------------------------------------------
+int ofTaskPool::getWorkerIndex() const{
+#if HAS_TLS
+	return currentPool == this ? currentWorker : -1;
+#else
+	lock_guard<mutex> lock(idsMutex);
+	auto id = this_thread::get_id();
+	for(size_t i = 0; i < workers.size(); i++){
+		if(workers[i]->id == id){
+			return i;
+		}
+	}
+	return -1;
+#endif
+}
+
+//----------------------------------------------------------
+void of::priv::processMainThreadTasks(){
+	lock_guard<recursive_mutex> lock(poolsMutex);
+	auto & pools = getPools();
+	// indexed since a function can destroy a pool, which at most delays
+	// the functions of the next pool until the next update
+	for(size_t i = 0; i < pools.size(); i++){
+		pools[i]->processMainThreadTasks();
+	}
+}
+
+//----------------------------------------------------------
+ofTaskPool & ofGetTaskPool(){
+	// never destroyed, like the main loop, so tasks can still be submitted
+	// while other static objects are destroyed on exit
+	static ofTaskPool * pool = new ofTaskPool;
+	return *pool;
+}
+
+//----------------------------------------------------------
+struct ofTaskGroup::State{
+	atomic<size_t> pending;
+	atomic<bool> canceled;
+	mutex finishedMutex;
+	condition_variable finished;
+	exception_ptr exception;
+};
+
+//----------------------------------------------------------
+ofTaskGroup::ofTaskGroup(ofTaskPool & pool)
+:pool(pool)
+,state(make_shared<State>()){
+	state->pending = 0;
+	state->canceled = false;
+}
+
+//----------------------------------------------------------
+ofTaskGroup::~ofTaskGroup(){
+	try{
+		wait();
+	}catch(std::exception & e){
+		ofLogError("ofTaskGroup") << "task threw an exception: " << e.what();
+	}catch(...){
+		ofLogError("ofTaskGroup") << "task threw an unknown exception";
+	}
+}
+
+//----------------------------------------------------------
+void ofTaskGroup::run(std::function<void()> task){
+	auto state = this->state;
+	state->pending++;
+	pool.submit([state, task]{
+		if(!state->canceled){
+			try{
+				task();
+			}catch(...){
+				lock_guard<mutex> lock(state->finishedMutex);
+				if(!state->exception){
+					state->exception = current_exception();
+				}
+			}
+		}
+		lock_guard<mutex> lock(state->finishedMutex);
+		if(--state->pending == 0){
+			state->finished.notify_all();
+		}
+	});
+}
+
+//----------------------------------------------------------
+void ofTaskGroup::wait(){
+	// running other tasks while waiting avoids running out of threads when
+	// every worker waits for a group of tasks that are still queued
+	while(state->pending > 0){
+		if(!pool.runPendingTask()){
+			unique_lock<mutex> lock(state->finishedMutex);
+			state->finished.wait_for(lock, chrono::milliseconds(1), [this]{
+				return state->pending == 0;
+			});
+		}
+	}
+	exception_ptr exception;
+	{
+		lock_guard<mutex> lock(state->finishedMutex);
+		swap(exception, state->exception);
+	}
+	state->canceled = false;
+	if(exception){
+		rethrow_exception(exception);
+	}
+}
+
+//----------------------------------------------------------
+void ofTaskGroup::cancel(){
+	state->canceled = true;
+}
+
+//----------------------------------------------------------
+bool ofTaskGroup::isCanceled() const{
+	return state->canceled;
+}
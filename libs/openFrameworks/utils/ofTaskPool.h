@@ -0,0 +1,335 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ofTaskPool;
+
+/// \brief Times of a task, passed to the callback set with
+/// ofTaskPool::setTimingCallback().
+struct ofTaskTiming{
+	/// \brief Index of the worker that ran the task or -1 if it was run by a
+	/// thread outside the pool while it was waiting for other tasks.
+	int worker;
+	/// \brief Time since the task was submitted until it started running.
+	std::chrono::nanoseconds waitTime;
+	/// \brief Time the task took to run.
+	std::chrono::nanoseconds runTime;
+};
+
+namespace of{
+namespace priv{
+	template<typename Result>
+	struct TaskContinuation;
+}
+}
+
+/// \brief A pool of threads that run tasks in parallel.
+///
+/// Every worker has its own queue of tasks. Tasks submitted from a worker
+/// go to its queue, which keeps related work in the same core, and workers
+/// that run out of tasks steal them from the others so the load stays
+/// balanced.
+///
+/// Most of the time there's no need to create a pool, ofGetTaskPool()
+/// returns one shared by the whole application and ofParallelFor(),
+/// ofParallelReduce() and ofTaskGroup use it by default:
+///
+/// ~~~~{.cpp}
+/// // a future with the result of a task
+/// std::future<ofPixels> pixels = ofGetTaskPool().async([]{
+/// 	ofPixels pixels;
+/// 	ofLoadImage(pixels, "big.png");
+/// 	return pixels;
+/// });
+///
+/// // or a function called in the main thread when the task is done
+/// ofGetTaskPool().async([]{
+/// 	ofPixels pixels;
+/// 	ofLoadImage(pixels, "big.png");
+/// 	return pixels;
+/// }, [this](ofPixels pixels){
+/// 	image.setFromPixels(pixels);
+/// });
+/// ~~~~
+///
+/// Functions passed to runOnMainThread() are called right before the update
+/// event of the windows, which every kind of window notifies, including
+/// ofAppNoWindow and the ones of mobile platforms that don't use the main
+/// loop.
+class ofTaskPool{
+public:
+	/// \brief Create a pool.
+	/// \param numThreads Number of worker threads, by default one less than
+	/// the cores of the computer since the thread that waits for the tasks
+	/// helps running them.
+	ofTaskPool(std::size_t numThreads = 0);
+	~ofTaskPool();
+
+	ofTaskPool(const ofTaskPool &) = delete;
+	ofTaskPool & operator=(const ofTaskPool &) = delete;
+
+	/// \brief Run a function in some worker thread.
+	///
+	/// Exceptions thrown by the function are logged as errors.
+	void submit(std::function<void()> task);
+
+	/// \brief Run a function in some worker thread.
+	/// \returns A future to wait for the result of the function or the
+	/// exception it throws.
+	template<typename Function>
+	auto async(Function function) -> std::future<decltype(function())>{
+		typedef decltype(function()) Result;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+		auto future = task->get_future();
+		submit([task]{
+			(*task)();
+		});
+		return future;
+	}
+
+	/// \brief Run a function in some worker thread and then pass its result
+	/// to another one in the main thread.
+	///
+	/// continuation is called with the result of function, or with no
+	/// arguments if it returns void.
+	template<typename Function, typename Continuation>
+	void async(Function function, Continuation continuation){
+		submit([this, function, continuation]() mutable{
+			of::priv::TaskContinuation<decltype(function())>::run(*this, function, continuation);
+		});
+	}
+
+	/// \brief Call a function in the main thread, before the next update
+	/// event.
+	///
+	/// It can be called from any thread, usually from a task to use its
+	/// results in something that can only be done in the main thread like
+	/// uploading to the graphics card.
+	void runOnMainThread(std::function<void()> function);
+
+	/// \brief Call the functions passed to runOnMainThread().
+	///
+	/// The windows already do this before notifying the update event, it's
+	/// only needed in applications that don't update any window.
+	void processMainThreadTasks();
+
+	/// \brief Run one of the queued tasks in the calling thread.
+	///
+	/// Useful to help the pool while waiting for some of its tasks.
+	/// \returns false if there was no queued task.
+	bool runPendingTask();
+
+	/// \brief Call function with blocks of the range [begin, end) in
+	/// parallel, returning when all of them are done.
+	///
+	/// The calling thread runs blocks too. If any call throws, the rest of
+	/// the blocks are skipped and the first exception is thrown again from
+	/// here.
+	/// \param grain Minimum number of elements in a block, big enough for a
+	/// block to be worth more than the cost of running it in another thread.
+	void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const std::function<void(std::size_t begin, std::size_t end)> & function);
+
+	/// \returns The number of elements in every block when parallelFor()
+	/// splits count elements with a grain.
+	std::size_t getBlockSize(std::size_t count, std::size_t grain) const;
+
+	/// \returns The number of worker threads.
+	std::size_t getNumThreads() const;
+
+	/// \returns true if called from one of the worker threads of this pool.
+	bool isWorkerThread() const;
+
+	/// \brief Set a function to call with the times of every task after
+	/// running it, to profile how the work is distributed.
+	///
+	/// It's called from the thread that ran the task so it has to be thread
+	/// safe. Pass nullptr to stop timing.
+	void setTimingCallback(std::function<void(const ofTaskTiming & timing)> callback);
+
+private:
+	struct Task{
+		std::function<void()> function;
+		std::chrono::steady_clock::time_point queued;
+	};
+	struct Worker;
+
+	void workerLoop(std::size_t index);
+	bool popTask(int worker, Task & task);
+	void runTask(Task & task, int worker);
+	int getWorkerIndex() const;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::deque<Task> globalTasks;
+	std::mutex globalMutex;
+	std::atomic<int> pending;
+	std::atomic<bool> stopping;
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	std::shared_ptr<std::function<void(const ofTaskTiming &)>> timingCallback;
+	std::mutex mainThreadMutex;
+	std::vector<std::function<void()>> mainThreadTasks;
+#if !HAS_TLS
+	mutable std::mutex idsMutex;
+#endif
+};
+
+namespace of{
+namespace priv{
+	/// \brief Call the functions passed to runOnMainThread() in every pool,
+	/// from ofCoreEvents::notifyUpdate().
+	void processMainThreadTasks();
+
+	template<typename Result>
+	struct TaskContinuation{
+		template<typename Function, typename Continuation>
+		static void run(ofTaskPool & pool, Function & function, Continuation & continuation){
+			auto result = std::make_shared<Result>(function());
+			pool.runOnMainThread([result, continuation]() mutable{
+				continuation(std::move(*result));
+			});
+		}
+	};
+
+	template<>
+	struct TaskContinuation<void>{
+		template<typename Function, typename Continuation>
+		static void run(ofTaskPool & pool, Function & function, Continuation & continuation){
+			function();
+			pool.runOnMainThread(continuation);
+		}
+	};
+}
+}
+
+/// \returns The task pool shared by the whole application, with a worker
+/// thread per core except one.
+ofTaskPool & ofGetTaskPool();
+
+/// \brief A set of tasks that can be waited for or canceled together.
+///
+/// ~~~~{.cpp}
+/// ofTaskGroup group;
+/// for(auto & path: paths){
+/// 	group.run([&]{ process(path); });
+/// }
+/// group.wait();
+/// ~~~~
+///
+/// The destructor waits for the tasks that are still running.
+class ofTaskGroup{
+public:
+	ofTaskGroup(ofTaskPool & pool = ofGetTaskPool());
+	~ofTaskGroup();
+
+	ofTaskGroup(const ofTaskGroup &) = delete;
+	ofTaskGroup & operator=(const ofTaskGroup &) = delete;
+
+	/// \brief Run a task in the pool as part of this group.
+	void run(std::function<void()> task);
+
+	/// \brief Wait until all the tasks of the group are done.
+	///
+	/// The calling thread runs queued tasks while it waits, so tasks can
+	/// wait for groups of their own. If any task threw an exception the
+	/// first one is thrown again from here. Afterwards the group can be
+	/// used again.
+	void wait();
+
+	/// \brief Skip the tasks of the group that didn't start yet.
+	///
+	/// Tasks already running are not interrupted, long tasks can check
+	/// isCanceled() to stop early.
+	void cancel();
+	bool isCanceled() const;
+
+private:
+	struct State;
+	ofTaskPool & pool;
+	std::shared_ptr<State> state;
+};
+
+/// \brief Call function with blocks of the range [begin, end) in parallel.
+///
+/// ~~~~{.cpp}
+/// ofParallelForRange(0, pixels.size(), [&](std::size_t begin, std::size_t end){
+/// 	for(std::size_t i = begin; i < end; i++){
+/// 		pixels[i] = 255 - pixels[i];
+/// 	}
+/// }, 4096);
+/// ~~~~
+///
+/// \param function Called with ranges of indices, possibly from several
+/// threads at the same time.
+/// \param grain Minimum number of elements worth running in another thread.
+template<typename Function>
+void ofParallelForRange(std::size_t begin, std::size_t end, Function function, std::size_t grain = 1){
+	ofGetTaskPool().parallelFor(begin, end, grain, function);
+}
+
+/// \brief Call function with every index in [begin, end) in parallel.
+/// \sa ofParallelForRange
+template<typename Function>
+void ofParallelFor(std::size_t begin, std::size_t end, Function function, std::size_t grain = 1){
+	ofGetTaskPool().parallelFor(begin, end, grain, [&function](std::size_t blockBegin, std::size_t blockEnd){
+		for(std::size_t i = blockBegin; i < blockEnd; i++){
+			function(i);
+		}
+	});
+}
+
+/// \brief Combine a value computed for every index in [begin, end) in
+/// parallel.
+///
+/// ~~~~{.cpp}
+/// float total = ofParallelReduce(0, values.size(), 0.f,
+/// 	[&](std::size_t i){ return values[i]; },
+/// 	[](float a, float b){ return a + b; });
+/// ~~~~
+///
+/// Every block is reduced in order starting from identity and the results
+/// of the blocks are then reduced in order too, so the result is always the
+/// same for the same input and pool even for operations like floating point
+/// additions that depend on the order.
+/// \param map Called with every index to get its value.
+/// \param reduce Combines two values, it has to be associative.
+template<typename T, typename Map, typename Reduce>
+T ofParallelReduce(std::size_t begin, std::size_t end, T identity, Map map, Reduce reduce, std::size_t grain = 1){
+	if(end <= begin){
+		return identity;
+	}
+	auto & pool = ofGetTaskPool();
+	const std::size_t blockSize = pool.getBlockSize(end - begin, grain);
+	const std::size_t numBlocks = (end - begin + blockSize - 1) / blockSize;
+	// wrapped so a vector<bool> doesn't pack the results of different
+	// threads in the same byte
+	struct Partial{
+		T value;
+	};
+	std::vector<Partial> partials(numBlocks, Partial{identity});
+	pool.parallelFor(0, numBlocks, 1, [&](std::size_t firstBlock, std::size_t lastBlock){
+		for(std::size_t block = firstBlock; block < lastBlock; block++){
+			std::size_t blockBegin = begin + block * blockSize;
+			std::size_t blockEnd = std::min(blockBegin + blockSize, end);
+			T value = identity;
+			for(std::size_t i = blockBegin; i < blockEnd; i++){
+				value = reduce(value, map(i));
+			}
+			partials[block].value = value;
+		}
+	});
+	T result = identity;
+	for(auto & partial: partials){
+		result = reduce(result, partial.value);
+	}
+	return result;
+}
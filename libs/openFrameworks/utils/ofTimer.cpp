@@ -1,11 +1,36 @@
 #include "ofTimer.h"
+#include <thread>
 
 #define NANOS_PER_SEC 1000000000ll
 
 void ofGetMonotonicTime(uint64_t & seconds, uint64_t & nanoseconds);
 
+#ifndef TARGET_WIN32
+// the timer follows the real time even when the time mode is fixed rate,
+// ofGetCurrentTime() doesn't advance while waiting in that case
+static ofTime getMonotonicTime(){
+	ofTime t;
+#if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI)) || defined(TARGET_EMSCRIPTEN)
+	// the same clock clock_nanosleep waits with
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	t.seconds = now.tv_sec;
+	t.nanoseconds = now.tv_nsec;
+#else
+	auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	t.seconds = now / NANOS_PER_SEC;
+	t.nanoseconds = now % NANOS_PER_SEC;
+#endif
+	return t;
+}
+#endif
+
 ofTimer::ofTimer()
 :nanosPerPeriod(0)
+,precise(false)
+,spinTime(std::chrono::milliseconds(2))
+,catchUp(false)
+,maxCatchUpEvents(5)
 #ifdef TARGET_WIN32
 ,hTimer(CreateWaitableTimer(nullptr, TRUE, nullptr))
 #endif
@@ -17,7 +42,7 @@ void ofTimer::reset(){
 #if defined(TARGET_WIN32)
 	GetSystemTimeAsFileTime((LPFILETIME)&nextWakeTime);
 #else
-	nextWakeTime = ofGetCurrentTime();
+	nextWakeTime = getMonotonicTime();
 #endif
 	calculateNextPeriod();
 }
@@ -27,7 +52,31 @@ void ofTimer::setPeriodicEvent(uint64_t nanoseconds){
 	reset();
 }
 
+void ofTimer::setPrecise(bool _precise, std::chrono::nanoseconds _spinTime){
+	precise = _precise;
+	spinTime = _spinTime;
+}
+
+void ofTimer::setCatchUp(bool _catchUp, int maxEvents){
+	catchUp = _catchUp;
+	maxCatchUpEvents = std::max(maxEvents, 0);
+}
+
 void ofTimer::waitNext(){
+	if(precise){
+		// the steady clock is cheap to query in the loop, the time left
+		// comes from the clock of the timer
+		auto timeToNext = getTimeToNext();
+		auto deadline = std::chrono::steady_clock::now() + timeToNext;
+		if(timeToNext > spinTime){
+			std::this_thread::sleep_for(timeToNext - spinTime);
+		}
+		while(std::chrono::steady_clock::now() < deadline){
+			std::this_thread::yield();
+		}
+		calculateNextPeriod();
+		return;
+	}
 #if (defined(TARGET_LINUX) && !defined(TARGET_RASPBERRY_PI))
 	timespec remainder = {0,0};
 	timespec wakeTime = nextWakeTime.getAsTimespec();
@@ -35,7 +84,7 @@ void ofTimer::waitNext(){
 #elif defined(TARGET_WIN32)
 	WaitForSingleObject(hTimer, INFINITE);
 #else
-	auto now = ofGetCurrentTime();
+	auto now = getMonotonicTime();
 	auto waitNanos = nextWakeTime - now;
 	if(waitNanos > std::chrono::nanoseconds(0)){
 		timespec waittime = (ofTime() + waitNanos).getAsTimespec();
@@ -47,20 +96,34 @@ void ofTimer::waitNext(){
 }
 
 
+std::chrono::nanoseconds ofTimer::getTimeToNext() const{
+#if defined(TARGET_WIN32)
+	LARGE_INTEGER now;
+	GetSystemTimeAsFileTime((LPFILETIME)&now);
+	return std::chrono::nanoseconds((nextWakeTime.QuadPart - now.QuadPart) * 100);
+#else
+	return nextWakeTime - getMonotonicTime();
+#endif
+}
+
 void ofTimer::calculateNextPeriod(){
+	// when late, skip the missed events unless catching up with them and
+	// not too far behind
 #if defined(TARGET_WIN32)
 	nextWakeTime.QuadPart += nanosPerPeriod.count()/100;
     LARGE_INTEGER now;
     GetSystemTimeAsFileTime((LPFILETIME)&now);
-	if(nextWakeTime.QuadPart<now.QuadPart){
+	auto maxDelay = catchUp ? nanosPerPeriod.count()/100 * maxCatchUpEvents : 0;
+	if(now.QuadPart - nextWakeTime.QuadPart > maxDelay){
 	    reset();
 	}else{
 	    SetWaitableTimer(hTimer, &nextWakeTime, 0, nullptr, nullptr, 0);
 	}
 #else
 	nextWakeTime += nanosPerPeriod;
-	auto now = ofGetCurrentTime();
-    if(nextWakeTime<now){
+	auto now = getMonotonicTime();
+	auto maxDelay = catchUp ? nanosPerPeriod * maxCatchUpEvents : std::chrono::nanoseconds(0);
+	if(now - nextWakeTime > maxDelay){
         reset();
     }
 #endif
@@ -20,9 +20,35 @@ public:
 	
 	/// \brief Sleep this thread until the next periodic event.
 	void waitNext();
+
+	/// \brief Wait for the events actively instead of only sleeping.
+	///
+	/// The operating system can wake a sleeping thread up to a few
+	/// milliseconds late, so a precise timer sleeps until spinTime before
+	/// the event and then yields the processor in a loop until it arrives.
+	/// That keeps the time between events much more regular at the cost of
+	/// keeping a core busy during spinTime.
+	/// \param precise true to wait actively, false to only sleep.
+	/// \param spinTime How long before the event to stop sleeping.
+	void setPrecise(bool precise, std::chrono::nanoseconds spinTime = std::chrono::milliseconds(2));
+
+	/// \brief What to do when waitNext() is called after the next event.
+	///
+	/// By default the timer skips the events it missed and the next one
+	/// happens a period after now. When catching up waitNext() returns
+	/// immediately until the missed events are recovered, so the average
+	/// rate stays the same, unless it's more than maxEvents behind.
+	/// \param catchUp true to recover the missed events, false to skip them.
+	/// \param maxEvents Maximum number of missed events to recover.
+	void setCatchUp(bool catchUp, int maxEvents = 5);
 private:
 	void calculateNextPeriod();
+	std::chrono::nanoseconds getTimeToNext() const;
 	std::chrono::nanoseconds nanosPerPeriod;
+	bool precise;
+	std::chrono::nanoseconds spinTime;
+	bool catchUp;
+	int maxCatchUpEvents;
 #if defined(TARGET_WIN32)
 	LARGE_INTEGER nextWakeTime;
 	HANDLE hTimer;
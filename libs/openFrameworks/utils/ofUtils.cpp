@@ -4,8 +4,12 @@
 #include "ofLog.h"
 
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <numeric>
 #include <locale>
+#include <map>
+#include <mutex>
 #include "uriparser/Uri.h"
 
 #ifdef TARGET_WIN32	 // For ofLaunchBrowser.
@@ -89,6 +93,160 @@ namespace{
             static auto * dataPathRoot = new std::filesystem::path(defaultDataPath());
             return *dataPathRoot;
     }
+
+	//--------------------------------------------------
+	// The parsers below read numbers directly from the characters with the
+	// same rules as extracting them from a stream in the classic locale,
+	// which is what ofTo<T>() did, so the results don't change.
+	bool isStreamSpace(char c){
+		return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+	}
+
+	bool isDigit(char c){
+		return c >= '0' && c <= '9';
+	}
+
+	//--------------------------------------------------
+	// leading whitespace is skipped and parsing stops at the first character
+	// that is not a digit. Numbers out of range are clamped to the limits of
+	// the type and 0 is returned if there are no digits.
+	template<typename Int>
+	Int parseInteger(ofStringView str){
+		typedef typename std::make_unsigned<Int>::type Unsigned;
+		auto c = str.begin();
+		auto end = str.end();
+		while(c != end && isStreamSpace(*c)){
+			c++;
+		}
+		bool negative = false;
+		if(c != end && (*c == '+' || *c == '-')){
+			negative = *c == '-';
+			c++;
+		}
+		if(c == end || !isDigit(*c)){
+			return 0;
+		}
+		const Unsigned limit = Unsigned(std::numeric_limits<Int>::max()) + (negative ? 1 : 0);
+		Unsigned value = 0;
+		for(; c != end && isDigit(*c); c++){
+			Unsigned digit = *c - '0';
+			if(value > (limit - digit) / 10){
+				return negative ? std::numeric_limits<Int>::min() : std::numeric_limits<Int>::max();
+			}
+			value = value * 10 + digit;
+		}
+		if(negative){
+			return value == limit ? std::numeric_limits<Int>::min() : -Int(value);
+		}
+		return Int(value);
+	}
+
+	template<typename Float>
+	Float stringToFloat(const char * str);
+
+	template<>
+	float stringToFloat<float>(const char * str){
+		return strtof(str, nullptr);
+	}
+
+	template<>
+	double stringToFloat<double>(const char * str){
+		return strtod(str, nullptr);
+	}
+
+	//--------------------------------------------------
+	// finds the part of the string a stream would read as a number and
+	// converts it with strtof or strtod, which is also what the stream uses,
+	// so the rounding is the same. Values too big for the type are clamped
+	// to its limits like the stream does instead of becoming infinite.
+	template<typename Float>
+	Float parseFloat(ofStringView str){
+		auto c = str.begin();
+		auto end = str.end();
+		while(c != end && isStreamSpace(*c)){
+			c++;
+		}
+		auto start = c;
+		if(c != end && (*c == '+' || *c == '-')){
+			c++;
+		}
+		size_t digits = 0;
+		for(; c != end && isDigit(*c); c++){
+			digits++;
+		}
+		if(c != end && *c == '.'){
+			for(c++; c != end && isDigit(*c); c++){
+				digits++;
+			}
+		}
+		if(digits == 0){
+			return 0;
+		}
+		if(c != end && (*c == 'e' || *c == 'E')){
+			c++;
+			if(c != end && (*c == '+' || *c == '-')){
+				c++;
+			}
+			// an exponent without digits makes the stream fail
+			if(c == end || !isDigit(*c)){
+				return 0;
+			}
+			while(c != end && isDigit(*c)){
+				c++;
+			}
+		}
+
+		// strtof and strtod need a null terminated string
+		char buffer[64];
+		std::string longNumber;
+		const char * number = buffer;
+		size_t length = c - start;
+		if(length < sizeof(buffer)){
+			std::copy(start, c, buffer);
+			buffer[length] = 0;
+		}else{
+			longNumber.assign(start, c);
+			number = longNumber.c_str();
+		}
+		Float value = stringToFloat<Float>(number);
+		if(std::isinf(value)){
+			return value > 0 ? std::numeric_limits<Float>::max() : -std::numeric_limits<Float>::max();
+		}
+		return value;
+	}
+
+	//--------------------------------------------------
+	// formats like snprintf into a string, the same digits a stream writes
+	// with the equivalent flags
+	template<typename T>
+	string formatNumber(const char * format, T value){
+		char buffer[64];
+		int length = snprintf(buffer, sizeof(buffer), format, value);
+		if(length < 0){
+			return string();
+		}
+		if(size_t(length) < sizeof(buffer)){
+			return string(buffer, length);
+		}
+		string str(length, 0);
+		snprintf(&str[0], length + 1, format, value);
+		return str;
+	}
+
+	template<typename T>
+	string formatNumber(const char * format, int precision, T value){
+		char buffer[64];
+		int length = snprintf(buffer, sizeof(buffer), format, precision, value);
+		if(length < 0){
+			return string();
+		}
+		if(size_t(length) < sizeof(buffer)){
+			return string(buffer, length);
+		}
+		string str(length, 0);
+		snprintf(&str[0], length + 1, format, precision, value);
+		return str;
+	}
 }
 
 namespace of{
@@ -121,7 +279,10 @@ namespace priv{
 
 		//--------------------------------------
 		void setTimeModeFixedRate(uint64_t stepNanos, ofMainLoop & mainLoop){
-			fixedRateTime = getMonotonicTimeForMode(ofTime::System);
+			// changing the step keeps the current time so it never jumps
+			if(mode != ofTime::FixedRate){
+				fixedRateTime = getMonotonicTimeForMode(ofTime::System);
+			}
 			mode = ofTime::FixedRate;
 			fixedRateStep = stepNanos;
 			loopListener = mainLoop.loopEvent.newListener([this]{
@@ -598,6 +759,81 @@ string ofFromString(const string& value){
 	return value;
 }
 
+//----------------------------------------
+template<>
+int ofTo(const string& str){
+	return parseInteger<int>(str);
+}
+
+//----------------------------------------
+template<>
+int64_t ofTo(const string& str){
+	return parseInteger<int64_t>(str);
+}
+
+//----------------------------------------
+template<>
+float ofTo(const string& str){
+	return parseFloat<float>(str);
+}
+
+//----------------------------------------
+template<>
+double ofTo(const string& str){
+	return parseFloat<double>(str);
+}
+
+//----------------------------------------
+string ofToString(int value){
+	return formatNumber("%d", value);
+}
+
+//----------------------------------------
+string ofToString(unsigned int value){
+	return formatNumber("%u", value);
+}
+
+//----------------------------------------
+string ofToString(long value){
+	return formatNumber("%ld", value);
+}
+
+//----------------------------------------
+string ofToString(unsigned long value){
+	return formatNumber("%lu", value);
+}
+
+//----------------------------------------
+string ofToString(long long value){
+	return formatNumber("%lld", value);
+}
+
+//----------------------------------------
+string ofToString(unsigned long long value){
+	return formatNumber("%llu", value);
+}
+
+//----------------------------------------
+string ofToString(float value){
+	// streams write floats with 6 significant digits by default
+	return formatNumber("%g", double(value));
+}
+
+//----------------------------------------
+string ofToString(double value){
+	return formatNumber("%g", value);
+}
+
+//----------------------------------------
+string ofToString(float value, int precision){
+	return formatNumber("%.*f", precision, double(value));
+}
+
+//----------------------------------------
+string ofToString(double value, int precision){
+	return formatNumber("%.*f", precision, value);
+}
+
 //----------------------------------------
 template<>
 const char * ofFromString(const string& value){
@@ -626,7 +862,17 @@ string ofToHex(const char* value) {
 
 //----------------------------------------
 int ofToInt(const string& intString) {
-	return ofTo<int>(intString);
+	return parseInteger<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(ofStringView intString) {
+	return parseInteger<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(const char * intString) {
+	return parseInteger<int>(intString);
 }
 
 //----------------------------------------
@@ -680,17 +926,47 @@ string ofHexToString(const string& stringHexString) {
 
 //----------------------------------------
 float ofToFloat(const string& floatString) {
-	return ofTo<float>(floatString);
+	return parseFloat<float>(floatString);
+}
+
+//----------------------------------------
+float ofToFloat(ofStringView floatString) {
+	return parseFloat<float>(floatString);
+}
+
+//----------------------------------------
+float ofToFloat(const char * floatString) {
+	return parseFloat<float>(floatString);
 }
 
 //----------------------------------------
 double ofToDouble(const string& doubleString) {
-	return ofTo<double>(doubleString);
+	return parseFloat<double>(doubleString);
+}
+
+//----------------------------------------
+double ofToDouble(ofStringView doubleString) {
+	return parseFloat<double>(doubleString);
+}
+
+//----------------------------------------
+double ofToDouble(const char * doubleString) {
+	return parseFloat<double>(doubleString);
 }
 
 //----------------------------------------
 int64_t ofToInt64(const string& intString) {
-	return ofTo<int64_t>(intString);
+	return parseInteger<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(ofStringView intString) {
+	return parseInteger<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(const char * intString) {
+	return parseInteger<int64_t>(intString);
 }
 
 //----------------------------------------
@@ -769,29 +1045,99 @@ string ofBinaryToString(const string& value) {
 	return out.str();
 }
 
+static const std::locale & getLocale(const string & locale);
+
+//--------------------------------------------------
+// removes the whitespace around a token like ofTrim does
+static ofStringView trimView(ofStringView str){
+	auto & ctype = std::use_facet<std::ctype<char>>(getLocale(""));
+	while(!str.empty() && ctype.is(std::ctype_base::space, str.front())){
+		str.remove_prefix(1);
+	}
+	while(!str.empty() && ctype.is(std::ctype_base::space, str.back())){
+		str.remove_suffix(1);
+	}
+	return str;
+}
+
 //--------------------------------------------------
 vector <string> ofSplitString(const string & source, const string & delimiter, bool ignoreEmpty, bool trim) {
 	vector<string> result;
-	if (delimiter.empty()) {
-		result.push_back(source);
-		return result;
-	}
-	string::const_iterator substart = source.begin(), subend;
-	while (true) {
-		subend = search(substart, source.end(), delimiter.begin(), delimiter.end());
-		string sub(substart, subend);
-		if(trim) {
-			sub = ofTrim(sub);
-		}
-		if (!ignoreEmpty || !sub.empty()) {
-			result.push_back(sub);
+	for(auto token: ofStringSplitter(source, delimiter, ignoreEmpty, trim)){
+		result.emplace_back(token.data(), token.size());
+	}
+	return result;
+}
+
+//--------------------------------------------------
+ofStringSplitter::ofStringSplitter(ofStringView source, ofStringView delimiter, bool ignoreEmpty, bool trim)
+:source(source)
+,delimiter(delimiter)
+,ignoreEmpty(ignoreEmpty)
+,trim(trim){
+
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator ofStringSplitter::begin() const{
+	return iterator(*this);
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator ofStringSplitter::end() const{
+	return iterator();
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator::iterator()
+:splitter(nullptr)
+,position(string::npos)
+,next(string::npos){
+
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator::iterator(const ofStringSplitter & splitter)
+:splitter(&splitter)
+,position(string::npos)
+,next(0){
+	if(splitter.delimiter.empty()){
+		// like ofSplitString, the whole source is the only token
+		position = 0;
+		next = string::npos;
+		token = splitter.source;
+	}else{
+		++(*this);
+	}
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator & ofStringSplitter::iterator::operator++(){
+	position = string::npos;
+	while(next != string::npos){
+		const ofStringView & source = splitter->source;
+		const ofStringView & delimiter = splitter->delimiter;
+		size_t start = next;
+		size_t found = source.find(delimiter, start);
+		size_t end = found == string::npos ? source.size() : found;
+		next = found == string::npos ? string::npos : found + delimiter.size();
+		token = source.substr(start, end - start);
+		if(splitter->trim){
+			token = trimView(token);
 		}
-		if (subend == source.end()) {
+		if(!splitter->ignoreEmpty || !token.empty()){
+			position = start;
 			break;
 		}
-		substart = subend + delimiter.size();
 	}
-	return result;
+	return *this;
+}
+
+//--------------------------------------------------
+ofStringSplitter::iterator ofStringSplitter::iterator::operator++(int){
+	iterator previous = *this;
+	++(*this);
+	return previous;
 }
 
 //--------------------------------------------------
@@ -816,16 +1162,53 @@ string ofJoinString(const vector<string>& stringElements, const string& delimite
 
 //--------------------------------------------------
 void ofStringReplace(string& input, const string& searchStr, const string& replaceStr){
+	if(searchStr.empty()){
+		return;
+	}
 	auto pos = input.find(searchStr);
-	while(pos != std::string::npos){
-		input.replace(pos, searchStr.size(), replaceStr);
-		pos += replaceStr.size();
-		std::string nextfind(input.begin() + pos, input.end());
-		auto nextpos = nextfind.find(searchStr);
-		if(nextpos==std::string::npos){
-			break;
+	if(pos == string::npos){
+		return;
+	}
+	const size_t searchSize = searchStr.size();
+	const size_t replaceSize = replaceStr.size();
+
+	if(replaceSize <= searchSize){
+		// the text between matches moves towards the front so it can be
+		// written over the same string, behind the position being searched
+		char * data = &input[0];
+		size_t read = pos;
+		size_t write = pos;
+		while(pos != string::npos){
+			if(write != read){
+				std::copy(data + read, data + pos, data + write);
+			}
+			write += pos - read;
+			std::copy(replaceStr.begin(), replaceStr.end(), data + write);
+			write += replaceSize;
+			read = pos + searchSize;
+			pos = input.find(searchStr, read);
 		}
-		pos += nextpos;
+		if(write != read){
+			std::copy(data + read, data + input.size(), data + write);
+		}
+		input.resize(write + input.size() - read);
+	}else{
+		// count the matches to allocate the result only once
+		size_t count = 0;
+		for(auto match = pos; match != string::npos; match = input.find(searchStr, match + searchSize)){
+			count++;
+		}
+		string result;
+		result.reserve(input.size() + count * (replaceSize - searchSize));
+		size_t read = 0;
+		while(pos != string::npos){
+			result.append(input, read, pos - read);
+			result += replaceStr;
+			read = pos + searchSize;
+			pos = input.find(searchStr, read);
+		}
+		result.append(input, read, string::npos);
+		input.swap(result);
 	}
 }
 
@@ -895,8 +1278,16 @@ utf8::iterator<std::string::const_reverse_iterator> ofUTF8Iterator::rend() const
 
 
 //--------------------------------------------------
-// helper method to get locale from name
-static std::locale getLocale(const string & locale) {
+// helper method to get locale from name. Creating a locale from its name
+// is slow so every locale is created only once and then reused.
+static const std::locale & getLocale(const string & locale) {
+	static std::mutex mutex;
+	static auto * locales = new std::map<string, std::locale>();
+	std::unique_lock<std::mutex> lock(mutex);
+	auto found = locales->find(locale);
+	if(found != locales->end()){
+		return found->second;
+	}
 	std::locale loc;
 	try {
 		loc = std::locale(locale.c_str());
@@ -904,16 +1295,18 @@ static std::locale getLocale(const string & locale) {
 	catch (...) {
 		ofLogWarning("ofUtils") << "Couldn't create locale " << locale << " using default, " << loc.name();
 	}
-	return loc;
+	// map elements never move so the reference stays valid
+	return locales->insert(std::make_pair(locale, loc)).first->second;
 }
 
 //--------------------------------------------------
 string ofToLower(const string & src, const string & locale){
 	std::string dst;
-	std::locale loc = getLocale(locale);
+	dst.reserve(src.size());
+	auto & ctype = std::use_facet<std::ctype<wchar_t>>(getLocale(locale));
 	try{
 		for(auto c: ofUTF8Iterator(src)){
-			utf8::append(std::tolower<wchar_t>(c, loc), back_inserter(dst));
+			utf8::append(ctype.tolower(c), back_inserter(dst));
 		}
 	}catch(...){
 	}
@@ -923,10 +1316,11 @@ string ofToLower(const string & src, const string & locale){
 //--------------------------------------------------
 string ofToUpper(const string & src, const string & locale){
 	std::string dst;
-	std::locale loc = getLocale(locale);
+	dst.reserve(src.size());
+	auto & ctype = std::use_facet<std::ctype<wchar_t>>(getLocale(locale));
 	try{
 		for(auto c: ofUTF8Iterator(src)){
-			utf8::append(std::toupper<wchar_t>(c, loc), back_inserter(dst));
+			utf8::append(ctype.toupper(c), back_inserter(dst));
 		}
 	}catch(...){
 	}
@@ -936,16 +1330,16 @@ string ofToUpper(const string & src, const string & locale){
 //--------------------------------------------------
 string ofTrimFront(const string & src, const string& locale){
     auto dst = src;
-    std::locale loc = getLocale(locale);
-    dst.erase(dst.begin(),std::find_if_not(dst.begin(),dst.end(),[&](char & c){return std::isspace<char>(c,loc);}));
+    auto & ctype = std::use_facet<std::ctype<char>>(getLocale(locale));
+    dst.erase(dst.begin(),std::find_if_not(dst.begin(),dst.end(),[&](char & c){return ctype.is(std::ctype_base::space, c);}));
     return dst;
 }
 
 //--------------------------------------------------
 string ofTrimBack(const string & src, const string& locale){
     auto dst = src;
-    std::locale loc = getLocale(locale);
-	dst.erase(std::find_if_not(dst.rbegin(),dst.rend(),[&](char & c){return std::isspace<char>(c,loc);}).base(), dst.end());
+    auto & ctype = std::use_facet<std::ctype<char>>(getLocale(locale));
+	dst.erase(std::find_if_not(dst.rbegin(),dst.rend(),[&](char & c){return ctype.is(std::ctype_base::space, c);}).base(), dst.end());
 	return dst;
 }
 
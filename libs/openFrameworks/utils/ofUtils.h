@@ -1,9 +1,12 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofRandomEngine.h"
+#include "ofStringView.h"
 #include "utf8.h"
 #include <bitset> // For ofToBinary.
 #include <chrono>
+#include <iterator>
 
 #include "ofLog.h"
 
@@ -256,10 +259,12 @@ void ofSetDataPathRoot(const std::filesystem::path& root);
 /// \brief Randomly reorder the values in a vector.
 /// \tparam T the type contained by the vector.
 /// \param values The vector of values to modify.
-/// \sa http://www.cplusplus.com/reference/algorithm/random_shuffle/
+/// It uses the same random engine as ofRandom(), so the order is
+/// reproducible after seeding it with ofSeedRandom(int).
+/// \sa http://www.cplusplus.com/reference/algorithm/shuffle/
 template<class T>
 void ofRandomize(std::vector<T>& values) {
-	random_shuffle(values.begin(), values.end());
+	std::shuffle(values.begin(), values.end(), ofGetRandomEngine());
 }
 
 /// \brief Conditionally remove values from a vector.
@@ -415,12 +420,92 @@ bool ofContains(const std::vector<T>& values, const T& target) {
 /// \returns A vector of strings split with the delimiter.
 std::vector<std::string> ofSplitString(const std::string& source, const std::string& delimiter, bool ignoreEmpty = false, bool trim = false);
 
+/// \brief Iterates over the tokens of a string split with a delimiter
+/// without copying them.
+///
+/// The tokens are the same ofSplitString() returns but every one is a view
+/// of the source string, so splitting doesn't allocate any memory:
+///
+/// ~~~~{.cpp}
+/// for(auto line: ofStringSplitter(csv, "\n", true)){
+/// 	for(auto field: ofStringSplitter(line, ",", false, true)){
+/// 		values.push_back(ofToFloat(field));
+/// 	}
+/// }
+/// ~~~~
+///
+/// The source and delimiter are not copied either, they have to stay valid
+/// while the splitter is used.
+class ofStringSplitter{
+public:
+	class iterator{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef ofStringView value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const ofStringView * pointer;
+		typedef const ofStringView & reference;
+
+		iterator();
+
+		reference operator*() const{
+			return token;
+		}
+
+		pointer operator->() const{
+			return &token;
+		}
+
+		iterator & operator++();
+		iterator operator++(int);
+
+		bool operator==(const iterator & other) const{
+			return position == other.position;
+		}
+
+		bool operator!=(const iterator & other) const{
+			return position != other.position;
+		}
+
+	private:
+		friend class ofStringSplitter;
+		iterator(const ofStringSplitter & splitter);
+
+		const ofStringSplitter * splitter;
+		// start of the current token, npos at the end
+		std::size_t position;
+		// where the search for the next token starts, npos after the last
+		std::size_t next;
+		ofStringView token;
+	};
+
+	/// \param source The string to split.
+	/// \param delimiter The delimiter string.
+	/// \param ignoreEmpty Set to true to skip empty tokens.
+	/// \param trim Set to true to remove the whitespace around the tokens.
+	ofStringSplitter(ofStringView source, ofStringView delimiter, bool ignoreEmpty = false, bool trim = false);
+
+	iterator begin() const;
+	iterator end() const;
+
+private:
+	ofStringView source;
+	ofStringView delimiter;
+	bool ignoreEmpty;
+	bool trim;
+};
+
 /// \brief Join a vector of strings together into one string.
 /// \param stringElements The vector of strings to join.
 /// \param delimiter The delimiter to put betweeen each string.
 std::string ofJoinString(const std::vector<std::string>& stringElements, const std::string& delimiter);
 
 /// \brief Replace all occurrences of a string with another string.
+///
+/// Runs in time linear to the size of the input. When the replacement is
+/// not longer than the searched string the input is modified in place,
+/// otherwise it's reallocated once with its final size.
+///
 /// \note The input string is passed by reference, so it will be modified.
 /// \param input The string to run the replacement on.
 /// \param searchStr The string to be replaced.
@@ -522,6 +607,25 @@ std::string ofToString(const T& value){
 	return out.str();
 }
 
+/// \name Fast conversions of numbers to strings
+/// \{
+
+/// The same as the ofToString() templates for the most common number types
+/// but formatted directly into the string, without a stream.
+
+std::string ofToString(int value);
+std::string ofToString(unsigned int value);
+std::string ofToString(long value);
+std::string ofToString(unsigned long value);
+std::string ofToString(long long value);
+std::string ofToString(unsigned long long value);
+std::string ofToString(float value);
+std::string ofToString(double value);
+std::string ofToString(float value, int precision);
+std::string ofToString(double value, int precision);
+
+/// \}
+
 /// \brief Convert a value to a string with a specific precision.
 ///
 /// Like sprintf "%4f" format, in this example precision=4
@@ -631,15 +735,30 @@ template<typename T> T ofTo(const std::string & str){
 	return x;
 }
 
+// the most common number types are parsed without a stream, see ofToInt()
+template<> int ofTo(const std::string & str);
+template<> int64_t ofTo(const std::string & str);
+template<> float ofTo(const std::string & str);
+template<> double ofTo(const std::string & str);
+
 /// \section Number Conversion
 /// \brief Convert a string to an integer.
 ///
 /// Converts a `std::string` representation of an int (e.g., `"3"`) to an actual
 /// `int`.
 ///
+/// The number is parsed directly from the characters, without a stream,
+/// but the result is the same as reading it from one: leading whitespace is
+/// skipped, parsing stops at the first character that is not part of the
+/// number and numbers out of range are clamped to the limits of the type.
+/// The overloads that take an ofStringView can parse part of a bigger
+/// string without copying it, like the tokens of an ofStringSplitter.
+///
 /// \param intString The string representation of the integer.
 /// \returns the integer represented by the string or 0 on failure.
 int ofToInt(const std::string& intString);
+int ofToInt(ofStringView intString);
+int ofToInt(const char * intString);
 
 /// \brief Convert a string to a int64_t.
 ///
@@ -649,6 +768,8 @@ int ofToInt(const std::string& intString);
 /// \param intString The string representation of the long integer.
 /// \returns the long integer represented by the string or 0 on failure.
 int64_t ofToInt64(const std::string& intString);
+int64_t ofToInt64(ofStringView intString);
+int64_t ofToInt64(const char * intString);
 
 /// \brief Convert a string to a float.
 ///
@@ -658,6 +779,8 @@ int64_t ofToInt64(const std::string& intString);
 /// \param floatString string representation of the float.
 /// \returns the float represented by the string or 0 on failure.
 float ofToFloat(const std::string& floatString);
+float ofToFloat(ofStringView floatString);
+float ofToFloat(const char * floatString);
 
 /// \brief Convert a string to a double.
 ///
@@ -667,6 +790,8 @@ float ofToFloat(const std::string& floatString);
 /// \param doubleString The string representation of the double.
 /// \returns the double represented by the string or 0 on failure.
 double ofToDouble(const std::string& doubleString);
+double ofToDouble(ofStringView doubleString);
+double ofToDouble(const char * doubleString);
 
 /// \brief Convert a string to a boolean.
 ///
@@ -1,10 +1,53 @@
 #include "ofVideoPlayer.h"
 #include "ofUtils.h"
 #include "ofAppRunner.h"
+#include "ofPixelsUpload.h"
+#include "ofTaskPool.h"
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
 using namespace std;
 
+#ifndef TARGET_OPENGLES
+struct ofVideoPlayer::TextureStream{
+	// a plane being copied from the pixels of the player to a buffer
+	struct Plane{
+		std::size_t index;
+		int buffer;
+		unsigned char * mapped;
+		const unsigned char * source;
+		std::size_t bytes;
+	};
+
+	~TextureStream(){
+		// the buffers can't be unmapped while the copy is writing them,
+		// a copy that didn't start yet won't run anymore
+		if(copy.valid() && claim()){
+			copy.wait();
+		}
+	}
+
+	// true if the copy was already taken by a worker or by the player
+	bool claim(){
+		return copyClaimed->exchange(true);
+	}
+
+	void copyPlanes(){
+		for(auto & plane: planes){
+			memcpy(plane.mapped, plane.source, plane.bytes);
+		}
+	}
+
+	ofPixelsUpload upload;
+	std::vector<Plane> planes;
+	std::future<void> copy;
+	// whoever sets it first does the copy, the task in the pool or
+	// finishTextureStreaming() if the workers didn't get to it yet
+	std::shared_ptr<std::atomic<bool>> copyClaimed;
+};
+#endif
+
 //---------------------------------------------------------------------------
 ofVideoPlayer::ofVideoPlayer (){
 	bUseTexture			= true;
@@ -15,6 +58,9 @@ ofVideoPlayer::ofVideoPlayer (){
 
 //---------------------------------------------------------------------------
 void ofVideoPlayer::setPlayer(shared_ptr<ofBaseVideoPlayer> newPlayer){
+#ifndef TARGET_OPENGLES
+	finishTextureStreaming();
+#endif
 	player = newPlayer;
 	setPixelFormat(internalPixelFormat);	//this means that it will try to set the pixel format you have been using before. 
 											//if the format is not supported ofVideoPlayer's internalPixelFormat will be updated to that of the player's
@@ -66,6 +112,9 @@ ofPixelFormat ofVideoPlayer::getPixelFormat() const{
 
 //---------------------------------------------------------------------------
 bool ofVideoPlayer::load(string name){
+#ifndef TARGET_OPENGLES
+	finishTextureStreaming();
+#endif
 	if( !player ){
 		setPlayer(std::make_shared<OF_VID_PLAYER_TYPE>());
 		player->setPixelFormat(internalPixelFormat);
@@ -99,6 +148,9 @@ bool ofVideoPlayer::load(string name){
 
 //---------------------------------------------------------------------------
 void ofVideoPlayer::loadAsync(string name){
+#ifndef TARGET_OPENGLES
+	finishTextureStreaming();
+#endif
 	if( !player ){
 		setPlayer(std::make_shared<OF_VID_PLAYER_TYPE>());
 		player->setPixelFormat(internalPixelFormat);
@@ -196,6 +248,11 @@ bool ofVideoPlayer::isFrameNew() const{
 //--------------------------------------------------------------------
 void ofVideoPlayer::update(){
 	if( player ){
+#ifndef TARGET_OPENGLES
+		// the pixels of the previous frame are only valid until the
+		// player updates
+		finishTextureStreaming();
+#endif
 
 		player->update();
 		
@@ -206,10 +263,25 @@ void ofVideoPlayer::update(){
 			if(playerTex == nullptr){
 				if(tex.size()!=player->getPixels().getNumPlanes()){
 					tex.resize(std::max(player->getPixels().getNumPlanes(),static_cast<std::size_t>(1)));
+#ifndef TARGET_OPENGLES
+					if(textureStream){
+						textureStream->upload.setup(3 * tex.size());
+					}
+#endif
 				}
 				if(std::size_t(player->getWidth()) != 0 && std::size_t(player->getHeight()) != 0) {
 					for(std::size_t i=0;i<player->getPixels().getNumPlanes();i++){
 						ofPixels plane = player->getPixels().getPlane(i);
+#ifndef TARGET_OPENGLES
+						if(textureStream){
+							ofPixels mapped;
+							int buffer = textureStream->upload.begin(mapped, plane.getWidth(), plane.getHeight(), plane.getPixelFormat());
+							if(buffer >= 0){
+								textureStream->planes.push_back({i, buffer, mapped.getData(), plane.getData(), plane.getTotalBytes()});
+								continue;
+							}
+						}
+#endif
 						bool bDiffPixFormat = ( tex[i].isAllocated() && tex[i].texData.glInternalFormat != ofGetGLInternalFormatFromPixelFormat(plane.getPixelFormat()) );
 						if(bDiffPixFormat || !tex[i].isAllocated() || std::size_t(tex[i].getWidth()) != plane.getWidth() || std::size_t(tex[i].getHeight()) != plane.getHeight())
 						{
@@ -217,6 +289,18 @@ void ofVideoPlayer::update(){
 						}
 						tex[i].loadData(plane);
 					}
+#ifndef TARGET_OPENGLES
+					if(textureStream && !textureStream->planes.empty()){
+						auto stream = textureStream.get();
+						auto claimed = std::make_shared<std::atomic<bool>>(false);
+						textureStream->copyClaimed = claimed;
+						textureStream->copy = ofGetTaskPool().async([stream, claimed]{
+							if(!claimed->exchange(true)){
+								stream->copyPlanes();
+							}
+						});
+					}
+#endif
 				}
 			}
 		}
@@ -230,6 +314,9 @@ void ofVideoPlayer::closeMovie(){
 
 //---------------------------------------------------------------------------
 void ofVideoPlayer::close(){
+#ifndef TARGET_OPENGLES
+	finishTextureStreaming();
+#endif
 	if( player ){
 		player->close();
 	}
@@ -388,6 +475,50 @@ bool ofVideoPlayer::isUsingTexture() const{
 	return bUseTexture;
 }
 
+//------------------------------------
+void ofVideoPlayer::setUseTextureStreaming(bool bStreaming){
+#ifndef TARGET_OPENGLES
+	if(bStreaming && !textureStream){
+		textureStream = std::make_shared<TextureStream>();
+		// a few frames for every plane
+		textureStream->upload.setup(3 * std::max(tex.size(), std::size_t(1)));
+	}else if(!bStreaming && textureStream){
+		finishTextureStreaming();
+		textureStream.reset();
+	}
+#endif
+}
+
+//------------------------------------
+bool ofVideoPlayer::isUsingTextureStreaming() const{
+#ifndef TARGET_OPENGLES
+	return textureStream != nullptr;
+#else
+	return false;
+#endif
+}
+
+#ifndef TARGET_OPENGLES
+//------------------------------------
+void ofVideoPlayer::finishTextureStreaming(){
+	if(!textureStream || !textureStream->copy.valid()){
+		return;
+	}
+	if(textureStream->claim()){
+		textureStream->copy.get();
+	}else{
+		// the workers are busy with other tasks, copying here is faster
+		// than waiting for them. the task still runs later but does nothing
+		textureStream->copyPlanes();
+		textureStream->copy = std::future<void>();
+	}
+	for(auto & plane: textureStream->planes){
+		textureStream->upload.end(plane.buffer, tex[plane.index]);
+	}
+	textureStream->planes.clear();
+}
+#endif
+
 //----------------------------------------------------------
 void ofVideoPlayer::setAnchorPercent(float xPct, float yPct){
 	getTexture().setAnchorPercent(xPct, yPct);
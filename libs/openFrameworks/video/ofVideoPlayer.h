@@ -108,6 +108,18 @@ class ofVideoPlayer : public ofBaseVideoPlayer,public ofBaseVideoDraws{
 
 		void 				setUseTexture(bool bUse);
 		bool 				isUsingTexture() const;
+		/// \brief Upload new frames through a ring of pixel buffers so
+		/// update() doesn't wait for the copy to the GPU.
+		///
+		/// A thread of ofGetTaskPool() copies every new frame to the mapped
+		/// buffers and the next update() starts the transfer to the
+		/// texture, so the texture is one update() behind the pixels.
+		///
+		/// Uses the memory of a few more frames. Only for players that
+		/// don't have a texture of their own, it does nothing with
+		/// OpenGL ES.
+		void 				setUseTextureStreaming(bool bStreaming);
+		bool 				isUsingTextureStreaming() const;
 		ofTexture &			getTexture();
 		const ofTexture &	getTexture() const;
 		OF_DEPRECATED_MSG("Use getTexture",ofTexture &			getTextureReference());
@@ -209,6 +221,11 @@ class ofVideoPlayer : public ofBaseVideoPlayer,public ofBaseVideoDraws{
 	private:
 		/// \brief Initialize the default player implementations.
 		void initDefaultPlayer();
+#ifndef TARGET_OPENGLES
+		/// \brief Wait for the frame being copied to the pixel buffers and
+		/// start its transfer to the textures.
+		void finishTextureStreaming();
+#endif
 		/// \brief A pointer to the internal video player implementation.
 		std::shared_ptr<ofBaseVideoPlayer>		player;
 		/// \brief A collection of texture planes used by the video player.
@@ -222,6 +239,12 @@ class ofVideoPlayer : public ofBaseVideoPlayer,public ofBaseVideoDraws{
 		ofTexture * playerTex;
 		/// \brief True if the video player is using a texture.
 		bool bUseTexture;
+#ifndef TARGET_OPENGLES
+		struct TextureStream;
+		/// \brief The pixel buffers for the uploads and the frame being
+		/// copied to them when texture streaming is enabled, null otherwise.
+		std::shared_ptr<TextureStream> textureStream;
+#endif
 		/// \brief The internal pixel format.
 		mutable ofPixelFormat internalPixelFormat;
 		/// \brief The stored path to the video's path.
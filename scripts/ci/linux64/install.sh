@@ -16,3 +16,5 @@ fi
 # sudo service postgresql stop
 
 sudo $OF_ROOT/scripts/linux/ubuntu/install_dependencies.sh -y;
+# virtual display for the gl tests
+sudo apt-get install -y xvfb
@@ -5,8 +5,21 @@ ROOT=$(pwd -P)
 echo "**** Running unit tests ****"
 cd $ROOT/tests
 for group in *; do
+	# benchmarks need release builds, and some of them hardware or data that
+	# CI doesn't have, they are run by hand
+	if [ "$group" == "benchmarks" ]; then
+		continue
+	fi
+	# the gl tests need OpenGL 3.2, which the CI machines don't have
+	if [ "$group" == "gl" ]; then
+		continue
+	fi
 	if [ -d $group ]; then
 		for test in $group/*; do
+			# ofxKinect needs libusb, which isn't installed here
+			if [ "$test" == "addons/kinect" ]; then
+				continue
+			fi
 			if [ -d $test ]; then
 				cd $test
 				cp ../../../scripts/templates/msys2/Makefile .
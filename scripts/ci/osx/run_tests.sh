@@ -21,6 +21,11 @@ make Debug
 echo "**** Running unit tests ****"
 cd $ROOT/tests
 for group in *; do
+    # benchmarks need release builds, and some of them hardware or data that
+    # CI doesn't have, they are run by hand
+    if [ "$group" == "benchmarks" ]; then
+        continue
+    fi
     if [ -d $group ]; then
         for test in $group/*; do
             if [ -d $test ]; then
@@ -0,0 +1,60 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofSpherePrimitive sphere1(10, 8);
+			ofSpherePrimitive sphere2(10, 8);
+			const ofSpherePrimitive & constSphere1 = sphere1;
+			const ofSpherePrimitive & constSphere2 = sphere2;
+			test(sphere1.isMeshShared(), "primitives share their mesh by default");
+			test(constSphere1.getMeshPtr() == constSphere2.getMeshPtr(), "primitives with the same parameters use the same mesh");
+			test_eq(sphere1.getMeshPtr() == constSphere2.getMeshPtr(), false, "the non const getMeshPtr() unshares the mesh");
+			test(sphere2.isMeshShared(), "unsharing one primitive doesn't unshare the others");
+		}
+
+		{
+			ofSpherePrimitive sphere(10, 8);
+			ofMesh & mesh = sphere.getMesh();
+			ofMesh * meshPtr = sphere.getMeshPtr();
+			test(&mesh == meshPtr, "getMesh() and getMeshPtr() return the same mesh");
+			auto numVertices = mesh.getNumVertices();
+
+			sphere.set(10, 16);
+			test(&sphere.getMesh() == &mesh, "set() keeps the mesh a user has a reference to");
+			test(mesh.getNumVertices() > numVertices, "the referenced mesh has the new geometry");
+			test_eq(sphere.isMeshShared(), false, "an exposed mesh is never shared again");
+
+			ofSpherePrimitive other(10, 16);
+			test_eq(other.getMesh().getNumVertices(), mesh.getNumVertices(), "the copied geometry is the same as the generated one");
+
+			sphere = other;
+			test(&sphere.getMesh() == &mesh, "assigning a primitive keeps the mesh a user has a reference to");
+		}
+
+		{
+			ofBoxPrimitive box1(10, 10, 10);
+			ofBoxPrimitive box2(10, 10, 10);
+			const ofMesh * shared = static_cast<const ofBoxPrimitive&>(box1).getMeshPtr();
+			test(shared->usingNormals(), "box has normals enabled");
+			box2.enableNormals();
+			test(box2.isMeshShared(), "enabling normals when they are already enabled doesn't unshare");
+			box2.disableNormals();
+			test_eq(box2.isMeshShared(), false, "disabling normals unshares");
+			test_eq(box2.getMesh().usingNormals(), false, "normals are disabled");
+			test(shared->usingNormals(), "the shared mesh is unchanged");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
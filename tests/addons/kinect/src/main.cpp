@@ -0,0 +1,238 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxKinectPlayer.h"
+#include "ofxKinectRecorder.h"
+#include "libfreenect_registration.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static const int numFrames = 5;
+	static const int width = ofxKinectCalibration::width;
+	static const int height = ofxKinectCalibration::height;
+
+	// a sphere moving in front of a wall
+	ofShortPixels createDepth(int frame){
+		ofShortPixels depth;
+		depth.allocate(width, height, 1);
+		glm::vec2 center(200 + frame * 8, 240);
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				float d = glm::distance(glm::vec2(x, y), center);
+				unsigned short z = d < 120 ? 1500 - sqrt(120 * 120 - d * d) * 4 : 3000;
+				// some pixels without depth, like the shadows of the emitter
+				if((x + y * 7 + frame) % 61 == 0){
+					z = 0;
+				}
+				depth[y * width + x] = z;
+			}
+		}
+		return depth;
+	}
+
+	ofPixels createVideo(int frame){
+		ofPixels video;
+		video.allocate(width, height, 3);
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				video.setColor(x, y, ofColor(x * 255 / width, y * 255 / height, frame * 40));
+			}
+		}
+		return video;
+	}
+
+	// tables like libfreenect's that see every depth pixel 10 pixels to
+	// the right in the video image
+	ofxKinectCalibration createRegisteredCalibration(){
+		std::vector<int32_t> shift(ofxKinectCalibration::maxDepth, 0);
+		std::vector<int32_t> table(width * height * 2);
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				table[(y * width + x) * 2] = (x + 10) * 256;
+				table[(y * width + x) * 2 + 1] = y;
+			}
+		}
+		freenect_registration registration{};
+		registration.zero_plane_info.reference_pixel_size = 0.1042f;
+		registration.zero_plane_info.reference_distance = 120;
+		registration.zero_plane_info.dcmos_emitter_dist = 7.5f;
+		registration.zero_plane_info.dcmos_rcmos_dist = 2.3f;
+		registration.depth_to_rgb_shift = shift.data();
+		registration.registration_table = reinterpret_cast<int32_t(*)[2]>(table.data());
+		ofxKinectCalibration calibration;
+		calibration.setup(registration);
+		return calibration;
+	}
+
+	bool samePixels(const ofShortPixels & a, const ofShortPixels & b){
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+	}
+
+	bool samePixels(const ofPixels & a, const ofPixels & b){
+		return a.size() == b.size() && a.getNumChannels() == b.getNumChannels() && std::equal(a.begin(), a.end(), b.begin());
+	}
+
+	std::string record(const std::string & name, const ofxKinectCalibration & calibration, int videoChannels){
+		auto path = ofToDataPath(name + ".kinect", true);
+		ofxKinectRecorder recorder;
+		test(recorder.open(path, calibration, videoChannels), name + " recorder open");
+		for(int frame = 0; frame < numFrames; frame++){
+			recorder.addFrame(createDepth(frame), createVideo(frame));
+		}
+		test_eq(recorder.getNumFrames(), numFrames, name + " frames recorded");
+		recorder.close();
+		return path;
+	}
+
+	void playback(const std::string & name, const ofxKinectCalibration & calibration, int videoChannels){
+		auto path = record(name, calibration, videoChannels);
+		ofxKinectPlayer player;
+		test(player.load(path, false), name + " player load");
+		test_eq(player.getNumFrames(), numFrames, name + " frames played");
+
+		auto & played = player.getCalibration();
+		test_eq(played.getZeroPlanePixelSize(), calibration.getZeroPlanePixelSize(), name + " zero plane pixel size");
+		test_eq(played.getZeroPlaneDistance(), calibration.getZeroPlaneDistance(), name + " zero plane distance");
+		test_eq(played.getSensorEmitterDistance(), calibration.getSensorEmitterDistance(), name + " sensor emitter distance");
+		test_eq(played.getSensorCameraDistance(), calibration.getSensorCameraDistance(), name + " sensor camera distance");
+		test_eq(played.hasRegistration(), calibration.hasRegistration(), name + " registration");
+		bool sameMapping = true;
+		for(int y = 0; y < height; y += 7){
+			for(int x = 0; x < width; x += 7){
+				for(unsigned short z: {0, 800, 3000, 9999}){
+					sameMapping &= played.getVideoIndexAt(x, y, z) == calibration.getVideoIndexAt(x, y, z);
+				}
+			}
+		}
+		test(sameMapping, name + " depth to video mapping");
+
+		bool sameFrames = true;
+		for(int frame = 0; frame < numFrames; frame++){
+			player.update();
+			sameFrames &= player.isFrameNew() && player.getCurrentFrame() == frame;
+			sameFrames &= samePixels(player.getRawDepthPixels(), createDepth(frame));
+			if(videoChannels > 0){
+				sameFrames &= samePixels(player.getPixels(), createVideo(frame));
+			}
+		}
+		test(sameFrames, name + " frames equal the recorded ones");
+		if(videoChannels == 0){
+			test(!player.getPixels().isAllocated(), name + " no video pixels");
+		}
+
+		player.update();
+		test_eq(player.getCurrentFrame(), 0, name + " loops");
+		player.setLoop(false);
+		player.setFrame(numFrames - 1);
+		player.update();
+		test(!player.isFrameNew(), name + " stops at the end without looping");
+
+		pointCloud(name, player, videoChannels > 0);
+		depthPixels(name, player);
+	}
+
+	void pointCloud(const std::string & name, ofxKinectPlayer & player, bool hasVideo){
+		auto & calibration = player.getCalibration();
+		auto & depth = player.getRawDepthPixels();
+		std::vector<glm::vec3> perPixel;
+		std::vector<glm::vec3> perPixelStep2;
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				float z = depth[y * width + x];
+				if(z > 0){
+					perPixel.push_back(calibration.getWorldCoordinateAt(x, y, z));
+					if(x % 2 == 0 && y % 2 == 0){
+						perPixelStep2.push_back(perPixel.back());
+					}
+				}
+			}
+		}
+
+		std::vector<glm::vec3> points;
+		player.getPointCloud(points);
+		bool same = points.size() == perPixel.size();
+		for(std::size_t i = 0; same && i < points.size(); i++){
+			same = glm::distance(points[i], perPixel[i]) < 0.001f;
+		}
+		test(same, name + " point cloud equals the per pixel conversion");
+
+		player.getPointCloud(points, 2);
+		same = points.size() == perPixelStep2.size();
+		for(std::size_t i = 0; same && i < points.size(); i++){
+			same = glm::distance(points[i], perPixelStep2[i]) < 0.001f;
+		}
+		test(same, name + " point cloud with step 2");
+
+		player.getPointCloud(points, 1, false);
+		test_eq(points.size(), std::size_t(width * height), name + " point cloud keeping the pixels without depth");
+
+		// the points without a video pixel are left out of the mesh
+		ofMesh mesh;
+		player.getPointCloud(mesh);
+		auto & video = player.getPixels();
+		std::size_t numColored = 0;
+		bool sameColors = true;
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				unsigned short z = depth[y * width + x];
+				if(z == 0){
+					continue;
+				}
+				if(!hasVideo){
+					numColored++;
+					continue;
+				}
+				int index = calibration.getVideoIndexAt(x, y, z);
+				if(index < 0){
+					continue;
+				}
+				if(numColored < mesh.getNumColors()){
+					sameColors &= mesh.getColor(numColored) == ofFloatColor(video.getColor(index * video.getNumChannels()));
+				}
+				numColored++;
+			}
+		}
+		test_eq(mesh.getNumVertices(), numColored, name + " mesh vertices");
+		if(hasVideo){
+			test_eq(mesh.getNumColors(), numColored, name + " mesh colors");
+			test(sameColors, name + " mesh colors from the video pixels");
+		}else{
+			test_eq(mesh.getNumColors(), std::size_t(0), name + " mesh without video has no colors");
+		}
+	}
+
+	void depthPixels(const std::string & name, ofxKinectPlayer & player){
+		auto & raw = player.getRawDepthPixels();
+		auto check = [&](bool nearWhite){
+			bool same = true;
+			for(std::size_t i = 0; i < raw.size(); i++){
+				unsigned char expected = raw[i] == 0 ? 0 : (unsigned char)ofMap(raw[i], 500, 4000, nearWhite ? 255 : 0, nearWhite ? 0 : 255, true);
+				same &= player.getDepthPixels()[i] == expected;
+				same &= player.getDistancePixels()[i] == raw[i];
+			}
+			return same;
+		};
+		player.setDepthClipping(500, 4000);
+		player.enableDepthNearValueWhite(true);
+		test(check(true), name + " depth and distance pixels");
+		player.enableDepthNearValueWhite(false);
+		test(check(false), name + " depth pixels with near values black");
+	}
+
+	void run(){
+		ofxKinectCalibration calibration;
+		calibration.setup(0.1, 121, 7.4, 2.4);
+		playback("rgb", calibration, 3);
+		playback("depthOnly", calibration, 0);
+		playback("registered", createRegisteredCalibration(), 3);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
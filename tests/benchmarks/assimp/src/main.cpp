@@ -0,0 +1,136 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxAssimpModelLoader.h"
+#include "ofxBenchmark.h"
+#include "ofxBenchmarkAllocations.h"
+
+class ofApp: public ofxBenchmarkApp{
+	static const std::size_t numModels = 16;
+
+	// the animated model of the assimp example, so the benchmark needs no
+	// data of its own
+	std::string modelPath(){
+		return ofToDataPath("../../../../../examples/3d/assimpExample/bin/data/astroBoy_walk.dae", true);
+	}
+
+	// moves the animations of a model a fixed step instead of using the
+	// elapsed time, so every run skins the same poses
+	void step(ofxAssimpModelLoader & model, float & position){
+		position = fmod(position + 0.01f, 1.f);
+		model.setPositionForAllAnimations(position);
+	}
+
+	ofxBenchmarkOptions heavy(){
+		ofxBenchmarkOptions options;
+		options.warmup = 1;
+		options.repetitions = 5;
+		options.iterations = 1;
+		return options;
+	}
+
+	bool loadModels(std::vector<ofxAssimpModelLoader> & models, float sampleRate){
+		for(auto & model: models){
+			model.setAnimationSampleRate(sampleRate);
+			if(!model.loadModel(modelPath())){
+				test(false, "load " + modelPath());
+				return false;
+			}
+			model.setLoopStateForAllAnimations(OF_LOOP_NORMAL);
+			model.playAllAnimations();
+			model.setPausedForAllAnimations(true);
+		}
+		return true;
+	}
+
+	void runBenchmarks(){
+		loading();
+
+		std::vector<ofxAssimpModelLoader> models(numModels);
+		if(!loadModels(models, 0)){
+			return;
+		}
+		std::vector<ofxAssimpModelLoader*> pointers;
+		for(auto & model: models){
+			pointers.push_back(&model);
+		}
+		std::vector<float> positions(numModels, 0.f);
+		for(std::size_t i = 0; i < numModels; i++){
+			positions[i] = float(i) / numModels;
+		}
+
+		benchmark("assimp update 1 model", [&]{
+			step(models[0], positions[0]);
+			models[0].update();
+		});
+
+		benchmark("assimp update 16 models", [&]{
+			for(std::size_t i = 0; i < numModels; i++){
+				step(models[i], positions[i]);
+				models[i].update();
+			}
+		});
+
+		benchmark("assimp updateModels 16 models", [&]{
+			for(std::size_t i = 0; i < numModels; i++){
+				step(models[i], positions[i]);
+			}
+			ofxAssimpModelLoader::updateModels(pointers);
+		});
+
+		// no bone moved so there's nothing to skin or upload
+		benchmark("assimp update paused model", [&]{
+			models[0].update();
+		});
+
+		std::vector<ofxAssimpModelLoader> bakedModels(numModels);
+		if(!loadModels(bakedModels, 30)){
+			return;
+		}
+		std::vector<ofxAssimpModelLoader*> bakedPointers;
+		for(auto & model: bakedModels){
+			bakedPointers.push_back(&model);
+		}
+		benchmark("assimp updateModels 16 models baked", [&]{
+			for(std::size_t i = 0; i < numModels; i++){
+				step(bakedModels[i], positions[i]);
+			}
+			ofxAssimpModelLoader::updateModels(bakedPointers);
+		});
+	}
+
+	void loading(){
+		benchmark("assimp loadModel", [&]{
+			ofxAssimpModelLoader model;
+			model.loadModel(modelPath());
+			ofxBenchmarkKeep(model.getMeshCount());
+		}, heavy());
+
+		ofxAssimpModelLoader sharedModel;
+		sharedModel.setSceneSharing(true);
+		sharedModel.loadModel(modelPath());
+		benchmark("assimp loadModel shared scene", [&]{
+			ofxAssimpModelLoader model;
+			model.setSceneSharing(true);
+			model.loadModel(modelPath());
+			ofxBenchmarkKeep(model.getMeshCount());
+		}, heavy());
+
+		ofxAssimpModelLoader asyncModel;
+		asyncModel.loadModelAsync(modelPath());
+		test(asyncModel.waitForLoading(), "loadModelAsync");
+		test_eq(asyncModel.getMeshCount(), sharedModel.getMeshCount(), "loadModelAsync meshes");
+		test_eq(asyncModel.getAnimationCount(), sharedModel.getAnimationCount(), "loadModelAsync animations");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the models need a GL context to load, the window is never shown
+	ofGLFWWindowSettings settings;
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
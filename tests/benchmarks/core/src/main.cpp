@@ -0,0 +1,508 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofCairoRenderer.h"
+#include "ofxBenchmark.h"
+#include "ofxBenchmarkAllocations.h"
+
+class ofApp: public ofxBenchmarkApp{
+	// heavy benchmarks, like building indices of a million points, run less
+	// times so the whole suite still finishes in reasonable time
+	ofxBenchmarkOptions heavy(){
+		ofxBenchmarkOptions options;
+		options.warmup = 1;
+		options.repetitions = 5;
+		return options;
+	}
+
+	void runBenchmarks(){
+		ofGetRandomEngine().seed(0);
+		pixels();
+		colorTransforms();
+		mesh();
+		primitives();
+		camera();
+		polyline();
+		bitmapFont();
+		events();
+		threadChannel();
+		strings();
+		files();
+		random();
+		taskPool();
+		spatialIndices();
+		particles();
+		cairo();
+	}
+
+	void pixels(){
+		ofPixels pixels;
+		pixels.allocate(1920, 1080, OF_PIXELS_RGB);
+		std::vector<float> values(pixels.size());
+		ofGetRandomEngine().fillUniform(values.data(), values.size(), 0, 255);
+		for(size_t i = 0; i < pixels.size(); i++){
+			pixels[i] = values[i];
+		}
+		benchmark("pixels mirror 1080p", [&]{
+			pixels.mirror(true, true);
+		});
+		benchmark("pixels swapRgb 1080p", [&]{
+			pixels.swapRgb();
+		});
+		ofPixels resized;
+		resized.allocate(960, 540, OF_PIXELS_RGB);
+		benchmark("pixels resize 1080p to 540p", [&]{
+			pixels.resizeTo(resized);
+		});
+		ofPixels gray;
+		benchmark("pixels rgb to gray 1080p", [&]{
+			gray = pixels;
+			gray.setImageType(OF_IMAGE_GRAYSCALE);
+		});
+		benchmark("pixels iterator invert 1080p", [&]{
+			for(auto pixel: pixels.getPixelsIter()){
+				for(size_t c = 0; c < pixel.getComponentsPerPixel(); c++){
+					pixel[c] = 255 - pixel[c];
+				}
+			}
+		});
+		benchmark("pixels kernel invert 1080p", [&]{
+			ofPixelsMap<3>(pixels, [](ofPixelValue<unsigned char, 3> p){
+				for(size_t c = 0; c < 3; c++){
+					p[c] = 255 - p[c];
+				}
+				return p;
+			});
+		});
+		benchmark("pixels kernel rgb to gray 1080p", [&]{
+			ofPixelsMap<3>(pixels, gray, [](ofPixelValue<unsigned char, 3> p){
+				return ofPixelValue<unsigned char, 1>{{(unsigned char)((p[0] * 77 + p[1] * 150 + p[2] * 29) >> 8)}};
+			});
+		});
+		float blur[3][3] = {{1/16.f, 2/16.f, 1/16.f}, {2/16.f, 4/16.f, 2/16.f}, {1/16.f, 2/16.f, 1/16.f}};
+		ofPixels blurred;
+		benchmark("pixels kernel convolve 3x3 1080p", [&]{
+			ofPixelsConvolve<3>(pixels, blurred, blur);
+		});
+	}
+
+	void colorTransforms(){
+		ofFloatPixels pixels;
+		pixels.allocate(1920, 1080, OF_PIXELS_RGB);
+		ofGetRandomEngine().fillUniform(pixels);
+		// every pair of transforms leaves the pixels as they were so the
+		// values don't drift between repetitions
+		benchmark("color srgb to linear and back 1080p", [&]{
+			pixels.convertSrgbToLinear();
+			pixels.convertLinearToSrgb();
+		});
+		benchmark("color rgb to hsb and back 1080p", [&]{
+			pixels.convertRgbToHsb();
+			pixels.convertHsbToRgb();
+		});
+		ofColorLut lut;
+		lut.allocate3D(33);
+		benchmark("color 3d lut 1080p", [&]{
+			pixels.applyLut(lut);
+		});
+	}
+
+	void mesh(){
+		// spheres of about 1k, 100k and 1M vertices, a sphere of resolution
+		// res has (res + 1) * (2 * res + 1) vertices, to show how the cost
+		// grows with the size of the mesh
+		for(int res: {22, 224, 707}){
+			auto sphere = ofMesh::sphere(100, res);
+			auto size = ofToString(sphere.getNumVertices()) + " vertices";
+			auto options = sphere.getNumVertices() > 500000 ? heavy() : ofxBenchmarkOptions();
+			ofMesh mesh;
+			// the copy is measured too since the normals functions rebuild
+			// the mesh in place
+			benchmark("mesh copy sphere " + size, [&]{
+				mesh = sphere;
+			}, options);
+			benchmark("mesh smooth normals sphere " + size, [&]{
+				mesh = sphere;
+				mesh.smoothNormals(60);
+			}, options);
+			benchmark("mesh smooth normals angle weighted sphere " + size, [&]{
+				mesh = sphere;
+				mesh.smoothNormals(60, OF_MESH_NORMALS_ANGLE_WEIGHTED);
+			}, options);
+			benchmark("mesh flat normals sphere " + size, [&]{
+				mesh = sphere;
+				mesh.flatNormals();
+			}, options);
+		}
+	}
+
+	void primitives(){
+		benchmark("primitive sphere generated", [&]{
+			ofxBenchmarkKeep(ofMesh::sphere(100, 48).getNumVertices());
+		});
+		// a live instance keeps the mesh in the cache
+		ofSpherePrimitive cached(100, 48);
+		benchmark("primitive sphere shared", [&]{
+			ofSpherePrimitive sphere(100, 48);
+			ofxBenchmarkKeep(sphere.isMeshShared());
+		});
+
+		// construction time and memory of many primitives with the same
+		// parameters, sharing the cached mesh or each with its own copy
+		const std::size_t count = 10000;
+		std::vector<ofSpherePrimitive> spheres;
+		auto shared = benchmark("primitive 10k spheres shared", [&]{
+			spheres.clear();
+			spheres.reserve(count);
+			for(std::size_t i = 0; i < count; i++){
+				spheres.emplace_back(100, 48);
+			}
+		}, heavy());
+		auto unshared = benchmark("primitive 10k spheres unshared", [&]{
+			spheres.clear();
+			spheres.reserve(count);
+			for(std::size_t i = 0; i < count; i++){
+				spheres.emplace_back(100, 48);
+				ofxBenchmarkKeep(spheres.back().getMesh().getNumVertices());
+			}
+		}, heavy());
+		spheres.clear();
+		if(ofxBenchmarkIsCountingAllocations()){
+			ofLogNotice() << "10k spheres allocate " << ofToString(shared.allocatedBytes / 1024 / 1024, 1)
+				<< "MB shared, " << ofToString(unshared.allocatedBytes / 1024 / 1024, 1) << "MB unshared";
+		}
+	}
+
+	void camera(){
+		ofCamera camera;
+		camera.setPosition(0, 0, 500);
+		camera.lookAt(glm::vec3(0));
+		ofRectangle viewport(0, 0, 1920, 1080);
+		std::vector<glm::vec3> points(100000);
+		ofGetRandomEngine().fillInSphere(points.data(), points.size(), 200);
+		std::vector<glm::vec3> screen(points.size());
+		benchmark("camera worldToScreen 100k one by one", [&]{
+			for(size_t i = 0; i < points.size(); i++){
+				screen[i] = camera.worldToScreen(points[i], viewport);
+			}
+		});
+		benchmark("camera worldToScreen 100k batch", [&]{
+			camera.worldToScreen(points.data(), screen.data(), points.size(), viewport);
+		});
+		benchmark("camera screenToWorld 100k batch", [&]{
+			camera.screenToWorld(screen.data(), points.data(), points.size(), viewport);
+		});
+	}
+
+	void polyline(){
+		ofPolyline line;
+		for(int i = 0; i < 10000; i++){
+			float angle = i * TWO_PI / 10000;
+			float radius = 300 + ofRandom(-10, 10);
+			line.addVertex(cos(angle) * radius, sin(angle) * radius);
+		}
+		line.close();
+		benchmark("polyline smoothed 10k", [&]{
+			ofxBenchmarkKeep(line.getSmoothed(5).size());
+		});
+		benchmark("polyline resampled 10k", [&]{
+			ofxBenchmarkKeep(line.getResampledBySpacing(1).size());
+		});
+		benchmark("polyline closest point 10k", [&]{
+			ofxBenchmarkKeep(line.getClosestPoint(glm::vec3(1000, 20, 0)));
+		});
+		benchmark("polyline inside 10k", [&]{
+			ofxBenchmarkKeep(line.inside(10, 20));
+		});
+	}
+
+	void bitmapFont(){
+		ofBitmapFont font;
+		std::vector<std::string> lines;
+		for(int i = 0; i < 100; i++){
+			lines.push_back("line " + ofToString(i) + ": value " + ofToString(i * 0.5f));
+		}
+		// the same mesh is reused like the renderers do
+		ofMesh mesh;
+		font.setCacheSize(0);
+		benchmark("bitmap font mesh 100 lines", [&]{
+			for(std::size_t i = 0; i < lines.size(); i++){
+				font.getCachedMesh(lines[i], mesh);
+				ofxBenchmarkKeep(mesh.getNumVertices());
+			}
+		});
+		font.setCacheSize(128);
+		benchmark("bitmap font cached mesh 100 lines", [&]{
+			for(std::size_t i = 0; i < lines.size(); i++){
+				font.getCachedMesh(lines[i], mesh);
+				ofxBenchmarkKeep(mesh.getNumVertices());
+			}
+		});
+		benchmark("bitmap font batch 100 lines", [&]{
+			font.clearBatch();
+			for(std::size_t i = 0; i < lines.size(); i++){
+				font.addToBatch(lines[i], 10, int(20 + i * 14), true, glm::mat4(1.0), ofFloatColor::white);
+			}
+			ofxBenchmarkKeep(font.getBatch().getNumVertices());
+		});
+	}
+
+	void events(){
+		ofEvent<int> event;
+		int sum = 0;
+		std::vector<ofEventListener> listeners;
+		for(int i = 0; i < 10; i++){
+			listeners.push_back(event.newListener([&sum](int & value){
+				sum += value;
+			}));
+		}
+		int value = 1;
+		benchmark("events notify 10 listeners", [&]{
+			event.notify(value);
+		});
+		benchmark("events add and remove listener", [&]{
+			auto listener = event.newListener([&sum](int & value){
+				sum -= value;
+			});
+		});
+		ofxBenchmarkKeep(sum);
+	}
+
+	void threadChannel(){
+		ofThreadChannel<int> toWorker;
+		ofThreadChannel<int> fromWorker;
+		std::thread worker([&]{
+			int value;
+			while(toWorker.receive(value)){
+				fromWorker.send(value);
+			}
+		});
+		int value = 0;
+		benchmark("thread channel round trip", [&]{
+			toWorker.send(value);
+			fromWorker.receive(value);
+		});
+		benchmark("thread channel 1000 values", [&]{
+			for(int i = 0; i < 1000; i++){
+				toWorker.send(i);
+			}
+			for(int i = 0; i < 1000; i++){
+				fromWorker.receive(value);
+			}
+		});
+		toWorker.close();
+		worker.join();
+	}
+
+	void strings(){
+		std::vector<std::string> numbers;
+		for(int i = 0; i < 10000; i++){
+			numbers.push_back(ofToString(ofRandom(-100000, 100000)));
+		}
+		auto csv = ofJoinString(numbers, ",");
+		benchmark("strings split 10k", [&]{
+			ofxBenchmarkKeep(ofSplitString(csv, ",").size());
+		});
+		benchmark("strings splitter 10k", [&]{
+			size_t count = 0;
+			for(auto token: ofStringSplitter(csv, ",")){
+				count += token.size();
+			}
+			ofxBenchmarkKeep(count);
+		});
+		benchmark("strings toFloat 10k", [&]{
+			float sum = 0;
+			for(auto & number: numbers){
+				sum += ofToFloat(number);
+			}
+			ofxBenchmarkKeep(sum);
+		});
+		benchmark("strings toInt 10k", [&]{
+			int sum = 0;
+			for(auto & number: numbers){
+				sum += ofToInt(number);
+			}
+			ofxBenchmarkKeep(sum);
+		});
+		benchmark("strings toString 10k", [&]{
+			size_t length = 0;
+			for(int i = 0; i < 10000; i++){
+				length += ofToString(i * 0.5f).size();
+			}
+			ofxBenchmarkKeep(length);
+		});
+		std::string text;
+		benchmark("strings replace 100k", [&]{
+			text = csv;
+			ofStringReplace(text, ",", ", ");
+		});
+		benchmark("strings lower 100k", [&]{
+			ofxBenchmarkKeep(ofToLower(csv).size());
+		});
+	}
+
+	void files(){
+		ofBuffer buffer;
+		buffer.allocate(16 * 1024 * 1024);
+		for(size_t i = 0; i < buffer.size(); i++){
+			buffer.getData()[i] = i % 251;
+		}
+		auto path = ofToDataPath("benchmark_io.bin");
+		benchmark("file write 16MB", [&]{
+			ofBufferToFile(path, buffer);
+		}, heavy());
+		benchmark("file read 16MB", [&]{
+			ofxBenchmarkKeep(ofBufferFromFile(path).size());
+		}, heavy());
+		ofFile::removeFile(path);
+	}
+
+	void random(){
+		std::vector<float> floats(1 << 20);
+		benchmark("random ofRandom 1M", [&]{
+			for(auto & value: floats){
+				value = ofRandom(1);
+			}
+		});
+		benchmark("random fillUniform 1M", [&]{
+			ofGetRandomEngine().fillUniform(floats.data(), floats.size());
+		});
+		benchmark("random fillNormal 1M", [&]{
+			ofGetRandomEngine().fillNormal(floats.data(), floats.size());
+		});
+		std::vector<glm::vec3> points(1 << 20);
+		benchmark("random fillInSphere 1M", [&]{
+			ofGetRandomEngine().fillInSphere(points.data(), points.size());
+		});
+	}
+
+	void taskPool(){
+		std::vector<float> values(1 << 22);
+		ofGetRandomEngine().fillUniform(values.data(), values.size());
+		std::vector<float> results(values.size());
+		benchmark("task pool serial sqrt 4M", [&]{
+			for(size_t i = 0; i < values.size(); i++){
+				results[i] = sqrt(values[i]);
+			}
+		});
+		benchmark("task pool parallel sqrt 4M", [&]{
+			ofParallelForRange(0, values.size(), [&](size_t begin, size_t end){
+				for(size_t i = begin; i < end; i++){
+					results[i] = sqrt(values[i]);
+				}
+			}, 1 << 14);
+		});
+		benchmark("task pool parallel reduce 4M", [&]{
+			ofxBenchmarkKeep(ofParallelReduce(0, values.size(), 0.0,
+				[&](size_t i){ return double(values[i]); },
+				[](double a, double b){ return a + b; }, 1 << 14));
+		});
+		benchmark("task pool empty tasks 1000", [&]{
+			ofTaskGroup group;
+			for(int i = 0; i < 1000; i++){
+				group.run([]{});
+			}
+			group.wait();
+		});
+	}
+
+	void spatialIndices(){
+		std::vector<glm::vec3> points(1000000);
+		ofGetRandomEngine().fillInSphere(points.data(), points.size(), 1000);
+		std::vector<glm::vec3> targets(10000);
+		ofGetRandomEngine().fillInSphere(targets.data(), targets.size(), 1000);
+		std::vector<size_t> indices;
+
+		ofKdTree3d tree;
+		benchmark("kd tree build 1M", [&]{
+			tree.build(points);
+		}, heavy());
+		benchmark("kd tree 10k closest in 1M", [&]{
+			size_t nearest = 0;
+			for(auto & target: targets){
+				tree.getClosestPoint(target, &nearest);
+			}
+			ofxBenchmarkKeep(nearest);
+		});
+		benchmark("kd tree 10k radius in 1M", [&]{
+			size_t found = 0;
+			for(auto & target: targets){
+				tree.findInRadius(target, 20, indices);
+				found += indices.size();
+			}
+			ofxBenchmarkKeep(found);
+		});
+
+		ofSpatialGrid3d grid(20);
+		benchmark("grid build 1M", [&]{
+			grid.build(points);
+		}, heavy());
+		benchmark("grid 10k radius in 1M", [&]{
+			size_t found = 0;
+			for(auto & target: targets){
+				grid.findInRadius(target, 20, indices);
+				found += indices.size();
+			}
+			ofxBenchmarkKeep(found);
+		});
+
+		auto sphere = ofMesh::sphere(100, 512);
+		ofMeshBvh bvh;
+		benchmark("bvh build sphere 512", [&]{
+			bvh.build(sphere);
+		}, heavy());
+		benchmark("bvh 10k rays sphere 512", [&]{
+			size_t hits = 0;
+			ofMeshBvh::Intersection intersection;
+			for(auto & target: targets){
+				auto origin = glm::normalize(target) * 500.f;
+				hits += bvh.intersect(origin, -origin, intersection);
+			}
+			ofxBenchmarkKeep(hits);
+		});
+	}
+
+	void particles(){
+		ofParticleSystem particles;
+		particles.resize(1000000);
+		ofGetRandomEngine().fillInSphere(particles.getPositions(), particles.size(), 100);
+		ofGetRandomEngine().fillInSphere(particles.getVelocities(), particles.size(), 10);
+		particles.setAcceleration(glm::vec3(0, -9.8, 0));
+		particles.setDamping(0.1);
+		benchmark("particles update 1M", [&]{
+			particles.update(1 / 60.f);
+		});
+	}
+
+	void cairo(){
+		std::vector<glm::vec3> circles(2000);
+		ofGetRandomEngine().fillInSphere(circles.data(), circles.size(), 1024);
+		for(int tileSize: {0, 256}){
+			ofCairoRenderer renderer;
+			renderer.setTiledRendering(tileSize);
+			renderer.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, 2048, 2048));
+			auto name = tileSize ? "cairo 2000 circles 2048px tiled" : "cairo 2000 circles 2048px";
+			benchmark(name, [&]{
+				renderer.startRender();
+				renderer.setColor(255, 255, 255, 128);
+				for(auto & circle: circles){
+					renderer.drawCircle(circle.x + 1024, circle.y + 1024, 0, 20 + circle.z * 0.02);
+				}
+				renderer.finishRender();
+				ofxBenchmarkKeep(renderer.getImageSurfacePixels().getData());
+			}, heavy());
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	// this kicks off the running of my app
+	// can be OF_WINDOW or OF_FULLSCREEN
+	// pass in width and height too:
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
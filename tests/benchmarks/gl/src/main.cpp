@@ -0,0 +1,232 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxBenchmark.h"
+#include "ofxBenchmarkAllocations.h"
+
+class ofApp: public ofxBenchmarkApp{
+	static const int numShapes = 10000;
+
+	std::shared_ptr<ofGLProgrammableRenderer> renderer;
+
+	// a grid of small shapes with different colors, some of them rotated
+	void drawShapes(int count){
+		for(int i = 0; i < count; i++){
+			float x = (i % 100) * 2.5f;
+			float y = (i / 100 % 100) * 2.5f;
+			ofSetColor(i % 255, (i * 7) % 255, (i * 13) % 255);
+			switch(i % 4){
+			case 0:
+				ofDrawRectangle(x, y, 2, 2);
+				break;
+			case 1:
+				ofDrawCircle(x + 1, y + 1, 1);
+				break;
+			case 2:
+				ofDrawTriangle(x, y, x + 2, y, x + 1, y + 2);
+				break;
+			case 3:
+				ofPushMatrix();
+				ofTranslate(x + 1, y + 1);
+				ofRotateDeg(45);
+				ofDrawRectangle(-1, -1, 2, 2);
+				ofPopMatrix();
+				break;
+			}
+		}
+		ofNoFill();
+		ofDrawLine(0, 0, 250, 250);
+		ofDrawRectangle(10, 10, 100, 100);
+		ofFill();
+	}
+
+	// a custom shader with a float and a vec2 uniform added to the color
+	ofShader loadUniformsShader(){
+		ofShader shader;
+		shader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			void main(){
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		shader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			uniform float brightness;
+			uniform vec2 offset;
+			out vec4 fragColor;
+			void main(){
+				fragColor = vec4(brightness + offset.x, offset.y, 0.0, 1.0);
+			})");
+		shader.bindDefaults();
+		shader.linkProgram();
+		return shader;
+	}
+
+	// a custom shader with the loose default uniforms, set by the
+	// renderer on every draw
+	ofShader loadCustomShader(){
+		ofShader shader;
+		shader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			void main(){
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		shader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			uniform vec4 globalColor;
+			out vec4 fragColor;
+			void main(){
+				fragColor = globalColor;
+			})");
+		shader.bindDefaults();
+		shader.linkProgram();
+		return shader;
+	}
+
+	void runBenchmarks(){
+		renderer = std::dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+		if(!renderer){
+			test(false, "programmable renderer");
+			return;
+		}
+
+
+		ofDisableShapeBatching();
+		benchmark("draw 10k shapes", [&]{
+			drawShapes(numShapes);
+		});
+
+		// every rectangle changes the matrices and the color, this is the
+		// per draw cost of uploadMatrices() and setDefaultUniforms(). it
+		// only uses the public api so it can be copied to older commits
+		auto transformed = benchmark("draw 10k transformed rects", [&]{
+			drawTransformedRects(numShapes);
+		});
+		logPerDraw(transformed, numShapes);
+
+		// the same with a custom shader, the renderer sets its loose
+		// default uniforms instead of the ofDefaultUniforms block
+		ofShader customShader = loadCustomShader();
+		customShader.begin();
+		auto transformedCustom = benchmark("draw 10k transformed rects custom shader", [&]{
+			drawTransformedRects(numShapes);
+		});
+		customShader.end();
+		logPerDraw(transformedCustom, numShapes);
+		ofSetColor(255);
+
+		ofEnableShapeBatching();
+		benchmark("draw 10k shapes batched", [&]{
+			drawShapes(numShapes);
+			ofFlushShapes();
+		});
+
+		benchmark("draw 10k rects batched", [&]{
+			for(int i = 0; i < numShapes; i++){
+				ofDrawRectangle((i % 100) * 2.5f, (i / 100) * 2.5f, 2, 2);
+			}
+			ofFlushShapes();
+		});
+		ofDisableShapeBatching();
+
+		ofMesh mesh = ofMesh::sphere(10, 12);
+		benchmark("draw 1k dynamic meshes", [&]{
+			for(int i = 0; i < 1000; i++){
+				mesh.draw();
+			}
+		});
+
+		ofShader shader = loadUniformsShader();
+		ofShader::Uniform brightness = shader.getUniform("brightness");
+		shader.begin();
+		benchmark("set 10k uniforms by name", [&]{
+			for(int i = 0; i < numShapes; i++){
+				shader.setUniform1f("brightness", i);
+			}
+		});
+		benchmark("set 10k uniforms by handle", [&]{
+			for(int i = 0; i < numShapes; i++){
+				shader.setUniform1f(brightness, i);
+			}
+		});
+		shader.end();
+
+		ofPolyline poly;
+		for(int i = 0; i < 100; i++){
+			poly.addVertex(i, (i * 7) % 13);
+		}
+		benchmark("draw 1k polylines", [&]{
+			for(int i = 0; i < 1000; i++){
+				poly.draw();
+			}
+		});
+
+		ofFbo fbo;
+		fbo.allocate(1920, 1080, GL_RGBA);
+		ofPixels pixels;
+		benchmark("draw and read 1080p", [&]{
+			fbo.begin();
+			ofClear(ofRandom(255), 255);
+			fbo.end();
+			fbo.readToPixels(pixels);
+		});
+
+		ofPixelsReadback readback;
+		readback.setup(3);
+		benchmark("draw and read 1080p async", [&]{
+			fbo.begin();
+			ofClear(ofRandom(255), 255);
+			fbo.end();
+			fbo.readToPixelsAsync(readback);
+			readback.getPixels(pixels);
+		});
+
+		ofPixels frame;
+		frame.allocate(3840, 2160, OF_PIXELS_RGBA);
+		frame.set(127);
+		ofTexture texture;
+		texture.allocate(frame);
+		auto loadData = benchmark("upload 4k", [&]{
+			texture.loadData(frame);
+		});
+		logThroughput(loadData, frame.getTotalBytes());
+
+		ofPixelsUpload upload;
+		upload.setup(3);
+		auto streamed = benchmark("upload 4k streamed", [&]{
+			upload.loadData(texture, frame);
+		});
+		logThroughput(streamed, frame.getTotalBytes());
+		glFinish();
+	}
+
+	void drawTransformedRects(int count){
+		for(int i = 0; i < count; i++){
+			ofPushMatrix();
+			ofTranslate((i % 100) * 2.5f, (i / 100) * 2.5f);
+			ofSetColor(i % 255);
+			ofDrawRectangle(0, 0, 2, 2);
+			ofPopMatrix();
+		}
+	}
+
+	void logPerDraw(const ofxBenchmarkResult & result, int draws){
+		ofLogNotice() << result.name << ": " << ofToString(result.median / draws, 1) << "ns per draw";
+	}
+
+	void logThroughput(const ofxBenchmarkResult & result, std::size_t bytes){
+		ofLogNotice() << result.name << ": " << ofToString(bytes / result.median * 1000, 0) << "MB/s";
+	}
+};
+
+//========================================================================
+int main( ){
+	// batching is only available with the programmable renderer, the
+	// window is never shown
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
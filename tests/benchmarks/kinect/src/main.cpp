@@ -0,0 +1,104 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxKinect.h"
+#include "ofxKinectPlayer.h"
+#include "ofxKinectRecorder.h"
+#include "ofxBenchmark.h"
+#include "ofxBenchmarkAllocations.h"
+
+class ofApp: public ofxBenchmarkApp{
+	static const int numFrames = 30;
+
+	// a recording of a sphere moving in front of a wall, so the benchmark
+	// runs without a kinect. tests/addons/kinect checks the results
+	std::string createRecording(){
+		const int width = ofxKinectCalibration::width;
+		const int height = ofxKinectCalibration::height;
+		ofShortPixels depth;
+		depth.allocate(width, height, 1);
+		ofPixels video;
+		video.allocate(width, height, 3);
+		for(int y = 0; y < height; y++){
+			for(int x = 0; x < width; x++){
+				video.setColor(x, y, ofColor(x * 255 / width, y * 255 / height, 128));
+			}
+		}
+
+		auto path = ofToDataPath("benchmark.kinect", true);
+		ofxKinectRecorder recorder;
+		recorder.open(path, ofxKinectCalibration());
+		for(int frame = 0; frame < numFrames; frame++){
+			glm::vec2 center(200 + frame * 8, 240);
+			for(int y = 0; y < height; y++){
+				for(int x = 0; x < width; x++){
+					float d = glm::distance(glm::vec2(x, y), center);
+					unsigned short z = d < 120 ? 1500 - sqrt(120 * 120 - d * d) * 4 : 3000;
+					// some pixels without depth, like the shadows of the emitter
+					if((x + y * 7 + frame) % 61 == 0){
+						z = 0;
+					}
+					depth[y * width + x] = z;
+				}
+			}
+			recorder.addFrame(depth, video);
+		}
+		recorder.close();
+		return path;
+	}
+
+	void runBenchmarks(){
+		auto path = createRecording();
+
+		ofxKinectPlayer player;
+		player.load(path, false);
+
+		benchmark("kinect player update", [&]{
+			player.update();
+			ofxBenchmarkKeep(player.getDepthPixels().getData());
+		});
+
+		player.setFrame(0);
+		auto & calibration = player.getCalibration();
+		auto & depth = player.getRawDepthPixels();
+		std::vector<glm::vec3> points;
+
+		benchmark("kinect point cloud per pixel", [&]{
+			points.clear();
+			for(int y = 0; y < ofxKinectCalibration::height; y++){
+				for(int x = 0; x < ofxKinectCalibration::width; x++){
+					float z = depth[y * ofxKinectCalibration::width + x];
+					if(z > 0){
+						points.push_back(calibration.getWorldCoordinateAt(x, y, z));
+					}
+				}
+			}
+			ofxBenchmarkKeep(points.data());
+		});
+
+		benchmark("kinect point cloud", [&]{
+			player.getPointCloud(points);
+			ofxBenchmarkKeep(points.data());
+		});
+
+		benchmark("kinect point cloud step 2", [&]{
+			player.getPointCloud(points, 2);
+			ofxBenchmarkKeep(points.data());
+		});
+
+		ofMesh mesh;
+		benchmark("kinect point cloud mesh", [&]{
+			player.getPointCloud(mesh);
+			ofxBenchmarkKeep(mesh.getVertices().data());
+		});
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
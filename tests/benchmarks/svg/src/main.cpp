@@ -0,0 +1,83 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxSvg.h"
+#include "ofxBenchmark.h"
+#include "ofxBenchmarkAllocations.h"
+
+class ofApp: public ofxBenchmarkApp{
+	ofxBenchmarkOptions heavy(){
+		ofxBenchmarkOptions options;
+		options.warmup = 1;
+		options.repetitions = 5;
+		options.iterations = 1;
+		return options;
+	}
+
+	// a map like file, a grid of filled and outlined cells with curved
+	// borders
+	std::string createSvg(std::size_t columns, std::size_t rows){
+		const float size = 10;
+		std::string svg = "<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\""
+			+ ofToString(columns * size) + "\" height=\"" + ofToString(rows * size) + "\">\n";
+		for(std::size_t y = 0; y < rows; y++){
+			for(std::size_t x = 0; x < columns; x++){
+				float left = x * size;
+				float top = y * size;
+				svg += "<path fill=\"#" + ofToHex<uint8_t>(x * 255 / columns) + ofToHex<uint8_t>(y * 255 / rows) + "80\""
+					" stroke=\"#202020\" stroke-width=\"" + ofToString(1 + (x + y) % 2) + "\""
+					" d=\"M " + ofToString(left) + " " + ofToString(top)
+					+ " L " + ofToString(left + size) + " " + ofToString(top)
+					+ " C " + ofToString(left + size * 1.2) + " " + ofToString(top + size * 0.3) + " "
+					+ ofToString(left + size * 0.8) + " " + ofToString(top + size * 0.7) + " "
+					+ ofToString(left + size) + " " + ofToString(top + size)
+					+ " L " + ofToString(left) + " " + ofToString(top + size) + " Z\"/>\n";
+			}
+		}
+		svg += "</svg>\n";
+		auto path = ofToDataPath("benchmark.svg", true);
+		ofBufferToFile(path, ofBuffer(svg.c_str(), svg.size()));
+		return path;
+	}
+
+	void runBenchmarks(){
+		auto path = createSvg(250, 200);
+
+		benchmark("svg load 50k shapes", [&]{
+			ofxSVG svg;
+			svg.load(path);
+			ofxBenchmarkKeep(svg.getNumPath());
+		}, heavy());
+
+		benchmark("svg load 50k shapes merged", [&]{
+			ofxSVG svg;
+			svg.setMergeOnLoad(true);
+			svg.load(path);
+			ofxBenchmarkKeep(svg.getNumPath());
+		}, heavy());
+
+		ofxSVG svg;
+		svg.setMergeOnLoad(true);
+		svg.load(path);
+		test_eq(svg.getNumPath(), 50000, "svg shapes");
+
+		benchmark("svg draw 50k shapes", [&]{
+			svg.draw();
+		}, heavy());
+
+		benchmark("svg drawMerged 50k shapes", [&]{
+			svg.drawMerged();
+		});
+	}
+};
+
+//========================================================================
+int main( ){
+	// drawing needs a GL context, the window is never shown
+	ofGLFWWindowSettings settings;
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,136 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	ofShader solidShader;
+
+	// fills everything it draws with green
+	void loadSolidShader(){
+		solidShader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			void main(){
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		solidShader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			out vec4 fragColor;
+			void main(){
+				fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+			})");
+		solidShader.bindDefaults();
+		solidShader.linkProgram();
+	}
+
+	// strings covered in part by shapes drawn after changing the blend
+	// mode, the depth test and the shader, so the batch has to be drawn
+	// before each of them to look the same as drawing the strings right away
+	void drawScene(){
+		ofClear(0, 255);
+		ofSetColor(255);
+		ofDrawBitmapString("blend mode", 10, 20);
+		ofDisableAlphaBlending();
+		ofSetColor(255, 0, 0);
+		ofDrawRectangle(0, 5, 40, 20);
+		ofEnableAlphaBlending();
+
+		ofSetColor(255, 255, 0);
+		ofDrawBitmapString("depth test", 10, 50);
+		ofEnableDepthTest();
+		ofSetColor(0, 0, 255);
+		ofDrawRectangle(0, 35, 40, 20);
+		ofDisableDepthTest();
+
+		ofSetColor(0, 255, 255);
+		ofDrawBitmapString("shader", 10, 80);
+		solidShader.begin();
+		ofDrawRectangle(0, 65, 40, 20);
+		ofDrawBitmapString("in the shader", 10, 110);
+		solidShader.end();
+
+		ofSetColor(255);
+		ofPushMatrix();
+		ofTranslate(20, 130);
+		ofRotateDeg(10);
+		ofDrawBitmapString("transformed", 0, 0);
+		ofPopMatrix();
+	}
+
+	void readScene(ofFbo & fbo, ofPixels & pixels, bool batching){
+		if(batching){
+			ofEnableBitmapStringBatching();
+		}else{
+			ofDisableBitmapStringBatching();
+		}
+		fbo.begin();
+		drawScene();
+		fbo.end();
+		ofDisableBitmapStringBatching();
+		fbo.readToPixels(pixels);
+	}
+
+	std::size_t countNotBlack(const ofPixels & pixels){
+		std::size_t count = 0;
+		for(std::size_t y = 0; y < pixels.getHeight(); y++){
+			for(std::size_t x = 0; x < pixels.getWidth(); x++){
+				ofColor color = pixels.getColor(x, y);
+				count += color.r != 0 || color.g != 0 || color.b != 0;
+			}
+		}
+		return count;
+	}
+
+	std::size_t countDifferent(const ofPixels & a, const ofPixels & b, const ofRectangle & area){
+		std::size_t count = 0;
+		for(std::size_t y = area.getTop(); y < area.getBottom(); y++){
+			for(std::size_t x = area.getLeft(); x < area.getRight(); x++){
+				ofColor ca = a.getColor(x, y);
+				ofColor cb = b.getColor(x, y);
+				count += std::abs(ca.r - cb.r) > 1 || std::abs(ca.g - cb.g) > 1 || std::abs(ca.b - cb.b) > 1;
+			}
+		}
+		return count;
+	}
+
+	void run(){
+		loadSolidShader();
+		ofFbo fbo;
+		fbo.allocate(200, 150, GL_RGBA);
+
+		ofPixels immediate, batched;
+		readScene(fbo, immediate, false);
+		readScene(fbo, batched, true);
+		test(countNotBlack(immediate) > 0, "the scene draws something");
+		// transforming the vertices in the cpu can move the edges of a few
+		// pixels, but the shapes drawn over the strings cover them the same
+		test(countDifferent(immediate, batched, ofRectangle(0, 0, 200, 150)) < 200 * 150 / 100, "batched strings look the same as strings drawn right away");
+		test_eq(countDifferent(immediate, batched, ofRectangle(0, 5, 40, 20)), std::size_t(0), "changing the blend mode draws the batched strings first");
+		test_eq(countDifferent(immediate, batched, ofRectangle(0, 35, 40, 20)), std::size_t(0), "changing the depth test draws the batched strings first");
+		test_eq(countDifferent(immediate, batched, ofRectangle(0, 65, 40, 20)), std::size_t(0), "binding a shader draws the batched strings first");
+
+		// strings drawn before clearing are cleared
+		ofEnableBitmapStringBatching();
+		fbo.begin();
+		ofClear(0, 255);
+		ofSetColor(255);
+		ofDrawBitmapString("cleared", 10, 20);
+		ofClear(0, 255);
+		fbo.end();
+		ofDisableBitmapStringBatching();
+		fbo.readToPixels(batched);
+		test_eq(countNotBlack(batched), std::size_t(0), "clearing draws the batched strings first");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the window is never shown, CI runs it with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,93 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static const int ageLocation = 5;
+
+	// draws every particle as a point with its age as the red component
+	ofShader loadAgeShader(){
+		ofShader shader;
+		shader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			in float age;
+			out float vAge;
+			void main(){
+				vAge = age;
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		shader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			in float vAge;
+			out vec4 fragColor;
+			void main(){
+				fragColor = vec4(vAge, 0.0, 0.0, 1.0);
+			})");
+		shader.bindDefaults();
+		shader.bindAttribute(ageLocation, "age");
+		shader.linkProgram();
+		return shader;
+	}
+
+	// one particle per pixel of a 16x16 grid
+	void setParticles(ofParticleSystem & particles, std::size_t count, float age){
+		particles.resize(count);
+		for(std::size_t i = 0; i < count; i++){
+			particles.getPositions()[i] = glm::vec3(i % 16 + 0.5f, i / 16 + 0.5f, 0);
+			particles.getAges()[i] = age;
+		}
+	}
+
+	void run(){
+		ofParticleSystem particles;
+		ofVbo vbo;
+		setParticles(particles, 100, 0);
+		particles.updateVbo(vbo);
+		test_eq(vbo.getNumVertices(), 100, "vbo with every particle");
+		test(!vbo.hasAttribute(ageLocation), "no age attribute until it's requested");
+
+		// the age attribute is added after the first update, with less
+		// particles than the vbo has room for
+		setParticles(particles, 40, 0.5);
+		particles.updateVbo(vbo, ageLocation);
+		test(vbo.hasAttribute(ageLocation), "age attribute added");
+		test_eq(vbo.getAttributeBuffer(ageLocation).size(), GLsizeiptr(40 * sizeof(float)), "age attribute with the live particles");
+		test_eq(vbo.getNumVertices(), 40, "every attribute reallocated with the live particles");
+
+		// growing again up to the size of the vbo updates every attribute
+		setParticles(particles, 80, 0.5);
+		particles.updateVbo(vbo, ageLocation);
+		test(vbo.getAttributeBuffer(ageLocation).size() >= GLsizeiptr(80 * sizeof(float)), "age attribute grows with the particles");
+
+		setParticles(particles, 60, 1);
+		particles.updateVbo(vbo, ageLocation);
+		test(vbo.getAttributeBuffer(ageLocation).size() >= GLsizeiptr(60 * sizeof(float)), "age attribute after shrinking");
+
+		ofShader shader = loadAgeShader();
+		ofFbo fbo;
+		fbo.allocate(16, 16, GL_RGBA);
+		fbo.begin();
+		ofClear(0, 255);
+		shader.begin();
+		vbo.draw(GL_POINTS, 0, particles.size());
+		shader.end();
+		fbo.end();
+		ofPixels pixels;
+		fbo.readToPixels(pixels);
+		test_eq(pixels.getColor(59 % 16, 59 / 16), ofColor(255, 0, 0), "ages of the live particles drawn");
+		test_eq(pixels.getColor(61 % 16, 61 / 16), ofColor(0, 0, 0), "nothing drawn for dead particles");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the window is never shown, CI runs it with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
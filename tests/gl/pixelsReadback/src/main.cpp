@@ -0,0 +1,86 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// clears the fbo to a different gray every frame
+	void drawFrame(ofFbo & fbo, std::size_t frame){
+		fbo.begin();
+		ofClear(frame * 10, 255);
+		fbo.end();
+	}
+
+	void run(){
+		ofFbo fbo;
+		fbo.allocate(64, 64, GL_RGBA);
+
+		ofPixelsReadback readback;
+		readback.setup(3);
+		ofPixels pixels;
+		std::vector<std::size_t> received;
+		for(std::size_t frame = 0; frame < 10; frame++){
+			drawFrame(fbo, frame);
+			fbo.readToPixelsAsync(readback);
+			while(readback.getPixels(pixels)){
+				received.push_back(pixels.getColor(32, 32).r / 10);
+			}
+		}
+		readback.flush();
+		while(readback.getPixels(pixels)){
+			received.push_back(pixels.getColor(32, 32).r / 10);
+		}
+		test_eq(pixels.getWidth(), 64, "readback width");
+		test_eq(pixels.getNumChannels(), 4, "readback channels");
+		test_eq(received.size() + readback.getStats().dropped, 10, "every frame received or dropped");
+		test(std::is_sorted(received.begin(), received.end()) && !received.empty() && received.back() == 9, "frames in order");
+
+		std::vector<std::size_t> frames;
+		bool rightColors = true;
+		readback.setCallback([&](ofPixels & framePixels, std::size_t frame){
+			frames.push_back(frame);
+			rightColors &= framePixels.getColor(0, 0).r == frame * 10;
+		});
+		readback.setup(2);
+		for(std::size_t frame = 0; frame < 10; frame++){
+			drawFrame(fbo, frame);
+			fbo.readToPixelsAsync(readback);
+		}
+		readback.flush();
+		test_eq(frames.size(), 10, "callback called for every frame");
+		test(rightColors, "callback pixels");
+
+		std::atomic<std::size_t> workerFrames(0);
+		readback.setCallback([&](ofPixels & framePixels, std::size_t frame){
+			if(framePixels.getColor(0, 0).r == frame * 10){
+				workerFrames++;
+			}
+		}, true);
+		readback.setup(3);
+		for(std::size_t frame = 0; frame < 10; frame++){
+			drawFrame(fbo, frame);
+			fbo.readToPixelsAsync(readback);
+		}
+		readback.flush();
+		auto start = ofGetElapsedTimeMillis();
+		while(workerFrames < 10 && ofGetElapsedTimeMillis() - start < 5000){
+			if(!ofGetTaskPool().runPendingTask()){
+				std::this_thread::yield();
+			}
+		}
+		test_eq(workerFrames.load(), 10, "callback in worker threads");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the readback uses pixel buffers and fences from OpenGL 3.2, the
+	// window is never shown. CI runs it with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,50 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofPixels pixels;
+		pixels.allocate(64, 64, OF_PIXELS_RGBA);
+		ofPixelsUpload upload;
+		upload.setup(2);
+		ofTexture texture;
+		ofPixels result;
+		bool sameColors = true;
+		for(int frame = 0; frame < 5; frame++){
+			pixels.setColor(ofColor(frame * 10, 0, 0, 255));
+			upload.loadData(texture, pixels);
+			texture.readToPixels(result);
+			sameColors &= result.getColor(32, 32) == ofColor(frame * 10, 0, 0, 255);
+		}
+		test(texture.isAllocated() && texture.getWidth() == 64, "upload allocates the texture");
+		test(sameColors, "uploaded pixels");
+		test_eq(upload.getStats().uploads, 5, "uploads");
+		test_eq(upload.getStats().bytesUploaded, 5 * pixels.getTotalBytes(), "uploaded bytes");
+
+		// the pixels are written from another thread directly to the buffer
+		ofPixels mapped;
+		int buffer = upload.begin(mapped, 32, 32, OF_PIXELS_GRAY);
+		test(buffer >= 0, "begin upload");
+		ofGetTaskPool().async([&]{
+			mapped.set(200);
+		}).get();
+		upload.end(buffer, texture);
+		texture.readToPixels(result);
+		test(texture.getWidth() == 32 && result.getNumChannels() == 1 && result[0] == 200, "upload written from another thread");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the upload maps pixel buffers from OpenGL 3.2, the window is never
+	// shown. CI runs it with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,174 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	std::shared_ptr<ofGLProgrammableRenderer> renderer;
+
+	// a custom shader with a float and a vec2 uniform added to the color
+	ofShader loadUniformsShader(){
+		ofShader shader;
+		shader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			void main(){
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		shader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			uniform float brightness;
+			uniform vec2 offset;
+			out vec4 fragColor;
+			void main(){
+				fragColor = vec4(brightness + offset.x, offset.y, 0.0, 1.0);
+			})");
+		shader.bindDefaults();
+		shader.linkProgram();
+		return shader;
+	}
+
+	// a custom shader with the loose default uniforms, the renderer sets
+	// them through the handles it looks up when the shader is bound
+	ofShader loadDefaultUniformsShader(){
+		ofShader shader;
+		shader.setupShaderFromSource(GL_VERTEX_SHADER, R"(#version 150
+			uniform mat4 modelViewProjectionMatrix;
+			in vec4 position;
+			void main(){
+				gl_Position = modelViewProjectionMatrix * position;
+			})");
+		shader.setupShaderFromSource(GL_FRAGMENT_SHADER, R"(#version 150
+			uniform vec4 globalColor;
+			out vec4 fragColor;
+			void main(){
+				fragColor = globalColor;
+			})");
+		shader.bindDefaults();
+		shader.linkProgram();
+		return shader;
+	}
+
+	void run(){
+		renderer = std::dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+		if(!renderer){
+			test(false, "programmable renderer");
+			return;
+		}
+		handles();
+		parameters();
+		defaultUniforms();
+		uniformBlock();
+	}
+
+	void handles(){
+		ofShader shader = loadUniformsShader();
+		ofShader::Uniform brightness = shader.getUniform("brightness");
+		test(brightness.location != -1, "uniform handle");
+		test_eq(shader.getUniform("missing").location, -1, "handle of a missing uniform");
+
+		ofFbo fbo;
+		fbo.allocate(8, 8, GL_RGBA);
+		ofPixels pixels;
+		fbo.begin();
+		ofClear(0, 255);
+		shader.begin();
+		shader.setUniform1f(brightness, 1);
+		shader.setUniform2f("offset", glm::vec2(0, 1));
+		ofDrawRectangle(0, 0, 8, 8);
+		shader.end();
+		fbo.end();
+		fbo.readToPixels(pixels);
+		test_eq(pixels.getColor(4, 4), ofColor(255, 255, 0), "uniforms set by handle and by name");
+	}
+
+	void parameters(){
+		ofShader shader = loadUniformsShader();
+		ofFbo fbo;
+		fbo.allocate(8, 8, GL_RGBA);
+		ofPixels pixels;
+
+		ofParameterGroup parameters;
+		ofParameter<float> brightness("brightness", 0);
+		ofParameter<glm::vec2> offset("offset", glm::vec2(1, 0));
+		parameters.add(brightness);
+		parameters.add(offset);
+		fbo.begin();
+		ofClear(0, 255);
+		shader.begin();
+		shader.setUniforms(parameters);
+		ofDrawRectangle(0, 0, 8, 8);
+		shader.end();
+		fbo.end();
+		fbo.readToPixels(pixels);
+		test_eq(pixels.getColor(4, 4), ofColor(255, 0, 0), "uniforms set from parameters");
+	}
+
+	void defaultUniforms(){
+		ofShader shader = loadDefaultUniformsShader();
+		ofFbo fbo;
+		fbo.allocate(8, 8, GL_RGBA);
+		ofPixels pixels;
+
+		fbo.begin();
+		ofClear(0, 255);
+		shader.begin();
+		ofSetColor(0, 255, 0);
+		ofPushMatrix();
+		ofTranslate(4, 4);
+		ofDrawRectangle(0, 0, 4, 4);
+		ofPopMatrix();
+		shader.end();
+		fbo.end();
+		fbo.readToPixels(pixels);
+		ofSetColor(255);
+		test_eq(pixels.getColor(6, 6), ofColor(0, 255, 0), "color of a custom shader set by the renderer");
+		test_eq(pixels.getColor(2, 2), ofColor::black, "matrices of a custom shader set by the renderer");
+	}
+
+	// the default shaders get the matrices and the color from the
+	// ofDefaultUniforms block, written only before draws that need it
+	void uniformBlock(){
+		if(!GLEW_ARB_uniform_buffer_object){
+			ofLogNotice() << "no uniform buffer objects, skipping the block tests";
+			return;
+		}
+		ofFbo fbo;
+		fbo.allocate(8, 8, GL_RGBA);
+		ofPixels pixels;
+
+		fbo.begin();
+		ofClear(0, 255);
+		renderer->resetStats();
+		ofPushMatrix();
+		for(int i = 0; i < 100; i++){
+			ofSetColor(i);
+			ofTranslate(1, 0);
+		}
+		ofPopMatrix();
+		test_eq(renderer->getStats().uniformBlockWrites, 0, "no block writes without draws");
+		ofSetColor(0, 0, 255);
+		ofTranslate(4, 4);
+		ofDrawRectangle(0, 0, 4, 4);
+		ofDrawRectangle(0, 0, 4, 4);
+		test_eq(renderer->getStats().uniformBlockWrites, 1, "one block write for the changes before a draw");
+		fbo.end();
+		fbo.readToPixels(pixels);
+		ofSetColor(255);
+		test_eq(pixels.getColor(6, 6), ofColor(0, 0, 255), "color and matrices from the block");
+		test_eq(pixels.getColor(2, 2), ofColor::black, "translated by the block matrices");
+	}
+};
+
+//========================================================================
+int main( ){
+	// the uniform handles and the default uniforms block are only used by
+	// the programmable renderer, the window is never shown. CI runs it
+	// with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,166 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static const int numShapes = 10000;
+
+	std::shared_ptr<ofGLProgrammableRenderer> renderer;
+
+	// a grid of small shapes with different colors, some of them rotated
+	void drawShapes(int count){
+		for(int i = 0; i < count; i++){
+			float x = (i % 100) * 2.5f;
+			float y = (i / 100 % 100) * 2.5f;
+			ofSetColor(i % 255, (i * 7) % 255, (i * 13) % 255);
+			switch(i % 4){
+			case 0:
+				ofDrawRectangle(x, y, 2, 2);
+				break;
+			case 1:
+				ofDrawCircle(x + 1, y + 1, 1);
+				break;
+			case 2:
+				ofDrawTriangle(x, y, x + 2, y, x + 1, y + 2);
+				break;
+			case 3:
+				ofPushMatrix();
+				ofTranslate(x + 1, y + 1);
+				ofRotateDeg(45);
+				ofDrawRectangle(-1, -1, 2, 2);
+				ofPopMatrix();
+				break;
+			}
+		}
+		ofNoFill();
+		ofDrawLine(0, 0, 250, 250);
+		ofDrawRectangle(10, 10, 100, 100);
+		ofFill();
+	}
+
+	void readShapes(ofFbo & fbo, ofPixels & pixels, bool batching){
+		fbo.begin();
+		ofClear(0, 255);
+		if(batching){
+			ofEnableShapeBatching();
+		}
+		drawShapes(numShapes);
+		ofDisableShapeBatching();
+		fbo.end();
+		fbo.readToPixels(pixels);
+	}
+
+	void run(){
+		renderer = std::dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+		if(!renderer){
+			test(false, "programmable renderer");
+			return;
+		}
+		counters();
+		correctness();
+		streaming();
+	}
+
+	void counters(){
+		ofDisableShapeBatching();
+		renderer->resetStats();
+		for(int i = 0; i < 100; i++){
+			ofDrawRectangle(i, 0, 1, 1);
+		}
+		test_eq(renderer->getStats().drawCalls, 100, "one draw call per rectangle");
+		test_eq(renderer->getStats().bufferUploads, 100, "one upload per rectangle");
+
+		ofEnableShapeBatching();
+		test(ofIsShapeBatching(), "ofIsShapeBatching");
+		renderer->resetStats();
+		drawShapes(100);
+		test_eq(renderer->getStats().drawCalls, 1, "the outlines flush the fills");
+		ofFlushShapes();
+		test_eq(renderer->getStats().drawCalls, 2, "fills and outlines batched");
+		test_eq(renderer->getStats().bufferUploads, 2, "one upload per batch");
+
+		renderer->resetStats();
+		ofDrawRectangle(0, 0, 1, 1);
+		ofEnableBlendMode(OF_BLENDMODE_ADD);
+		ofDrawRectangle(0, 0, 1, 1);
+		ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+		test_eq(renderer->getStats().drawCalls, 2, "blend mode changes flush");
+		ofFlushShapes();
+
+		renderer->resetStats();
+		ofDrawRectangle(0, 0, 1, 1);
+		ofDisableShapeBatching();
+		test_eq(renderer->getStats().drawCalls, 1, "disabling flushes");
+		test(!ofIsShapeBatching(), "ofIsShapeBatching disabled");
+	}
+
+	void correctness(){
+		ofFbo fbo;
+		fbo.allocate(256, 256, GL_RGBA);
+		ofPixels immediate, batched;
+		readShapes(fbo, immediate, false);
+		readShapes(fbo, batched, true);
+
+		// transforming the vertices in the cpu can move the edges of a few
+		// pixels
+		std::size_t different = 0;
+		for(std::size_t i = 0; i < immediate.size(); i++){
+			if(std::abs(int(immediate[i]) - int(batched[i])) > 1){
+				different++;
+			}
+		}
+		test(immediate.size() == batched.size() && different < immediate.size() / 100, "batched shapes look the same");
+	}
+
+	void streaming(){
+		ofFbo fbo;
+		fbo.allocate(64, 64, GL_RGBA);
+		ofMesh quad;
+		quad.setMode(OF_PRIMITIVE_TRIANGLES);
+		quad.addVertices({{0, 0, 0}, {32, 0, 0}, {32, 32, 0}, {0, 32, 0}});
+		ofFloatColor red(1, 0, 0);
+		quad.addColors({red, red, red, red});
+		quad.addIndices({0, 1, 2, 0, 2, 3});
+		ofPolyline line;
+		line.addVertex(40, 0.5);
+		line.addVertex(64, 0.5);
+
+		// every draw writes to a different range of the streaming buffer
+		ofPixels pixels;
+		renderer->resetStats();
+		for(int pass = 0; pass < 3; pass++){
+			fbo.begin();
+			ofClear(0, 255);
+			for(int i = 0; i < 100; i++){
+				ofSetColor(255);
+				quad.draw();
+				ofSetColor(0, 255, 0);
+				line.draw();
+			}
+			fbo.end();
+			fbo.readToPixels(pixels);
+		}
+		ofSetColor(255);
+
+		test_eq(pixels.getColor(16, 16), ofColor::red, "streamed mesh with indices and colors");
+		test_eq(pixels.getColor(50, 0), ofColor(0, 255, 0), "streamed polyline");
+		test_eq(pixels.getColor(50, 50), ofColor::black, "nothing drawn outside");
+		test_eq(renderer->getStats().bufferUploads, 600, "one upload per mesh or polyline");
+		std::size_t bytes = 300 * (4 * sizeof(glm::vec3) + 4 * sizeof(ofFloatColor) + 6 * sizeof(ofIndexType) + 2 * sizeof(glm::vec3));
+		test_eq(renderer->getStats().uploadedBytes, bytes, "uploaded bytes");
+	}
+};
+
+//========================================================================
+int main( ){
+	// batching is only available with the programmable renderer, the
+	// window is never shown. CI runs it with Mesa's llvmpipe
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
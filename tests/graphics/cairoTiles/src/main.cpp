@@ -0,0 +1,67 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void drawFrame(ofCairoRenderer & renderer, int frame){
+		renderer.startRender();
+		renderer.setFillMode(OF_FILLED);
+		for(int i=0;i<20;i++){
+			renderer.setColor(ofColor::fromHsb((i * 13 + frame * 40) % 255, 200, 255), 120);
+			renderer.drawCircle(10 + i * 11, 20 + (i * 37 + frame * 17) % 110, 0, 15 + i);
+		}
+
+		// flushing in the middle of a frame has to continue drawing
+		// on top of what's already there
+		renderer.getImageSurfacePixels();
+
+		renderer.pushMatrix();
+		renderer.translate(100, 75);
+		renderer.rotateDeg(30 + frame * 10);
+		renderer.setColor(255, 255, 255, 80);
+		renderer.drawRectangle(-60, -20, 0, 120, 40);
+		renderer.popMatrix();
+
+		// clips that aren't rectangles have to survive a flush too
+		cairo_t * cr = renderer.getCairoContext();
+		cairo_save(cr);
+		cairo_arc(cr, 100, 75, 50, 0, TWO_PI);
+		cairo_clip(cr);
+		renderer.getImageSurfacePixels();
+		renderer.setColor(0, 0, 255, 150);
+		renderer.drawRectangle(0, 0, 0, 200, 150);
+		cairo_restore(cr);
+
+		renderer.finishRender();
+	}
+
+	void run(){
+		ofRectangle size(0, 0, 203, 150);
+		ofCairoRenderer direct;
+		direct.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, size);
+
+		ofCairoRenderer tiled;
+		tiled.setTiledRendering(32, 4);
+		tiled.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, size);
+		test(tiled.isTiledRendering(), "tiled rendering enabled");
+
+		for(int frame=0;frame<3;frame++){
+			drawFrame(direct, frame);
+			drawFrame(tiled, frame);
+			const ofPixels & directPixels = direct.getImageSurfacePixels();
+			const ofPixels & tiledPixels = tiled.getImageSurfacePixels();
+			test_eq(tiledPixels.size(), directPixels.size(), "tiled pixels size, frame " + ofToString(frame));
+			test(std::equal(directPixels.begin(), directPixels.end(), tiledPixels.begin()), "tiled pixels equal to rendering to a single surface, frame " + ofToString(frame));
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -309,6 +309,157 @@ class ofApp: public ofxUnitTestsApp{
                 test_eq((uint64_t)&pixels.getLine(0).getPixel(10)[0], (uint64_t)pixels.getData()+(10*bpp/8),"getLine(0).getPixel(10)[0]==pixels.getData()+(10*bpp/8)");
 			}
 		}
+
+		// color transforms
+		ofPixels color;
+		color.allocate(w,h,OF_PIXELS_RGBA);
+		for(size_t i=0;i<color.size();i++){
+			color[i] = (i * 7919) % 256;
+		}
+		ofPixels original = color;
+
+		ofPixels hsb = color;
+		hsb.convertRgbToHsb();
+		bool hsbEqual = true;
+		for(size_t i=0;i<color.size() && hsbEqual;i+=4){
+			float hue, saturation, brightness;
+			ofColor(color[i],color[i+1],color[i+2]).getHsb(hue,saturation,brightness);
+			hsbEqual = abs(hsb[i]-hue)<=1 && abs(hsb[i+1]-saturation)<=1 && abs(hsb[i+2]-brightness)<=1 && hsb[i+3]==color[i+3];
+		}
+		test(hsbEqual,"convertRgbToHsb() same as ofColor::getHsb()");
+
+		ofPixels rgb = hsb;
+		rgb.convertHsbToRgb();
+		bool rgbEqual = true;
+		for(size_t i=0;i<color.size() && rgbEqual;i+=4){
+			auto c = ofColor::fromHsb(hsb[i],hsb[i+1],hsb[i+2]);
+			rgbEqual = abs(rgb[i]-c.r)<=1 && abs(rgb[i+1]-c.g)<=1 && abs(rgb[i+2]-c.b)<=1 && rgb[i+3]==color[i+3];
+		}
+		test(rgbEqual,"convertHsbToRgb() same as ofColor::setHsb()");
+
+		ofFloatPixels floatColor = color;
+		ofFloatPixels floatOriginal = floatColor;
+		floatColor.convertSrgbToLinear();
+		floatColor.convertLinearToSrgb();
+		bool srgbRoundTrip = true;
+		for(size_t i=0;i<floatColor.size() && srgbRoundTrip;i++){
+			srgbRoundTrip = abs(floatColor[i]-floatOriginal[i])<0.0001;
+		}
+		test(srgbRoundTrip,"sRGB to linear to sRGB round trip");
+
+		color.applyGamma(1);
+		test(std::equal(color.begin(),color.end(),original.begin()),"applyGamma(1) doesn't change the pixels");
+		color.applyLevels(0,1);
+		test(std::equal(color.begin(),color.end(),original.begin()),"applyLevels(0,1) doesn't change the pixels");
+		color.applyContrast(1);
+		test(std::equal(color.begin(),color.end(),original.begin()),"applyContrast(1) doesn't change the pixels");
+
+		ofColorLut lut;
+		lut.allocate3D(33);
+		color.applyLut(lut);
+		test(std::equal(color.begin(),color.end(),original.begin()),"identity 3d lut doesn't change the pixels");
+		lut.allocate1D(256);
+		color.applyLut(lut);
+		test(std::equal(color.begin(),color.end(),original.begin()),"identity 1d lut doesn't change the pixels");
+
+		// pixel kernels
+		ofPixels inverted = original;
+		ofPixelsMap<4>(inverted,[](ofPixelValue<unsigned char,4> p){
+			for(size_t c=0;c<4;c++){
+				p[c] = 255 - p[c];
+			}
+			return p;
+		});
+		bool invertedEqual = true;
+		for(size_t i=0;i<original.size() && invertedEqual;i++){
+			invertedEqual = inverted[i] == 255 - original[i];
+		}
+		test(invertedEqual,"ofPixelsMap() in place");
+
+		ofPixels alpha;
+		ofPixelsMap<4>(original,alpha,[](ofPixelValue<unsigned char,4> p){
+			return ofPixelValue<unsigned char,1>{{p[3]}};
+		});
+		test_eq(alpha.getNumChannels(),1,"ofPixelsMap() allocates with the channels of the result");
+		bool alphaEqual = alpha.getWidth() == w && alpha.getHeight() == h;
+		for(size_t i=0;i<alpha.size() && alphaEqual;i++){
+			alphaEqual = alpha[i] == original[i*4+3];
+		}
+		test(alphaEqual,"ofPixelsMap() to other pixels");
+
+		ofPixels sum;
+		ofPixelsZip<4>(original,inverted,sum,[](ofPixelValue<unsigned char,4> a, ofPixelValue<unsigned char,4> b){
+			return a + b;
+		});
+		test(std::all_of(sum.begin(),sum.end(),[](unsigned char v){ return v == 255; }),"ofPixelsZip()");
+
+		ofPixels aliased = original;
+		ofPixelsMap<4>(aliased,aliased,[](ofPixelValue<unsigned char,4> p){
+			return ofPixelValue<unsigned char,1>{{p[3]}};
+		});
+		test_eq(aliased.getNumChannels(),1,"ofPixelsMap() into its source with other channels reallocates");
+		test(std::equal(aliased.begin(),aliased.end(),alpha.begin()),"ofPixelsMap() into its source with other channels");
+
+		aliased = original;
+		ofPixelsZip<4>(aliased,inverted,aliased,[](ofPixelValue<unsigned char,4> a, ofPixelValue<unsigned char,4> b){
+			return ofPixelValue<unsigned char,1>{{static_cast<unsigned char>(a[3] + b[3])}};
+		});
+		test_eq(aliased.getNumChannels(),1,"ofPixelsZip() into a source with other channels reallocates");
+		test(std::all_of(aliased.begin(),aliased.end(),[](unsigned char v){ return v == 255; }),"ofPixelsZip() into a source with other channels");
+
+		uint64_t total = ofPixelsReduce<4>(original,uint64_t(0),[](ofPixelValue<unsigned char,4> p){
+			return uint64_t(p[0]) + p[1] + p[2] + p[3];
+		},[](uint64_t a, uint64_t b){
+			return a + b;
+		});
+		uint64_t expectedTotal = 0;
+		for(auto value: original){
+			expectedTotal += value;
+		}
+		test_eq(total,expectedTotal,"ofPixelsReduce()");
+
+		float blur[3][3] = {{1/16.f,2/16.f,1/16.f},{2/16.f,4/16.f,2/16.f},{1/16.f,2/16.f,1/16.f}};
+		ofPixels blurred;
+		ofPixelsConvolve<4>(original,blurred,blur);
+		bool blurEqual = blurred.getWidth() == w && blurred.getHeight() == h;
+		for(int y=0;y<h && blurEqual;y++){
+			for(int x=0;x<w && blurEqual;x++){
+				for(size_t c=0;c<4 && blurEqual;c++){
+					float value = 0;
+					for(int dy=-1;dy<=1;dy++){
+						for(int dx=-1;dx<=1;dx++){
+							int nx = ofClamp(x+dx,0,w-1);
+							int ny = ofClamp(y+dy,0,h-1);
+							value += blur[dy+1][dx+1] * original[(ny*w+nx)*4+c];
+						}
+					}
+					blurEqual = abs(blurred[(y*w+x)*4+c] - value) <= 0.5f;
+				}
+			}
+		}
+		test(blurEqual,"ofPixelsConvolve() 3x3 with clamped borders");
+
+		ofPixels copy;
+		ofPixelsFilter<4,0>(original,copy,[](const ofPixelNeighborhood<unsigned char,4,0> & n){
+			return n.center();
+		});
+		test(std::equal(copy.begin(),copy.end(),original.begin()),"ofPixelsFilter() with radius 0 copies the pixels");
+
+		// pixels wrapping the memory of the source would be read after
+		// being written
+		ofPixels source = original;
+		ofPixels shared;
+		shared.setFromExternalPixels(source.getData(),source.getWidth(),source.getHeight(),source.getNumChannels());
+		ofPixelsFilter<4,1>(source,shared,[](const ofPixelNeighborhood<unsigned char,4,1> &){
+			return ofPixelValue<unsigned char,4>::filled(0);
+		});
+		test(std::equal(source.begin(),source.end(),original.begin()),"ofPixelsFilter() into pixels sharing the memory of the source doesn't change them");
+
+		ofPixels wrongChannels = original;
+		ofPixelsMap<3>(wrongChannels,[](ofPixelValue<unsigned char,3>){
+			return ofPixelValue<unsigned char,3>::filled(0);
+		});
+		test(std::equal(wrongChannels.begin(),wrongChannels.end(),original.begin()),"ofPixelsMap() with the wrong number of channels doesn't change the pixels");
 	}
 };
 
@@ -0,0 +1,105 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofRecordingRenderer.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void drawScene(ofBaseRenderer & renderer, ofColor color){
+		ofPolyline polyline;
+		polyline.addVertex(10, 10);
+		polyline.addVertex(190, 40);
+		polyline.addVertex(60, 140);
+		polyline.close();
+
+		ofMesh mesh;
+		mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+		mesh.addVertex({120, 20, 0});
+		mesh.addVertex({190, 130, 0});
+		mesh.addVertex({100, 110, 0});
+
+		renderer.setFillMode(OF_FILLED);
+		renderer.setColor(color);
+		renderer.drawRectangle(20, 20, 0, 80, 50);
+		// redundant state changes for optimize() to remove
+		renderer.setColor(255, 0, 0);
+		renderer.setColor(0, 255, 0, 128);
+		renderer.pushMatrix();
+		renderer.translate(100, 75);
+		renderer.rotateDeg(20);
+		renderer.drawCircle(0, 0, 0, 40);
+		renderer.popMatrix();
+		renderer.setFillMode(OF_OUTLINE);
+		renderer.setFillMode(OF_OUTLINE);
+		renderer.setColor(0, 0, 255);
+		renderer.draw(polyline);
+		renderer.setFillMode(OF_FILLED);
+		renderer.draw(mesh, OF_MESH_FILL, false, false, false);
+	}
+
+	ofPixels render(std::function<void(ofBaseRenderer&)> draw){
+		ofCairoRenderer cairo;
+		cairo.setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, 200, 150));
+		cairo.startRender();
+		draw(cairo);
+		cairo.finishRender();
+		return cairo.getImageSurfacePixels();
+	}
+
+	bool equal(const ofPixels & p1, const ofPixels & p2){
+		return p1.size() == p2.size() && std::equal(p1.begin(), p1.end(), p2.begin());
+	}
+
+	void run(){
+		ofRecordingRenderer recorder(ofRectangle(0, 0, 200, 150));
+		test(recorder.empty(), "new recording is empty");
+		drawScene(recorder, ofColor::white);
+		test_gt(recorder.getNumCommands(), 0u, "commands recorded");
+		auto numCommands = recorder.getNumCommands();
+
+		auto direct = render([&](ofBaseRenderer & renderer){
+			drawScene(renderer, ofColor::white);
+		});
+		auto replayed = render([&](ofBaseRenderer & renderer){
+			recorder.replay(renderer);
+		});
+		test(equal(direct, replayed), "replaying into cairo draws the same as drawing directly");
+
+		ofNoopRenderer noop;
+		recorder.replay(noop);
+		test_eq(recorder.getNumCommands(), numCommands, "replaying doesn't consume the recording");
+
+		ofRecordingRenderer same(ofRectangle(0, 0, 200, 150));
+		drawScene(same, ofColor::white);
+		test_eq(same.getHash(), recorder.getHash(), "same drawing gives the same hash");
+
+		ofRecordingRenderer different(ofRectangle(0, 0, 200, 150));
+		drawScene(different, ofColor::yellow);
+		test(different.getHash() != recorder.getHash(), "different colors give different hashes");
+
+		ofRecordingRenderer copy(ofRectangle(0, 0, 200, 150));
+		recorder.replay(copy);
+		test_eq(copy.getNumCommands(), numCommands, "replaying into a recording records the same commands");
+		test_eq(copy.getHash(), recorder.getHash(), "replaying into a recording gives the same hash");
+
+		recorder.optimize();
+		test_lt(recorder.getNumCommands(), numCommands, "optimize removes redundant state changes");
+		auto optimized = render([&](ofBaseRenderer & renderer){
+			recorder.replay(renderer);
+		});
+		test(equal(direct, optimized), "replaying an optimized recording draws the same");
+
+		recorder.reset();
+		test(recorder.empty(), "reset discards the recording");
+		test_eq(recorder.getSizeInBytes(), 0u, "reset recording has no commands");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,195 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static float distance2(const glm::vec3 & a, const glm::vec3 & b){
+		glm::vec3 d = a - b;
+		return glm::dot(d, d);
+	}
+
+	std::vector<glm::vec3> randomPoints(std::size_t count, float radius){
+		std::vector<glm::vec3> points(count);
+		for(auto & point: points){
+			point = glm::vec3(ofRandom(-radius, radius), ofRandom(-radius, radius), ofRandom(-radius, radius));
+		}
+		return points;
+	}
+
+	std::vector<std::size_t> bruteForceRadius(const std::vector<glm::vec3> & points, const glm::vec3 & center, float radius){
+		std::vector<std::size_t> indices;
+		for(std::size_t i = 0; i < points.size(); i++){
+			if(distance2(points[i], center) <= radius * radius){
+				indices.push_back(i);
+			}
+		}
+		return indices;
+	}
+
+	std::vector<std::size_t> sorted(std::vector<std::size_t> indices){
+		std::sort(indices.begin(), indices.end());
+		return indices;
+	}
+
+	// distance along the ray to a triangle, or a negative value if it misses
+	float rayTriangle(const glm::vec3 & origin, const glm::vec3 & direction, const glm::vec3 & v0, const glm::vec3 & v1, const glm::vec3 & v2){
+		glm::vec3 e1 = v1 - v0;
+		glm::vec3 e2 = v2 - v0;
+		glm::vec3 p = glm::cross(direction, e2);
+		float det = glm::dot(e1, p);
+		if(std::abs(det) < 1e-12f){
+			return -1;
+		}
+		glm::vec3 t = origin - v0;
+		float u = glm::dot(t, p) / det;
+		if(u < 0 || u > 1){
+			return -1;
+		}
+		glm::vec3 q = glm::cross(t, e1);
+		float v = glm::dot(direction, q) / det;
+		if(v < 0 || u + v > 1){
+			return -1;
+		}
+		return glm::dot(e2, q) / det;
+	}
+
+	void kdTree(){
+		auto points = randomPoints(2000, 100);
+		auto targets = randomPoints(100, 120);
+		ofKdTree3d tree(points);
+		test_eq(tree.size(), points.size(), "kd tree size");
+
+		bool closestOk = true;
+		bool kNearestOk = true;
+		bool radiusOk = true;
+		std::vector<std::size_t> indices;
+		for(auto & target: targets){
+			// closest, compared by distance since points can be equally far
+			std::size_t nearest = 0;
+			tree.getClosestPoint(target, &nearest);
+			float best = std::numeric_limits<float>::max();
+			for(auto & point: points){
+				best = std::min(best, distance2(point, target));
+			}
+			closestOk &= distance2(points[nearest], target) == best;
+
+			// the k closest, sorted from the closest to the farthest
+			const std::size_t k = 8;
+			tree.findClosest(target, k, indices);
+			std::vector<float> distances;
+			for(auto & point: points){
+				distances.push_back(distance2(point, target));
+			}
+			std::sort(distances.begin(), distances.end());
+			kNearestOk &= indices.size() == k;
+			for(std::size_t i = 0; i < indices.size() && i < k; i++){
+				kNearestOk &= distance2(points[indices[i]], target) == distances[i];
+			}
+
+			tree.findInRadius(target, 15, indices);
+			radiusOk &= sorted(indices) == bruteForceRadius(points, target, 15);
+		}
+		test(closestOk, "kd tree closest point equals brute force");
+		test(kNearestOk, "kd tree k closest points equal brute force");
+		test(radiusOk, "kd tree radius search equals brute force");
+
+		ofKdTree3d empty;
+		test_eq(empty.getClosestPoint(glm::vec3(1, 2, 3)), glm::vec3(1, 2, 3), "empty kd tree returns the target");
+	}
+
+	void spatialGrid(){
+		auto points = randomPoints(2000, 100);
+		auto targets = randomPoints(100, 120);
+		ofSpatialGrid3d grid(10);
+		grid.build(points);
+		test_eq(grid.size(), points.size(), "grid size");
+
+		std::vector<std::size_t> indices;
+		bool radiusOk = true;
+		bool bigRadiusOk = true;
+		for(auto & target: targets){
+			grid.findInRadius(target, 15, indices);
+			radiusOk &= sorted(indices) == bruteForceRadius(points, target, 15);
+			// many more cells than points, checks every point instead
+			grid.findInRadius(target, 1000, indices);
+			bigRadiusOk &= sorted(indices) == bruteForceRadius(points, target, 1000);
+		}
+		test(radiusOk, "grid radius search equals brute force");
+		test(bigRadiusOk, "grid radius search much bigger than the cells equals brute force");
+
+		// moving and removing points keeps the results the same as
+		// searching the remaining points
+		for(std::size_t i = 0; i < points.size(); i += 2){
+			points[i] += glm::vec3(ofRandom(-20, 20), ofRandom(-20, 20), ofRandom(-20, 20));
+			grid.update(i, points[i]);
+		}
+		grid.remove(1);
+		grid.findInRadius(points[0], 30, indices);
+		auto expected = bruteForceRadius(points, points[0], 30);
+		expected.erase(std::remove(expected.begin(), expected.end(), 1), expected.end());
+		test(sorted(indices) == expected, "grid radius search after moving and removing points");
+
+		// coordinates that don't fit in an int cell
+		ofSpatialGrid3d huge(1);
+		auto a = huge.add(glm::vec3(1e30f, 0, 0));
+		auto b = huge.add(glm::vec3(1e30f, 0, 0));
+		huge.add(glm::vec3(-1e30f, 0, 0));
+		huge.findInRadius(glm::vec3(1e30f, 0, 0), 1, indices);
+		test(sorted(indices) == std::vector<std::size_t>({a, b}), "grid with huge coordinates");
+		huge.findInRadius(glm::vec3(0), 1e31f, indices);
+		test_eq(indices.size(), std::size_t(3), "grid with a huge radius");
+	}
+
+	void bvh(){
+		auto mesh = ofMesh::sphere(100, 16, OF_PRIMITIVE_TRIANGLES);
+		ofMeshBvh bvh(mesh);
+		auto & faces = mesh.getUniqueFaces();
+		test_eq(bvh.getNumTriangles(), faces.size(), "bvh triangles");
+
+		bool intersectOk = true;
+		bool anyHitOk = true;
+		int hits = 0;
+		for(int i = 0; i < 200; i++){
+			glm::vec3 origin = glm::normalize(glm::vec3(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1))) * 300.f;
+			glm::vec3 direction = glm::vec3(ofRandom(-120, 120), ofRandom(-120, 120), ofRandom(-120, 120)) - origin;
+			float closest = std::numeric_limits<float>::max();
+			for(auto & face: faces){
+				float distance = rayTriangle(origin, direction, face.getVertex(0), face.getVertex(1), face.getVertex(2));
+				if(distance >= 0 && distance < closest){
+					closest = distance;
+				}
+			}
+			bool hit = closest != std::numeric_limits<float>::max();
+			hits += hit;
+
+			ofMeshBvh::Intersection intersection;
+			bool bvhHit = bvh.intersect(origin, direction, intersection);
+			intersectOk &= bvhHit == hit;
+			if(hit && bvhHit){
+				intersectOk &= std::abs(intersection.distance - closest) < 1e-4f;
+				intersectOk &= glm::distance(intersection.position, origin + direction * closest) < 1e-2f;
+			}
+			anyHitOk &= bvh.intersects(origin, direction) == hit;
+		}
+		test(hits > 0 && hits < 200, "rays both hit and miss the mesh");
+		test(intersectOk, "bvh closest intersection equals brute force");
+		test(anyHitOk, "bvh any hit equals brute force");
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		kdTree();
+		spatialGrid();
+		bvh();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
@@ -0,0 +1,139 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofProfiler.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void testHistogram(){
+		ofHistogram histogram(1e-3, 10, 20);
+		test_eq(histogram.getCount(), 0u, "empty histogram count");
+		test_eq(histogram.getPercentile(0.5), 0.0, "empty histogram percentile");
+
+		// 1ms to 100ms
+		for(int i=1;i<=100;i++){
+			histogram.add(i / 1000.0);
+		}
+		test_eq(histogram.getCount(), 100u, "histogram count");
+		test_eq(histogram.getMin(), 0.001, "histogram min");
+		test_eq(histogram.getMax(), 0.1, "histogram max");
+		test_lt(std::abs(histogram.getMean() - 0.0505), 1e-9, "histogram mean");
+
+		// 20 buckets per decade have a resolution of about 12%
+		auto p50 = histogram.getPercentile(0.5);
+		auto p90 = histogram.getPercentile(0.9);
+		auto p99 = histogram.getPercentile(0.99);
+		test_lt(std::abs(p50 - 0.050) / 0.050, 0.13, "histogram p50 " + ofToString(p50));
+		test_lt(std::abs(p90 - 0.090) / 0.090, 0.13, "histogram p90 " + ofToString(p90));
+		test_lt(std::abs(p99 - 0.099) / 0.099, 0.13, "histogram p99 " + ofToString(p99));
+		test(p50 <= p90 && p90 <= p99, "histogram percentiles are ordered");
+		test_eq(histogram.getPercentile(1), histogram.getMax(), "histogram p100 is the max");
+		test_eq(histogram.getPercentile(2), histogram.getMax(), "histogram percentiles are clamped");
+		test_lt(std::abs(histogram.getPercentile(0) - histogram.getMin()) / histogram.getMin(), 0.13, "histogram p0 is the min");
+
+		histogram.add(0.0001);
+		histogram.add(100);
+		test_eq(histogram.getBucketCount(0), 1u, "values below the range go to the first bucket");
+		test_eq(histogram.getBucketCount(histogram.getNumBuckets() - 1), 1u, "values above the range go to the last bucket");
+		test_eq(histogram.getMax(), 100.0, "max includes values out of range");
+
+		uint64_t total = 0;
+		for(size_t i=0;i<histogram.getNumBuckets();i++){
+			total += histogram.getBucketCount(i);
+		}
+		test_eq(total, histogram.getCount(), "bucket counts add up to the count");
+
+		histogram.reset();
+		test_eq(histogram.getCount(), 0u, "histogram reset");
+		test_eq(histogram.getMax(), 0.0, "reset histogram max");
+	}
+
+	void testCounter(){
+		ofCounter counter;
+		test_eq(counter.get(), 0, "new counter is 0");
+		std::vector<std::thread> threads;
+		for(int i=0;i<4;i++){
+			threads.emplace_back([&counter]{
+				for(int j=0;j<10000;j++){
+					counter.add();
+				}
+			});
+		}
+		for(auto & thread: threads){
+			thread.join();
+		}
+		test_eq(counter.get(), 40000, "counter adds from several threads");
+		counter.add(-5);
+		test_eq(counter.get(), 39995, "counter adds negative values");
+		counter.reset();
+		test_eq(counter.get(), 0, "counter reset");
+	}
+
+	void testProfiler(){
+		ofProfiler profiler;
+		auto & section = profiler.getSection("section, \"quoted\"");
+		test(&profiler.getSection("section, \"quoted\"") == &section, "sections are created once");
+		profiler.getCounter("counter").add(3);
+
+		section.add(std::chrono::milliseconds(2));
+		test_eq(section.getHistogram().getCount(), 1u, "add records in the histogram");
+
+		profiler.startTrace();
+		section.add(std::chrono::milliseconds(1));
+		{
+			ofScopedTimer timer(section);
+		}
+		profiler.stopTrace();
+		section.add(std::chrono::milliseconds(3));
+		test_eq(section.getHistogram().getCount(), 4u, "every measurement is in the histogram");
+
+		profiler.setEnabled(false);
+		section.add(std::chrono::milliseconds(3));
+		{
+			ofScopedTimer timer(section);
+		}
+		test_eq(section.getHistogram().getCount(), 4u, "nothing is measured while disabled");
+		profiler.setEnabled(true);
+
+		test(profiler.saveTrace("trace.json"), "save trace");
+		auto trace = ofLoadJson("trace.json");
+		auto & events = trace["traceEvents"];
+		test_eq(events.size(), 2u, "only measurements while tracing are in the trace");
+		if(events.size() == 2){
+			test_eq(events[0]["name"].get<std::string>(), section.getName(), "trace event name");
+			test_eq(events[0]["ph"].get<std::string>(), "X", "trace event type");
+			test_eq(events[0]["dur"].get<double>(), 1000.0, "added durations are in the trace, in microseconds");
+			test(events[1]["ts"].get<double>() >= events[0]["ts"].get<double>(), "trace events are in order");
+		}
+		ofFile::removeFile("trace.json");
+
+		test(profiler.saveCsv("profile.csv"), "save csv");
+		auto lines = ofSplitString(ofBufferFromFile("profile.csv").getText(), "\n", true, true);
+		test_eq(lines.size(), 3u, "csv has a header, a section and a counter");
+		if(lines.size() == 3){
+			test_eq(lines[0], "type,name,count,mean,min,p50,p90,p99,max", "csv header");
+			test(ofIsStringInString(lines[1], "section,\"section, \"\"quoted\"\"\",4,"), "csv section name is escaped and has the count");
+			test_eq(lines[2], "counter,counter,3,,,,,,", "csv counter");
+		}
+		ofFile::removeFile("profile.csv");
+
+		profiler.reset();
+		test_eq(section.getHistogram().getCount(), 0u, "profiler reset clears the sections");
+		test_eq(profiler.getCounter("counter").get(), 0, "profiler reset clears the counters");
+	}
+
+	void run(){
+		testHistogram();
+		testCounter();
+		testProfiler();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
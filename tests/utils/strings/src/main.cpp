@@ -55,6 +55,31 @@ class ofApp: public ofxUnitTestsApp{
 		ofStringReplace(replace,"replace","replaceeee");
 		test_eq(replace , "hi this is a replaceeee test","replace string element");
 
+		std::string shrink = "a--b--c----d";
+		ofStringReplace(shrink,"--","-");
+		test_eq(shrink, "a-b-c--d", "replace with shorter string");
+
+		std::string empty = "no search string";
+		ofStringReplace(empty,"","x");
+		test_eq(empty, "no search string", "replace empty search string");
+
+		std::vector<std::string> tokens;
+		for(auto token: ofStringSplitter(" hi,, this ,is ", ",", true, true)){
+			tokens.emplace_back(token.data(), token.size());
+		}
+		test_eq(ofJoinString(tokens, "|"), "hi|this|is", "splitter trim");
+		test_eq(tokens == ofSplitString(" hi,, this ,is ", ",", true, true), true, "splitter same as split");
+
+		test_eq(ofToInt(" 42abc"), 42, "toint");
+		test_eq(ofToInt("-2147483649"), std::numeric_limits<int>::min(), "toint clamped");
+		test_eq(ofToInt64("9223372036854775807"), std::numeric_limits<int64_t>::max(), "toint64");
+		test_eq(ofToFloat("1.5e3"), 1500.f, "tofloat");
+		test_eq(ofToDouble(ofStringView("0.25,0.5").substr(5)), 0.5, "todouble view");
+		test_eq(ofToFloat("1e"), 0.f, "tofloat exponent without digits");
+		test_eq(ofToString(1.f/3.f), "0.333333", "tostring float");
+		test_eq(ofToString(3.14159, 2), "3.14", "tostring precision");
+		test_eq(ofToString(-12345678901234ll), "-12345678901234", "tostring long long");
+
 #if !defined(TARGET_WIN32) || _MSC_VER
 		//TODO: This won't work by now in msys2 since it seems to only support C locale
 		test_eq(ofToLower("AbCéÉBbCcc"),"abcéébbccc","tolower");
@@ -0,0 +1,208 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void parallelFor(){
+		std::vector<int> counts(100000, 0);
+		ofParallelFor(0, counts.size(), [&](std::size_t i){
+			counts[i]++;
+		}, 1000);
+		test(std::all_of(counts.begin(), counts.end(), [](int count){ return count == 1; }), "parallel for calls every index once");
+
+		bool called = false;
+		ofParallelFor(10, 10, [&](std::size_t){
+			called = true;
+		});
+		test(!called, "parallel for with an empty range");
+
+		ofTaskPool pool(3);
+		std::mutex blocksMutex;
+		std::vector<std::pair<std::size_t, std::size_t>> blocks;
+		pool.parallelFor(5, 1005, 10, [&](std::size_t begin, std::size_t end){
+			std::lock_guard<std::mutex> lock(blocksMutex);
+			blocks.emplace_back(begin, end);
+		});
+		std::sort(blocks.begin(), blocks.end());
+		bool contiguous = !blocks.empty() && blocks.front().first == 5 && blocks.back().second == 1005;
+		for(std::size_t i = 1; i < blocks.size(); i++){
+			contiguous &= blocks[i].first == blocks[i - 1].second;
+		}
+		test(contiguous, "parallel for blocks cover the range without overlapping");
+	}
+
+	void parallelReduce(){
+		std::vector<float> values(100000);
+		for(auto & value: values){
+			value = ofRandom(-1, 1);
+		}
+		auto sum = [&]{
+			return ofParallelReduce(0, values.size(), 0.f,
+				[&](std::size_t i){ return values[i]; },
+				[](float a, float b){ return a + b; }, 100);
+		};
+		float first = sum();
+		bool sameResult = true;
+		for(int i = 0; i < 10; i++){
+			sameResult &= sum() == first;
+		}
+		test(sameResult, "parallel reduce of floats is always the same");
+
+		double expected = 0;
+		for(auto value: values){
+			expected += value;
+		}
+		test(std::abs(first - expected) < 1e-2, "parallel reduce sums every value");
+
+		auto count = ofParallelReduce(0, 12345, std::size_t(0),
+			[](std::size_t){ return std::size_t(1); },
+			[](std::size_t a, std::size_t b){ return a + b; });
+		test_eq(count, std::size_t(12345), "parallel reduce maps every index once");
+		test_eq(ofParallelReduce(3, 3, 7, [](std::size_t){ return 1; }, [](int a, int b){ return a + b; }), 7, "parallel reduce of an empty range returns the identity");
+	}
+
+	void groupCancel(){
+		// with one worker busy in the first task, the rest stay queued
+		// until the group is canceled
+		ofTaskPool pool(1);
+		ofTaskGroup group(pool);
+		std::atomic<bool> started(false);
+		std::atomic<bool> release(false);
+		std::atomic<int> ran(0);
+		group.run([&]{
+			started = true;
+			while(!release){
+				std::this_thread::yield();
+			}
+			ran++;
+		});
+		while(!started){
+			std::this_thread::yield();
+		}
+		for(int i = 0; i < 10; i++){
+			group.run([&]{
+				ran++;
+			});
+		}
+		group.cancel();
+		test(group.isCanceled(), "group canceled");
+		release = true;
+		group.wait();
+		test_eq(ran.load(), 1, "canceled group skips the tasks that didn't start");
+
+		test(!group.isCanceled(), "group can be used again after waiting");
+		for(int i = 0; i < 10; i++){
+			group.run([&]{
+				ran++;
+			});
+		}
+		group.wait();
+		test_eq(ran.load(), 11, "group runs every task after a cancel");
+	}
+
+	void exceptions(){
+		ofTaskGroup group;
+		std::atomic<int> ran(0);
+		for(int i = 0; i < 10; i++){
+			group.run([&, i]{
+				ran++;
+				if(i == 5){
+					throw std::runtime_error("group");
+				}
+			});
+		}
+		std::string message;
+		try{
+			group.wait();
+		}catch(std::exception & e){
+			message = e.what();
+		}
+		test_eq(message, std::string("group"), "group wait throws the exception of a task");
+		test_eq(ran.load(), 10, "an exception doesn't skip the other tasks of the group");
+
+		message.clear();
+		try{
+			group.wait();
+		}catch(std::exception & e){
+			message = e.what();
+		}
+		test(message.empty(), "the exception is only thrown once");
+
+		message.clear();
+		try{
+			ofParallelFor(0, 1000, [](std::size_t i){
+				if(i == 500){
+					throw std::runtime_error("parallel for");
+				}
+			});
+		}catch(std::exception & e){
+			message = e.what();
+		}
+		test_eq(message, std::string("parallel for"), "parallel for throws the exception of a block");
+
+		auto future = ofGetTaskPool().async([]() -> int{
+			throw std::runtime_error("async");
+		});
+		message.clear();
+		try{
+			future.get();
+		}catch(std::exception & e){
+			message = e.what();
+		}
+		test_eq(message, std::string("async"), "async future throws the exception of the task");
+	}
+
+	void mainThread(){
+		// every window notifies update, even the ones that don't use
+		// ofMainLoop, so that's what calls the main thread functions
+		auto mainThreadId = std::this_thread::get_id();
+		bool called = false;
+		bool onMainThread = false;
+		ofTaskPool pool(1);
+		pool.submit([&]{
+			pool.runOnMainThread([&]{
+				called = true;
+				onMainThread = std::this_thread::get_id() == mainThreadId;
+			});
+		});
+		auto start = ofGetElapsedTimeMillis();
+		while(!called && ofGetElapsedTimeMillis() - start < 5000){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(1);
+		}
+		test(called, "run on main thread called from the update event");
+		test(onMainThread, "run on main thread called from the main thread");
+
+		int result = 0;
+		ofGetTaskPool().async([]{
+			return 42;
+		}, [&](int value){
+			result = value;
+		});
+		start = ofGetElapsedTimeMillis();
+		while(result == 0 && ofGetElapsedTimeMillis() - start < 5000){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(1);
+		}
+		test_eq(result, 42, "async continuation called with the result in the main thread");
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		parallelFor();
+		parallelReduce();
+		groupCancel();
+		exceptions();
+		mainThread();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}
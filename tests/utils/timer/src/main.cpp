@@ -0,0 +1,133 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// advances the virtual time one frame, like an iteration of the main loop
+	void nextFrame(){
+		ofGetMainLoop()->loopEvent.notify(this);
+	}
+
+	void testVirtualPacing(){
+		ofSetFrameRate(50);
+		ofSetFramePacing(OF_FRAME_PACING_VIRTUAL);
+		test_eq(ofGetFramePacing(), OF_FRAME_PACING_VIRTUAL, "virtual pacing set");
+		test_eq(ofEvents().getTimeMode(), ofCoreEvents::FixedRate, "virtual pacing uses fixed rate time");
+		test_eq(ofEvents().getTimeModeFixedRateStep(), ofGetFixedStepForFps(50), "virtual pacing step is one frame");
+		test_eq(ofGetLastFrameTime(), std::chrono::duration<double>(std::chrono::nanoseconds(ofGetFixedStepForFps(50))).count(), "last frame time is one frame");
+
+		auto then = ofGetElapsedTimeMicros();
+		ofSleepMillis(10);
+		test_eq(ofGetElapsedTimeMicros(), then, "virtual time doesn't advance between frames");
+		nextFrame();
+		test_eq(ofGetElapsedTimeMicros() - then, 20000u, "virtual time advances exactly one frame");
+
+		ofFpsCounter counter;
+		for(int i=0;i<10;i++){
+			nextFrame();
+			counter.newFrame();
+			ofSleepMillis(i % 3);
+		}
+		test_eq(counter.getNumFrames(), 10u, "frames counted");
+		test_eq(counter.getLastFrameNanos(), ofGetFixedStepForFps(50), "virtual frames last exactly one step");
+		test_lt(counter.getFrameTimeJitterSecs(), 1e-6, "virtual frames have no jitter");
+
+		ofSetFrameRate(25);
+		test_eq(ofEvents().getTimeModeFixedRateStep(), ofGetFixedStepForFps(25), "changing the frame rate changes the virtual step");
+		then = ofGetElapsedTimeMicros();
+		nextFrame();
+		test_eq(ofGetElapsedTimeMicros() - then, 40000u, "virtual time advances one frame of the new rate");
+	}
+
+	void run(){
+		ofSetTimeModeFiltered(0.5);
+		testVirtualPacing();
+		ofSetFramePacing(OF_FRAME_PACING_SLEEP);
+		test_eq(ofEvents().getTimeMode(), ofCoreEvents::Filtered, "leaving virtual pacing restores filtered time");
+		test_eq(ofEvents().getTimeModeFilterAlpha(), 0.5f, "leaving virtual pacing keeps the filter alpha");
+
+		ofSetTimeModeFixedRate(ofGetFixedStepForFps(10));
+		testVirtualPacing();
+		ofSetFramePacing(OF_FRAME_PACING_PRECISE);
+		test_eq(ofEvents().getTimeMode(), ofCoreEvents::FixedRate, "leaving virtual pacing restores fixed rate time");
+		test_eq(ofEvents().getTimeModeFixedRateStep(), ofGetFixedStepForFps(10), "leaving virtual pacing restores the fixed rate step");
+		auto then = ofGetElapsedTimeMicros();
+		nextFrame();
+		test_eq(ofGetElapsedTimeMicros() - then, 100000u, "the clock uses the restored step");
+
+		ofSetTimeModeSystem();
+		testVirtualPacing();
+		ofSetFramePacing(OF_FRAME_PACING_SLEEP);
+		test_eq(ofEvents().getTimeMode(), ofCoreEvents::System, "leaving virtual pacing restores system time");
+		then = ofGetElapsedTimeMicros();
+		ofSleepMillis(10);
+		test_gt(ofGetElapsedTimeMicros() - then, 0u, "system time advances by itself");
+
+		// precise timer, the lower bound can't fail due to scheduling,
+		// the upper one is very generous for loaded machines
+		auto period = 5.0;
+		auto millisSince = [](std::chrono::steady_clock::time_point start){
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		};
+		ofTimer timer;
+		timer.setPrecise(true);
+		timer.setPeriodicEvent(period * 1000000);
+		auto start = std::chrono::steady_clock::now();
+		for(int i=0;i<10;i++){
+			timer.waitNext();
+		}
+		auto elapsed = millisSince(start);
+		test_gt(elapsed, period * 9, "precise timer waits for every event");
+		test_lt(elapsed, period * 100, "precise timer doesn't wait too long");
+
+		// catching up returns immediately for the missed events. a long
+		// period makes the waits that don't return immediately easy to tell
+		// apart even on loaded machines: sleeping 3.2 periods misses 3
+		// events and the next one is 0.8 periods away
+		period = 100.0;
+		auto countImmediateWaits = [&]{
+			timer.reset();
+			ofSleepMillis(int(period * 3.2));
+			int immediate = 0;
+			for(int i=0;i<10;i++){
+				auto waitStart = std::chrono::steady_clock::now();
+				timer.waitNext();
+				if(millisSince(waitStart) > period / 4){
+					break;
+				}
+				immediate++;
+			}
+			return immediate;
+		};
+		timer.setPeriodicEvent(period * 1000000);
+		timer.setCatchUp(true, 5);
+		test_eq(countImmediateWaits(), 3, "catching up doesn't wait for missed events");
+		timer.setCatchUp(false);
+		test_eq(countImmediateWaits(), 1, "without catching up the missed events are skipped");
+		timer.setCatchUp(true, 1);
+		test_eq(countImmediateWaits(), 1, "catching up skips the events over the maximum");
+
+		// the timer follows the real time in fixed rate time mode too
+		ofSetTimeModeFixedRate(ofGetFixedStepForFps(60));
+		timer.setCatchUp(false);
+		timer.setPeriodicEvent(5 * 1000000);
+		start = std::chrono::steady_clock::now();
+		for(int i=0;i<10;i++){
+			timer.waitNext();
+		}
+		elapsed = millisSince(start);
+		test_gt(elapsed, 5.0 * 9, "precise timer waits with fixed rate time");
+		test_lt(elapsed, 5.0 * 100, "precise timer doesn't wait forever with fixed rate time");
+		ofSetTimeModeSystem();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+
+}